@@ -37,7 +37,9 @@ public class MicroManager : ModuleRules
 				"Slate", "SlateCore", "UMG", "Niagara", "CinematicCamera", "MovieScene",
 				"MovieSceneTracks", "LevelSequence","AssetRegistry",
 				"AssetTools",
-				"ContentBrowser","InputCore","AppFramework", "Projects"
+				"ContentBrowser","InputCore","AppFramework", "Projects",
+				"EditorSubsystem",
+				"MicroManagerCore"
 			}
 		);
 
@@ -49,7 +51,11 @@ public class MicroManager : ModuleRules
 				"EditorStyle", 
 				"LevelEditor", 
 				"UMG",
-				"SlateReflector"
+				"SlateReflector",
+				"Kismet",
+				"DesktopPlatform",
+				"DirectoryWatcher",
+				"MaterialEditor"
 				// Add private dependencies that you statically link with here
 			}
 		);
@@ -0,0 +1,130 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "ActorActions/MicroManagerWorldActors.h"
+#include "Editor.h"
+#include "Engine/BlueprintGeneratedClass.h"
+#include "Subsystems/EditorActorSubsystem.h"
+#include "WorldPartition/WorldPartition.h"
+#include "WorldPartition/WorldPartitionActorDesc.h"
+#include "WorldPartition/WorldPartitionEditorLoaderAdapter.h"
+#include "WorldPartition/WorldPartitionHelpers.h"
+#include "WorldPartition/LoaderAdapter/LoaderAdapterActorList.h"
+
+FMicroManagerWorldActors::FMicroManagerWorldActors()
+{
+	World = GEditor ? GEditor->GetEditorWorldContext().World() : nullptr;
+	WorldPartition = World.IsValid() ? World->GetWorldPartition() : nullptr;
+
+	FEditorDelegates::MapChange.AddRaw(this, &FMicroManagerWorldActors::OnMapChange);
+}
+
+FMicroManagerWorldActors::~FMicroManagerWorldActors()
+{
+	FEditorDelegates::MapChange.RemoveAll(this);
+}
+
+void FMicroManagerWorldActors::OnMapChange(uint32 MapChangeFlags)
+{
+	// A rebuild keeps the map, and the actors loaded for it
+	if (!(MapChangeFlags & (MapChangeEventFlags::NewMap | MapChangeEventFlags::WorldTornDown))) return;
+
+	EditorLoaderAdapter.Reset();
+	WorldPartition.Reset();
+}
+
+bool FMicroManagerWorldActors::IsForEditorWorld() const
+{
+	return World.IsValid() && GEditor && GEditor->GetEditorWorldContext().World() == World.Get();
+}
+
+FMicroManagerActorSummary FMicroManagerWorldActors::MakeSummary(AActor* Actor)
+{
+	FMicroManagerActorSummary Summary;
+	Summary.Label = Actor->GetActorLabel();
+	Summary.ClassName = Actor->GetClass()->GetName();
+	Summary.bIsBlueprintClass = Actor->GetClass()->IsA<UBlueprintGeneratedClass>();
+	Summary.LoadedActor = Actor;
+	return Summary;
+}
+
+TArray<FMicroManagerActorSummary> FMicroManagerWorldActors::GatherActors() const
+{
+	TArray<FMicroManagerActorSummary> Summaries;
+
+	if (UWorldPartition* Partition = WorldPartition.Get())
+	{
+		FWorldPartitionHelpers::ForEachActorDesc(Partition, [&Summaries](const FWorldPartitionActorDesc* ActorDesc)
+		{
+			FMicroManagerActorSummary& Summary = Summaries.AddDefaulted_GetRef();
+			Summary.Guid = ActorDesc->GetGuid();
+			Summary.Label = ActorDesc->GetActorLabel().IsNone() ? ActorDesc->GetActorName().ToString() : ActorDesc->GetActorLabel().ToString();
+			Summary.bIsBlueprintClass = !ActorDesc->GetBaseClass().IsNull();
+			Summary.ClassName = Summary.bIsBlueprintClass
+				? ActorDesc->GetBaseClass().GetAssetName().ToString()
+				: GetNameSafe(ActorDesc->GetActorNativeClass());
+			Summary.LoadedActor = ActorDesc->IsLoaded() ? ActorDesc->GetActor() : nullptr;
+			return true;
+		});
+		return Summaries;
+	}
+
+	UEditorActorSubsystem* EditorActorSubsystem = GEditor ? GEditor->GetEditorSubsystem<UEditorActorSubsystem>() : nullptr;
+	if (!EditorActorSubsystem) return Summaries;
+
+	for (AActor* Actor : EditorActorSubsystem->GetAllLevelActors())
+	{
+		if (Actor)
+		{
+			Summaries.Add(MakeSummary(Actor));
+		}
+	}
+	return Summaries;
+}
+
+TArray<AActor*> FMicroManagerWorldActors::LoadActors(TConstArrayView<FMicroManagerActorSummary> Summaries)
+{
+	TArray<AActor*> Actors;
+	Actors.Reserve(Summaries.Num());
+
+	TArray<FGuid> ActorGuidsToLoad;
+	for (const FMicroManagerActorSummary& Summary : Summaries)
+	{
+		if (AActor* LoadedActor = Summary.LoadedActor.Get())
+		{
+			Actors.Add(LoadedActor);
+		}
+		else if (Summary.Guid.IsValid())
+		{
+			ActorGuidsToLoad.Add(Summary.Guid);
+		}
+	}
+
+	UWorldPartition* Partition = WorldPartition.Get();
+	if (!Partition || ActorGuidsToLoad.Num() == 0) return Actors;
+
+	// One loader for everything loaded on demand, listed as a user region in the World Partition editor.
+	// Only the listed actors get loaded, not the cells around them.
+	if (!EditorLoaderAdapter.IsValid())
+	{
+		EditorLoaderAdapter = Partition->CreateEditorLoaderAdapter<FLoaderAdapterActorList>(World.Get());
+		EditorLoaderAdapter->GetLoaderAdapter()->SetUserCreated(true);
+	}
+
+	IWorldPartitionActorLoaderInterface::ILoaderAdapter* LoaderAdapter = EditorLoaderAdapter->GetLoaderAdapter();
+	static_cast<FLoaderAdapterActorList*>(LoaderAdapter)->AddActors(ActorGuidsToLoad);
+	if (!LoaderAdapter->IsLoaded())
+	{
+		LoaderAdapter->Load();
+	}
+
+	for (const FGuid& ActorGuid : ActorGuidsToLoad)
+	{
+		const FWorldPartitionActorDesc* ActorDesc = Partition->GetActorDesc(ActorGuid);
+		if (AActor* Actor = ActorDesc ? ActorDesc->GetActor() : nullptr)
+		{
+			Actors.Add(Actor);
+		}
+	}
+	return Actors;
+}
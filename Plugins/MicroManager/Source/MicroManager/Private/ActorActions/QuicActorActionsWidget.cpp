@@ -2,7 +2,259 @@
 
 #include "Subsystems/EditorActorSubsystem.h"
 #include "ActorActions/QuicActorActionsWidget.h"
+#include "ActorActions/MicroManagerWorldActors.h"
 #include "DebugHelper.h"
+#include "ScopedTransaction.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/StaticMeshActor.h"
+#include "Components/HierarchicalInstancedStaticMeshComponent.h"
+#include "Components/LocalLightComponent.h"
+#include "MicroManagerCoreAlgorithms.h"
+#include "SlateWidgets/MicroManagerReportWidget.h"
+
+namespace
+{
+	// Actors can only share an instanced component when they sit in the same level, and the mesh, the material overrides
+	// and every setting one instanced component holds for all of its instances match
+	struct FInstancingGroupKey
+	{
+		ULevel* Level = nullptr;
+		UStaticMesh* StaticMesh = nullptr;
+		TArray<UMaterialInterface*> OverrideMaterials;
+
+		TEnumAsByte<EComponentMobility::Type> Mobility = EComponentMobility::Static;
+		FName CollisionProfileName;
+		TEnumAsByte<ECollisionEnabled::Type> CollisionEnabled = ECollisionEnabled::NoCollision;
+		TEnumAsByte<ECollisionChannel> CollisionObjectType = ECC_WorldStatic;
+		FCollisionResponseContainer CollisionResponses;
+		float CullDistance = 0.f;
+		bool bCastShadow = true;
+		FLightingChannels LightingChannels;
+
+		bool operator==(const FInstancingGroupKey& Other) const
+		{
+			return Level == Other.Level && StaticMesh == Other.StaticMesh && OverrideMaterials == Other.OverrideMaterials &&
+				Mobility == Other.Mobility && CollisionProfileName == Other.CollisionProfileName &&
+				CollisionEnabled == Other.CollisionEnabled && CollisionObjectType == Other.CollisionObjectType &&
+				FMemory::Memcmp(CollisionResponses.EnumArray, Other.CollisionResponses.EnumArray, sizeof(CollisionResponses.EnumArray)) == 0 &&
+				CullDistance == Other.CullDistance && bCastShadow == Other.bCastShadow &&
+				GetLightingChannelMaskForStruct(LightingChannels) == GetLightingChannelMaskForStruct(Other.LightingChannels);
+		}
+
+		friend uint32 GetTypeHash(const FInstancingGroupKey& Key)
+		{
+			uint32 Hash = HashCombine(GetTypeHash(Key.Level), GetTypeHash(Key.StaticMesh));
+			for (const UMaterialInterface* Material : Key.OverrideMaterials)
+			{
+				Hash = HashCombine(Hash, GetTypeHash(Material));
+			}
+			Hash = HashCombine(Hash, GetTypeHash(Key.CollisionProfileName));
+			return HashCombine(Hash, FCrc::MemCrc32(Key.CollisionResponses.EnumArray, sizeof(Key.CollisionResponses.EnumArray)));
+		}
+	};
+
+	FInstancingGroupKey MakeInstancingGroupKey(ULevel* Level, const UStaticMeshComponent& MeshComponent)
+	{
+		FInstancingGroupKey GroupKey;
+		GroupKey.Level = Level;
+		GroupKey.StaticMesh = MeshComponent.GetStaticMesh();
+		GroupKey.OverrideMaterials = MeshComponent.OverrideMaterials;
+		GroupKey.Mobility = MeshComponent.Mobility;
+		GroupKey.CollisionProfileName = MeshComponent.GetCollisionProfileName();
+		GroupKey.CollisionEnabled = MeshComponent.GetCollisionEnabled();
+		GroupKey.CollisionObjectType = MeshComponent.GetCollisionObjectType();
+		GroupKey.CollisionResponses = MeshComponent.GetCollisionResponseToChannels();
+		GroupKey.CullDistance = MeshComponent.LDMaxDrawDistance;
+		GroupKey.bCastShadow = MeshComponent.CastShadow;
+		GroupKey.LightingChannels = MeshComponent.LightingChannels;
+		return GroupKey;
+	}
+
+	// Why an actor can't be folded into an instance, empty when it can. Only a plain static mesh actor holds nothing
+	// an instance would lose: a subclass may carry logic, other components or attached actors would be left behind.
+	FString GetInstancingBlocker(const AActor* Actor)
+	{
+		if (Actor->GetClass() != AStaticMeshActor::StaticClass()) return TEXT("not a plain static mesh actor");
+
+		const UStaticMeshComponent* MeshComponent = CastChecked<AStaticMeshActor>(Actor)->GetStaticMeshComponent();
+		if (!MeshComponent || !MeshComponent->GetStaticMesh()) return TEXT("no static mesh");
+
+		if (Actor->GetComponents().Num() > 1) return TEXT("has other components");
+		if (Actor->GetAttachParentActor()) return TEXT("attached to another actor");
+
+		TArray<AActor*> AttachedActors;
+		Actor->GetAttachedActors(AttachedActors);
+		if (AttachedActors.Num() > 0) return TEXT("has attached actors");
+
+		return FString();
+	}
+
+	namespace LevelAuditColumns
+	{
+		static const FName Name(TEXT("Name"));
+		static const FName Count(TEXT("Count"));
+		static const FName Detail(TEXT("Detail"));
+	}
+
+	struct FLevelAuditFinding
+	{
+		AActor* Actor = nullptr;
+		FString Detail;
+	};
+
+	struct FLevelAuditResult
+	{
+		TArray<FLevelAuditFinding> Findings[static_cast<int32>(E_LevelAuditCategory::ELAC_MAX)];
+
+		TArray<FLevelAuditFinding>& GetFindings(E_LevelAuditCategory Category) { return Findings[static_cast<int32>(Category)]; }
+	};
+
+	// A Blueprint ticking on top of a native base whose Tick does nothing only needs it for its own Tick event
+	bool TicksWithoutTickEvent(const UClass* Class, bool bTickEnabled, std::initializer_list<const UClass*> BaseNativeClasses)
+	{
+		if(!bTickEnabled || Class->IsNative()) return false;
+
+		const UClass* NativeClass = Class->GetSuperClass();
+		while(NativeClass && !NativeClass->IsNative())
+		{
+			NativeClass = NativeClass->GetSuperClass();
+		}
+
+		bool bHasBaseNativeClass = false;
+		for(const UClass* BaseNativeClass:BaseNativeClasses)
+		{
+			bHasBaseNativeClass |= NativeClass == BaseNativeClass;
+		}
+		return bHasBaseNativeClass && !Class->IsFunctionImplementedInScript(TEXT("ReceiveTick"));
+	}
+
+	struct FShadowLightSphere
+	{
+		const ULocalLightComponent* Light = nullptr;
+		FVector Center;
+		float Radius = 0.f;
+	};
+
+	// Sweeps the spheres along X so only the lights whose extents overlap on that axis are compared
+	TSet<const ULocalLightComponent*> FindOverlappingLights(TArray<FShadowLightSphere>& Spheres)
+	{
+		Spheres.Sort([](const FShadowLightSphere& A, const FShadowLightSphere& B)
+		{
+			return A.Center.X - A.Radius < B.Center.X - B.Radius;
+		});
+
+		TSet<const ULocalLightComponent*> OverlappingLights;
+		for(int32 SphereIndex = 0; SphereIndex < Spheres.Num(); ++SphereIndex)
+		{
+			const FShadowLightSphere& Sphere = Spheres[SphereIndex];
+			for(int32 OtherIndex = SphereIndex + 1; OtherIndex < Spheres.Num(); ++OtherIndex)
+			{
+				const FShadowLightSphere& Other = Spheres[OtherIndex];
+				if(Other.Center.X - Other.Radius > Sphere.Center.X + Sphere.Radius) break;
+
+				if(FVector::DistSquared(Sphere.Center, Other.Center) < FMath::Square(Sphere.Radius + Other.Radius))
+				{
+					OverlappingLights.Add(Sphere.Light);
+					OverlappingLights.Add(Other.Light);
+				}
+			}
+		}
+		return OverlappingLights;
+	}
+
+	FLevelAuditResult AuditLevelActors(const TArray<AActor*>& Actors, int32 MinimumActorsPerGroup)
+	{
+		FLevelAuditResult Result;
+		TMap<FInstancingGroupKey, TArray<AStaticMeshActor*>> InstancingGroups;
+		TArray<FShadowLightSphere> ShadowLightSpheres;
+		TArray<UActorComponent*> Components;
+
+		for(AActor* Actor:Actors)
+		{
+			if(!Actor) continue;
+
+			TArray<FString> TickingParts;
+			if(TicksWithoutTickEvent(Actor->GetClass(),
+				Actor->PrimaryActorTick.bCanEverTick && Actor->PrimaryActorTick.bStartWithTickEnabled, { AActor::StaticClass() }))
+			{
+				TickingParts.Add(Actor->GetClass()->GetName());
+			}
+
+			TArray<FString> UnculledMeshes;
+			Actor->GetComponents(Components);
+			for(UActorComponent* Component:Components)
+			{
+				if(TicksWithoutTickEvent(Component->GetClass(),
+					Component->PrimaryComponentTick.bCanEverTick && Component->PrimaryComponentTick.bStartWithTickEnabled,
+					{ UActorComponent::StaticClass(), USceneComponent::StaticClass() }))
+				{
+					TickingParts.Add(Component->GetName());
+				}
+
+				if(const ULocalLightComponent* Light = Cast<ULocalLightComponent>(Component))
+				{
+					if(Light->Mobility == EComponentMobility::Movable && Light->CastShadows && Light->CastDynamicShadows && Light->IsVisible())
+					{
+						ShadowLightSpheres.Add({ Light, Light->GetComponentLocation(), Light->AttenuationRadius });
+					}
+				}
+
+				// Instanced components cull per instance with their own distances
+				const UStaticMeshComponent* MeshComponent = Cast<UStaticMeshComponent>(Component);
+				if(MeshComponent && !MeshComponent->IsA<UInstancedStaticMeshComponent>() && MeshComponent->GetStaticMesh() &&
+					MeshComponent->IsVisible() && MeshComponent->LDMaxDrawDistance <= 0.f && MeshComponent->CachedMaxDrawDistance <= 0.f)
+				{
+					UnculledMeshes.Add(MeshComponent->GetStaticMesh()->GetName());
+				}
+			}
+
+			if(TickingParts.Num() > 0)
+			{
+				Result.GetFindings(E_LevelAuditCategory::ELAC_UnneededTick).Add({ Actor, FString::Join(TickingParts, TEXT(", ")) });
+			}
+			if(UnculledMeshes.Num() > 0)
+			{
+				Result.GetFindings(E_LevelAuditCategory::ELAC_NoCullDistance).Add({ Actor, FString::Join(UnculledMeshes, TEXT(", ")) });
+			}
+
+			// Only what the merge action would accept
+			if(GetInstancingBlocker(Actor).IsEmpty())
+			{
+				AStaticMeshActor* StaticMeshActor = CastChecked<AStaticMeshActor>(Actor);
+				InstancingGroups.FindOrAdd(MakeInstancingGroupKey(StaticMeshActor->GetLevel(), *StaticMeshActor->GetStaticMeshComponent()))
+					.Add(StaticMeshActor);
+			}
+		}
+
+		const TSet<const ULocalLightComponent*> OverlappingLights = FindOverlappingLights(ShadowLightSpheres);
+		for(const FShadowLightSphere& Sphere:ShadowLightSpheres)
+		{
+			if(OverlappingLights.Contains(Sphere.Light))
+			{
+				Result.GetFindings(E_LevelAuditCategory::ELAC_OverlappingShadowLights).Add({ Sphere.Light->GetOwner(),
+					FString::Printf(TEXT("%s, radius %.0f"), *Sphere.Light->GetName(), Sphere.Radius) });
+			}
+		}
+
+		for(const TPair<FInstancingGroupKey, TArray<AStaticMeshActor*>>& Group:InstancingGroups)
+		{
+			if(Group.Value.Num() < MinimumActorsPerGroup) continue;
+
+			for(AStaticMeshActor* GroupActor:Group.Value)
+			{
+				Result.GetFindings(E_LevelAuditCategory::ELAC_InstancingCandidates).Add({ GroupActor,
+					FString::Printf(TEXT("%s, %d copies"), *Group.Key.StaticMesh->GetName(), Group.Value.Num()) });
+			}
+		}
+
+		return Result;
+	}
+
+	FString GetCategoryDisplayName(E_LevelAuditCategory Category)
+	{
+		return StaticEnum<E_LevelAuditCategory>()->GetDisplayNameTextByValue(static_cast<int64>(Category)).ToString();
+	}
+}
 
 void UQuicActorActionsWidget::SelectAllActorsWithSimilarName()
 {
@@ -26,19 +278,39 @@ void UQuicActorActionsWidget::SelectAllActorsWithSimilarName()
 	FString SelectedActorName = SelectedActors[0]->GetActorLabel();
 	const FString NameToSearch = SelectedActorName.LeftChop(4);
 
-	TArray<AActor*> AllLeveActors = EditorActorSubsystem->GetAllLevelActors();
+	// On World Partition maps the labels come from the actor descriptors, unloaded cells included
+	TArray<FMicroManagerActorSummary> MatchingActors;
+	int32 UnloadedMatches = 0;
 
-	for(AActor* ActorInLevel:AllLeveActors)
+	for(const FMicroManagerActorSummary& ActorSummary:GetWorldActors().GatherActors())
 	{
-		if(!ActorInLevel) continue;
+		if(ActorSummary.Label.Contains(NameToSearch,SearchCase))
+		{
+			MatchingActors.Add(ActorSummary);
+			UnloadedMatches += ActorSummary.LoadedActor.IsValid() ? 0 : 1;
+		}
+	}
+
+	if(UnloadedMatches>0)
+	{
+		const EAppReturnType::Type ConfirmResult = DebugHelper::ShowMsgDialog(EAppMsgType::YesNo,
+			FString::Printf(TEXT("%d of the %d actors with a similar name are in unloaded cells.\n\nLoad them to select them too?\n")
+			TEXT("They stay loaded until you unload their region in the World Partition editor."),
+			UnloadedMatches, MatchingActors.Num()), false);
 
-		if(ActorInLevel->GetActorLabel().Contains(NameToSearch,SearchCase))
+		if(ConfirmResult != EAppReturnType::Yes)
 		{
-			EditorActorSubsystem->SetActorSelectionState(ActorInLevel,true);
-			SelectionCounter++;
+			MatchingActors.RemoveAll([](const FMicroManagerActorSummary& ActorSummary) { return !ActorSummary.LoadedActor.IsValid(); });
 		}
 	}
 
+	// Only the matches get loaded, not the cells around them
+	for(AActor* ActorInLevel:GetWorldActors().LoadActors(MatchingActors))
+	{
+		EditorActorSubsystem->SetActorSelectionState(ActorInLevel,true);
+		SelectionCounter++;
+	}
+
 	if(SelectionCounter>0)
 	{
 		DebugHelper::ShowNotifyInfo(TEXT("Successfully selected ") + 
@@ -120,6 +392,392 @@ void UQuicActorActionsWidget::DuplicateActors()
 }
 
 
+#pragma region ActorBatchInstancing
+
+void UQuicActorActionsWidget::MergeActorsIntoInstances()
+{
+	if(!GetEditorActorSubsystem()) return;
+
+	TArray<AActor*> SelectedActors = EditorActorSubsystem->GetSelectedLevelActors();
+
+	if(SelectedActors.Num()==0)
+	{
+		DebugHelper::ShowNotifyInfo(TEXT("No actor selected"));
+		return;
+	}
+
+	// Bucket every selected static mesh actor by level, mesh, overrides and component settings in one pass.
+	// Actors whose settings differ land in different groups, so nothing is flattened onto the first actor's settings.
+	TMap<FInstancingGroupKey, TArray<AStaticMeshActor*>> ActorGroups;
+	int32 BlockedActorCount = 0;
+
+	for(AActor* SelectedActor:SelectedActors)
+	{
+		if(!SelectedActor) continue;
+
+		const FString Blocker = GetInstancingBlocker(SelectedActor);
+		if(!Blocker.IsEmpty())
+		{
+			DebugHelper::PrintLog(SelectedActor->GetActorLabel() + TEXT(" is not merged: ") + Blocker);
+			++BlockedActorCount;
+			continue;
+		}
+
+		AStaticMeshActor* StaticMeshActor = CastChecked<AStaticMeshActor>(SelectedActor);
+		ActorGroups.FindOrAdd(MakeInstancingGroupKey(StaticMeshActor->GetLevel(), *StaticMeshActor->GetStaticMeshComponent()))
+			.Add(StaticMeshActor);
+	}
+
+	// Drop groups that are too small to be worth merging
+	int32 UngroupedActorCount = 0;
+	for(auto GroupIt = ActorGroups.CreateIterator(); GroupIt; ++GroupIt)
+	{
+		if(GroupIt.Value().Num() < MinimumActorsPerGroup)
+		{
+			UngroupedActorCount += GroupIt.Value().Num();
+			GroupIt.RemoveCurrent();
+		}
+	}
+
+	FString LeftOutText;
+	if(BlockedActorCount > 0)
+	{
+		LeftOutText += FString::Printf(TEXT("%d actors are left out: other classes, other components or attachments, see the output log.\n"),
+			BlockedActorCount);
+	}
+	if(UngroupedActorCount > 0)
+	{
+		LeftOutText += FString::Printf(TEXT("%d actors are left out: fewer than %d share their mesh, materials, mobility, collision, ")
+			TEXT("cull distance, shadow and lighting channels.\n"), UngroupedActorCount, MinimumActorsPerGroup);
+	}
+
+	if(ActorGroups.Num()==0)
+	{
+		DebugHelper::ShowMsgDialog(EAppMsgType::Ok, TEXT("No group of identical static mesh actors found in selection.\n") + LeftOutText);
+		return;
+	}
+
+	// Every actor costs one component and one draw per mesh section, every group will cost that only once
+	int32 ActorsToMerge = 0;
+	int32 DrawCallsBefore = 0;
+	int32 DrawCallsAfter = 0;
+
+	for(const TPair<FInstancingGroupKey, TArray<AStaticMeshActor*>>& Group:ActorGroups)
+	{
+		const int32 SectionsPerMesh = FMath::Max(1, Group.Key.StaticMesh->GetNumSections(0));
+
+		ActorsToMerge += Group.Value.Num();
+		DrawCallsBefore += Group.Value.Num() * SectionsPerMesh;
+		DrawCallsAfter += SectionsPerMesh;
+	}
+
+	const EAppReturnType::Type ConfirmResult = DebugHelper::ShowMsgDialog(EAppMsgType::YesNo,
+		FString::Printf(TEXT("%d actors will be merged into %d instanced components.\n%s")
+		TEXT("Components: %d -> %d\nDraw calls (LOD0 sections): %d -> %d\n\nDo you want to continue?"),
+		ActorsToMerge, ActorGroups.Num(), *LeftOutText, ActorsToMerge, ActorGroups.Num(), DrawCallsBefore, DrawCallsAfter), false);
+
+	if(ConfirmResult != EAppReturnType::Yes) return;
+
+	const FScopedTransaction Transaction(FText::FromString(TEXT("Merge Actors Into Instances")));
+
+	TArray<AActor*> CreatedHostActors;
+
+	for(const TPair<FInstancingGroupKey, TArray<AStaticMeshActor*>>& Group:ActorGroups)
+	{
+		AStaticMeshActor* FirstActor = Group.Value[0];
+		UWorld* World = FirstActor->GetWorld();
+		if(!World) continue;
+
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.ObjectFlags |= RF_Transactional;
+		SpawnParams.OverrideLevel = FirstActor->GetLevel();
+
+		AActor* HostActor = World->SpawnActor<AActor>(AActor::StaticClass(), FirstActor->GetActorTransform(), SpawnParams);
+		if(!HostActor) continue;
+
+		UInstancedStaticMeshComponent* InstancedComponent = bUseHierarchicalInstances ?
+			NewObject<UHierarchicalInstancedStaticMeshComponent>(HostActor, NAME_None, RF_Transactional) :
+			NewObject<UInstancedStaticMeshComponent>(HostActor, NAME_None, RF_Transactional);
+
+		// Every actor of the group shares these settings, a movable or overlap only group must not turn into static blocking geometry
+		const FInstancingGroupKey& GroupKey = Group.Key;
+		InstancedComponent->SetMobility(GroupKey.Mobility);
+		InstancedComponent->SetCollisionProfileName(GroupKey.CollisionProfileName);
+		InstancedComponent->SetCollisionEnabled(GroupKey.CollisionEnabled);
+		InstancedComponent->SetCollisionObjectType(GroupKey.CollisionObjectType);
+		InstancedComponent->SetCollisionResponseToChannels(GroupKey.CollisionResponses);
+		InstancedComponent->SetCastShadow(GroupKey.bCastShadow);
+		InstancedComponent->LightingChannels = GroupKey.LightingChannels;
+
+		// Each actor was culled on its own, each instance is too
+		InstancedComponent->SetCullDistances(0, FMath::RoundToInt(GroupKey.CullDistance));
+		InstancedComponent->SetWorldTransform(FirstActor->GetActorTransform());
+		HostActor->SetRootComponent(InstancedComponent);
+		HostActor->AddInstanceComponent(InstancedComponent);
+		InstancedComponent->RegisterComponent();
+
+		InstancedComponent->SetStaticMesh(Group.Key.StaticMesh);
+		for(int32 MaterialIndex = 0; MaterialIndex < Group.Key.OverrideMaterials.Num(); ++MaterialIndex)
+		{
+			InstancedComponent->SetMaterial(MaterialIndex, Group.Key.OverrideMaterials[MaterialIndex]);
+		}
+
+		// Take the component transform, not the actor one, so a pivot offset on the original survives
+		TArray<FTransform> InstanceTransforms;
+		InstanceTransforms.Reserve(Group.Value.Num());
+		for(const AStaticMeshActor* GroupActor:Group.Value)
+		{
+			InstanceTransforms.Add(GroupActor->GetStaticMeshComponent()->GetComponentTransform());
+		}
+		InstancedComponent->AddInstances(InstanceTransforms, false, true);
+
+		HostActor->SetActorLabel((bUseHierarchicalInstances ? TEXT("HISM_") : TEXT("ISM_")) + Group.Key.StaticMesh->GetName());
+		CreatedHostActors.Add(HostActor);
+
+		for(AStaticMeshActor* GroupActor:Group.Value)
+		{
+			World->EditorDestroyActor(GroupActor, true);
+		}
+	}
+
+	EditorActorSubsystem->SetSelectedLevelActors(CreatedHostActors);
+
+	DebugHelper::ShowNotifyInfo(TEXT("Successfully merged ") + FString::FromInt(ActorsToMerge) +
+	TEXT(" actors into ") + FString::FromInt(CreatedHostActors.Num()) + TEXT(" instanced components"));
+}
+
+#pragma endregion
+
+
+#pragma region ActorDuplicateDetection
+
+void UQuicActorActionsWidget::SelectOverlappingDuplicates()
+{
+	if(!GetEditorActorSubsystem()) return;
+
+	const TArray<AActor*> DuplicateActors = FindOverlappingDuplicateActors();
+	if(DuplicateActors.Num()==0)
+	{
+		DebugHelper::ShowNotifyInfo(TEXT("No overlapping duplicate found"));
+		return;
+	}
+
+	EditorActorSubsystem->SetSelectedLevelActors(DuplicateActors);
+
+	DebugHelper::ShowNotifyInfo(TEXT("Successfully selected ") + FString::FromInt(DuplicateActors.Num()) + TEXT(" overlapping duplicates"));
+}
+
+void UQuicActorActionsWidget::DeleteOverlappingDuplicates()
+{
+	if(!GetEditorActorSubsystem()) return;
+
+	const TArray<AActor*> DuplicateActors = FindOverlappingDuplicateActors();
+	if(DuplicateActors.Num()==0)
+	{
+		DebugHelper::ShowNotifyInfo(TEXT("No overlapping duplicate found"));
+		return;
+	}
+
+	const EAppReturnType::Type ConfirmResult = DebugHelper::ShowMsgDialog(EAppMsgType::YesNo,
+		FString::Printf(TEXT("%d actors are stacked on an identical one and will be deleted.\n\nDo you want to continue?"),
+		DuplicateActors.Num()), false);
+
+	if(ConfirmResult != EAppReturnType::Yes) return;
+
+	const FScopedTransaction Transaction(FText::FromString(TEXT("Delete Overlapping Duplicates")));
+
+	int32 Counter = 0;
+	for(AActor* DuplicateActor:DuplicateActors)
+	{
+		UWorld* World = DuplicateActor->GetWorld();
+		if(World && World->EditorDestroyActor(DuplicateActor, true))
+		{
+			Counter++;
+		}
+	}
+
+	DebugHelper::ShowNotifyInfo(TEXT("Successfully deleted ") + FString::FromInt(Counter) + TEXT(" overlapping duplicates"));
+}
+
+TArray<AActor*> UQuicActorActionsWidget::FindOverlappingDuplicateActors()
+{
+	const double StartSeconds = FPlatformTime::Seconds();
+
+	// One group id per level, class, mesh, materials and component settings, the spatial hash only compares actors of the same group.
+	// Sublevels and streamed in cells often repeat a placement on purpose, only one level's copy is a duplicate.
+	TMap<TPair<UClass*, FInstancingGroupKey>, int32> GroupIds;
+	TArray<AActor*> Actors;
+	TArray<FMicroManagerPlacement> Placements;
+
+	for(AActor* Actor:EditorActorSubsystem->GetAllLevelActors())
+	{
+		const UStaticMeshComponent* MeshComponent = Actor ? Cast<UStaticMeshComponent>(Actor->GetRootComponent()) : nullptr;
+		if(!MeshComponent || !MeshComponent->GetStaticMesh() || MeshComponent->IsA<UInstancedStaticMeshComponent>()) continue;
+
+		const int32& GroupId = GroupIds.FindOrAdd(
+			TPair<UClass*, FInstancingGroupKey>(Actor->GetClass(), MakeInstancingGroupKey(Actor->GetLevel(), *MeshComponent)), GroupIds.Num());
+
+		Actors.Add(Actor);
+		Placements.Add({ GroupId, MeshComponent->GetComponentTransform() });
+	}
+
+	FMicroManagerTransformTolerance Tolerance;
+	Tolerance.Location = DuplicateLocationTolerance;
+	Tolerance.RotationDegrees = DuplicateRotationTolerance;
+	Tolerance.Scale = DuplicateScaleTolerance;
+
+	TArray<int32> DuplicateIndices;
+	MicroManagerCore::FindOverlappingDuplicates(Placements, Tolerance, DuplicateIndices);
+
+	TArray<AActor*> DuplicateActors;
+	DuplicateActors.Reserve(DuplicateIndices.Num());
+	for(const int32 DuplicateIndex:DuplicateIndices)
+	{
+		DuplicateActors.Add(Actors[DuplicateIndex]);
+	}
+
+	DebugHelper::PrintLog(FString::Printf(TEXT("Found %d overlapping duplicates among %d static mesh actors in %.1f ms"),
+		DuplicateActors.Num(), Actors.Num(), (FPlatformTime::Seconds() - StartSeconds) * 1000.0));
+
+	return DuplicateActors;
+}
+
+#pragma endregion
+
+
+#pragma region LevelAudit
+
+void UQuicActorActionsWidget::AuditLevelPerformance()
+{
+	if(!GetEditorActorSubsystem()) return;
+
+	const TArray<AActor*> ActorsToAudit = GetActorsToAudit();
+
+	// The class counts cover the unloaded cells of a World Partition map, the categories need loaded components
+	TArray<FMicroManagerActorSummary> ActorSummaries;
+	if(bAuditSelectedActorsOnly)
+	{
+		for(AActor* ActorToAudit:ActorsToAudit)
+		{
+			ActorSummaries.Add(FMicroManagerWorldActors::MakeSummary(ActorToAudit));
+		}
+	}
+	else
+	{
+		ActorSummaries = GetWorldActors().GatherActors();
+	}
+
+	if(ActorSummaries.Num()==0)
+	{
+		DebugHelper::ShowNotifyInfo(TEXT("No actor to audit"));
+		return;
+	}
+
+	FLevelAuditResult Result = AuditLevelActors(ActorsToAudit, MinimumActorsPerGroup);
+
+	TMap<FString, int32> ActorCountPerClass;
+	TSet<FString> BlueprintClassNames;
+	int32 UnloadedActors = 0;
+	for(const FMicroManagerActorSummary& ActorSummary:ActorSummaries)
+	{
+		++ActorCountPerClass.FindOrAdd(ActorSummary.ClassName);
+		if(ActorSummary.bIsBlueprintClass)
+		{
+			BlueprintClassNames.Add(ActorSummary.ClassName);
+		}
+		UnloadedActors += ActorSummary.LoadedActor.IsValid() ? 0 : 1;
+	}
+
+	TArray<TSharedPtr<FMicroManagerReportRow>> Rows;
+	TArray<FString> CategoryCounts;
+
+	for(int32 CategoryIndex = 0; CategoryIndex < static_cast<int32>(E_LevelAuditCategory::ELAC_MAX); ++CategoryIndex)
+	{
+		const E_LevelAuditCategory Category = static_cast<E_LevelAuditCategory>(CategoryIndex);
+		const TArray<FLevelAuditFinding>& Findings = Result.GetFindings(Category);
+		CategoryCounts.Add(FString::Printf(TEXT("%d %s"), Findings.Num(), *GetCategoryDisplayName(Category).ToLower()));
+
+		TSharedPtr<FMicroManagerReportRow> CategoryRow = MakeShared<FMicroManagerReportRow>();
+		CategoryRow->SetText(LevelAuditColumns::Name, GetCategoryDisplayName(Category));
+		CategoryRow->SetValue(LevelAuditColumns::Count, Findings.Num(), FString::FromInt(Findings.Num()));
+
+		for(const FLevelAuditFinding& Finding:Findings)
+		{
+			TSharedPtr<FMicroManagerReportRow> FindingRow = MakeShared<FMicroManagerReportRow>();
+			FindingRow->SetText(LevelAuditColumns::Name, Finding.Actor->GetActorLabel());
+			FindingRow->SetText(LevelAuditColumns::Detail, Finding.Detail);
+
+			TWeakObjectPtr<AActor> WeakActor = Finding.Actor;
+			// The report window can outlive this widget, go through the subsystem directly
+			FindingRow->OnNavigate = FSimpleDelegate::CreateLambda([WeakActor]()
+			{
+				UEditorActorSubsystem* ActorSubsystem = GEditor->GetEditorSubsystem<UEditorActorSubsystem>();
+				if(!WeakActor.IsValid() || !ActorSubsystem) return;
+
+				ActorSubsystem->SetSelectedLevelActors({ WeakActor.Get() });
+				GEditor->MoveViewportCamerasToActor(*WeakActor.Get(), false);
+			});
+			CategoryRow->Children.Add(FindingRow);
+		}
+		Rows.Add(CategoryRow);
+	}
+
+	TSharedPtr<FMicroManagerReportRow> ClassesRow = MakeShared<FMicroManagerReportRow>();
+	ClassesRow->SetText(LevelAuditColumns::Name, TEXT("Actors Per Class"));
+	ClassesRow->SetValue(LevelAuditColumns::Count, ActorSummaries.Num(), FString::FromInt(ActorSummaries.Num()));
+	for(const TPair<FString, int32>& ClassCount:ActorCountPerClass)
+	{
+		TSharedPtr<FMicroManagerReportRow> ClassRow = MakeShared<FMicroManagerReportRow>();
+		ClassRow->SetText(LevelAuditColumns::Name, ClassCount.Key);
+		ClassRow->SetValue(LevelAuditColumns::Count, ClassCount.Value, FString::FromInt(ClassCount.Value));
+		ClassRow->SetText(LevelAuditColumns::Detail, BlueprintClassNames.Contains(ClassCount.Key) ? TEXT("Blueprint") : TEXT("Native"));
+		ClassesRow->Children.Add(ClassRow);
+	}
+	Rows.Add(ClassesRow);
+
+	const FString UnloadedNote = UnloadedActors > 0
+		? FString::Printf(TEXT(" %d of them are in unloaded cells, counted per class but not audited."), UnloadedActors)
+		: FString();
+
+	const FString Summary = FString::Printf(TEXT("%d actors in %d classes.%s\n%s.\nSet Category To Select and use Select Level Audit Category to select a whole category at once."),
+		ActorSummaries.Num(), ActorCountPerClass.Num(), *UnloadedNote, *FString::Join(CategoryCounts, TEXT(", ")));
+
+	SMicroManagerReportView::OpenInWindow(TEXT("Level Performance Audit"), Summary,
+	{
+		{ LevelAuditColumns::Name, TEXT("Name"), 0.4f, false },
+		{ LevelAuditColumns::Count, TEXT("Count"), 0.1f, true },
+		{ LevelAuditColumns::Detail, TEXT("Detail"), 0.5f, false },
+	}, Rows, LevelAuditColumns::Count);
+}
+
+void UQuicActorActionsWidget::SelectLevelAuditCategory()
+{
+	if(!GetEditorActorSubsystem() || CategoryToSelect == E_LevelAuditCategory::ELAC_MAX) return;
+
+	const TArray<AActor*> ActorsToAudit = GetActorsToAudit();
+	FLevelAuditResult Result = AuditLevelActors(ActorsToAudit, MinimumActorsPerGroup);
+
+	TArray<AActor*> ActorsToSelect;
+	for(const FLevelAuditFinding& Finding:Result.GetFindings(CategoryToSelect))
+	{
+		ActorsToSelect.AddUnique(Finding.Actor);
+	}
+
+	if(ActorsToSelect.Num()==0)
+	{
+		DebugHelper::ShowNotifyInfo(TEXT("No actor found for ") + GetCategoryDisplayName(CategoryToSelect));
+		return;
+	}
+
+	// One selection change instead of one per actor
+	EditorActorSubsystem->SetSelectedLevelActors(ActorsToSelect);
+
+	DebugHelper::ShowNotifyInfo(TEXT("Successfully selected ") + FString::FromInt(ActorsToSelect.Num()) +
+	TEXT(" actors for ") + GetCategoryDisplayName(CategoryToSelect));
+}
+
+#pragma endregion
+
 
 bool UQuicActorActionsWidget::GetEditorActorSubsystem()
 {
@@ -134,3 +792,18 @@ bool UQuicActorActionsWidget::GetEditorActorSubsystem()
 	
 	
 }
+
+TArray<AActor*> UQuicActorActionsWidget::GetActorsToAudit()
+{
+	return bAuditSelectedActorsOnly ? EditorActorSubsystem->GetSelectedLevelActors() : EditorActorSubsystem->GetAllLevelActors();
+}
+
+FMicroManagerWorldActors& UQuicActorActionsWidget::GetWorldActors()
+{
+	if(!WorldActors.IsValid() || !WorldActors->IsForEditorWorld())
+	{
+		WorldActors = MakeShared<FMicroManagerWorldActors>();
+	}
+
+	return *WorldActors;
+}
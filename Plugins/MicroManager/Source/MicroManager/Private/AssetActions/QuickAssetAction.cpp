@@ -3,6 +3,7 @@
 #include "EditorUtilityLibrary.h"
 #include "EditorAssetLibrary.h"
 #include "ObjectTools.h"
+#include "Subsystems/MicroManagerSubsystem.h"
 
 #include "AssetRegistry/AssetRegistryModule.h"
 #include "AssetToolsModule.h"
@@ -101,18 +102,23 @@ void UQuickAssetAction::AddPrefixes()
  */
 void UQuickAssetAction::RemoveUnusedAssets()
 {
-    TArray<FAssetData> SelectedAssetsData = UEditorUtilityLibrary::GetSelectedAssetData();
-    TArray<FAssetData> UnusedAssetsData;
-    FixUpRedirectors();
+    TArray<TSharedPtr<FAssetData>> SelectedAssetsData;
+    for (const FAssetData& SelectedAssetData : UEditorUtilityLibrary::GetSelectedAssetData())
+    {
+        SelectedAssetsData.Add(MakeShared<FAssetData>(SelectedAssetData));
+    }
 
-    for (const FAssetData& SelectedAssetData : SelectedAssetsData)
+    // Same redirector fixup and unused detection as the Content Browser menu and the tab
+    UMicroManagerSubsystem* MicroManagerSubsystem = UMicroManagerSubsystem::Get();
+    MicroManagerSubsystem->FixUpRedirectors();
+
+    TArray<TSharedPtr<FAssetData>> UnusedAssetsDataPtrs;
+    MicroManagerSubsystem->ListUnusedAssets(SelectedAssetsData, UnusedAssetsDataPtrs);
+
+    TArray<FAssetData> UnusedAssetsData;
+    for (const TSharedPtr<FAssetData>& UnusedAssetDataPtr : UnusedAssetsDataPtrs)
     {
-        TArray<FString> AssetReferencers =
-        UEditorAssetLibrary::FindPackageReferencersForAsset(SelectedAssetData.GetObjectPathString());
-        if (AssetReferencers.Num() == 0)
-        {
-            UnusedAssetsData.Add(SelectedAssetData);
-        }
+        UnusedAssetsData.Add(*UnusedAssetDataPtr);
     }
     if (UnusedAssetsData.Num() == 0)
     {
@@ -126,44 +132,3 @@ void UQuickAssetAction::RemoveUnusedAssets()
     DebugHelper::ShowMsgDialog(EAppMsgType::Ok,TEXT("Successfully removed " + FString::FromInt(NumOfAssetsDeleted) + " unused files"));
     
 }
-
-/**
- * @brief Fixes up redirectors in the asset registry.
- * 
- * This function searches for all object redirectors within the "/Game" directory
- * and attempts to fix up their referencers. This is useful for cleaning up
- * redirectors that may have been left behind after renaming or moving assets.
- * 
- * @param None
- * @return None
- */
-void UQuickAssetAction::FixUpRedirectors()
-{
-    TArray<UObjectRedirector*> RedirectorsToFixArray;
-
-    FAssetRegistryModule& AssetRegistryModule =
-    FModuleManager::Get().LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry"));
-
-    FARFilter Filter;
-    Filter.bRecursivePaths = true;
-    Filter.PackagePaths.Emplace("/Game");
-	Filter.ClassPaths.Emplace(FTopLevelAssetPath(TEXT("/Script/Engine"), TEXT("ObjectRedirector")));
-
-
-    TArray<FAssetData> OutRedirectors;
-
-    AssetRegistryModule.Get().GetAssets(Filter,OutRedirectors);
-
-    for(const FAssetData& RedirectorData:OutRedirectors)
-    {
-        if(UObjectRedirector* RedirectorToFix = Cast<UObjectRedirector>(RedirectorData.GetAsset()))
-        {
-            RedirectorsToFixArray.Add(RedirectorToFix);
-        }
-    }
-
-    FAssetToolsModule& AssetToolsModule =
-    FModuleManager::LoadModuleChecked<FAssetToolsModule>(TEXT("AssetTools"));
-
-    AssetToolsModule.Get().FixupReferencers(RedirectorsToFixArray);
-}
\ No newline at end of file
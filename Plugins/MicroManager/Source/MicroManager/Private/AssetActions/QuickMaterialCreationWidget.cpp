@@ -17,6 +17,10 @@
 #include "AssetToolsModule.h"
 #include "EditorUtilityLibrary.h"
 #include "AssetRegistry/AssetRegistryModule.h"
+#include "FileHelpers.h"
+#include "Misc/FileHelper.h"
+#include "Misc/ScopedSlowTask.h"
+#include "UObject/StrongObjectPtr.h"
 
 
 #pragma region QuickMaterialCreationCore
@@ -41,6 +45,8 @@ void UQuickMaterialCreationWidget::CreateMaterialFromSelectedTextures()
 	
 	if(CheckIsNameUsed(SelectedTextureFolderPath, MaterialName)) {MaterialName = TEXT("M_"); return;}
 
+	CompileTextureSetClassifier();
+
 	UMaterial* CreatedMaterial = CreateMaterialAsset(MaterialName,SelectedTextureFolderPath);
 
 	if(!CreatedMaterial)
@@ -161,31 +167,10 @@ UTexture2D* SelectedTexture, uint32& PinsConnectedCounter)
 	// If parameterized mode is active, always use parameterized nodes
 	if (bUseMaterialParameters)
 	{
-		FName ParamName = TEXT("TextureParam");
-
-		if (SelectedTexture->GetName().Contains(TEXT("Base")) || TryConnectBaseColor(nullptr, SelectedTexture, CreatedMaterial))
-		{
-			ParamName = BaseColorParameterName;
-		}
-		else if (SelectedTexture->GetName().Contains(TEXT("Norm")))
-		{
-			ParamName = TEXT("Normal");
-		}
-		else if (SelectedTexture->GetName().Contains(TEXT("Rough")))
-		{
-			ParamName = TEXT("Roughness");
-		}
-		else if (SelectedTexture->GetName().Contains(TEXT("Metal")))
-		{
-			ParamName = TEXT("Metallic");
-		}
-		else if (SelectedTexture->GetName().Contains(TEXT("AO")))
-		{
-			ParamName = TEXT("AO");
-		}
-		else if (SelectedTexture->GetName().Contains(TEXT("ORM")) || SelectedTexture->GetName().Contains(TEXT("ARM")))
+		FName ParamName = GetParameterNameForChannel(TextureSetClassifier.Classify(SelectedTexture->GetName()).Channel);
+		if (ParamName.IsNone())
 		{
-			ParamName = TEXT("ORM");
+			ParamName = TEXT("TextureParam");
 		}
 
 		UMaterialExpressionTextureSampleParameter2D* ParamNode = NewObject<UMaterialExpressionTextureSampleParameter2D>(CreatedMaterial);
@@ -273,18 +258,55 @@ UTexture2D* SelectedTexture, uint32& PinsConnectedCounter)
 	UMaterialExpressionTextureSample* TextureSampleNode = NewObject<UMaterialExpressionTextureSample>(CreatedMaterial);
 	if (!TextureSampleNode) return;
 
-	if (TryConnectBaseColor(TextureSampleNode, SelectedTexture, CreatedMaterial) ||
-		TryConnectMetalic(TextureSampleNode, SelectedTexture, CreatedMaterial) ||
-		TryConnectRoughness(TextureSampleNode, SelectedTexture, CreatedMaterial) ||
-		TryConnectNormal(TextureSampleNode, SelectedTexture, CreatedMaterial) ||
-		TryConnectAO(TextureSampleNode, SelectedTexture, CreatedMaterial) ||
-		TryConnectORM(TextureSampleNode, SelectedTexture, CreatedMaterial))
+	// One pass over the name decides the channel, the first partial match no longer wins
+	const FMicroManagerTextureClassification Classification = TextureSetClassifier.Classify(SelectedTexture->GetName());
+
+	switch (Classification.Channel)
 	{
-		PinsConnectedCounter++;
+	case EMicroManagerTextureChannel::BaseColor: ConnectBaseColor(TextureSampleNode, SelectedTexture, CreatedMaterial); break;
+	case EMicroManagerTextureChannel::Metallic: ConnectMetalic(TextureSampleNode, SelectedTexture, CreatedMaterial); break;
+	case EMicroManagerTextureChannel::Roughness: ConnectRoughness(TextureSampleNode, SelectedTexture, CreatedMaterial); break;
+	case EMicroManagerTextureChannel::Normal: ConnectNormal(TextureSampleNode, SelectedTexture, CreatedMaterial); break;
+	case EMicroManagerTextureChannel::AmbientOcclusion: ConnectAO(TextureSampleNode, SelectedTexture, CreatedMaterial); break;
+	case EMicroManagerTextureChannel::ORM: ConnectORM(TextureSampleNode, SelectedTexture, CreatedMaterial); break;
+	default:
+		DebugHelper::Print(TEXT("Failed to connect texture: ") + SelectedTexture->GetName(), FColor::Red);
+		return;
 	}
-	else
+
+	PinsConnectedCounter++;
+
+	if (Classification.Confidence < 1.f)
 	{
-		DebugHelper::Print(TEXT("Failed to connect texture: ") + SelectedTexture->GetName(), FColor::Red);
+		DebugHelper::PrintLog(FString::Printf(TEXT("%s connected as %s from %s with confidence %.2f"),
+			*SelectedTexture->GetName(), FMicroManagerTextureSetClassifier::LexToString(Classification.Channel),
+			*Classification.MatchedSuffix, Classification.Confidence));
+	}
+}
+
+void UQuickMaterialCreationWidget::CompileTextureSetClassifier()
+{
+	TextureSetClassifier.Reset();
+	TextureSetClassifier.AddSuffixes(EMicroManagerTextureChannel::BaseColor, BaseColorArray);
+	TextureSetClassifier.AddSuffixes(EMicroManagerTextureChannel::Metallic, MetallicArray);
+	TextureSetClassifier.AddSuffixes(EMicroManagerTextureChannel::Roughness, RoughnessArray);
+	TextureSetClassifier.AddSuffixes(EMicroManagerTextureChannel::Normal, NormalArray);
+	TextureSetClassifier.AddSuffixes(EMicroManagerTextureChannel::AmbientOcclusion, AmbientOcclusionArray);
+	TextureSetClassifier.AddSuffixes(EMicroManagerTextureChannel::ORM, ORMArray);
+	TextureSetClassifier.Compile();
+}
+
+FName UQuickMaterialCreationWidget::GetParameterNameForChannel(EMicroManagerTextureChannel Channel) const
+{
+	switch (Channel)
+	{
+	case EMicroManagerTextureChannel::BaseColor: return BaseColorParameterName;
+	case EMicroManagerTextureChannel::Normal: return TEXT("Normal");
+	case EMicroManagerTextureChannel::Roughness: return TEXT("Roughness");
+	case EMicroManagerTextureChannel::Metallic: return TEXT("Metallic");
+	case EMicroManagerTextureChannel::AmbientOcclusion: return TEXT("AO");
+	case EMicroManagerTextureChannel::ORM: return TEXT("ORM");
+	default: return NAME_None;
 	}
 }
 
@@ -292,161 +314,101 @@ UTexture2D* SelectedTexture, uint32& PinsConnectedCounter)
 
 #pragma region CreateMaterialNodes
 
-bool UQuickMaterialCreationWidget::TryConnectBaseColor(UMaterialExpressionTextureSample* TextureSampleNode,
+void UQuickMaterialCreationWidget::ConnectBaseColor(UMaterialExpressionTextureSample* TextureSampleNode,
 	UTexture2D* SelectedTexture, UMaterial* CreatedMaterial)
 {
-	for (const FString& BaseColorName : BaseColorArray)
-	{
-		if (SelectedTexture->GetName().Contains(BaseColorName))
-		{
-			TextureSampleNode->Texture = SelectedTexture;
+	TextureSampleNode->Texture = SelectedTexture;
 
-			CreatedMaterial->GetEditorOnlyData()->ExpressionCollection.Expressions.Add(TextureSampleNode);
-			CreatedMaterial->GetEditorOnlyData()->BaseColor.Expression = TextureSampleNode;
-			CreatedMaterial->PostEditChange();
+	CreatedMaterial->GetEditorOnlyData()->ExpressionCollection.Expressions.Add(TextureSampleNode);
+	CreatedMaterial->GetEditorOnlyData()->BaseColor.Expression = TextureSampleNode;
+	CreatedMaterial->PostEditChange();
 
-			TextureSampleNode->MaterialExpressionEditorX -= 600;
-			return true;
-		}
-	}
-	return false;
+	TextureSampleNode->MaterialExpressionEditorX -= 600;
 }
 
-bool UQuickMaterialCreationWidget::TryConnectMetalic(UMaterialExpressionTextureSample * TextureSampleNode, 
+void UQuickMaterialCreationWidget::ConnectMetalic(UMaterialExpressionTextureSample * TextureSampleNode, 
 UTexture2D * SelectedTexture, UMaterial * CreatedMaterial)
 {
-	for(const FString& MetalicName:MetallicArray)
-	{
-		if(SelectedTexture->GetName().Contains(MetalicName))
-		{
-			SelectedTexture->CompressionSettings = TextureCompressionSettings::TC_Default;
-			SelectedTexture->SRGB = false;
-			SelectedTexture->PostEditChange();
-
-			TextureSampleNode->Texture = SelectedTexture;
-			TextureSampleNode->SamplerType = EMaterialSamplerType::SAMPLERTYPE_LinearColor;
+	SelectedTexture->CompressionSettings = TextureCompressionSettings::TC_Default;
+	SelectedTexture->SRGB = false;
+	SelectedTexture->PostEditChange();
 
-			CreatedMaterial->GetEditorOnlyData()->ExpressionCollection.Expressions.Add(TextureSampleNode);
-			CreatedMaterial->GetEditorOnlyData()->Metallic.Expression = TextureSampleNode;
-			CreatedMaterial->PostEditChange();
+	TextureSampleNode->Texture = SelectedTexture;
+	TextureSampleNode->SamplerType = EMaterialSamplerType::SAMPLERTYPE_LinearColor;
 
-			TextureSampleNode->MaterialExpressionEditorX -=600;
-			TextureSampleNode->MaterialExpressionEditorY +=240;
+	CreatedMaterial->GetEditorOnlyData()->ExpressionCollection.Expressions.Add(TextureSampleNode);
+	CreatedMaterial->GetEditorOnlyData()->Metallic.Expression = TextureSampleNode;
+	CreatedMaterial->PostEditChange();
 
-			return true;
-		}
-	}
-	
-	return false;
+	TextureSampleNode->MaterialExpressionEditorX -=600;
+	TextureSampleNode->MaterialExpressionEditorY +=240;
 }
 
-
-
-bool UQuickMaterialCreationWidget::TryConnectRoughness(UMaterialExpressionTextureSample * TextureSampleNode, UTexture2D * SelectedTexture, UMaterial * CreatedMaterial)
+void UQuickMaterialCreationWidget::ConnectRoughness(UMaterialExpressionTextureSample * TextureSampleNode, UTexture2D * SelectedTexture, UMaterial * CreatedMaterial)
 {
-	for(const FString& RoughnessName:RoughnessArray)
-	{
-		if(SelectedTexture->GetName().Contains(RoughnessName))
-		{
-			SelectedTexture->CompressionSettings = TextureCompressionSettings::TC_Default;
-			SelectedTexture->SRGB = false;
-			SelectedTexture->PostEditChange();
-
-			TextureSampleNode->Texture = SelectedTexture;
-			TextureSampleNode->SamplerType = EMaterialSamplerType::SAMPLERTYPE_LinearColor;
+	SelectedTexture->CompressionSettings = TextureCompressionSettings::TC_Default;
+	SelectedTexture->SRGB = false;
+	SelectedTexture->PostEditChange();
 
-			CreatedMaterial->GetEditorOnlyData()->ExpressionCollection.Expressions.Add(TextureSampleNode);
-			CreatedMaterial->GetEditorOnlyData()->Roughness.Expression = TextureSampleNode;
-			CreatedMaterial->PostEditChange();
+	TextureSampleNode->Texture = SelectedTexture;
+	TextureSampleNode->SamplerType = EMaterialSamplerType::SAMPLERTYPE_LinearColor;
 
-			TextureSampleNode->MaterialExpressionEditorX -=600;
-			TextureSampleNode->MaterialExpressionEditorY +=480;
-
-			return true;
-		}
-	}
+	CreatedMaterial->GetEditorOnlyData()->ExpressionCollection.Expressions.Add(TextureSampleNode);
+	CreatedMaterial->GetEditorOnlyData()->Roughness.Expression = TextureSampleNode;
+	CreatedMaterial->PostEditChange();
 
-	return false;
+	TextureSampleNode->MaterialExpressionEditorX -=600;
+	TextureSampleNode->MaterialExpressionEditorY +=480;
 }
 
-bool UQuickMaterialCreationWidget::TryConnectNormal(UMaterialExpressionTextureSample * TextureSampleNode, UTexture2D * SelectedTexture, UMaterial * CreatedMaterial)
+void UQuickMaterialCreationWidget::ConnectNormal(UMaterialExpressionTextureSample * TextureSampleNode, UTexture2D * SelectedTexture, UMaterial * CreatedMaterial)
 {
-	for(const FString& NormalName:NormalArray)
-	{	
-		if(SelectedTexture->GetName().Contains(NormalName))
-		{
-			TextureSampleNode->Texture = SelectedTexture;
-			TextureSampleNode->SamplerType = EMaterialSamplerType::SAMPLERTYPE_Normal;
+	TextureSampleNode->Texture = SelectedTexture;
+	TextureSampleNode->SamplerType = EMaterialSamplerType::SAMPLERTYPE_Normal;
 
-			CreatedMaterial->GetEditorOnlyData()->ExpressionCollection.Expressions.Add(TextureSampleNode);
-			CreatedMaterial->GetEditorOnlyData()->Normal.Expression = TextureSampleNode;
-			CreatedMaterial->PostEditChange();
+	CreatedMaterial->GetEditorOnlyData()->ExpressionCollection.Expressions.Add(TextureSampleNode);
+	CreatedMaterial->GetEditorOnlyData()->Normal.Expression = TextureSampleNode;
+	CreatedMaterial->PostEditChange();
 
-			TextureSampleNode->MaterialExpressionEditorX -= 600;
-			TextureSampleNode->MaterialExpressionEditorY += 720;
-
-			return true;
-		}
-	}
-	
-	return false;
+	TextureSampleNode->MaterialExpressionEditorX -= 600;
+	TextureSampleNode->MaterialExpressionEditorY += 720;
 }
 
-bool UQuickMaterialCreationWidget::TryConnectAO(UMaterialExpressionTextureSample * TextureSampleNode, UTexture2D * SelectedTexture, UMaterial * CreatedMaterial)
+void UQuickMaterialCreationWidget::ConnectAO(UMaterialExpressionTextureSample * TextureSampleNode, UTexture2D * SelectedTexture, UMaterial * CreatedMaterial)
 {
-	for(const FString& AOName:AmbientOcclusionArray)
-	{	
-		if(SelectedTexture->GetName().Contains(AOName))
-		{
-			SelectedTexture->CompressionSettings = TextureCompressionSettings::TC_Default;
-			SelectedTexture->SRGB = false;
-			SelectedTexture->PostEditChange();
+	SelectedTexture->CompressionSettings = TextureCompressionSettings::TC_Default;
+	SelectedTexture->SRGB = false;
+	SelectedTexture->PostEditChange();
 
-			TextureSampleNode->Texture = SelectedTexture;
-			TextureSampleNode->SamplerType = EMaterialSamplerType::SAMPLERTYPE_LinearColor;
-
-			CreatedMaterial->GetEditorOnlyData()->ExpressionCollection.Expressions.Add(TextureSampleNode);
-			CreatedMaterial->GetEditorOnlyData()->AmbientOcclusion.Expression = TextureSampleNode;
-			CreatedMaterial->PostEditChange();
-
-
-			TextureSampleNode->MaterialExpressionEditorX -= 600;
-			TextureSampleNode->MaterialExpressionEditorY += 960;
-
-			return true;
-		}
-	}
+	TextureSampleNode->Texture = SelectedTexture;
+	TextureSampleNode->SamplerType = EMaterialSamplerType::SAMPLERTYPE_LinearColor;
 
-	return false;
+	CreatedMaterial->GetEditorOnlyData()->ExpressionCollection.Expressions.Add(TextureSampleNode);
+	CreatedMaterial->GetEditorOnlyData()->AmbientOcclusion.Expression = TextureSampleNode;
+	CreatedMaterial->PostEditChange();
 
+	TextureSampleNode->MaterialExpressionEditorX -= 600;
+	TextureSampleNode->MaterialExpressionEditorY += 960;
 }
-bool UQuickMaterialCreationWidget::TryConnectORM(UMaterialExpressionTextureSample * TextureSampleNode, UTexture2D * SelectedTexture, UMaterial * CreatedMaterial)
-{	
-	for(const FString& ORM_Name:ORMArray)
-	{
-		if(SelectedTexture->GetName().Contains(ORM_Name))
-		{
-			SelectedTexture->CompressionSettings = TC_Masks;
-			SelectedTexture->SRGB = false;
-			SelectedTexture->PostEditChange();
 
-			TextureSampleNode->Texture = SelectedTexture;
-			TextureSampleNode->SamplerType = SAMPLERTYPE_Masks;
+void UQuickMaterialCreationWidget::ConnectORM(UMaterialExpressionTextureSample * TextureSampleNode, UTexture2D * SelectedTexture, UMaterial * CreatedMaterial)
+{
+	SelectedTexture->CompressionSettings = TC_Masks;
+	SelectedTexture->SRGB = false;
+	SelectedTexture->PostEditChange();
 
-			CreatedMaterial->GetEditorOnlyData()->ExpressionCollection.Expressions.Add(TextureSampleNode);
-			CreatedMaterial->GetEditorOnlyData()->AmbientOcclusion.Connect(0, TextureSampleNode); // Red
-			CreatedMaterial->GetEditorOnlyData()->Roughness.Connect(1, TextureSampleNode);        // Green
-			CreatedMaterial->GetEditorOnlyData()->Metallic.Connect(2, TextureSampleNode);         // Blue
+	TextureSampleNode->Texture = SelectedTexture;
+	TextureSampleNode->SamplerType = SAMPLERTYPE_Masks;
 
-			CreatedMaterial->PostEditChange();
+	CreatedMaterial->GetEditorOnlyData()->ExpressionCollection.Expressions.Add(TextureSampleNode);
+	CreatedMaterial->GetEditorOnlyData()->AmbientOcclusion.Connect(0, TextureSampleNode); // Red
+	CreatedMaterial->GetEditorOnlyData()->Roughness.Connect(1, TextureSampleNode);        // Green
+	CreatedMaterial->GetEditorOnlyData()->Metallic.Connect(2, TextureSampleNode);         // Blue
 
-			TextureSampleNode->MaterialExpressionEditorX -= 600;
-			TextureSampleNode->MaterialExpressionEditorY += 960;
+	CreatedMaterial->PostEditChange();
 
-			return true;
-		}
-	}
-	return false;
+	TextureSampleNode->MaterialExpressionEditorX -= 600;
+	TextureSampleNode->MaterialExpressionEditorY += 960;
 }
 
 #pragma endregion
@@ -469,9 +431,9 @@ UMaterialInstanceConstant* UQuickMaterialCreationWidget::CreateMaterialInstanceA
 
 	if (UMaterialInstanceConstant* CreatedMI = Cast<UMaterialInstanceConstant>(CreatedObject))
 	{
+		// Parenting doesn't change the material, editing it again would only recompile its shaders
 		CreatedMI->SetParentEditorOnly(CreatedMaterial);
 		CreatedMI->PostEditChange();
-		CreatedMaterial->PostEditChange();
 		return CreatedMI;
 	}
 
@@ -481,23 +443,20 @@ UMaterialInstanceConstant* UQuickMaterialCreationWidget::CreateMaterialInstanceA
 void UQuickMaterialCreationWidget::CreateMaterialInstanceFromSelectedMaterial()
 {
 	TArray<FAssetData> SelectedAssets = UEditorUtilityLibrary::GetSelectedAssetData();
-	uint32 NumCreated = 0;
+	TArray<UPackage*> PackagesToSave;
 
 	for (const FAssetData& AssetData : SelectedAssets)
 	{
-		UMaterial* Material = Cast<UMaterial>(AssetData.GetAsset());
-		if (!Material)
+		// Instances can parent instances too
+		UMaterialInterface* ParentMaterial = Cast<UMaterialInterface>(AssetData.GetAsset());
+		if (!ParentMaterial)
 		{
-			DebugHelper::Print(TEXT("Selected asset is not a Material"), FColor::Red);
+			DebugHelper::Print(TEXT("Selected asset is not a Material nor a Material Instance"), FColor::Red);
 			continue;
 		}
 
-		// Set up factory
-		UMaterialInstanceConstantFactoryNew* MICFactory = NewObject<UMaterialInstanceConstantFactoryNew>();
-		MICFactory->InitialParent = Material;
-
 		// Create asset path and name
-		const FString AssetName = FString::Printf(TEXT("MI_%s"), *Material->GetName().Replace(TEXT("M_"), TEXT("")));
+		const FString AssetName = FString::Printf(TEXT("MI_%s"), *ParentMaterial->GetName().Replace(TEXT("M_"), TEXT("")));
 		const FString PackagePath = AssetData.PackagePath.ToString();
 		const FString AssetPath = FPaths::Combine(PackagePath, AssetName);
 
@@ -508,21 +467,19 @@ void UQuickMaterialCreationWidget::CreateMaterialInstanceFromSelectedMaterial()
 			continue;
 		}
 
-		// Use AssetTools to create new asset
-		FAssetToolsModule& AssetToolsModule = FModuleManager::LoadModuleChecked<FAssetToolsModule>("AssetTools");
-		UObject* CreatedAsset = AssetToolsModule.Get().CreateAsset(AssetName, PackagePath, UMaterialInstanceConstant::StaticClass(), MICFactory);
-
-		if (CreatedAsset)
+		if (UMaterialInstanceConstant* CreatedMI = CreateMaterialInstanceInPackage(ParentMaterial, PackagePath, AssetName))
 		{
-			UEditorAssetLibrary::SaveAsset(CreatedAsset->GetPathName(), false);
-			DebugHelper::PrintLog(FString::Printf(TEXT("Created Material Instance: %s"), *CreatedAsset->GetPathName()));
-			++NumCreated;
+			CreatedMI->PostEditChange();
+			PackagesToSave.Add(CreatedMI->GetOutermost());
+			DebugHelper::PrintLog(FString::Printf(TEXT("Created Material Instance: %s"), *CreatedMI->GetPathName()));
 		}
 	}
 
-	if (NumCreated > 0)
+	if (PackagesToSave.Num() > 0)
 	{
-		DebugHelper::ShowNotifyInfo(FString::Printf(TEXT("Created %d Material Instance(s)"), NumCreated));
+		// One save for the whole selection
+		UEditorLoadingAndSavingUtils::SavePackages(PackagesToSave, false);
+		DebugHelper::ShowNotifyInfo(FString::Printf(TEXT("Created %d Material Instance(s)"), PackagesToSave.Num()));
 	}
 	else
 	{
@@ -530,4 +487,249 @@ void UQuickMaterialCreationWidget::CreateMaterialInstanceFromSelectedMaterial()
 	}
 }
 
+#pragma region BatchMaterialInstances
+
+void UQuickMaterialCreationWidget::CreateMaterialInstancesFromTable()
+{
+	if (!MaterialInstanceTable)
+	{
+		DebugHelper::ShowMsgDialog(EAppMsgType::Ok, TEXT("No material instance table set"));
+		return;
+	}
+
+	if (MaterialInstanceTable->GetRowStruct() != FMicroManagerMaterialInstanceRow::StaticStruct())
+	{
+		DebugHelper::ShowMsgDialog(EAppMsgType::Ok, MaterialInstanceTable->GetName() + TEXT(" does not use the MicroManagerMaterialInstanceRow structure"));
+		return;
+	}
+
+	CreateMaterialInstancesFromRows(MaterialInstanceTable);
+}
+
+void UQuickMaterialCreationWidget::CreateMaterialInstancesFromCsv()
+{
+	const FString CsvFilePath = FPaths::ConvertRelativePathToFull(MaterialInstanceCsvFile.FilePath);
+
+	FString CsvString;
+	if (!FFileHelper::LoadFileToString(CsvString, *CsvFilePath))
+	{
+		DebugHelper::ShowMsgDialog(EAppMsgType::Ok, TEXT("Failed to read ") + CsvFilePath);
+		return;
+	}
+
+	// Imported into a transient table, the rows then take the same path as a data table asset
+	const TStrongObjectPtr<UDataTable> CsvTable(NewObject<UDataTable>(GetTransientPackage()));
+	CsvTable->RowStruct = FMicroManagerMaterialInstanceRow::StaticStruct();
+
+	for (const FString& Problem : CsvTable->CreateTableFromCSVString(CsvString))
+	{
+		DebugHelper::PrintLog(CsvFilePath + TEXT(": ") + Problem);
+	}
+
+	if (CsvTable->GetRowMap().Num() == 0)
+	{
+		DebugHelper::ShowMsgDialog(EAppMsgType::Ok, TEXT("No row could be read from ") + CsvFilePath + TEXT(", see the output log"));
+		return;
+	}
+
+	CreateMaterialInstancesFromRows(CsvTable.Get());
+}
+
+int32 UQuickMaterialCreationWidget::CreateMaterialInstancesFromRows(const UDataTable* Table)
+{
+	CompileTextureSetClassifier();
+
+	const TMap<FName, uint8*>& RowMap = Table->GetRowMap();
+
+	// Listed once per folder and parent, rows of a batch mostly share both
+	TMap<FName, TArray<FAssetData>> FolderAssetsCache;
+	TMap<UMaterialInterface*, TSet<FName>> ParentParameterNames;
+
+	TArray<UPackage*> CreatedPackages;
+	int32 FailedCount = 0;
+	{
+		FScopedSlowTask SlowTask(RowMap.Num(), FText::FromString(TEXT("Creating material instances...")));
+		SlowTask.MakeDialog(true);
+
+		for (const TPair<FName, uint8*>& RowPair : RowMap)
+		{
+			if (SlowTask.ShouldCancel()) break;
+			SlowTask.EnterProgressFrame(1.f, FText::FromName(RowPair.Key));
+
+			const FMicroManagerMaterialInstanceRow& Row = *reinterpret_cast<const FMicroManagerMaterialInstanceRow*>(RowPair.Value);
+
+			UMaterialInterface* ParentMaterial = Row.Parent.LoadSynchronous();
+			if (!ParentMaterial)
+			{
+				DebugHelper::PrintLog(FString::Printf(TEXT("%s: parent %s not found"), *RowPair.Key.ToString(), *Row.Parent.ToString()));
+				++FailedCount;
+				continue;
+			}
+
+			TMap<FName, UTexture*> TexturesByParameter;
+			if (!Row.TextureSet.IsEmpty())
+			{
+				ResolveTextureSet(Row.TextureSet, FolderAssetsCache, TexturesByParameter);
+			}
+			// A texture that doesn't load fails the row, an instance missing one of its textures would look valid
+			bool bAllTexturesLoaded = true;
+			for (const TPair<FName, TSoftObjectPtr<UTexture>>& TextureParameter : Row.TextureParameters)
+			{
+				if (UTexture* Texture = TextureParameter.Value.LoadSynchronous())
+				{
+					TexturesByParameter.Add(TextureParameter.Key, Texture);
+				}
+				else
+				{
+					DebugHelper::PrintLog(FString::Printf(TEXT("%s: texture %s of parameter %s not found"),
+						*RowPair.Key.ToString(), *TextureParameter.Value.ToString(), *TextureParameter.Key.ToString()));
+					bAllTexturesLoaded = false;
+				}
+			}
+			if (!bAllTexturesLoaded)
+			{
+				++FailedCount;
+				continue;
+			}
+
+			FString PackagePath = Row.DestinationPath;
+			if (PackagePath.IsEmpty())
+			{
+				PackagePath = FPackageName::GetLongPackagePath(Row.TextureSet.IsEmpty() ? ParentMaterial->GetOutermost()->GetName() : Row.TextureSet);
+			}
+			const FString AssetName = Row.InstanceName.IsEmpty() ? TEXT("MI_") + RowPair.Key.ToString() : Row.InstanceName;
+
+			if (FindPackage(nullptr, *(PackagePath / AssetName)) || FPackageName::DoesPackageExist(PackagePath / AssetName))
+			{
+				DebugHelper::PrintLog(FString::Printf(TEXT("%s: %s already exists"), *RowPair.Key.ToString(), *(PackagePath / AssetName)));
+				++FailedCount;
+				continue;
+			}
+
+			UMaterialInstanceConstant* CreatedMI = CreateMaterialInstanceInPackage(ParentMaterial, PackagePath, AssetName);
+			if (!CreatedMI)
+			{
+				++FailedCount;
+				continue;
+			}
+
+			const TSet<FName>* ParameterNames = ParentParameterNames.Find(ParentMaterial);
+			if (!ParameterNames)
+			{
+				TSet<FName>& NewParameterNames = ParentParameterNames.Add(ParentMaterial);
+				for (const EMaterialParameterType ParameterType : { EMaterialParameterType::Scalar, EMaterialParameterType::Vector, EMaterialParameterType::Texture })
+				{
+					TArray<FMaterialParameterInfo> ParameterInfos;
+					TArray<FGuid> ParameterIds;
+					ParentMaterial->GetAllParameterInfoOfType(ParameterType, ParameterInfos, ParameterIds);
+					for (const FMaterialParameterInfo& ParameterInfo : ParameterInfos)
+					{
+						NewParameterNames.Add(ParameterInfo.Name);
+					}
+				}
+				ParameterNames = &NewParameterNames;
+			}
+
+			auto IsKnownParameter = [&RowPair, ParameterNames, ParentMaterial](FName ParameterName)
+			{
+				if (ParameterNames->Contains(ParameterName)) return true;
+
+				DebugHelper::PrintLog(FString::Printf(TEXT("%s: %s has no parameter %s"),
+					*RowPair.Key.ToString(), *ParentMaterial->GetName(), *ParameterName.ToString()));
+				return false;
+			};
+
+			for (const TPair<FName, UTexture*>& TextureParameter : TexturesByParameter)
+			{
+				if (!IsKnownParameter(TextureParameter.Key)) continue;
+				CreatedMI->SetTextureParameterValueEditorOnly(FMaterialParameterInfo(TextureParameter.Key), TextureParameter.Value);
+			}
+			for (const TPair<FName, float>& ScalarParameter : Row.ScalarParameters)
+			{
+				if (!IsKnownParameter(ScalarParameter.Key)) continue;
+				CreatedMI->SetScalarParameterValueEditorOnly(FMaterialParameterInfo(ScalarParameter.Key), ScalarParameter.Value);
+			}
+			for (const TPair<FName, FLinearColor>& VectorParameter : Row.VectorParameters)
+			{
+				if (!IsKnownParameter(VectorParameter.Key)) continue;
+				CreatedMI->SetVectorParameterValueEditorOnly(FMaterialParameterInfo(VectorParameter.Key), VectorParameter.Value);
+			}
+
+			// The instance only, the parent is left untouched so its shaders are not recompiled per row
+			CreatedMI->PostEditChange();
+			CreatedPackages.Add(CreatedMI->GetOutermost());
+		}
+	}
+
+	if (CreatedPackages.Num() > 0)
+	{
+		UEditorLoadingAndSavingUtils::SavePackages(CreatedPackages, false);
+	}
+
+	const FString Result = FString::Printf(TEXT("Created %d Material Instance(s), %d row(s) failed"), CreatedPackages.Num(), FailedCount);
+	if (FailedCount > 0)
+	{
+		DebugHelper::ShowMsgDialog(EAppMsgType::Ok, Result + TEXT(", see the output log"));
+	}
+	else
+	{
+		DebugHelper::ShowNotifyInfo(Result);
+	}
+
+	return CreatedPackages.Num();
+}
+
+UMaterialInstanceConstant* UQuickMaterialCreationWidget::CreateMaterialInstanceInPackage(UMaterialInterface* Parent, const FString& PackagePath, const FString& AssetName)
+{
+	UPackage* Package = CreatePackage(*(PackagePath / AssetName));
+	if (!Package) return nullptr;
+
+	UMaterialInstanceConstant* CreatedMI = NewObject<UMaterialInstanceConstant>(Package, FName(*AssetName), RF_Public | RF_Standalone | RF_Transactional);
+
+	// Shaders are recached once, by the caller's PostEditChange on the instance
+	CreatedMI->SetParentEditorOnly(Parent, false);
+
+	FAssetRegistryModule::AssetCreated(CreatedMI);
+	Package->MarkPackageDirty();
+	return CreatedMI;
+}
+
+void UQuickMaterialCreationWidget::ResolveTextureSet(const FString& TextureSetPrefix, TMap<FName, TArray<FAssetData>>& FolderAssetsCache,
+	TMap<FName, UTexture*>& OutTexturesByParameter) const
+{
+	const FName FolderPath(*FPackageName::GetLongPackagePath(TextureSetPrefix));
+	const FString NamePrefix = FPackageName::GetShortName(TextureSetPrefix);
+
+	const TArray<FAssetData>* FolderTextures = FolderAssetsCache.Find(FolderPath);
+	if (!FolderTextures)
+	{
+		FARFilter TextureFilter;
+		TextureFilter.PackagePaths.Add(FolderPath);
+		TextureFilter.ClassPaths.Add(UTexture::StaticClass()->GetClassPathName());
+		TextureFilter.bRecursiveClasses = true;
+
+		TArray<FAssetData> Textures;
+		FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get().GetAssets(TextureFilter, Textures);
+		FolderTextures = &FolderAssetsCache.Add(FolderPath, MoveTemp(Textures));
+	}
+
+	for (const FAssetData& TextureData : *FolderTextures)
+	{
+		// "T_Rock" takes "T_Rock_Normal" but not "T_Rocky_Normal"
+		const FString TextureName = TextureData.AssetName.ToString();
+		if (!TextureName.StartsWith(NamePrefix)) continue;
+		if (TextureName.Len() > NamePrefix.Len() && TextureName[NamePrefix.Len()] != TEXT('_')) continue;
+
+		const FName ParameterName = GetParameterNameForChannel(TextureSetClassifier.Classify(TextureName).Channel);
+		if (ParameterName.IsNone()) continue;
+
+		if (UTexture* Texture = Cast<UTexture>(TextureData.GetAsset()))
+		{
+			OutTexturesByParameter.Add(ParameterName, Texture);
+		}
+	}
+}
+
+#pragma endregion
+
 
@@ -0,0 +1,339 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "AssetAnalysis/MicroManagerAssetQuery.h"
+#include "AssetAnalysis/MicroManagerSizeCache.h"
+
+#pragma region AssetColumns
+
+void FMicroManagerAssetColumns::AddAssets(const TArray<TSharedPtr<FAssetData>>& AssetsDataToAdd)
+{
+	for (const TSharedPtr<FAssetData>& AssetData : AssetsDataToAdd)
+	{
+		if (!AssetData.IsValid() || RowIndices.Contains(AssetData)) continue;
+
+		const int32 Row = Assets.Add(AssetData);
+		RowIndices.Add(AssetData, Row);
+
+		ClassNames.Add(AssetData->AssetClassPath.GetAssetName());
+		AssetNames.Add(AssetData->AssetName);
+		++AssetNameCounts.FindOrAdd(AssetData->AssetName);
+		LowerPackagePaths.Add(AssetData->PackagePath.ToString().ToLower());
+		LowerAssetNames.Add(AssetData->AssetName.ToString().ToLower());
+		DiskSizes.Add(-1);
+		DependencySizes.Add(-1);
+		UnusedFlags.Add(-1);
+	}
+}
+
+void FMicroManagerAssetColumns::RefreshSizes(const FMicroManagerSizeCache& SizeCache)
+{
+	for (int32 Row = 0; Row < Assets.Num(); ++Row)
+	{
+		if (DiskSizes[Row] >= 0) continue;
+
+		if (const FMicroManagerAssetSizeInfo* SizeInfo = SizeCache.FindSizeInfo(Assets[Row]->PackageName))
+		{
+			DiskSizes[Row] = SizeInfo->DiskSize;
+			DependencySizes[Row] = SizeInfo->DependencySize;
+		}
+	}
+}
+
+int32 FMicroManagerAssetColumns::FindRow(const TSharedPtr<FAssetData>& AssetData) const
+{
+	const int32* Row = RowIndices.Find(AssetData);
+	return Row ? *Row : INDEX_NONE;
+}
+
+#pragma endregion
+
+
+#pragma region AssetQuery
+
+bool FMicroManagerAssetQuery::Compile(const FString& QueryText, FMicroManagerAssetQuery& OutQuery, FString& OutError)
+{
+	OutQuery.Predicates.Empty();
+
+	TArray<FString> Tokens;
+	QueryText.ParseIntoArrayWS(Tokens);
+
+	bool bNegateNextTerm = false;
+	for (const FString& Token : Tokens)
+	{
+		if (Token.Equals(TEXT("AND"), ESearchCase::IgnoreCase)) continue;
+
+		if (Token.Equals(TEXT("OR"), ESearchCase::IgnoreCase))
+		{
+			OutError = TEXT("OR is not supported, save one preset per alternative");
+			return false;
+		}
+
+		if (Token.Equals(TEXT("NOT"), ESearchCase::IgnoreCase))
+		{
+			bNegateNextTerm = !bNegateNextTerm;
+			continue;
+		}
+
+		FString Term = Token;
+		if (Term.StartsWith(TEXT("-")))
+		{
+			bNegateNextTerm = !bNegateNextTerm;
+			Term.RightChopInline(1);
+		}
+
+		FPredicate Predicate;
+		if (!ParseTerm(Term, Predicate, OutError))
+		{
+			return false;
+		}
+
+		Predicate.bNegated = bNegateNextTerm;
+		bNegateNextTerm = false;
+
+		OutQuery.Predicates.Add(MoveTemp(Predicate));
+	}
+
+	if (bNegateNextTerm)
+	{
+		OutError = TEXT("NOT must be followed by a term");
+		return false;
+	}
+
+	// Cheapest first, the registry lookups behind unused only run on what survived the rest
+	OutQuery.Predicates.StableSort([](const FPredicate& A, const FPredicate& B) { return A.Cost < B.Cost; });
+
+	return true;
+}
+
+bool FMicroManagerAssetQuery::ParseTerm(const FString& Term, FPredicate& OutPredicate, FString& OutError)
+{
+	if (Term.Equals(TEXT("unused"), ESearchCase::IgnoreCase))
+	{
+		OutPredicate.Kind = EPredicateKind::Unused;
+		OutPredicate.Cost = 100;
+		return true;
+	}
+
+	if (Term.Equals(TEXT("samename"), ESearchCase::IgnoreCase))
+	{
+		OutPredicate.Kind = EPredicateKind::SameName;
+		OutPredicate.Cost = 1;
+		return true;
+	}
+
+	FString Key;
+	FString Value;
+	if (Term.Split(TEXT(":"), &Key, &Value))
+	{
+		if (Value.IsEmpty())
+		{
+			OutError = FString::Printf(TEXT("Missing value in '%s'"), *Term);
+			return false;
+		}
+
+		if (Key.Equals(TEXT("class"), ESearchCase::IgnoreCase))
+		{
+			OutPredicate.Kind = EPredicateKind::Class;
+			OutPredicate.NameValue = FName(*Value);
+			OutPredicate.Cost = 1;
+			return true;
+		}
+
+		if (Key.Equals(TEXT("path"), ESearchCase::IgnoreCase))
+		{
+			OutPredicate.Kind = EPredicateKind::Path;
+			OutPredicate.StringValue = Value.ToLower();
+			OutPredicate.Cost = 2;
+			return true;
+		}
+
+		if (Key.Equals(TEXT("name"), ESearchCase::IgnoreCase))
+		{
+			OutPredicate.Kind = EPredicateKind::Name;
+			OutPredicate.StringValue = Value.ToLower();
+			OutPredicate.Cost = 3;
+			return true;
+		}
+
+		OutError = FString::Printf(TEXT("Unknown field '%s'"), *Key);
+		return false;
+	}
+
+	if (Term.StartsWith(TEXT("size"), ESearchCase::IgnoreCase) || Term.StartsWith(TEXT("deps"), ESearchCase::IgnoreCase))
+	{
+		return ParseSizeTerm(Term, OutPredicate, OutError);
+	}
+
+	OutError = FString::Printf(TEXT("Unknown term '%s'"), *Term);
+	return false;
+}
+
+bool FMicroManagerAssetQuery::ParseSizeTerm(const FString& Term, FPredicate& OutPredicate, FString& OutError)
+{
+	OutPredicate.Kind = Term.StartsWith(TEXT("size"), ESearchCase::IgnoreCase) ? EPredicateKind::DiskSize : EPredicateKind::DependencySize;
+	OutPredicate.Cost = 1;
+
+	FString Remainder = Term.RightChop(4);
+
+	// Two character operators first so ">=" is not read as ">"
+	static const TPair<const TCHAR*, ESizeComparison> Comparisons[] =
+	{
+		{ TEXT(">="), ESizeComparison::GreaterOrEqual },
+		{ TEXT("<="), ESizeComparison::LessOrEqual },
+		{ TEXT(">"), ESizeComparison::Greater },
+		{ TEXT("<"), ESizeComparison::Less },
+		{ TEXT("="), ESizeComparison::Equal },
+	};
+
+	bool bFoundComparison = false;
+	for (const TPair<const TCHAR*, ESizeComparison>& Comparison : Comparisons)
+	{
+		if (Remainder.StartsWith(Comparison.Key))
+		{
+			OutPredicate.SizeComparison = Comparison.Value;
+			Remainder.RightChopInline(FCString::Strlen(Comparison.Key));
+			bFoundComparison = true;
+			break;
+		}
+	}
+
+	if (!bFoundComparison)
+	{
+		OutError = FString::Printf(TEXT("Missing comparison in '%s'"), *Term);
+		return false;
+	}
+
+	static const TPair<const TCHAR*, int64> Units[] =
+	{
+		{ TEXT("GB"), 1024ll * 1024 * 1024 },
+		{ TEXT("MB"), 1024ll * 1024 },
+		{ TEXT("KB"), 1024ll },
+		{ TEXT("B"), 1ll },
+	};
+
+	int64 UnitMultiplier = 1;
+	for (const TPair<const TCHAR*, int64>& Unit : Units)
+	{
+		if (Remainder.EndsWith(Unit.Key, ESearchCase::IgnoreCase))
+		{
+			UnitMultiplier = Unit.Value;
+			Remainder.LeftChopInline(FCString::Strlen(Unit.Key));
+			break;
+		}
+	}
+
+	if (Remainder.IsEmpty() || !Remainder.IsNumeric())
+	{
+		OutError = FString::Printf(TEXT("Invalid size in '%s'"), *Term);
+		return false;
+	}
+
+	OutPredicate.SizeValue = static_cast<int64>(FCString::Atod(*Remainder) * UnitMultiplier);
+	return true;
+}
+
+bool FMicroManagerAssetQuery::EvaluateSize(const FPredicate& Predicate, int64 Size)
+{
+	switch (Predicate.SizeComparison)
+	{
+	case ESizeComparison::Greater:        return Size > Predicate.SizeValue;
+	case ESizeComparison::GreaterOrEqual: return Size >= Predicate.SizeValue;
+	case ESizeComparison::Less:           return Size < Predicate.SizeValue;
+	case ESizeComparison::LessOrEqual:    return Size <= Predicate.SizeValue;
+	case ESizeComparison::Equal:          return Size == Predicate.SizeValue;
+	default:                              return false;
+	}
+}
+
+void FMicroManagerAssetQuery::Execute(FMicroManagerAssetColumns& Columns, TArray<int32>& InOutRows) const
+{
+	for (const FPredicate& Predicate : Predicates)
+	{
+		if (InOutRows.Num() == 0) return;
+
+		ExecutePredicate(Predicate, Columns, InOutRows);
+	}
+}
+
+void FMicroManagerAssetQuery::ExecutePredicate(const FPredicate& Predicate, FMicroManagerAssetColumns& Columns, TArray<int32>& InOutRows) const
+{
+	const bool bNegated = Predicate.bNegated;
+
+	switch (Predicate.Kind)
+	{
+	case EPredicateKind::Unused:
+	{
+		TArray<int32> UnresolvedRows;
+		for (const int32 Row : InOutRows)
+		{
+			if (Columns.UnusedFlags[Row] < 0)
+			{
+				UnresolvedRows.Add(Row);
+			}
+		}
+		if (UnresolvedRows.Num() > 0)
+		{
+			Columns.ResolveUnusedFlags.ExecuteIfBound(UnresolvedRows, Columns);
+		}
+
+		const TArray<int8>& UnusedFlags = Columns.UnusedFlags;
+		InOutRows.RemoveAll([&UnusedFlags, bNegated](const int32 Row) { return (UnusedFlags[Row] == 1) == bNegated; });
+		break;
+	}
+	case EPredicateKind::SameName:
+	{
+		const TArray<FName>& AssetNames = Columns.AssetNames;
+		const TMap<FName, int32>& AssetNameCounts = Columns.AssetNameCounts;
+		InOutRows.RemoveAll([&AssetNames, &AssetNameCounts, bNegated](const int32 Row)
+		{
+			return (AssetNameCounts.FindChecked(AssetNames[Row]) > 1) == bNegated;
+		});
+		break;
+	}
+	case EPredicateKind::Class:
+	{
+		const TArray<FName>& ClassNames = Columns.ClassNames;
+		const FName ClassName = Predicate.NameValue;
+		InOutRows.RemoveAll([&ClassNames, ClassName, bNegated](const int32 Row) { return (ClassNames[Row] == ClassName) == bNegated; });
+		break;
+	}
+	case EPredicateKind::Path:
+	{
+		const TArray<FString>& LowerPackagePaths = Columns.LowerPackagePaths;
+		const FString& PathPrefix = Predicate.StringValue;
+		InOutRows.RemoveAll([&LowerPackagePaths, &PathPrefix, bNegated](const int32 Row)
+		{
+			return LowerPackagePaths[Row].StartsWith(PathPrefix, ESearchCase::CaseSensitive) == bNegated;
+		});
+		break;
+	}
+	case EPredicateKind::Name:
+	{
+		const TArray<FString>& LowerAssetNames = Columns.LowerAssetNames;
+		const FString& NamePart = Predicate.StringValue;
+		InOutRows.RemoveAll([&LowerAssetNames, &NamePart, bNegated](const int32 Row)
+		{
+			return LowerAssetNames[Row].Contains(NamePart, ESearchCase::CaseSensitive) == bNegated;
+		});
+		break;
+	}
+	case EPredicateKind::DiskSize:
+	case EPredicateKind::DependencySize:
+	{
+		const TArray<int64>& Sizes = Predicate.Kind == EPredicateKind::DiskSize ? Columns.DiskSizes : Columns.DependencySizes;
+
+		// Sizes still computing don't match, a negated predicate keeps them. The query runs again once they arrive.
+		InOutRows.RemoveAll([&Sizes, &Predicate, bNegated](const int32 Row)
+		{
+			const bool bMatches = Sizes[Row] >= 0 && EvaluateSize(Predicate, Sizes[Row]);
+			return bMatches == bNegated;
+		});
+		break;
+	}
+	default:
+		break;
+	}
+}
+
+#pragma endregion
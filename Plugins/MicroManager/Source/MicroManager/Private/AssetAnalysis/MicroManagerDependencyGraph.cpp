@@ -0,0 +1,580 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "AssetAnalysis/MicroManagerDependencyGraph.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Algo/Reverse.h"
+#include "HAL/FileManager.h"
+#include "Misc/ConfigCacheIni.h"
+#include "Misc/PackageName.h"
+
+namespace
+{
+	// Registry data first, it is already in memory. Only hit the file system when the registry has no entry.
+	int64 GetPackageDiskSize(const IAssetRegistry& AssetRegistry, const FName PackageName)
+	{
+		const TOptional<FAssetPackageData> PackageData = AssetRegistry.GetAssetPackageDataCopy(PackageName);
+		if (PackageData.IsSet() && PackageData->DiskSize >= 0)
+		{
+			return PackageData->DiskSize;
+		}
+
+		FString PackageFilename;
+		if (FPackageName::DoesPackageExist(PackageName.ToString(), &PackageFilename))
+		{
+			return FMath::Max<int64>(IFileManager::Get().FileSize(*PackageFilename), 0);
+		}
+
+		return 0;
+	}
+
+	// Queries one kind of dependency for every node and appends them to a flat edge list
+	void BuildEdgeList(const IAssetRegistry& AssetRegistry, const TArray<FName>& PackageNames, const TMap<FName, int32>& NodeIndices,
+		const UE::AssetRegistry::EDependencyQuery DependencyQuery, TArray<int32>& OutOffsets, TArray<int32>& OutTargets)
+	{
+		OutOffsets.Reset(PackageNames.Num() + 1);
+		OutOffsets.Add(0);
+
+		TArray<FName> Dependencies;
+		for (int32 NodeIndex = 0; NodeIndex < PackageNames.Num(); ++NodeIndex)
+		{
+			Dependencies.Reset();
+			AssetRegistry.GetDependencies(PackageNames[NodeIndex], Dependencies,
+				UE::AssetRegistry::EDependencyCategory::Package, DependencyQuery);
+
+			for (const FName Dependency : Dependencies)
+			{
+				// Script packages and missing packages are not nodes, they cost nothing on disk
+				const int32* DependencyIndex = NodeIndices.Find(Dependency);
+				if (DependencyIndex && *DependencyIndex != NodeIndex)
+				{
+					OutTargets.Add(*DependencyIndex);
+				}
+			}
+
+			OutOffsets.Add(OutTargets.Num());
+		}
+	}
+
+	bool IsPathTokenChar(const TCHAR Character)
+	{
+		return FChar::IsAlnum(Character) || Character == TEXT('_') || Character == TEXT('/') ||
+			Character == TEXT('.') || Character == TEXT('-');
+	}
+
+	// Pulls every /Mount/Path/Asset looking token out of a config value, object names stripped
+	void ExtractPackageNames(const FString& ConfigValue, TSet<FName>& OutPackageNames)
+	{
+		const int32 ValueLength = ConfigValue.Len();
+
+		for (int32 CharIndex = 0; CharIndex < ValueLength; ++CharIndex)
+		{
+			if (ConfigValue[CharIndex] != TEXT('/')) continue;
+			if (CharIndex > 0 && IsPathTokenChar(ConfigValue[CharIndex - 1])) continue;
+
+			int32 TokenEnd = CharIndex;
+			int32 ObjectNameStart = INDEX_NONE;
+			while (TokenEnd < ValueLength && IsPathTokenChar(ConfigValue[TokenEnd]))
+			{
+				if (ConfigValue[TokenEnd] == TEXT('.') && ObjectNameStart == INDEX_NONE)
+				{
+					ObjectNameStart = TokenEnd;
+				}
+				++TokenEnd;
+			}
+
+			const int32 PackageNameEnd = ObjectNameStart != INDEX_NONE ? ObjectNameStart : TokenEnd;
+			const FString PackageName = ConfigValue.Mid(CharIndex, PackageNameEnd - CharIndex);
+
+			if (!PackageName.StartsWith(TEXT("/Script/")) && FPackageName::IsValidLongPackageName(PackageName))
+			{
+				OutPackageNames.Add(FName(*PackageName));
+			}
+
+			CharIndex = TokenEnd;
+		}
+	}
+}
+
+TSet<FName> FMicroManagerDependencyGraph::GatherConfigReferencedPackages()
+{
+	check(IsInGameThread());
+
+	TSet<FName> ConfigReferencedPackages;
+	if (!GConfig) return ConfigReferencedPackages;
+
+	const FString* ConfigFilenames[] = { &GGameIni, &GEngineIni, &GEditorIni, &GInputIni };
+
+	for (const FString* ConfigFilename : ConfigFilenames)
+	{
+		const FConfigFile* ConfigFile = GConfig->FindConfigFile(*ConfigFilename);
+		if (!ConfigFile) continue;
+
+		for (const TPair<FString, FConfigSection>& Section : *ConfigFile)
+		{
+			for (const TPair<FName, FConfigValue>& Entry : Section.Value)
+			{
+				ExtractPackageNames(Entry.Value.GetValue(), ConfigReferencedPackages);
+			}
+		}
+	}
+
+	return ConfigReferencedPackages;
+}
+
+TSharedRef<FMicroManagerDependencyGraph> FMicroManagerDependencyGraph::Build(const IAssetRegistry& AssetRegistry,
+	const TSet<FName>& ConfigReferencedPackages)
+{
+	TSharedRef<FMicroManagerDependencyGraph> Graph = MakeShared<FMicroManagerDependencyGraph>();
+
+	TArray<FAssetData> AllAssetsData;
+	AssetRegistry.GetAllAssets(AllAssetsData, true);
+
+	const FTopLevelAssetPath WorldClassPath(TEXT("/Script/Engine"), TEXT("World"));
+
+	for (const FAssetData& AssetData : AllAssetsData)
+	{
+		int32 NodeIndex = INDEX_NONE;
+		if (const int32* ExistingIndex = Graph->NodeIndices.Find(AssetData.PackageName))
+		{
+			NodeIndex = *ExistingIndex;
+		}
+		else
+		{
+			NodeIndex = Graph->PackageNames.Add(AssetData.PackageName);
+			Graph->NodeIndices.Add(AssetData.PackageName, NodeIndex);
+			Graph->RootFlags.Add(ConfigReferencedPackages.Contains(AssetData.PackageName) ?
+				EMicroManagerRootFlags::ConfigReference : EMicroManagerRootFlags::None);
+		}
+
+		if (AssetData.AssetClassPath == WorldClassPath)
+		{
+			Graph->RootFlags[NodeIndex] |= EMicroManagerRootFlags::Map;
+		}
+		if (AssetData.GetPrimaryAssetId().IsValid())
+		{
+			Graph->RootFlags[NodeIndex] |= EMicroManagerRootFlags::PrimaryAsset;
+		}
+	}
+
+	const int32 NumNodes = Graph->PackageNames.Num();
+
+	for (int32 NodeIndex = 0; NodeIndex < NumNodes; ++NodeIndex)
+	{
+		if (Graph->IsRoot(NodeIndex))
+		{
+			Graph->RootNodeIndices.Add(NodeIndex);
+		}
+	}
+
+	Graph->DiskSizes.SetNumUninitialized(NumNodes);
+	for (int32 NodeIndex = 0; NodeIndex < NumNodes; ++NodeIndex)
+	{
+		Graph->DiskSizes[NodeIndex] = GetPackageDiskSize(AssetRegistry, Graph->PackageNames[NodeIndex]);
+	}
+
+	BuildEdgeList(AssetRegistry, Graph->PackageNames, Graph->NodeIndices, UE::AssetRegistry::EDependencyQuery::Hard,
+		Graph->HardDependencyOffsets, Graph->HardDependencies);
+	BuildEdgeList(AssetRegistry, Graph->PackageNames, Graph->NodeIndices, UE::AssetRegistry::EDependencyQuery::Soft,
+		Graph->SoftDependencyOffsets, Graph->SoftDependencies);
+
+	// Referencers are the reversed hard and soft edges: count per target, prefix sum, then scatter
+	Graph->ReferencerOffsets.SetNumZeroed(NumNodes + 1);
+	for (const int32 Target : Graph->HardDependencies) { ++Graph->ReferencerOffsets[Target + 1]; }
+	for (const int32 Target : Graph->SoftDependencies) { ++Graph->ReferencerOffsets[Target + 1]; }
+
+	for (int32 NodeIndex = 0; NodeIndex < NumNodes; ++NodeIndex)
+	{
+		Graph->ReferencerOffsets[NodeIndex + 1] += Graph->ReferencerOffsets[NodeIndex];
+	}
+
+	Graph->Referencers.SetNumUninitialized(Graph->ReferencerOffsets[NumNodes]);
+	TArray<int32> WriteCursors(Graph->ReferencerOffsets.GetData(), NumNodes);
+
+	for (int32 NodeIndex = 0; NodeIndex < NumNodes; ++NodeIndex)
+	{
+		for (const int32 Target : Graph->GetHardDependencies(NodeIndex)) { Graph->Referencers[WriteCursors[Target]++] = NodeIndex; }
+		for (const int32 Target : Graph->GetSoftDependencies(NodeIndex)) { Graph->Referencers[WriteCursors[Target]++] = NodeIndex; }
+	}
+
+	return Graph;
+}
+
+int32 FMicroManagerDependencyGraph::FindNode(FName PackageName) const
+{
+	const int32* NodeIndex = NodeIndices.Find(PackageName);
+	return NodeIndex ? *NodeIndex : INDEX_NONE;
+}
+
+TConstArrayView<int32> FMicroManagerDependencyGraph::GetHardDependencies(int32 NodeIndex) const
+{
+	return TConstArrayView<int32>(HardDependencies.GetData() + HardDependencyOffsets[NodeIndex],
+		HardDependencyOffsets[NodeIndex + 1] - HardDependencyOffsets[NodeIndex]);
+}
+
+TConstArrayView<int32> FMicroManagerDependencyGraph::GetSoftDependencies(int32 NodeIndex) const
+{
+	return TConstArrayView<int32>(SoftDependencies.GetData() + SoftDependencyOffsets[NodeIndex],
+		SoftDependencyOffsets[NodeIndex + 1] - SoftDependencyOffsets[NodeIndex]);
+}
+
+TConstArrayView<int32> FMicroManagerDependencyGraph::GetReferencers(int32 NodeIndex) const
+{
+	return TConstArrayView<int32>(Referencers.GetData() + ReferencerOffsets[NodeIndex],
+		ReferencerOffsets[NodeIndex + 1] - ReferencerOffsets[NodeIndex]);
+}
+
+bool FMicroManagerDependencyGraph::FindShortestPathToRoot(int32 StartNode, TArray<int32>& OutPath) const
+{
+	OutPath.Reset();
+	if (StartNode == INDEX_NONE) return false;
+
+	if (IsRoot(StartNode))
+	{
+		OutPath.Add(StartNode);
+		return true;
+	}
+
+	// Only the visited nodes are stored, a query usually meets the roots after a few levels and should not pay for
+	// the whole graph. Forward parents point back towards the start node, backward parents point towards the root the
+	// node was reached from.
+	struct FVisit
+	{
+		int32 Parent = INDEX_NONE;
+		int32 Depth = 0;
+	};
+	constexpr int32 FrontierOrigin = -2;
+
+	TMap<int32, FVisit> ForwardVisits;
+	TMap<int32, FVisit> BackwardVisits;
+	BackwardVisits.Reserve(RootNodeIndices.Num());
+
+	TArray<int32> ForwardFrontier;
+	TArray<int32> BackwardFrontier(RootNodeIndices);
+	TArray<int32> NextFrontier;
+
+	ForwardFrontier.Add(StartNode);
+	ForwardVisits.Add(StartNode, { FrontierOrigin, 0 });
+
+	for (const int32 RootNode : RootNodeIndices)
+	{
+		BackwardVisits.Add(RootNode, { FrontierOrigin, 0 });
+	}
+
+	int32 MeetingNode = INDEX_NONE;
+	int32 ShortestLength = MAX_int32;
+
+	// Visits a node from the side being grown, and keeps it as the meeting point if the other side reached it on a shorter chain
+	auto Visit = [&MeetingNode, &ShortestLength, &NextFrontier](TMap<int32, FVisit>& Visits, const TMap<int32, FVisit>& OtherVisits,
+		const int32 Node, const int32 Parent, const int32 Depth)
+	{
+		if (Visits.Contains(Node)) return;
+
+		Visits.Add(Node, { Parent, Depth });
+		NextFrontier.Add(Node);
+
+		if (const FVisit* OtherVisit = OtherVisits.Find(Node))
+		{
+			if (Depth + OtherVisit->Depth < ShortestLength)
+			{
+				ShortestLength = Depth + OtherVisit->Depth;
+				MeetingNode = Node;
+			}
+		}
+	};
+
+	// Whole levels are expanded before stopping, so the best meeting point of the level wins
+	int32 ForwardDepth = 0;
+	int32 BackwardDepth = 0;
+	while (MeetingNode == INDEX_NONE && ForwardFrontier.Num() > 0 && BackwardFrontier.Num() > 0)
+	{
+		NextFrontier.Reset();
+
+		if (ForwardFrontier.Num() <= BackwardFrontier.Num())
+		{
+			++ForwardDepth;
+			for (const int32 FrontierNode : ForwardFrontier)
+			{
+				for (const int32 Referencer : GetReferencers(FrontierNode))
+				{
+					Visit(ForwardVisits, BackwardVisits, Referencer, FrontierNode, ForwardDepth);
+				}
+			}
+			Swap(ForwardFrontier, NextFrontier);
+		}
+		else
+		{
+			++BackwardDepth;
+			for (const int32 FrontierNode : BackwardFrontier)
+			{
+				for (const TConstArrayView<int32> Dependencies : { GetHardDependencies(FrontierNode), GetSoftDependencies(FrontierNode) })
+				{
+					for (const int32 Dependency : Dependencies)
+					{
+						Visit(BackwardVisits, ForwardVisits, Dependency, FrontierNode, BackwardDepth);
+					}
+				}
+			}
+			Swap(BackwardFrontier, NextFrontier);
+		}
+	}
+
+	if (MeetingNode == INDEX_NONE) return false;
+
+	// Start node up to the meeting point, then on to the root
+	for (int32 PathNode = MeetingNode; PathNode != FrontierOrigin; PathNode = ForwardVisits[PathNode].Parent)
+	{
+		OutPath.Add(PathNode);
+	}
+	Algo::Reverse(OutPath);
+
+	for (int32 PathNode = BackwardVisits[MeetingNode].Parent; PathNode != FrontierOrigin; PathNode = BackwardVisits[PathNode].Parent)
+	{
+		OutPath.Add(PathNode);
+	}
+
+	return true;
+}
+
+void FMicroManagerDependencyGraph::ComputeInclusiveSizes(const TArray<int32>& RootNodes, TArray<int64>& OutInclusiveSizes) const
+{
+	OutInclusiveSizes.SetNumZeroed(RootNodes.Num());
+
+	// Gather the subgraph reachable from the roots through hard references
+	TArray<int32> LocalIndices;
+	LocalIndices.Init(INDEX_NONE, Num());
+	TArray<int32> LocalNodes;
+
+	for (const int32 RootNode : RootNodes)
+	{
+		if (RootNode != INDEX_NONE && LocalIndices[RootNode] == INDEX_NONE)
+		{
+			LocalIndices[RootNode] = LocalNodes.Add(RootNode);
+		}
+	}
+
+	for (int32 Cursor = 0; Cursor < LocalNodes.Num(); ++Cursor)
+	{
+		for (const int32 Dependency : GetHardDependencies(LocalNodes[Cursor]))
+		{
+			if (LocalIndices[Dependency] == INDEX_NONE)
+			{
+				LocalIndices[Dependency] = LocalNodes.Add(Dependency);
+			}
+		}
+	}
+
+	const int32 NumLocalNodes = LocalNodes.Num();
+	if (NumLocalNodes == 0) return;
+
+	// Tarjan's strongly connected components, iterative so long reference chains can't overflow the stack.
+	// Components come out sinks first: every edge between components goes to a lower component index.
+	struct FVisitFrame
+	{
+		int32 LocalNode;
+		int32 EdgeCursor;
+	};
+
+	TArray<int32> VisitOrder;
+	TArray<int32> LowLinks;
+	TArray<int32> ComponentOf;
+	VisitOrder.Init(INDEX_NONE, NumLocalNodes);
+	LowLinks.Init(INDEX_NONE, NumLocalNodes);
+	ComponentOf.Init(INDEX_NONE, NumLocalNodes);
+
+	TBitArray<> OnTarjanStack(false, NumLocalNodes);
+	TArray<int32> TarjanStack;
+	TArray<FVisitFrame> CallStack;
+	int32 NextVisitOrder = 0;
+	int32 NumComponents = 0;
+
+	for (int32 StartNode = 0; StartNode < NumLocalNodes; ++StartNode)
+	{
+		if (VisitOrder[StartNode] != INDEX_NONE) continue;
+
+		VisitOrder[StartNode] = LowLinks[StartNode] = NextVisitOrder++;
+		TarjanStack.Add(StartNode);
+		OnTarjanStack[StartNode] = true;
+		CallStack.Add({StartNode, 0});
+
+		while (CallStack.Num() > 0)
+		{
+			const int32 CurrentNode = CallStack.Last().LocalNode;
+			const TConstArrayView<int32> Dependencies = GetHardDependencies(LocalNodes[CurrentNode]);
+
+			if (CallStack.Last().EdgeCursor < Dependencies.Num())
+			{
+				const int32 NextNode = LocalIndices[Dependencies[CallStack.Last().EdgeCursor++]];
+
+				if (VisitOrder[NextNode] == INDEX_NONE)
+				{
+					VisitOrder[NextNode] = LowLinks[NextNode] = NextVisitOrder++;
+					TarjanStack.Add(NextNode);
+					OnTarjanStack[NextNode] = true;
+					CallStack.Add({NextNode, 0});
+				}
+				else if (OnTarjanStack[NextNode])
+				{
+					LowLinks[CurrentNode] = FMath::Min(LowLinks[CurrentNode], VisitOrder[NextNode]);
+				}
+				continue;
+			}
+
+			if (LowLinks[CurrentNode] == VisitOrder[CurrentNode])
+			{
+				int32 MemberNode;
+				do
+				{
+					MemberNode = TarjanStack.Pop(false);
+					OnTarjanStack[MemberNode] = false;
+					ComponentOf[MemberNode] = NumComponents;
+				}
+				while (MemberNode != CurrentNode);
+
+				++NumComponents;
+			}
+
+			CallStack.Pop(false);
+			if (CallStack.Num() > 0)
+			{
+				const int32 ParentNode = CallStack.Last().LocalNode;
+				LowLinks[ParentNode] = FMath::Min(LowLinks[ParentNode], LowLinks[CurrentNode]);
+			}
+		}
+	}
+
+	// Condense: one size per component, members grouped per component, then de-duplicated component edges
+	TArray<int64> ComponentSizes;
+	ComponentSizes.SetNumZeroed(NumComponents);
+	TArray<int32> MemberOffsets;
+	MemberOffsets.SetNumZeroed(NumComponents + 1);
+
+	for (int32 LocalNode = 0; LocalNode < NumLocalNodes; ++LocalNode)
+	{
+		ComponentSizes[ComponentOf[LocalNode]] += DiskSizes[LocalNodes[LocalNode]];
+		++MemberOffsets[ComponentOf[LocalNode] + 1];
+	}
+	for (int32 Component = 0; Component < NumComponents; ++Component)
+	{
+		MemberOffsets[Component + 1] += MemberOffsets[Component];
+	}
+
+	TArray<int32> Members;
+	Members.SetNumUninitialized(NumLocalNodes);
+	TArray<int32> MemberCursors(MemberOffsets.GetData(), NumComponents);
+	for (int32 LocalNode = 0; LocalNode < NumLocalNodes; ++LocalNode)
+	{
+		Members[MemberCursors[ComponentOf[LocalNode]]++] = LocalNode;
+	}
+
+	TArray<int32> ComponentEdgeOffsets;
+	TArray<int32> ComponentEdges;
+	TArray<int32> LastSeenFrom;
+	ComponentEdgeOffsets.Reserve(NumComponents + 1);
+	ComponentEdgeOffsets.Add(0);
+	LastSeenFrom.Init(INDEX_NONE, NumComponents);
+
+	for (int32 Component = 0; Component < NumComponents; ++Component)
+	{
+		for (int32 MemberIndex = MemberOffsets[Component]; MemberIndex < MemberOffsets[Component + 1]; ++MemberIndex)
+		{
+			for (const int32 Dependency : GetHardDependencies(LocalNodes[Members[MemberIndex]]))
+			{
+				const int32 DependencyComponent = ComponentOf[LocalIndices[Dependency]];
+				if (DependencyComponent != Component && LastSeenFrom[DependencyComponent] != Component)
+				{
+					LastSeenFrom[DependencyComponent] = Component;
+					ComponentEdges.Add(DependencyComponent);
+				}
+			}
+		}
+		ComponentEdgeOffsets.Add(ComponentEdges.Num());
+	}
+
+	TArray<int64> InclusiveSizes;
+	InclusiveSizes.Init(-1, NumComponents);
+
+	if (NumComponents <= MaxComponentsForMemoizedPass)
+	{
+		// One pass in topological order. Each component reaches itself plus everything its children reach,
+		// and since children always have a lower index only the first Component / 64 + 1 words can be set.
+		const int32 NumWords = (NumComponents + 63) / 64;
+		TArray<uint64> ReachSets;
+		ReachSets.SetNumZeroed(NumComponents * NumWords);
+
+		for (int32 Component = 0; Component < NumComponents; ++Component)
+		{
+			uint64* ReachSet = ReachSets.GetData() + Component * NumWords;
+			const int32 UsedWords = Component / 64 + 1;
+
+			ReachSet[Component / 64] |= 1ull << (Component % 64);
+
+			for (int32 EdgeIndex = ComponentEdgeOffsets[Component]; EdgeIndex < ComponentEdgeOffsets[Component + 1]; ++EdgeIndex)
+			{
+				const uint64* ChildReachSet = ReachSets.GetData() + ComponentEdges[EdgeIndex] * NumWords;
+				for (int32 WordIndex = 0; WordIndex < UsedWords; ++WordIndex)
+				{
+					ReachSet[WordIndex] |= ChildReachSet[WordIndex];
+				}
+			}
+
+			int64 InclusiveSize = 0;
+			for (int32 WordIndex = 0; WordIndex < UsedWords; ++WordIndex)
+			{
+				for (uint64 Bits = ReachSet[WordIndex]; Bits != 0; Bits &= Bits - 1)
+				{
+					InclusiveSize += ComponentSizes[WordIndex * 64 + FMath::CountTrailingZeros64(Bits)];
+				}
+			}
+			InclusiveSizes[Component] = InclusiveSize;
+		}
+	}
+	else
+	{
+		// Too big to memoize the reach sets, walk the condensed DAG once per distinct root component
+		TArray<uint32> VisitedStamps;
+		VisitedStamps.Init(0, NumComponents);
+		uint32 CurrentStamp = 0;
+		TArray<int32> ComponentsToVisit;
+
+		for (const int32 RootNode : RootNodes)
+		{
+			if (RootNode == INDEX_NONE) continue;
+
+			const int32 RootComponent = ComponentOf[LocalIndices[RootNode]];
+			if (InclusiveSizes[RootComponent] >= 0) continue;
+
+			++CurrentStamp;
+			int64 InclusiveSize = 0;
+			ComponentsToVisit.Reset();
+			ComponentsToVisit.Add(RootComponent);
+			VisitedStamps[RootComponent] = CurrentStamp;
+
+			while (ComponentsToVisit.Num() > 0)
+			{
+				const int32 Component = ComponentsToVisit.Pop(false);
+				InclusiveSize += ComponentSizes[Component];
+
+				for (int32 EdgeIndex = ComponentEdgeOffsets[Component]; EdgeIndex < ComponentEdgeOffsets[Component + 1]; ++EdgeIndex)
+				{
+					const int32 ChildComponent = ComponentEdges[EdgeIndex];
+					if (VisitedStamps[ChildComponent] != CurrentStamp)
+					{
+						VisitedStamps[ChildComponent] = CurrentStamp;
+						ComponentsToVisit.Add(ChildComponent);
+					}
+				}
+			}
+
+			InclusiveSizes[RootComponent] = InclusiveSize;
+		}
+	}
+
+	for (int32 RootIndex = 0; RootIndex < RootNodes.Num(); ++RootIndex)
+	{
+		if (RootNodes[RootIndex] != INDEX_NONE)
+		{
+			OutInclusiveSizes[RootIndex] = InclusiveSizes[ComponentOf[LocalIndices[RootNodes[RootIndex]]]];
+		}
+	}
+}
@@ -0,0 +1,100 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "AssetAnalysis/MicroManagerExportCommandlet.h"
+#include "AssetAnalysis/MicroManagerScanExport.h"
+#include "AssetAnalysis/MicroManagerSizeCache.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "HAL/PlatformProcess.h"
+#include "MicroManager.h"
+#include "Misc/Paths.h"
+#include "Subsystems/MicroManagerSubsystem.h"
+
+UMicroManagerExportCommandlet::UMicroManagerExportCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = true;
+	LogToConsole = true;
+}
+
+int32 UMicroManagerExportCommandlet::Main(const FString& Params)
+{
+	FString PathsParam = TEXT("/Game");
+	FParse::Value(*Params, TEXT("Paths="), PathsParam, false);
+
+	TArray<FString> FolderPaths;
+	PathsParam.ParseIntoArray(FolderPaths, TEXT("+"));
+
+	FString Listing = TEXT("All");
+	FParse::Value(*Params, TEXT("Listing="), Listing);
+
+	FString ExportFilePath = FMicroManagerScanExport::GetExportDir() / TEXT("MicroManagerScan.csv");
+	FParse::Value(*Params, TEXT("Output="), ExportFilePath);
+	ExportFilePath = FPaths::ConvertRelativePathToFull(ExportFilePath);
+
+	UMicroManagerSubsystem* MicroManagerSubsystem = UMicroManagerSubsystem::Get();
+	if (!MicroManagerSubsystem)
+	{
+		UE_LOG(LogTemp, Error, TEXT("MicroManagerExport: the MicroManager subsystem is not available"));
+		return 1;
+	}
+
+	// Commandlets start before the registry has discovered anything
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+	AssetRegistry.SearchAllAssets(true);
+
+	TArray<TSharedPtr<FAssetData>> AssetsData;
+	UMicroManagerSubsystem::GatherAssetDataUnderFolders(AssetRegistry, FolderPaths, AssetsData);
+
+	if (Listing.Equals(TEXT("Unused"), ESearchCase::IgnoreCase))
+	{
+		TArray<TSharedPtr<FAssetData>> UnusedAssetsData;
+		MicroManagerSubsystem->ListUnusedAssets(AssetsData, UnusedAssetsData);
+		AssetsData = MoveTemp(UnusedAssetsData);
+	}
+	else if (Listing.Equals(TEXT("SameName"), ESearchCase::IgnoreCase))
+	{
+		TArray<TSharedPtr<FAssetData>> SameNameAssetsData;
+		FModuleManager::LoadModuleChecked<FMicroManagerModule>(TEXT("MicroManager")).ListSameNameAssetsForAssetList(AssetsData, SameNameAssetsData);
+		AssetsData = MoveTemp(SameNameAssetsData);
+	}
+	else if (!Listing.Equals(TEXT("All"), ESearchCase::IgnoreCase))
+	{
+		UE_LOG(LogTemp, Error, TEXT("MicroManagerExport: unknown listing %s, expected All, Unused or SameName"), *Listing);
+		return 1;
+	}
+
+	UE_LOG(LogTemp, Display, TEXT("MicroManagerExport: computing the sizes of %d assets under %s"), AssetsData.Num(), *PathsParam);
+
+	// The sizes are computed on workers and handed back through the game thread queue, which nothing pumps in a commandlet
+	bool bSizesReady = false;
+	MicroManagerSubsystem->RequestAssetSizes(AssetsData, FSimpleDelegate::CreateLambda([&bSizesReady]()
+	{
+		bSizesReady = true;
+	}));
+
+	while (!bSizesReady)
+	{
+		FTaskGraphInterface::Get().ProcessThreadUntilIdle(ENamedThreads::GameThread);
+		FPlatformProcess::Sleep(0.01f);
+	}
+
+	TArray<FMicroManagerExportRow> Rows;
+	if (!FMicroManagerScanExport::MakeRows(AssetsData, *MicroManagerSubsystem->GetSizeCache(), Rows))
+	{
+		UE_LOG(LogTemp, Error, TEXT("MicroManagerExport: some sizes could not be computed, %s was not written"), *ExportFilePath);
+		return 1;
+	}
+
+	if (!FMicroManagerScanExport::WriteToFile(ExportFilePath, FMicroManagerScanExport::GetFormatForFile(ExportFilePath), Rows))
+	{
+		UE_LOG(LogTemp, Error, TEXT("MicroManagerExport: failed to write %s"), *ExportFilePath);
+		return 1;
+	}
+
+	UE_LOG(LogTemp, Display, TEXT("MicroManagerExport: exported %d assets into %s"), Rows.Num(), *ExportFilePath);
+
+	return 0;
+}
@@ -0,0 +1,105 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "AssetAnalysis/MicroManagerNameIndex.h"
+#include "Algo/BinarySearch.h"
+#include "String/Find.h"
+
+void FMicroManagerNameIndex::Build(const TArray<FString>& ItemTexts)
+{
+	TextBuffer.Reset();
+	ItemOffsets.Reset(ItemTexts.Num() + 1);
+	TrigramPostings.Reset();
+
+	ItemOffsets.Add(0);
+	for (int32 ItemId = 0; ItemId < ItemTexts.Num(); ++ItemId)
+	{
+		const int32 ItemStart = TextBuffer.Num();
+		for (const TCHAR Character : ItemTexts[ItemId])
+		{
+			TextBuffer.Add(FChar::ToLower(Character));
+		}
+		ItemOffsets.Add(TextBuffer.Num());
+
+		for (int32 CharIndex = ItemStart; CharIndex + 3 <= TextBuffer.Num(); ++CharIndex)
+		{
+			// Items are added in order, so a repeated trigram of the same item is always the last posting
+			TArray<int32>& Posting = TrigramPostings.FindOrAdd(MakeTrigramKey(&TextBuffer[CharIndex]));
+			if (Posting.Num() == 0 || Posting.Last() != ItemId)
+			{
+				Posting.Add(ItemId);
+			}
+		}
+	}
+}
+
+void FMicroManagerNameIndex::Search(FStringView SearchText, TArray<int32>& OutMatches) const
+{
+	OutMatches.Reset();
+
+	const FString LowerSearchText = FString(SearchText).ToLower();
+
+	// Too short for a trigram, every item is a candidate
+	if (LowerSearchText.Len() < 3)
+	{
+		for (int32 ItemId = 0; ItemId < Num(); ++ItemId)
+		{
+			if (ItemContains(ItemId, LowerSearchText))
+			{
+				OutMatches.Add(ItemId);
+			}
+		}
+		return;
+	}
+
+	TArray<const TArray<int32>*, TInlineAllocator<16>> Postings;
+	for (int32 CharIndex = 0; CharIndex + 3 <= LowerSearchText.Len(); ++CharIndex)
+	{
+		const TArray<int32>* Posting = TrigramPostings.Find(MakeTrigramKey(&LowerSearchText[CharIndex]));
+		if (!Posting)
+		{
+			return;
+		}
+		Postings.AddUnique(Posting);
+	}
+
+	// Start from the rarest trigram so the intersections stay small
+	Postings.Sort([](const TArray<int32>& A, const TArray<int32>& B) { return A.Num() < B.Num(); });
+
+	OutMatches = *Postings[0];
+	for (int32 PostingIndex = 1; PostingIndex < Postings.Num() && OutMatches.Num() > 0; ++PostingIndex)
+	{
+		const TArray<int32>& Posting = *Postings[PostingIndex];
+		OutMatches.RemoveAll([&Posting](const int32 ItemId)
+		{
+			return Algo::BinarySearch(Posting, ItemId) == INDEX_NONE;
+		});
+	}
+
+	// Every trigram being there doesn't mean they are in a row
+	OutMatches.RemoveAll([this, &LowerSearchText](const int32 ItemId)
+	{
+		return !ItemContains(ItemId, LowerSearchText);
+	});
+}
+
+void FMicroManagerNameIndex::Narrow(FStringView SearchText, TArray<int32>& InOutMatches) const
+{
+	const FString LowerSearchText = FString(SearchText).ToLower();
+
+	InOutMatches.RemoveAll([this, &LowerSearchText](const int32 ItemId)
+	{
+		return !ItemContains(ItemId, LowerSearchText);
+	});
+}
+
+uint64 FMicroManagerNameIndex::MakeTrigramKey(const TCHAR* Characters)
+{
+	return (static_cast<uint64>(Characters[0]) << 42) | (static_cast<uint64>(Characters[1]) << 21) | static_cast<uint64>(Characters[2]);
+}
+
+bool FMicroManagerNameIndex::ItemContains(int32 ItemId, FStringView LowerSearchText) const
+{
+	const FStringView ItemText(TextBuffer.GetData() + ItemOffsets[ItemId], ItemOffsets[ItemId + 1] - ItemOffsets[ItemId]);
+	return UE::String::FindFirst(ItemText, LowerSearchText) != INDEX_NONE;
+}
@@ -0,0 +1,248 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "AssetAnalysis/MicroManagerScanExport.h"
+#include "AssetAnalysis/MicroManagerSizeCache.h"
+#include "Async/Async.h"
+#include "HAL/FileManager.h"
+#include "Misc/Paths.h"
+
+namespace
+{
+	// Writes the builder's text as UTF-8 and empties it, keeping its buffer for the next chunk
+	void FlushChunk(FArchive& Writer, FStringBuilderBase& Builder)
+	{
+		if (Builder.Len() == 0) return;
+
+		const FTCHARToUTF8 Utf8Chunk(Builder.GetData(), Builder.Len());
+		Writer.Serialize(const_cast<ANSICHAR*>(reinterpret_cast<const ANSICHAR*>(Utf8Chunk.Get())), Utf8Chunk.Length());
+		Builder.Reset();
+	}
+
+	void AppendSizeOrEmpty(FStringBuilderBase& Builder, int64 Size, const TCHAR* EmptyText)
+	{
+		if (Size >= 0)
+		{
+			Builder.Appendf(TEXT("%lld"), Size);
+		}
+		else
+		{
+			Builder.Append(EmptyText);
+		}
+	}
+}
+
+bool FMicroManagerScanExport::MakeRows(const TArray<TSharedPtr<FAssetData>>& AssetsData, const FMicroManagerSizeCache& SizeCache,
+	TArray<FMicroManagerExportRow>& OutRows)
+{
+	TArray<FMicroManagerExportRow>& Rows = OutRows;
+	Rows.Reset(AssetsData.Num());
+	bool bAllSizesCached = true;
+
+	for (const TSharedPtr<FAssetData>& AssetData : AssetsData)
+	{
+		// Also drops the placeholder row the tab shows while nothing was found
+		if (!AssetData.IsValid() || !AssetData->IsValid()) continue;
+
+		FMicroManagerExportRow& Row = Rows.AddDefaulted_GetRef();
+		Row.PackageName = AssetData->PackageName;
+		Row.AssetName = AssetData->AssetName;
+		Row.AssetClass = AssetData->AssetClassPath.GetAssetName();
+
+		const FMicroManagerAssetSizeInfo* SizeInfo = SizeCache.FindSizeInfo(AssetData->PackageName);
+		if (SizeInfo && SizeInfo->IsComputed())
+		{
+			Row.DiskSize = SizeInfo->DiskSize;
+			Row.DependencySize = SizeInfo->DependencySize;
+		}
+		else
+		{
+			bAllSizesCached = false;
+		}
+	}
+
+	// The listing order depends on the registry's gather order and on the sort column, neither is stable across runs
+	Rows.Sort([](const FMicroManagerExportRow& A, const FMicroManagerExportRow& B)
+	{
+		if (A.PackageName != B.PackageName)
+		{
+			return A.PackageName.LexicalLess(B.PackageName);
+		}
+		return A.AssetName.LexicalLess(B.AssetName);
+	});
+
+	return bAllSizesCached;
+}
+
+EMicroManagerExportFormat FMicroManagerScanExport::GetFormatForFile(const FString& FilePath)
+{
+	return FPaths::GetExtension(FilePath).Equals(TEXT("json"), ESearchCase::IgnoreCase) ? EMicroManagerExportFormat::Json : EMicroManagerExportFormat::Csv;
+}
+
+bool FMicroManagerScanExport::WriteToFile(const FString& FilePath, EMicroManagerExportFormat Format, const TArray<FMicroManagerExportRow>& Rows)
+{
+	// A failed export must not leave a truncated file in place of the previous one
+	const FString TempFilePath = FilePath + TEXT(".tmp");
+	{
+		TUniquePtr<FArchive> Writer(IFileManager::Get().CreateFileWriter(*TempFilePath));
+		if (!Writer.IsValid()) return false;
+
+		// A worker's stack is too small for a chunk, the builder writes into one heap buffer for the whole file
+		TArray<TCHAR> ChunkBuffer;
+		ChunkBuffer.SetNumUninitialized(ChunkSize + ChunkSlack);
+		FStringBuilderBase Builder(ChunkBuffer.GetData(), ChunkBuffer.Num());
+		TStringBuilder<256> NameBuffer;
+
+		if (Format == EMicroManagerExportFormat::Csv)
+		{
+			Builder.Append(TEXT("Package,Asset,Class,DiskSize,DependencySize\n"));
+		}
+		else
+		{
+			Builder.Append(TEXT("["));
+		}
+
+		for (int32 RowIndex = 0; RowIndex < Rows.Num(); ++RowIndex)
+		{
+			const FMicroManagerExportRow& Row = Rows[RowIndex];
+
+			if (Format == EMicroManagerExportFormat::Csv)
+			{
+				NameBuffer.Reset();
+				Row.PackageName.AppendString(NameBuffer);
+				AppendCsvField(Builder, NameBuffer);
+				Builder.AppendChar(TEXT(','));
+
+				NameBuffer.Reset();
+				Row.AssetName.AppendString(NameBuffer);
+				AppendCsvField(Builder, NameBuffer);
+				Builder.AppendChar(TEXT(','));
+
+				NameBuffer.Reset();
+				Row.AssetClass.AppendString(NameBuffer);
+				AppendCsvField(Builder, NameBuffer);
+				Builder.AppendChar(TEXT(','));
+
+				AppendSizeOrEmpty(Builder, Row.DiskSize, TEXT(""));
+				Builder.AppendChar(TEXT(','));
+				AppendSizeOrEmpty(Builder, Row.DependencySize, TEXT(""));
+				Builder.AppendChar(TEXT('\n'));
+			}
+			else
+			{
+				Builder.Append(RowIndex == 0 ? TEXT("\n  {\"package\": ") : TEXT(",\n  {\"package\": "));
+
+				NameBuffer.Reset();
+				Row.PackageName.AppendString(NameBuffer);
+				AppendJsonString(Builder, NameBuffer);
+
+				Builder.Append(TEXT(", \"asset\": "));
+				NameBuffer.Reset();
+				Row.AssetName.AppendString(NameBuffer);
+				AppendJsonString(Builder, NameBuffer);
+
+				Builder.Append(TEXT(", \"class\": "));
+				NameBuffer.Reset();
+				Row.AssetClass.AppendString(NameBuffer);
+				AppendJsonString(Builder, NameBuffer);
+
+				Builder.Append(TEXT(", \"diskSize\": "));
+				AppendSizeOrEmpty(Builder, Row.DiskSize, TEXT("null"));
+				Builder.Append(TEXT(", \"dependencySize\": "));
+				AppendSizeOrEmpty(Builder, Row.DependencySize, TEXT("null"));
+				Builder.AppendChar(TEXT('}'));
+			}
+
+			if (Builder.Len() >= ChunkSize)
+			{
+				FlushChunk(*Writer, Builder);
+			}
+		}
+
+		if (Format == EMicroManagerExportFormat::Json)
+		{
+			Builder.Append(Rows.Num() > 0 ? TEXT("\n]\n") : TEXT("]\n"));
+		}
+		FlushChunk(*Writer, Builder);
+
+		if (!Writer->Close())
+		{
+			IFileManager::Get().Delete(*TempFilePath);
+			return false;
+		}
+	}
+
+	return IFileManager::Get().Move(*FilePath, *TempFilePath, true);
+}
+
+void FMicroManagerScanExport::WriteToFileAsync(const FString& FilePath, TArray<FMicroManagerExportRow>&& Rows, FOnMicroManagerExportComplete OnComplete)
+{
+	const EMicroManagerExportFormat Format = GetFormatForFile(FilePath);
+
+	Async(EAsyncExecution::ThreadPool, [FilePath, Format, Rows = MoveTemp(Rows), OnComplete]()
+	{
+		const bool bSucceeded = WriteToFile(FilePath, Format, Rows);
+
+		AsyncTask(ENamedThreads::GameThread, [OnComplete, bSucceeded]()
+		{
+			OnComplete.ExecuteIfBound(bSucceeded);
+		});
+	});
+}
+
+FString FMicroManagerScanExport::GetExportDir()
+{
+	return FPaths::ProjectSavedDir() / TEXT("MicroManager") / TEXT("Exports");
+}
+
+void FMicroManagerScanExport::AppendCsvField(FStringBuilderBase& Builder, FStringView Field)
+{
+	bool bNeedsQuotes = false;
+	for (const TCHAR Character : Field)
+	{
+		bNeedsQuotes |= Character == TEXT(',') || Character == TEXT('"') || Character == TEXT('\n') || Character == TEXT('\r');
+	}
+
+	if (!bNeedsQuotes)
+	{
+		Builder.Append(Field);
+		return;
+	}
+
+	Builder.AppendChar(TEXT('"'));
+	for (const TCHAR Character : Field)
+	{
+		if (Character == TEXT('"'))
+		{
+			Builder.AppendChar(TEXT('"'));
+		}
+		Builder.AppendChar(Character);
+	}
+	Builder.AppendChar(TEXT('"'));
+}
+
+void FMicroManagerScanExport::AppendJsonString(FStringBuilderBase& Builder, FStringView Text)
+{
+	Builder.AppendChar(TEXT('"'));
+	for (const TCHAR Character : Text)
+	{
+		switch (Character)
+		{
+		case TEXT('"'): Builder.Append(TEXT("\\\"")); break;
+		case TEXT('\\'): Builder.Append(TEXT("\\\\")); break;
+		case TEXT('\n'): Builder.Append(TEXT("\\n")); break;
+		case TEXT('\r'): Builder.Append(TEXT("\\r")); break;
+		case TEXT('\t'): Builder.Append(TEXT("\\t")); break;
+		default:
+			if (Character < 0x20)
+			{
+				Builder.Appendf(TEXT("\\u%04x"), static_cast<uint32>(Character));
+			}
+			else
+			{
+				Builder.AppendChar(Character);
+			}
+		}
+	}
+	Builder.AppendChar(TEXT('"'));
+}
@@ -0,0 +1,170 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "AssetAnalysis/MicroManagerSizeCache.h"
+#include "AssetAnalysis/MicroManagerDependencyGraph.h"
+#include "Async/Async.h"
+#include "UObject/Package.h"
+
+void FMicroManagerSizeCache::RequestSizes(const TArray<TSharedPtr<FAssetData>>& AssetsData,
+	TSharedRef<const FMicroManagerDependencyGraph> DependencyGraph, FSimpleDelegate OnSizesUpdated)
+{
+	TArray<FName> PackageNames;
+	PackageNames.Reserve(AssetsData.Num());
+	for (const TSharedPtr<FAssetData>& AssetData : AssetsData)
+	{
+		if (AssetData.IsValid() && !AssetData->PackageName.IsNone())
+		{
+			PackageNames.Add(AssetData->PackageName);
+		}
+	}
+
+	RequestPackageSizes(MoveTemp(PackageNames), DependencyGraph, OnSizesUpdated);
+}
+
+void FMicroManagerSizeCache::RequestPackageSizes(TArray<FName>&& PackageNames, TSharedRef<const FMicroManagerDependencyGraph> DependencyGraph,
+	FSimpleDelegate OnSizesUpdated)
+{
+	check(IsInGameThread());
+
+	TSet<FName> MissingPackages;
+	TArray<FName> PackagesToCompute;
+	for (const FName PackageName : PackageNames)
+	{
+		if (CachedSizes.Contains(PackageName)) continue;
+
+		// Packages already queued by an earlier request are waited for rather than computed twice
+		MissingPackages.Add(PackageName);
+		if (!PendingPackages.Contains(PackageName))
+		{
+			PendingPackages.Add(PackageName);
+			PackagesToCompute.Add(PackageName);
+		}
+	}
+
+	if (MissingPackages.Num() == 0)
+	{
+		OnSizesUpdated.ExecuteIfBound();
+		return;
+	}
+
+	Waiters.Add(MoveTemp(PackageNames), MoveTemp(MissingPackages), OnSizesUpdated);
+
+	if (PackagesToCompute.Num() == 0) return;
+
+	TWeakPtr<FMicroManagerSizeCache> WeakCache = AsShared();
+	const uint32 BatchGeneration = Waiters.GetGeneration();
+
+	Async(EAsyncExecution::ThreadPool, [WeakCache, BatchGeneration, DependencyGraph, PackagesToCompute = MoveTemp(PackagesToCompute)]()
+	{
+		TArray<FMicroManagerAssetSizeInfo> ComputedSizes;
+		ComputeSizes(*DependencyGraph, PackagesToCompute, ComputedSizes);
+
+		AsyncTask(ENamedThreads::GameThread, [WeakCache, BatchGeneration, PackagesToCompute, ComputedSizes = MoveTemp(ComputedSizes)]() mutable
+		{
+			if (TSharedPtr<FMicroManagerSizeCache> SizeCache = WeakCache.Pin())
+			{
+				SizeCache->OnSizesComputed(BatchGeneration, PackagesToCompute, ComputedSizes);
+			}
+		});
+	});
+}
+
+void FMicroManagerSizeCache::ComputeSizes(const FMicroManagerDependencyGraph& DependencyGraph, const TArray<FName>& PackageNames,
+	TArray<FMicroManagerAssetSizeInfo>& OutSizes)
+{
+	OutSizes.SetNum(PackageNames.Num());
+
+	TArray<int32> RootNodes;
+	RootNodes.Reserve(PackageNames.Num());
+	for (const FName PackageName : PackageNames)
+	{
+		RootNodes.Add(DependencyGraph.FindNode(PackageName));
+	}
+
+	// The whole batch shares one closure pass over the graph instead of one walk per asset
+	TArray<int64> InclusiveSizes;
+	DependencyGraph.ComputeInclusiveSizes(RootNodes, InclusiveSizes);
+
+	for (int32 PackageIndex = 0; PackageIndex < PackageNames.Num(); ++PackageIndex)
+	{
+		FMicroManagerAssetSizeInfo& SizeInfo = OutSizes[PackageIndex];
+		const int32 NodeIndex = RootNodes[PackageIndex];
+
+		SizeInfo.DiskSize = NodeIndex != INDEX_NONE ? DependencyGraph.GetDiskSize(NodeIndex) : 0;
+		SizeInfo.ResourceSize = SizeInfo.DiskSize;
+		SizeInfo.DependencySize = FMath::Max<int64>(InclusiveSizes[PackageIndex] - SizeInfo.DiskSize, 0);
+	}
+}
+
+void FMicroManagerSizeCache::OnSizesComputed(uint32 BatchGeneration, const TArray<FName>& PackageNames, TArray<FMicroManagerAssetSizeInfo>& ComputedSizes)
+{
+	check(IsInGameThread());
+
+	// Computed from a graph that went stale since, its requests were handed to RequeueInvalidatedRequests
+	const int32 NumPackagesToCache = BatchGeneration == Waiters.GetGeneration() ? PackageNames.Num() : 0;
+
+	for (int32 PackageIndex = 0; PackageIndex < NumPackagesToCache; ++PackageIndex)
+	{
+		FMicroManagerAssetSizeInfo& SizeInfo = ComputedSizes[PackageIndex];
+
+		// Loaded assets can report their real resource size, the object lookup is only legal on the game thread
+		if (const UPackage* LoadedPackage = FindPackage(nullptr, *PackageNames[PackageIndex].ToString()))
+		{
+			if (UObject* LoadedAsset = LoadedPackage->FindAssetInPackage())
+			{
+				SizeInfo.ResourceSize = LoadedAsset->GetResourceSizeBytes(EResourceSizeMode::EstimatedTotal);
+			}
+		}
+
+		PendingPackages.Remove(PackageNames[PackageIndex]);
+		CachedSizes.Add(PackageNames[PackageIndex], SizeInfo);
+	}
+
+	// Run last, a callback may request more sizes
+	for (const FSimpleDelegate& OnSizesUpdated : Waiters.OnBatchLanded(BatchGeneration, PackageNames))
+	{
+		OnSizesUpdated.ExecuteIfBound();
+	}
+}
+
+const FMicroManagerAssetSizeInfo* FMicroManagerSizeCache::FindSizeInfo(FName PackageName) const
+{
+	return CachedSizes.Find(PackageName);
+}
+
+int64 FMicroManagerSizeCache::GetDiskSize(FName PackageName) const
+{
+	const FMicroManagerAssetSizeInfo* SizeInfo = CachedSizes.Find(PackageName);
+	return SizeInfo ? SizeInfo->DiskSize : -1;
+}
+
+int64 FMicroManagerSizeCache::GetResourceSize(FName PackageName) const
+{
+	const FMicroManagerAssetSizeInfo* SizeInfo = CachedSizes.Find(PackageName);
+	return SizeInfo ? SizeInfo->ResourceSize : -1;
+}
+
+int64 FMicroManagerSizeCache::GetDependencySize(FName PackageName) const
+{
+	const FMicroManagerAssetSizeInfo* SizeInfo = CachedSizes.Find(PackageName);
+	return SizeInfo ? SizeInfo->DependencySize : -1;
+}
+
+void FMicroManagerSizeCache::InvalidateAll()
+{
+	CachedSizes.Empty();
+	PendingPackages.Empty();
+
+	// Completing them now would hand an empty cache to their callbacks
+	InvalidatedRequests.Append(Waiters.Invalidate());
+}
+
+void FMicroManagerSizeCache::RequeueInvalidatedRequests(TSharedRef<const FMicroManagerDependencyGraph> DependencyGraph)
+{
+	TArray<FMicroManagerSizeWaiters::FWaiter> RequestsToQueue = MoveTemp(InvalidatedRequests);
+	for (FMicroManagerSizeWaiters::FWaiter& Request : RequestsToQueue)
+	{
+		RequestPackageSizes(MoveTemp(Request.RequestedPackages), DependencyGraph, Request.OnComplete);
+	}
+}
@@ -0,0 +1,332 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "AssetAnalysis/MicroManagerTextReferenceScanner.h"
+#include "Async/ParallelFor.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+
+namespace
+{
+	uint8 ToLowerAscii(uint8 Char)
+	{
+		return (Char >= 'A' && Char <= 'Z') ? Char + ('a' - 'A') : Char;
+	}
+
+	// Characters that continue a package path, a match touching one of them is part of a longer path
+	bool IsPathChar(uint8 Char)
+	{
+		return (Char >= 'a' && Char <= 'z') || (Char >= 'A' && Char <= 'Z') || (Char >= '0' && Char <= '9')
+			|| Char == '_' || Char == '-' || Char == '/';
+	}
+
+	bool IsScannedExtension(const FString& Extension)
+	{
+		static const TSet<FString> ScannedExtensions = {
+			TEXT("ini"), TEXT("h"), TEXT("hpp"), TEXT("cpp"), TEXT("inl"), TEXT("c"),
+			TEXT("json"), TEXT("csv"), TEXT("txt"), TEXT("xml"), TEXT("yaml"), TEXT("yml")
+		};
+		return ScannedExtensions.Contains(Extension);
+	}
+
+	bool IsSkippedDirectory(const FString& FilePath)
+	{
+		return FilePath.Contains(TEXT("/Intermediate/")) || FilePath.Contains(TEXT("/Binaries/"))
+			|| FilePath.Contains(TEXT("/Saved/")) || FilePath.Contains(TEXT("/Content/"));
+	}
+
+	bool LoadFileAsUtf8(const FString& FilePath, TArray<uint8>& OutUtf8Text)
+	{
+		if (!FFileHelper::LoadFileToArray(OutUtf8Text, *FilePath, FILEREAD_Silent)) return false;
+
+		// Ini files are sometimes saved as UTF-16, bring them back to bytes the automaton understands
+		const bool bIsUtf16 = OutUtf8Text.Num() >= 2
+			&& ((OutUtf8Text[0] == 0xFF && OutUtf8Text[1] == 0xFE) || (OutUtf8Text[0] == 0xFE && OutUtf8Text[1] == 0xFF));
+		if (bIsUtf16)
+		{
+			FString Text;
+			FFileHelper::BufferToString(Text, OutUtf8Text.GetData(), OutUtf8Text.Num());
+			FTCHARToUTF8 Utf8Text(*Text);
+			OutUtf8Text = TArray<uint8>(reinterpret_cast<const uint8*>(Utf8Text.Get()), Utf8Text.Length());
+		}
+
+		return true;
+	}
+}
+
+#pragma region PathMatcher
+
+void FMicroManagerPathMatcher::Build(const TArray<FString>& Patterns)
+{
+	TArray<TArray<uint8>> LowerPatterns;
+	LowerPatterns.Reserve(Patterns.Num());
+	for (const FString& Pattern : Patterns)
+	{
+		FTCHARToUTF8 Utf8Pattern(*Pattern);
+		TArray<uint8>& LowerPattern = LowerPatterns.Emplace_GetRef(reinterpret_cast<const uint8*>(Utf8Pattern.Get()), Utf8Pattern.Length());
+		for (uint8& Char : LowerPattern)
+		{
+			Char = ToLowerAscii(Char);
+		}
+	}
+
+	PatternLengths.Reset(Patterns.Num());
+	for (const TArray<uint8>& LowerPattern : LowerPatterns)
+	{
+		PatternLengths.Add(LowerPattern.Num());
+	}
+
+	// Inserting the patterns in byte order creates the children of every node in label order,
+	// and the nodes of the previous pattern are the only ones a new pattern can share
+	TArray<int32> Order;
+	Order.SetNumUninitialized(LowerPatterns.Num());
+	for (int32 Index = 0; Index < Order.Num(); ++Index) Order[Index] = Index;
+	Order.Sort([&LowerPatterns](const int32 A, const int32 B)
+	{
+		const TArray<uint8>& PatternA = LowerPatterns[A];
+		const TArray<uint8>& PatternB = LowerPatterns[B];
+		const int32 Comparison = FMemory::Memcmp(PatternA.GetData(), PatternB.GetData(), FMath::Min(PatternA.Num(), PatternB.Num()));
+		return Comparison != 0 ? Comparison < 0 : PatternA.Num() < PatternB.Num();
+	});
+
+	TArray<int32> NodeParents = { INDEX_NONE };
+	TArray<uint8> NodeLabels = { 0 };
+	NodePatterns = { INDEX_NONE };
+
+	TArray<int32> PreviousPath = { RootNode };
+	const TArray<uint8>* PreviousPattern = nullptr;
+
+	for (const int32 PatternIndex : Order)
+	{
+		const TArray<uint8>& Pattern = LowerPatterns[PatternIndex];
+		if (Pattern.Num() == 0) continue;
+
+		int32 SharedLength = 0;
+		if (PreviousPattern)
+		{
+			const int32 MaxShared = FMath::Min(PreviousPattern->Num(), Pattern.Num());
+			while (SharedLength < MaxShared && (*PreviousPattern)[SharedLength] == Pattern[SharedLength]) ++SharedLength;
+		}
+
+		PreviousPath.SetNum(SharedLength + 1);
+		for (int32 Depth = SharedLength; Depth < Pattern.Num(); ++Depth)
+		{
+			NodeParents.Add(PreviousPath[Depth]);
+			NodeLabels.Add(Pattern[Depth]);
+			PreviousPath.Add(NodePatterns.Add(INDEX_NONE));
+		}
+
+		// Package names are unique without case, a duplicate would only repeat the first one's matches
+		int32& EndPattern = NodePatterns[PreviousPath.Last()];
+		if (EndPattern == INDEX_NONE)
+		{
+			EndPattern = PatternIndex;
+		}
+
+		PreviousPattern = &Pattern;
+	}
+
+	// Flatten the children of every node, a stable counting sort by parent keeps them in label order
+	const int32 NumNodes = NodeParents.Num();
+	ChildOffsets.Init(0, NumNodes + 1);
+	for (int32 Node = 1; Node < NumNodes; ++Node)
+	{
+		++ChildOffsets[NodeParents[Node] + 1];
+	}
+	for (int32 Node = 0; Node < NumNodes; ++Node)
+	{
+		ChildOffsets[Node + 1] += ChildOffsets[Node];
+	}
+
+	ChildLabels.SetNumUninitialized(NumNodes - 1);
+	ChildNodes.SetNumUninitialized(NumNodes - 1);
+	TArray<int32> WriteOffsets(ChildOffsets.GetData(), NumNodes);
+	for (int32 Node = 1; Node < NumNodes; ++Node)
+	{
+		const int32 EdgeIndex = WriteOffsets[NodeParents[Node]]++;
+		ChildLabels[EdgeIndex] = NodeLabels[Node];
+		ChildNodes[EdgeIndex] = Node;
+	}
+
+	// Failure and output links, breadth first so shallower nodes are always done before their suffixes are needed
+	FailureLinks.Init(RootNode, NumNodes);
+	OutputLinks.Init(INDEX_NONE, NumNodes);
+
+	TArray<int32> Queue;
+	Queue.Reserve(NumNodes);
+	Queue.Add(RootNode);
+	for (int32 QueueIndex = 0; QueueIndex < Queue.Num(); ++QueueIndex)
+	{
+		const int32 Node = Queue[QueueIndex];
+		for (int32 EdgeIndex = ChildOffsets[Node]; EdgeIndex < ChildOffsets[Node + 1]; ++EdgeIndex)
+		{
+			const int32 Child = ChildNodes[EdgeIndex];
+			const uint8 Label = ChildLabels[EdgeIndex];
+			Queue.Add(Child);
+
+			if (Node != RootNode)
+			{
+				int32 Fallback = FailureLinks[Node];
+				int32 FallbackChild = FindChild(Fallback, Label);
+				while (FallbackChild == INDEX_NONE && Fallback != RootNode)
+				{
+					Fallback = FailureLinks[Fallback];
+					FallbackChild = FindChild(Fallback, Label);
+				}
+				FailureLinks[Child] = FallbackChild != INDEX_NONE ? FallbackChild : RootNode;
+			}
+
+			const int32 Failure = FailureLinks[Child];
+			OutputLinks[Child] = NodePatterns[Failure] != INDEX_NONE ? Failure : OutputLinks[Failure];
+		}
+	}
+}
+
+void FMicroManagerPathMatcher::FindMatches(TConstArrayView<uint8> Utf8Text, TFunctionRef<void(int32 PatternIndex)> OnMatch) const
+{
+	if (ChildOffsets.Num() == 0) return;
+
+	const int32 TextLength = Utf8Text.Num();
+	int32 State = RootNode;
+
+	for (int32 Position = 0; Position < TextLength; ++Position)
+	{
+		const uint8 Char = ToLowerAscii(Utf8Text[Position]);
+
+		int32 Next = FindChild(State, Char);
+		while (Next == INDEX_NONE && State != RootNode)
+		{
+			State = FailureLinks[State];
+			Next = FindChild(State, Char);
+		}
+		State = Next != INDEX_NONE ? Next : RootNode;
+
+		for (int32 OutputNode = NodePatterns[State] != INDEX_NONE ? State : OutputLinks[State];
+			OutputNode != INDEX_NONE;
+			OutputNode = OutputLinks[OutputNode])
+		{
+			const int32 PatternIndex = NodePatterns[OutputNode];
+			const int32 Start = Position - PatternLengths[PatternIndex] + 1;
+
+			const bool bStartsPath = Start == 0 || !IsPathChar(Utf8Text[Start - 1]);
+			const bool bEndsPath = Position + 1 == TextLength || !IsPathChar(Utf8Text[Position + 1]);
+			if (bStartsPath && bEndsPath)
+			{
+				OnMatch(PatternIndex);
+			}
+		}
+	}
+}
+
+int32 FMicroManagerPathMatcher::FindChild(int32 Node, uint8 Label) const
+{
+	int32 Low = ChildOffsets[Node];
+	int32 High = ChildOffsets[Node + 1];
+	while (Low < High)
+	{
+		const int32 Middle = (Low + High) / 2;
+		if (ChildLabels[Middle] < Label)
+		{
+			Low = Middle + 1;
+		}
+		else
+		{
+			High = Middle;
+		}
+	}
+
+	return (Low < ChildOffsets[Node + 1] && ChildLabels[Low] == Label) ? ChildNodes[Low] : INDEX_NONE;
+}
+
+#pragma endregion
+
+#pragma region TextReferenceScanner
+
+void FMicroManagerTextReferenceScanner::FindReferencedPackages(const TArray<FName>& CandidatePackages, TSet<FName>& OutReferencedPackages)
+{
+	OutReferencedPackages.Reset();
+	if (CandidatePackages.Num() == 0) return;
+
+	TArray<FString> Patterns;
+	Patterns.Reserve(CandidatePackages.Num());
+	for (const FName CandidatePackage : CandidatePackages)
+	{
+		Patterns.Add(CandidatePackage.ToString());
+	}
+
+	FMicroManagerPathMatcher PathMatcher;
+	PathMatcher.Build(Patterns);
+
+	TArray<FString> FilePaths;
+	GatherTextFiles(FilePaths);
+
+	// Files only take the lock when they matched something, most source files mention no asset at all
+	TBitArray<> IsPatternFound(false, Patterns.Num());
+	FCriticalSection FoundPatternsLock;
+
+	ParallelFor(FilePaths.Num(), [&FilePaths, &PathMatcher, &IsPatternFound, &FoundPatternsLock](int32 FileIndex)
+	{
+		TArray<uint8> Utf8Text;
+		if (!LoadFileAsUtf8(FilePaths[FileIndex], Utf8Text)) return;
+
+		TArray<int32> FoundPatterns;
+		PathMatcher.FindMatches(Utf8Text, [&FoundPatterns](int32 PatternIndex)
+		{
+			FoundPatterns.Add(PatternIndex);
+		});
+
+		if (FoundPatterns.Num() > 0)
+		{
+			FScopeLock ScopeLock(&FoundPatternsLock);
+			for (const int32 PatternIndex : FoundPatterns)
+			{
+				IsPatternFound[PatternIndex] = true;
+			}
+		}
+	});
+
+	for (TConstSetBitIterator<> FoundIt(IsPatternFound); FoundIt; ++FoundIt)
+	{
+		OutReferencedPackages.Add(CandidatePackages[FoundIt.GetIndex()]);
+	}
+}
+
+void FMicroManagerTextReferenceScanner::GatherTextFiles(TArray<FString>& OutFilePaths)
+{
+	TArray<FString> RootDirectories;
+	GetTextDirectories(RootDirectories);
+
+	for (const FString& RootDirectory : RootDirectories)
+	{
+		IFileManager::Get().IterateDirectoryRecursively(*RootDirectory, [&OutFilePaths](const TCHAR* Path, bool bIsDirectory)
+		{
+			if (!bIsDirectory)
+			{
+				const FString FilePath(Path);
+				if (IsScannedFile(FilePath))
+				{
+					OutFilePaths.Add(FilePath);
+				}
+			}
+			return true;
+		});
+	}
+}
+
+void FMicroManagerTextReferenceScanner::GetTextDirectories(TArray<FString>& OutDirectories)
+{
+	OutDirectories = {
+		FPaths::ConvertRelativePathToFull(FPaths::ProjectConfigDir()),
+		FPaths::ConvertRelativePathToFull(FPaths::GameSourceDir()),
+		FPaths::ConvertRelativePathToFull(FPaths::ProjectPluginsDir())
+	};
+}
+
+bool FMicroManagerTextReferenceScanner::IsScannedFile(const FString& FilePath)
+{
+	return IsScannedExtension(FPaths::GetExtension(FilePath).ToLower()) && !IsSkippedDirectory(FilePath);
+}
+
+#pragma endregion
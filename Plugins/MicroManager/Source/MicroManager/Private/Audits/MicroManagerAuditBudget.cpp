@@ -0,0 +1,30 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Audits/MicroManagerAuditBudget.h"
+#include "Misc/ConfigCacheIni.h"
+
+namespace
+{
+	const TCHAR* BudgetSection = TEXT("MicroManager");
+}
+
+void FMicroManagerAuditBudget::Read(const TCHAR* Key, int32& InOutValue)
+{
+	GConfig->GetInt(BudgetSection, Key, InOutValue, GEditorPerProjectIni);
+}
+
+void FMicroManagerAuditBudget::Read(const TCHAR* Key, float& InOutValue)
+{
+	GConfig->GetFloat(BudgetSection, Key, InOutValue, GEditorPerProjectIni);
+}
+
+const TCHAR* FMicroManagerAuditBudget::GetWhereToSetText()
+{
+	return TEXT("Set in the MicroManager section of EditorPerProjectUserSettings.");
+}
+
+bool FMicroManagerAuditBudget::ReadString(const TCHAR* Key, FString& OutValue)
+{
+	return GConfig->GetString(BudgetSection, Key, OutValue, GEditorPerProjectIni);
+}
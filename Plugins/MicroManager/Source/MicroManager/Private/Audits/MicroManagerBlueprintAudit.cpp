@@ -0,0 +1,396 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Audits/MicroManagerBlueprintAudit.h"
+#include "AssetAnalysis/MicroManagerDependencyGraph.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Async/Async.h"
+#include "BlueprintEditor.h"
+#include "DebugHelper.h"
+#include "Editor.h"
+#include "Engine/Blueprint.h"
+#include "Engine/InheritableComponentHandler.h"
+#include "Engine/SCS_Node.h"
+#include "Engine/SimpleConstructionScript.h"
+#include "SlateWidgets/MicroManagerReportWidget.h"
+#include "SMyBlueprint.h"
+#include "Subsystems/AssetEditorSubsystem.h"
+#include "Subsystems/MicroManagerSubsystem.h"
+
+namespace BlueprintAuditColumns
+{
+	static const FName Name(TEXT("Name"));
+	static const FName Kind(TEXT("Kind"));
+	static const FName HardLoadSize(TEXT("HardLoadSize"));
+	static const FName HardReferences(TEXT("HardReferences"));
+	static const FName SoftReferences(TEXT("SoftReferences"));
+	static const FName SoftReferenceSize(TEXT("SoftReferenceSize"));
+}
+
+namespace
+{
+	bool IsHardObjectProperty(const FProperty* Property)
+	{
+		// Soft, weak and lazy pointers derive from the object property base too but don't load what they point to
+		return Property->IsA<FObjectProperty>() || Property->IsA<FClassProperty>();
+	}
+
+	bool IsInPackage(const UObject* Object, FName PackageName)
+	{
+		return Object && Object->GetOutermost()->GetFName() == PackageName;
+	}
+
+	// Whether the value or anything nested in it through structs and containers is a hard reference into the package.
+	// OutSubPath gets what to append to the property name to reach it.
+	bool ValueReferencesPackage(const FProperty* Property, const void* Value, FName PackageName, FString& OutSubPath)
+	{
+		if (IsHardObjectProperty(Property))
+		{
+			return IsInPackage(CastFieldChecked<FObjectPropertyBase>(Property)->GetObjectPropertyValue(Value), PackageName);
+		}
+
+		if (const FStructProperty* StructProperty = CastField<FStructProperty>(Property))
+		{
+			for (TFieldIterator<FProperty> InnerIt(StructProperty->Struct); InnerIt; ++InnerIt)
+			{
+				for (int32 ArrayIndex = 0; ArrayIndex < InnerIt->ArrayDim; ++ArrayIndex)
+				{
+					if (ValueReferencesPackage(*InnerIt, InnerIt->ContainerPtrToValuePtr<void>(Value, ArrayIndex), PackageName, OutSubPath))
+					{
+						// Members of user defined structs carry a generated suffix, the authored name is the one shown in the editor
+						OutSubPath = TEXT(".") + InnerIt->GetAuthoredName() + OutSubPath;
+						return true;
+					}
+				}
+			}
+		}
+		else if (const FArrayProperty* ArrayProperty = CastField<FArrayProperty>(Property))
+		{
+			FScriptArrayHelper ArrayHelper(ArrayProperty, Value);
+			for (int32 ElementIndex = 0; ElementIndex < ArrayHelper.Num(); ++ElementIndex)
+			{
+				if (ValueReferencesPackage(ArrayProperty->Inner, ArrayHelper.GetRawPtr(ElementIndex), PackageName, OutSubPath))
+				{
+					OutSubPath = FString::Printf(TEXT("[%d]"), ElementIndex) + OutSubPath;
+					return true;
+				}
+			}
+		}
+		else if (const FSetProperty* SetProperty = CastField<FSetProperty>(Property))
+		{
+			FScriptSetHelper SetHelper(SetProperty, Value);
+			for (int32 ElementIndex = 0; ElementIndex < SetHelper.GetMaxIndex(); ++ElementIndex)
+			{
+				if (SetHelper.IsValidIndex(ElementIndex)
+					&& ValueReferencesPackage(SetProperty->ElementProp, SetHelper.GetElementPtr(ElementIndex), PackageName, OutSubPath))
+				{
+					return true;
+				}
+			}
+		}
+		else if (const FMapProperty* MapProperty = CastField<FMapProperty>(Property))
+		{
+			FScriptMapHelper MapHelper(MapProperty, Value);
+			for (int32 PairIndex = 0; PairIndex < MapHelper.GetMaxIndex(); ++PairIndex)
+			{
+				if (!MapHelper.IsValidIndex(PairIndex)) continue;
+
+				if (ValueReferencesPackage(MapProperty->KeyProp, MapHelper.GetKeyPtr(PairIndex), PackageName, OutSubPath)
+					|| ValueReferencesPackage(MapProperty->ValueProp, MapHelper.GetValuePtr(PairIndex), PackageName, OutSubPath))
+				{
+					return true;
+				}
+			}
+		}
+
+		return false;
+	}
+
+	TSharedPtr<FMicroManagerReportRow> MakeReferenceRow(FName BlueprintPackage, const FMicroManagerBlueprintReference& Reference, bool bIsHard)
+	{
+		TSharedPtr<FMicroManagerReportRow> ReferenceRow = MakeShared<FMicroManagerReportRow>();
+		ReferenceRow->SetText(BlueprintAuditColumns::Name, Reference.PackageName.ToString());
+		ReferenceRow->SetText(BlueprintAuditColumns::Kind, bIsHard ? TEXT("Hard") : TEXT("Soft"));
+		ReferenceRow->SetSize(BlueprintAuditColumns::HardLoadSize, Reference.InclusiveSize);
+
+		const FName ReferencedPackage = Reference.PackageName;
+		if (bIsHard)
+		{
+			// Jump to the property so it can be turned into a soft reference
+			ReferenceRow->OnNavigate.BindLambda([BlueprintPackage, ReferencedPackage]()
+			{
+				FMicroManagerBlueprintAudit::NavigateToReferencingProperty(BlueprintPackage, ReferencedPackage);
+			});
+		}
+		else
+		{
+			ReferenceRow->AssetPath = FSoftObjectPath(ReferencedPackage.ToString());
+		}
+
+		return ReferenceRow;
+	}
+}
+
+void FMicroManagerBlueprintAudit::RunAndShowReport(const TArray<TSharedPtr<FAssetData>>& AssetsData)
+{
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+
+	// Widget, animation and every other Blueprint flavor derive from UBlueprint
+	TSet<FTopLevelAssetPath> BlueprintClassPaths;
+	AssetRegistry.GetDerivedClassNames({ UBlueprint::StaticClass()->GetClassPathName() }, {}, BlueprintClassPaths);
+
+	TArray<FName> BlueprintPackages;
+	for (const TSharedPtr<FAssetData>& AssetData : AssetsData)
+	{
+		if (AssetData.IsValid() && BlueprintClassPaths.Contains(AssetData->AssetClassPath))
+		{
+			BlueprintPackages.Add(AssetData->PackageName);
+		}
+	}
+
+	if (BlueprintPackages.Num() == 0)
+	{
+		DebugHelper::ShowMsgDialog(EAppMsgType::Ok, TEXT("No Blueprint found under the selected folders"));
+		return;
+	}
+
+	DebugHelper::ShowNotifyInfo(FString::Printf(TEXT("Auditing %d Blueprints..."), BlueprintPackages.Num()));
+
+	UMicroManagerSubsystem::Get()->RequestDependencyGraph(FOnMicroManagerDependencyGraphReady::CreateLambda(
+		[BlueprintPackages](TSharedRef<const FMicroManagerDependencyGraph> DependencyGraph)
+		{
+			Async(EAsyncExecution::ThreadPool, [DependencyGraph, BlueprintPackages]()
+			{
+				TArray<FMicroManagerBlueprintAuditEntry> Entries;
+				ComputeEntries(*DependencyGraph, BlueprintPackages, Entries);
+
+				AsyncTask(ENamedThreads::GameThread, [Entries = MoveTemp(Entries)]()
+				{
+					TArray<TSharedPtr<FMicroManagerReportRow>> Rows;
+					int64 TotalHardLoadSize = 0;
+
+					for (const FMicroManagerBlueprintAuditEntry& Entry : Entries)
+					{
+						TSharedPtr<FMicroManagerReportRow> BlueprintRow = MakeShared<FMicroManagerReportRow>();
+						BlueprintRow->SetText(BlueprintAuditColumns::Name, Entry.BlueprintPackage.ToString());
+						BlueprintRow->SetText(BlueprintAuditColumns::Kind, TEXT("Blueprint"));
+						BlueprintRow->SetSize(BlueprintAuditColumns::HardLoadSize, Entry.HardLoadSize);
+						BlueprintRow->SetValue(BlueprintAuditColumns::HardReferences, Entry.HardReferences.Num(), FString::FromInt(Entry.HardReferences.Num()));
+						BlueprintRow->SetValue(BlueprintAuditColumns::SoftReferences, Entry.SoftReferences.Num(), FString::FromInt(Entry.SoftReferences.Num()));
+						BlueprintRow->SetSize(BlueprintAuditColumns::SoftReferenceSize, Entry.SoftReferenceSize);
+						BlueprintRow->AssetPath = FSoftObjectPath(Entry.BlueprintPackage.ToString());
+
+						for (const FMicroManagerBlueprintReference& Reference : Entry.HardReferences)
+						{
+							BlueprintRow->Children.Add(MakeReferenceRow(Entry.BlueprintPackage, Reference, true));
+						}
+						for (const FMicroManagerBlueprintReference& Reference : Entry.SoftReferences)
+						{
+							BlueprintRow->Children.Add(MakeReferenceRow(Entry.BlueprintPackage, Reference, false));
+						}
+
+						TotalHardLoadSize += Entry.HardLoadSize;
+						Rows.Add(BlueprintRow);
+					}
+
+					const FString Summary = FString::Printf(
+						TEXT("%d Blueprints pull in %s through hard references.\nExpand a Blueprint to see its direct references, double click a hard one to jump to the property holding it."),
+						Entries.Num(), *FText::AsMemory(TotalHardLoadSize).ToString());
+
+					SMicroManagerReportView::OpenInWindow(TEXT("Blueprint Hard Reference Audit"), Summary,
+					{
+						{ BlueprintAuditColumns::Name, TEXT("Blueprint / Reference"), 0.4f, false },
+						{ BlueprintAuditColumns::Kind, TEXT("Kind"), 0.08f, false },
+						{ BlueprintAuditColumns::HardLoadSize, TEXT("Hard Load Size"), 0.12f, true },
+						{ BlueprintAuditColumns::HardReferences, TEXT("Hard Refs"), 0.08f, true },
+						{ BlueprintAuditColumns::SoftReferences, TEXT("Soft Refs"), 0.08f, true },
+						{ BlueprintAuditColumns::SoftReferenceSize, TEXT("Soft Size"), 0.12f, true },
+					}, Rows, BlueprintAuditColumns::HardLoadSize);
+				});
+			});
+		}));
+}
+
+void FMicroManagerBlueprintAudit::ComputeEntries(const FMicroManagerDependencyGraph& DependencyGraph, const TArray<FName>& BlueprintPackages,
+	TArray<FMicroManagerBlueprintAuditEntry>& OutEntries)
+{
+	OutEntries.Reset();
+
+	// Blueprints and everything they reference directly share one closure pass
+	TArray<int32> RootNodes;
+	TMap<int32, int32> RootIndices;
+	auto AddRoot = [&RootNodes, &RootIndices](const int32 NodeIndex)
+	{
+		if (!RootIndices.Contains(NodeIndex))
+		{
+			RootIndices.Add(NodeIndex, RootNodes.Add(NodeIndex));
+		}
+	};
+
+	TArray<int32> BlueprintNodes;
+	for (const FName BlueprintPackage : BlueprintPackages)
+	{
+		const int32 BlueprintNode = DependencyGraph.FindNode(BlueprintPackage);
+		if (BlueprintNode == INDEX_NONE) continue;
+
+		BlueprintNodes.Add(BlueprintNode);
+		AddRoot(BlueprintNode);
+		for (const int32 DependencyNode : DependencyGraph.GetHardDependencies(BlueprintNode)) AddRoot(DependencyNode);
+		for (const int32 DependencyNode : DependencyGraph.GetSoftDependencies(BlueprintNode)) AddRoot(DependencyNode);
+	}
+
+	TArray<int64> InclusiveSizes;
+	DependencyGraph.ComputeInclusiveSizes(RootNodes, InclusiveSizes);
+
+	auto MakeReferences = [&DependencyGraph, &RootIndices, &InclusiveSizes](TConstArrayView<int32> DependencyNodes,
+		TArray<FMicroManagerBlueprintReference>& OutReferences)
+	{
+		for (const int32 DependencyNode : DependencyNodes)
+		{
+			FMicroManagerBlueprintReference& Reference = OutReferences.AddDefaulted_GetRef();
+			Reference.PackageName = DependencyGraph.GetPackageName(DependencyNode);
+			Reference.InclusiveSize = InclusiveSizes[RootIndices[DependencyNode]];
+		}
+
+		OutReferences.Sort([](const FMicroManagerBlueprintReference& A, const FMicroManagerBlueprintReference& B)
+		{
+			return A.InclusiveSize > B.InclusiveSize;
+		});
+	};
+
+	for (const int32 BlueprintNode : BlueprintNodes)
+	{
+		FMicroManagerBlueprintAuditEntry& Entry = OutEntries.AddDefaulted_GetRef();
+		Entry.BlueprintPackage = DependencyGraph.GetPackageName(BlueprintNode);
+		Entry.HardLoadSize = InclusiveSizes[RootIndices[BlueprintNode]];
+
+		// The hard references are already paid for in HardLoadSize, summing them would count shared dependencies twice
+		MakeReferences(DependencyGraph.GetHardDependencies(BlueprintNode), Entry.HardReferences);
+		MakeReferences(DependencyGraph.GetSoftDependencies(BlueprintNode), Entry.SoftReferences);
+
+		for (const FMicroManagerBlueprintReference& Reference : Entry.SoftReferences)
+		{
+			Entry.SoftReferenceSize += Reference.InclusiveSize;
+		}
+	}
+
+	OutEntries.Sort([](const FMicroManagerBlueprintAuditEntry& A, const FMicroManagerBlueprintAuditEntry& B)
+	{
+		return A.HardLoadSize > B.HardLoadSize;
+	});
+}
+
+bool FMicroManagerBlueprintAudit::FindReferencingProperty(UBlueprint* Blueprint, FName ReferencedPackage,
+	FString& OutPropertyPath, FName& OutVariableName)
+{
+	OutPropertyPath.Empty();
+	OutVariableName = NAME_None;
+
+	if (!Blueprint || !Blueprint->GeneratedClass) return false;
+
+	// Class defaults first, variables declared by the Blueprint are the usual offenders
+	FName RootPropertyName;
+	if (FindReferencingPropertyInObject(Blueprint->GeneratedClass->GetDefaultObject(), ReferencedPackage, OutPropertyPath, RootPropertyName))
+	{
+		const bool bIsBlueprintVariable = Blueprint->NewVariables.ContainsByPredicate([RootPropertyName](const FBPVariableDescription& Variable)
+		{
+			return Variable.VarName == RootPropertyName;
+		});
+		if (bIsBlueprintVariable)
+		{
+			OutVariableName = RootPropertyName;
+		}
+		return true;
+	}
+
+	// Then the templates of the components the Blueprint adds
+	FString PropertyPath;
+	if (Blueprint->SimpleConstructionScript)
+	{
+		for (const USCS_Node* Node : Blueprint->SimpleConstructionScript->GetAllNodes())
+		{
+			if (Node && FindReferencingPropertyInObject(Node->ComponentTemplate, ReferencedPackage, PropertyPath, RootPropertyName))
+			{
+				OutPropertyPath = Node->GetVariableName().ToString() + TEXT(".") + PropertyPath;
+				return true;
+			}
+		}
+	}
+
+	// And the overrides of the components inherited from a parent Blueprint
+	if (UInheritableComponentHandler* ComponentHandler = Blueprint->GetInheritableComponentHandler())
+	{
+		for (auto RecordIt = ComponentHandler->CreateRecordIterator(); RecordIt; ++RecordIt)
+		{
+			if (FindReferencingPropertyInObject(RecordIt->ComponentTemplate, ReferencedPackage, PropertyPath, RootPropertyName))
+			{
+				OutPropertyPath = RecordIt->ComponentKey.GetSCSVariableName().ToString() + TEXT(".") + PropertyPath;
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
+
+bool FMicroManagerBlueprintAudit::FindReferencingPropertyInObject(const UObject* Object, FName ReferencedPackage,
+	FString& OutPropertyPath, FName& OutRootPropertyName)
+{
+	if (!Object) return false;
+
+	FString SubPath;
+	for (TFieldIterator<FProperty> PropertyIt(Object->GetClass()); PropertyIt; ++PropertyIt)
+	{
+		const FProperty* Property = *PropertyIt;
+		for (int32 ArrayIndex = 0; ArrayIndex < Property->ArrayDim; ++ArrayIndex)
+		{
+			if (ValueReferencesPackage(Property, Property->ContainerPtrToValuePtr<void>(Object, ArrayIndex), ReferencedPackage, SubPath))
+			{
+				OutRootPropertyName = Property->GetFName();
+				OutPropertyPath = Property->GetName() + SubPath;
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
+
+void FMicroManagerBlueprintAudit::NavigateToReferencingProperty(FName BlueprintPackage, FName ReferencedPackage)
+{
+	UPackage* LoadedPackage = LoadPackage(nullptr, *BlueprintPackage.ToString(), LOAD_None);
+	UBlueprint* Blueprint = LoadedPackage ? Cast<UBlueprint>(LoadedPackage->FindAssetInPackage()) : nullptr;
+	if (!Blueprint)
+	{
+		DebugHelper::ShowMsgDialog(EAppMsgType::Ok, TEXT("Failed to load Blueprint: ") + BlueprintPackage.ToString());
+		return;
+	}
+
+	UAssetEditorSubsystem* AssetEditorSubsystem = GEditor->GetEditorSubsystem<UAssetEditorSubsystem>();
+	AssetEditorSubsystem->OpenEditorForAsset(Blueprint);
+
+	FString PropertyPath;
+	FName VariableName;
+	if (!FindReferencingProperty(Blueprint, ReferencedPackage, PropertyPath, VariableName))
+	{
+		DebugHelper::ShowMsgDialog(EAppMsgType::Ok, FString::Printf(
+			TEXT("%s is not held by a class default nor a component property of %s.\nThe reference comes from the graphs: casts, spawn or function call nodes, or pin defaults."),
+			*ReferencedPackage.ToString(), *Blueprint->GetName()));
+		return;
+	}
+
+	// Select the variable in My Blueprint so its type can be switched to a soft reference right away
+	if (!VariableName.IsNone())
+	{
+		if (FBlueprintEditor* BlueprintEditor = static_cast<FBlueprintEditor*>(AssetEditorSubsystem->FindEditorForAsset(Blueprint, true)))
+		{
+			if (TSharedPtr<SMyBlueprint> MyBlueprintWidget = BlueprintEditor->GetMyBlueprintWidget())
+			{
+				MyBlueprintWidget->SelectItemByName(VariableName);
+			}
+		}
+	}
+
+	DebugHelper::ShowNotifyInfo(FString::Printf(TEXT("%s hard references %s through %s"),
+		*Blueprint->GetName(), *ReferencedPackage.ToString(), *PropertyPath));
+}
@@ -0,0 +1,784 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Audits/MicroManagerMaterialDuplicates.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "AssetToolsModule.h"
+#include "DebugHelper.h"
+#include "FileHelpers.h"
+#include "Factories/MaterialInstanceConstantFactoryNew.h"
+#include "Materials/Material.h"
+#include "Materials/MaterialExpression.h"
+#include "Materials/MaterialExpressionCustomOutput.h"
+#include "Materials/MaterialExpressionScalarParameter.h"
+#include "Materials/MaterialExpressionTextureSampleParameter.h"
+#include "Materials/MaterialExpressionVectorParameter.h"
+#include "Materials/MaterialInstanceConstant.h"
+#include "Misc/ScopedSlowTask.h"
+#include "ObjectTools.h"
+#include "SlateWidgets/MicroManagerReportWidget.h"
+
+namespace MaterialDuplicateColumns
+{
+	static const FName Name(TEXT("Name"));
+	static const FName Kind(TEXT("Kind"));
+	static const FName Duplicates(TEXT("Duplicates"));
+	static const FName Referencers(TEXT("Referencers"));
+}
+
+namespace
+{
+	// Parameter types whose defaults an instance can override without a permutation of its own
+	const EMaterialParameterType OverridableParameterTypes[] = {
+		EMaterialParameterType::Scalar, EMaterialParameterType::Vector, EMaterialParameterType::Texture
+	};
+
+	void UpdateString(FBlake3& Hasher, const FString& Text)
+	{
+		// Length first so consecutive strings can't run into each other
+		const int32 Length = Text.Len();
+		Hasher.Update(&Length, sizeof(Length));
+		Hasher.Update(*Text, Length * sizeof(TCHAR));
+	}
+
+	void UpdateHash(FBlake3& Hasher, const FBlake3Hash& Hash)
+	{
+		Hasher.Update(Hash.GetBytes(), sizeof(FBlake3Hash::ByteArray));
+	}
+
+	template <typename ValueType>
+	FString ToHex(const ValueType& Value)
+	{
+		return BytesToHex(reinterpret_cast<const uint8*>(&Value), sizeof(ValueType));
+	}
+
+	bool IsConnectionStruct(const FProperty* Property)
+	{
+		// FExpressionInput and the typed material inputs, connections are hashed through the expressions they point to
+		const FStructProperty* StructProperty = CastField<FStructProperty>(Property);
+		return StructProperty && StructProperty->Struct->GetName().EndsWith(TEXT("Input"));
+	}
+
+	bool IsGuid(const FProperty* Property)
+	{
+		const FStructProperty* StructProperty = CastField<FStructProperty>(Property);
+		return StructProperty && StructProperty->Struct == TBaseStructure<FGuid>::Get();
+	}
+
+	// Function call inputs, custom node inputs and the like wrap a connection, exporting them as text would
+	// hash the path of the expression connected
+	bool HoldsConnection(const UStruct* Struct)
+	{
+		for (TFieldIterator<FProperty> PropertyIt(Struct); PropertyIt; ++PropertyIt)
+		{
+			if (IsConnectionStruct(*PropertyIt)) return true;
+
+			const FStructProperty* StructProperty = CastField<FStructProperty>(*PropertyIt);
+			if (StructProperty && HoldsConnection(StructProperty->Struct)) return true;
+		}
+		return false;
+	}
+
+	// Editor and import state every material and instance has its own copy of
+	bool IsMaterialInterfaceEditorState(const FProperty* Property)
+	{
+		static const TSet<FName> EditorStateProperties = {
+			TEXT("AssetImportData"), TEXT("ThumbnailInfo"), TEXT("PreviewMesh"), TEXT("AssetUserData"),
+			TEXT("TextureStreamingData"), TEXT("bTextureStreamingDataSorted"), TEXT("TextureStreamingDataVersion"), TEXT("ReferencedTextureGuids"),
+			TEXT("bIncludedInBaseGame")
+		};
+		return IsGuid(Property) || EditorStateProperties.Contains(Property->GetFName());
+	}
+
+	int32 CountReferencers(const IAssetRegistry& AssetRegistry, const FAssetData& AssetData)
+	{
+		TArray<FName> Referencers;
+		AssetRegistry.GetReferencers(AssetData.PackageName, Referencers);
+		return Referencers.Num();
+	}
+
+	// Calls back for every scalar, vector and texture parameter whose default differs between the two materials
+	int32 ForEachChangedDefault(const UMaterial* CanonicalMaterial, const UMaterial* DuplicateMaterial,
+		TFunctionRef<void(EMaterialParameterType, const FMaterialParameterInfo&, const FMaterialParameterValue&)> Callback)
+	{
+		int32 ChangedCount = 0;
+		for (const EMaterialParameterType ParameterType : OverridableParameterTypes)
+		{
+			TArray<FMaterialParameterInfo> ParameterInfos;
+			TArray<FGuid> ParameterIds;
+			DuplicateMaterial->GetAllParameterInfoOfType(ParameterType, ParameterInfos, ParameterIds);
+
+			for (const FMaterialParameterInfo& ParameterInfo : ParameterInfos)
+			{
+				FMaterialParameterMetadata DuplicateValue;
+				FMaterialParameterMetadata CanonicalValue;
+				const FMemoryImageMaterialParameterInfo LookupInfo(ParameterInfo);
+				if (!DuplicateMaterial->GetParameterValue(ParameterType, LookupInfo, DuplicateValue)) continue;
+				if (CanonicalMaterial->GetParameterValue(ParameterType, LookupInfo, CanonicalValue) && CanonicalValue.Value == DuplicateValue.Value) continue;
+
+				Callback(ParameterType, ParameterInfo, DuplicateValue.Value);
+				++ChangedCount;
+			}
+		}
+		return ChangedCount;
+	}
+
+	void AddGroups(const IAssetRegistry& AssetRegistry, const TMap<FBlake3Hash, TArray<const FAssetData*>>& AssetsByHash,
+		EMicroManagerMaterialDuplicateKind Kind, TArray<FMicroManagerMaterialDuplicateGroup>& OutGroups)
+	{
+		for (const TPair<FBlake3Hash, TArray<const FAssetData*>>& Pair : AssetsByHash)
+		{
+			if (Pair.Value.Num() < 2) continue;
+
+			// Keep the most referenced one so the fewest referencers have to be rewritten
+			TArray<TPair<int32, const FAssetData*>> Members;
+			for (const FAssetData* Member : Pair.Value)
+			{
+				Members.Emplace(CountReferencers(AssetRegistry, *Member), Member);
+			}
+			Members.Sort([](const TPair<int32, const FAssetData*>& A, const TPair<int32, const FAssetData*>& B)
+			{
+				return A.Key != B.Key ? A.Key > B.Key : A.Value->PackageName.LexicalLess(B.Value->PackageName);
+			});
+
+			FMicroManagerMaterialDuplicateGroup& Group = OutGroups.AddDefaulted_GetRef();
+			Group.Kind = Kind;
+			Group.Canonical = *Members[0].Value;
+			Group.CanonicalReferencerCount = Members[0].Key;
+			for (int32 MemberIndex = 1; MemberIndex < Members.Num(); ++MemberIndex)
+			{
+				Group.Duplicates.Add(*Members[MemberIndex].Value);
+				Group.DuplicateReferencerCounts.Add(Members[MemberIndex].Key);
+			}
+		}
+	}
+
+	void SortGroups(TArray<FMicroManagerMaterialDuplicateGroup>& Groups)
+	{
+		Groups.Sort([](const FMicroManagerMaterialDuplicateGroup& A, const FMicroManagerMaterialDuplicateGroup& B)
+		{
+			return A.Duplicates.Num() > B.Duplicates.Num();
+		});
+	}
+
+	// Same members whatever the referencer counts, to tell a regrouped set from one already reported
+	FString MakeGroupKey(const FMicroManagerMaterialDuplicateGroup& Group)
+	{
+		TArray<FString> MemberPaths = { Group.Canonical.GetObjectPathString() };
+		for (const FAssetData& Duplicate : Group.Duplicates)
+		{
+			MemberPaths.Add(Duplicate.GetObjectPathString());
+		}
+		MemberPaths.Sort();
+		return FString::Join(MemberPaths, TEXT("|"));
+	}
+
+	/**
+	 * Merkle hash of a material graph: an expression hashes what feeds it, so two graphs hash alike whatever
+	 * the names, positions and creation order of their nodes.
+	 */
+	class FMaterialGraphHasher
+	{
+	public:
+		FBlake3Hash HashExpression(const UMaterialExpression* Expression)
+		{
+			if (const FBlake3Hash* KnownHash = ExpressionHashes.Find(Expression))
+			{
+				return *KnownHash;
+			}
+
+			// Graphs are acyclic, a broken one still has to terminate
+			bool bAlreadyInProgress = false;
+			ExpressionsInProgress.Add(Expression, &bAlreadyInProgress);
+			if (bAlreadyInProgress) return FBlake3Hash();
+
+			FBlake3 Hasher;
+			UpdateString(Hasher, Expression->GetClass()->GetPathName());
+
+			const bool bIsValueParameter = Expression->IsA<UMaterialExpressionScalarParameter>() || Expression->IsA<UMaterialExpressionVectorParameter>();
+			const bool bIsTextureParameter = Expression->IsA<UMaterialExpressionTextureSampleParameter>();
+
+			HashProperties(Hasher, Expression->GetClass(), Expression, [bIsValueParameter, bIsTextureParameter](const FProperty* Property)
+			{
+				// The base class only holds editor state: position, description, guid, owning material
+				if (Property->GetOwnerClass() == UMaterialExpression::StaticClass()) return true;
+				if (IsConnectionStruct(Property) || IsGuid(Property)) return true;
+
+				const FName PropertyName = Property->GetFName();
+				if (PropertyName == TEXT("Group") || PropertyName == TEXT("SortPriority")) return true;
+
+				// Left to the instances to override
+				if (bIsValueParameter && PropertyName == TEXT("DefaultValue")) return true;
+				if (bIsTextureParameter && PropertyName == GET_MEMBER_NAME_CHECKED(UMaterialExpressionTextureBase, Texture)) return true;
+
+				return false;
+			});
+
+			for (FExpressionInputIterator InputIt{ const_cast<UMaterialExpression*>(Expression) }; InputIt; ++InputIt)
+			{
+				Hasher.Update(&InputIt.Index, sizeof(InputIt.Index));
+				HashInput(Hasher, *InputIt.Input);
+			}
+
+			const FBlake3Hash Hash = Hasher.Finalize();
+			ExpressionsInProgress.Remove(Expression);
+			ExpressionHashes.Add(Expression, Hash);
+			return Hash;
+		}
+
+		void HashInput(FBlake3& Hasher, const FExpressionInput& Input)
+		{
+			const int32 Connection[] = { Input.OutputIndex, Input.Mask, Input.MaskR, Input.MaskG, Input.MaskB, Input.MaskA };
+			const bool bIsConnected = Input.Expression != nullptr;
+			Hasher.Update(&bIsConnected, sizeof(bIsConnected));
+			if (!bIsConnected) return;
+
+			Hasher.Update(Connection, sizeof(Connection));
+			UpdateHash(Hasher, HashExpression(Input.Expression));
+		}
+
+		void HashProperties(FBlake3& Hasher, const UStruct* Struct, const void* Container, TFunctionRef<bool(const FProperty*)> ShouldSkip)
+		{
+			for (TFieldIterator<FProperty> PropertyIt(Struct); PropertyIt; ++PropertyIt)
+			{
+				const FProperty* Property = *PropertyIt;
+				if (Property->HasAnyPropertyFlags(CPF_Transient | CPF_DuplicateTransient | CPF_NonPIEDuplicateTransient | CPF_Deprecated)) continue;
+				if (ShouldSkip(Property)) continue;
+
+				UpdateString(Hasher, Property->GetName());
+				for (int32 ArrayIndex = 0; ArrayIndex < Property->ArrayDim; ++ArrayIndex)
+				{
+					HashValue(Hasher, Property, Property->ContainerPtrToValuePtr<void>(Container, ArrayIndex));
+				}
+			}
+		}
+
+	private:
+		void HashValue(FBlake3& Hasher, const FProperty* Property, const void* Value)
+		{
+			if (const FObjectPropertyBase* ObjectProperty = CastField<FObjectPropertyBase>(Property))
+			{
+				// Named reroutes and the like point at other expressions, whose names mean nothing
+				const UObject* Object = ObjectProperty->GetObjectPropertyValue(Value);
+				if (const UMaterialExpression* ReferencedExpression = Cast<UMaterialExpression>(Object))
+				{
+					UpdateHash(Hasher, HashExpression(ReferencedExpression));
+				}
+				else
+				{
+					UpdateString(Hasher, Object ? Object->GetPathName() : FString());
+				}
+				return;
+			}
+
+			if (const FStructProperty* StructProperty = CastField<FStructProperty>(Property))
+			{
+				// Hashed through the expression connected and its output, like the inputs of the expression itself
+				if (IsConnectionStruct(StructProperty))
+				{
+					HashInput(Hasher, *static_cast<const FExpressionInput*>(Value));
+					return;
+				}
+
+				if (HoldsConnection(StructProperty->Struct))
+				{
+					HashProperties(Hasher, StructProperty->Struct, Value, &IsGuid);
+					return;
+				}
+			}
+
+			if (const FArrayProperty* ArrayProperty = CastField<FArrayProperty>(Property))
+			{
+				const FStructProperty* InnerStruct = CastField<FStructProperty>(ArrayProperty->Inner);
+				if (InnerStruct && (IsConnectionStruct(InnerStruct) || HoldsConnection(InnerStruct->Struct)))
+				{
+					FScriptArrayHelper ArrayHelper(ArrayProperty, Value);
+					const int32 Num = ArrayHelper.Num();
+					Hasher.Update(&Num, sizeof(Num));
+					for (int32 ElementIndex = 0; ElementIndex < Num; ++ElementIndex)
+					{
+						HashValue(Hasher, ArrayProperty->Inner, ArrayHelper.GetRawPtr(ElementIndex));
+					}
+					return;
+				}
+			}
+
+			FString ValueText;
+			Property->ExportTextItem_Direct(ValueText, Value, nullptr, nullptr, PPF_None);
+			UpdateString(Hasher, ValueText);
+		}
+
+		TMap<const UMaterialExpression*, FBlake3Hash> ExpressionHashes;
+		TSet<const UMaterialExpression*> ExpressionsInProgress;
+	};
+}
+
+FBlake3Hash FMicroManagerMaterialDuplicates::HashMaterial(UMaterial* Material)
+{
+	FMaterialGraphHasher GraphHasher;
+	FBlake3 Hasher;
+
+	// Subsurface profile and lightmass settings of any material
+	GraphHasher.HashProperties(Hasher, UMaterialInterface::StaticClass(), Material, &IsMaterialInterfaceEditorState);
+
+	// Blend mode, shading model, usage flags and every other setting of the material itself
+	GraphHasher.HashProperties(Hasher, UMaterial::StaticClass(), Material, [](const FProperty* Property)
+	{
+		if (Property->GetOwnerClass() != UMaterial::StaticClass()) return true;
+		if (IsConnectionStruct(Property) || IsGuid(Property)) return true;
+
+		static const TSet<FName> EditorStateProperties = {
+			TEXT("ExpressionCollection"), TEXT("ParameterGroupData"), TEXT("EditorX"), TEXT("EditorY"), TEXT("EditorPitch"), TEXT("EditorYaw")
+		};
+		return EditorStateProperties.Contains(Property->GetFName());
+	});
+
+	// The outputs are the roots, anything not reaching one doesn't make it into a shader
+	for (int32 PropertyIndex = 0; PropertyIndex < MP_MAX; ++PropertyIndex)
+	{
+		const FExpressionInput* Input = Material->GetExpressionInputForProperty(static_cast<EMaterialProperty>(PropertyIndex));
+		if (!Input || !Input->Expression) continue;
+
+		Hasher.Update(&PropertyIndex, sizeof(PropertyIndex));
+		GraphHasher.HashInput(Hasher, *Input);
+	}
+
+	// Custom outputs are roots too, sorted since their order in the graph means nothing
+	TArray<FString> CustomOutputHashes;
+	for (const UMaterialExpression* Expression : Material->GetExpressions())
+	{
+		if (Expression && Expression->IsA<UMaterialExpressionCustomOutput>())
+		{
+			const FBlake3Hash CustomOutputHash = GraphHasher.HashExpression(Expression);
+			CustomOutputHashes.Add(BytesToHex(CustomOutputHash.GetBytes(), sizeof(FBlake3Hash::ByteArray)));
+		}
+	}
+	CustomOutputHashes.Sort();
+	for (const FString& CustomOutputHash : CustomOutputHashes)
+	{
+		UpdateString(Hasher, CustomOutputHash);
+	}
+
+	return Hasher.Finalize();
+}
+
+bool FMicroManagerMaterialDuplicates::HashMaterialInstance(const UMaterialInstanceConstant* MaterialInstance, FBlake3Hash& OutHash)
+{
+	FBlake3 Hasher;
+	UpdateString(Hasher, MaterialInstance->Parent ? MaterialInstance->Parent->GetPathName() : FString());
+
+	// One line per override, sorted so the order they were set in doesn't matter
+	TArray<FString> Overrides;
+	for (int32 TypeIndex = 0; TypeIndex < NumMaterialParameterTypes; ++TypeIndex)
+	{
+		const EMaterialParameterType ParameterType = static_cast<EMaterialParameterType>(TypeIndex);
+
+		TArray<FMaterialParameterInfo> ParameterInfos;
+		TArray<FGuid> ParameterIds;
+		MaterialInstance->GetAllParameterInfoOfType(ParameterType, ParameterInfos, ParameterIds);
+
+		for (const FMaterialParameterInfo& ParameterInfo : ParameterInfos)
+		{
+			FMaterialParameterMetadata Metadata;
+			if (!MaterialInstance->GetParameterValue(ParameterType, FMemoryImageMaterialParameterInfo(ParameterInfo), Metadata, EMaterialGetParameterValueFlags::CheckInstanceOverrides)) continue;
+
+			const FMaterialParameterValue& Value = Metadata.Value;
+			FString ValueText;
+			switch (ParameterType)
+			{
+			case EMaterialParameterType::Scalar: ValueText = ToHex(Value.AsScalar()); break;
+			case EMaterialParameterType::Vector: ValueText = ToHex(Value.AsLinearColor()); break;
+			case EMaterialParameterType::DoubleVector: ValueText = ToHex(Value.AsVector4d()); break;
+			case EMaterialParameterType::StaticSwitch: ValueText = Value.AsStaticSwitch() ? TEXT("1") : TEXT("0"); break;
+			case EMaterialParameterType::StaticComponentMask:
+				{
+					const FStaticComponentMaskValue Mask = Value.AsStaticComponentMask();
+					ValueText = FString::Printf(TEXT("%d%d%d%d"), Mask.R, Mask.G, Mask.B, Mask.A);
+					break;
+				}
+			case EMaterialParameterType::Texture:
+				ValueText = Value.AsTextureObject() ? Value.AsTextureObject()->GetPathName() : FString();
+				break;
+			default:
+				// Fonts and virtual textures, rare enough to leave such an instance out
+				return false;
+			}
+
+			Overrides.Add(FString::Printf(TEXT("%d|%s|%d|%d|%s"), TypeIndex, *ParameterInfo.Name.ToString(),
+				static_cast<int32>(ParameterInfo.Association), ParameterInfo.Index, *ValueText));
+		}
+	}
+
+	Overrides.Sort();
+	for (const FString& Override : Overrides)
+	{
+		UpdateString(Hasher, Override);
+	}
+
+	// Blend mode, two sided and the other base property overrides
+	FMaterialGraphHasher PropertyHasher;
+	PropertyHasher.HashProperties(Hasher, FMaterialInstanceBasePropertyOverrides::StaticStruct(), &MaterialInstance->BasePropertyOverrides,
+		[](const FProperty*) { return false; });
+
+	// Subsurface profile and lightmass settings, the instance may override either
+	PropertyHasher.HashProperties(Hasher, UMaterialInterface::StaticClass(), MaterialInstance, &IsMaterialInterfaceEditorState);
+
+	OutHash = Hasher.Finalize();
+	return true;
+}
+
+bool FMicroManagerMaterialDuplicates::FindDuplicateGroups(const TArray<TSharedPtr<FAssetData>>& AssetsData, TArray<FMicroManagerMaterialDuplicateGroup>& OutGroups)
+{
+	OutGroups.Reset();
+
+	const FTopLevelAssetPath MaterialClassPath = UMaterial::StaticClass()->GetClassPathName();
+	const FTopLevelAssetPath MaterialInstanceClassPath = UMaterialInstanceConstant::StaticClass()->GetClassPathName();
+
+	TArray<const FAssetData*> Candidates;
+	for (const TSharedPtr<FAssetData>& AssetData : AssetsData)
+	{
+		if (AssetData.IsValid() && (AssetData->AssetClassPath == MaterialClassPath || AssetData->AssetClassPath == MaterialInstanceClassPath))
+		{
+			Candidates.Add(AssetData.Get());
+		}
+	}
+
+	TMap<FBlake3Hash, TArray<const FAssetData*>> MaterialsByHash;
+	TMap<FBlake3Hash, TArray<const FAssetData*>> MaterialInstancesByHash;
+	{
+		FScopedSlowTask SlowTask(Candidates.Num(), FText::FromString(TEXT("Hashing materials...")));
+		SlowTask.MakeDialog(true);
+
+		for (const FAssetData* Candidate : Candidates)
+		{
+			if (SlowTask.ShouldCancel()) return false;
+			SlowTask.EnterProgressFrame(1.f, FText::FromName(Candidate->AssetName));
+
+			UObject* Asset = Candidate->GetAsset();
+			if (UMaterial* Material = Cast<UMaterial>(Asset))
+			{
+				MaterialsByHash.FindOrAdd(HashMaterial(Material)).Add(Candidate);
+			}
+			else if (const UMaterialInstanceConstant* MaterialInstance = Cast<UMaterialInstanceConstant>(Asset))
+			{
+				FBlake3Hash InstanceHash;
+				if (HashMaterialInstance(MaterialInstance, InstanceHash))
+				{
+					MaterialInstancesByHash.FindOrAdd(InstanceHash).Add(Candidate);
+				}
+			}
+		}
+	}
+
+	const IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+
+	AddGroups(AssetRegistry, MaterialsByHash, EMicroManagerMaterialDuplicateKind::Material, OutGroups);
+	AddGroups(AssetRegistry, MaterialInstancesByHash, EMicroManagerMaterialDuplicateKind::MaterialInstance, OutGroups);
+	SortGroups(OutGroups);
+
+	return true;
+}
+
+void FMicroManagerMaterialDuplicates::FindDuplicateInstanceGroups(const TArray<FAssetData>& InstanceCandidates, TArray<FMicroManagerMaterialDuplicateGroup>& OutGroups)
+{
+	OutGroups.Reset();
+
+	TMap<FBlake3Hash, TArray<const FAssetData*>> MaterialInstancesByHash;
+	for (const FAssetData& Candidate : InstanceCandidates)
+	{
+		// Consolidated instances only exist as a redirector now, loading them would land on the instance kept instead
+		const UMaterialInstanceConstant* MaterialInstance = Cast<UMaterialInstanceConstant>(Candidate.FastGetAsset(false));
+		if (!MaterialInstance || MaterialInstance->GetPathName() != Candidate.GetObjectPathString()) continue;
+
+		FBlake3Hash InstanceHash;
+		if (HashMaterialInstance(MaterialInstance, InstanceHash))
+		{
+			MaterialInstancesByHash.FindOrAdd(InstanceHash).Add(&Candidate);
+		}
+	}
+
+	const IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+	AddGroups(AssetRegistry, MaterialInstancesByHash, EMicroManagerMaterialDuplicateKind::MaterialInstance, OutGroups);
+	SortGroups(OutGroups);
+}
+
+int32 FMicroManagerMaterialDuplicates::ConsolidateGroup(const FMicroManagerMaterialDuplicateGroup& Group)
+{
+	UMaterialInterface* Canonical = Cast<UMaterialInterface>(Group.Canonical.GetAsset());
+	if (!Canonical) return 0;
+
+	const IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+
+	// The redirectors, the new instances and the referencers rewritten, saved together once the group is done
+	TArray<UPackage*> PackagesToSave;
+	TSet<FName> ReferencerNames;
+
+	int32 ConsolidatedCount = 0;
+	for (const FAssetData& DuplicateData : Group.Duplicates)
+	{
+		UMaterialInterface* Duplicate = Cast<UMaterialInterface>(DuplicateData.GetAsset());
+		if (!Duplicate) continue;
+
+		// Read before consolidating, the registry then lists the referencers under the kept asset
+		TArray<FName> DuplicateReferencers;
+		AssetRegistry.GetReferencers(DuplicateData.PackageName, DuplicateReferencers);
+
+		UMaterialInterface* Replacement = Canonical;
+
+		UMaterial* CanonicalMaterial = Cast<UMaterial>(Canonical);
+		UMaterial* DuplicateMaterial = Cast<UMaterial>(Duplicate);
+		if (CanonicalMaterial && DuplicateMaterial
+			&& ForEachChangedDefault(CanonicalMaterial, DuplicateMaterial, [](EMaterialParameterType, const FMaterialParameterInfo&, const FMaterialParameterValue&) {}) > 0)
+		{
+			Replacement = CreateReplacementInstance(CanonicalMaterial, DuplicateMaterial);
+			if (!Replacement)
+			{
+				DebugHelper::PrintLog(TEXT("Failed to create an instance replacing ") + DuplicateData.GetObjectPathString());
+				continue;
+			}
+		}
+
+		if (ConsolidateInto(Replacement, Duplicate))
+		{
+			++ConsolidatedCount;
+			ReferencerNames.Append(DuplicateReferencers);
+			PackagesToSave.AddUnique(Replacement->GetOutermost());
+			if (UPackage* RedirectorPackage = FindPackage(nullptr, *DuplicateData.PackageName.ToString()))
+			{
+				PackagesToSave.AddUnique(RedirectorPackage);
+			}
+		}
+	}
+
+	// Referencers left unloaded still point at the redirectors, only the loaded ones were rewritten
+	for (const FName ReferencerName : ReferencerNames)
+	{
+		UPackage* ReferencerPackage = FindPackage(nullptr, *ReferencerName.ToString());
+		if (ReferencerPackage && ReferencerPackage->IsDirty())
+		{
+			PackagesToSave.AddUnique(ReferencerPackage);
+		}
+	}
+
+	if (PackagesToSave.Num() > 0)
+	{
+		UEditorLoadingAndSavingUtils::SavePackages(PackagesToSave, false);
+	}
+
+	return ConsolidatedCount;
+}
+
+UMaterialInstanceConstant* FMicroManagerMaterialDuplicates::CreateReplacementInstance(UMaterial* CanonicalMaterial, UMaterial* DuplicateMaterial)
+{
+	FString InstanceName = DuplicateMaterial->GetName();
+	InstanceName.RemoveFromStart(TEXT("M_"));
+	InstanceName.InsertAt(0, TEXT("MI_"));
+
+	FAssetToolsModule& AssetToolsModule = FModuleManager::LoadModuleChecked<FAssetToolsModule>(TEXT("AssetTools"));
+
+	FString UniquePackageName;
+	FString UniqueAssetName;
+	AssetToolsModule.Get().CreateUniqueAssetName(
+		FPackageName::GetLongPackagePath(DuplicateMaterial->GetOutermost()->GetName()) / InstanceName, TEXT(""), UniquePackageName, UniqueAssetName);
+
+	UMaterialInstanceConstantFactoryNew* MIFactoryNew = NewObject<UMaterialInstanceConstantFactoryNew>();
+	MIFactoryNew->InitialParent = CanonicalMaterial;
+
+	UMaterialInstanceConstant* CreatedMI = Cast<UMaterialInstanceConstant>(AssetToolsModule.Get().CreateAsset(
+		UniqueAssetName, FPackageName::GetLongPackagePath(UniquePackageName), UMaterialInstanceConstant::StaticClass(), MIFactoryNew));
+	if (!CreatedMI) return nullptr;
+
+	ForEachChangedDefault(CanonicalMaterial, DuplicateMaterial,
+		[CreatedMI](EMaterialParameterType ParameterType, const FMaterialParameterInfo& ParameterInfo, const FMaterialParameterValue& Value)
+		{
+			switch (ParameterType)
+			{
+			case EMaterialParameterType::Scalar: CreatedMI->SetScalarParameterValueEditorOnly(ParameterInfo, Value.AsScalar()); break;
+			case EMaterialParameterType::Vector: CreatedMI->SetVectorParameterValueEditorOnly(ParameterInfo, Value.AsLinearColor()); break;
+			case EMaterialParameterType::Texture: CreatedMI->SetTextureParameterValueEditorOnly(ParameterInfo, Value.AsTextureObject()); break;
+			default: break;
+			}
+		});
+
+	CreatedMI->PostEditChange();
+	return CreatedMI;
+}
+
+bool FMicroManagerMaterialDuplicates::ConsolidateInto(UMaterialInterface* Canonical, UMaterialInterface* Duplicate)
+{
+	TArray<UObject*> ObjectsToConsolidate = { Duplicate };
+	const ObjectTools::FConsolidationResults Results = ObjectTools::ConsolidateObjects(Canonical, ObjectsToConsolidate, false);
+
+	if (Results.FailedConsolidationObjs.Num() > 0 || Results.InvalidConsolidationObjs.Num() > 0)
+	{
+		DebugHelper::PrintLog(FString::Printf(TEXT("Failed to consolidate %s into %s"), *Duplicate->GetPathName(), *Canonical->GetPathName()));
+		return false;
+	}
+	return true;
+}
+
+const TCHAR* FMicroManagerMaterialDuplicates::LexToString(EMicroManagerMaterialDuplicateKind Kind)
+{
+	switch (Kind)
+	{
+	case EMicroManagerMaterialDuplicateKind::MaterialInstance: return TEXT("Material Instance");
+	default: return TEXT("Material");
+	}
+}
+
+void FMicroManagerMaterialDuplicates::RunAndShowReport(const TArray<TSharedPtr<FAssetData>>& AssetsData)
+{
+	TArray<FMicroManagerMaterialDuplicateGroup> Groups;
+	if (!FindDuplicateGroups(AssetsData, Groups)) return;
+
+	if (Groups.Num() == 0)
+	{
+		DebugHelper::ShowMsgDialog(EAppMsgType::Ok, TEXT("No duplicate material nor material instance found under the selected folders"), false);
+		return;
+	}
+
+	// Instances are hashed again once a material group is consolidated, their parents may then match
+	TSharedRef<FReportContext> Context = MakeShared<FReportContext>();
+	const FTopLevelAssetPath MaterialInstanceClassPath = UMaterialInstanceConstant::StaticClass()->GetClassPathName();
+	for (const TSharedPtr<FAssetData>& AssetData : AssetsData)
+	{
+		if (AssetData.IsValid() && AssetData->AssetClassPath == MaterialInstanceClassPath)
+		{
+			Context->InstanceCandidates.Add(*AssetData);
+		}
+	}
+
+	ShowGroupsReport(TEXT("Duplicate Materials"), Groups, Context);
+}
+
+void FMicroManagerMaterialDuplicates::ShowGroupsReport(const FString& Title, const TArray<FMicroManagerMaterialDuplicateGroup>& Groups,
+	TSharedRef<FReportContext> Context)
+{
+	TArray<TSharedPtr<FMicroManagerReportRow>> Rows;
+	int32 DuplicateMaterialCount = 0;
+	int32 DuplicateInstanceCount = 0;
+
+	for (const FMicroManagerMaterialDuplicateGroup& Group : Groups)
+	{
+		Context->ReportedGroupKeys.Add(MakeGroupKey(Group));
+
+		TSharedPtr<FMicroManagerReportRow> GroupRow = MakeShared<FMicroManagerReportRow>();
+		GroupRow->SetText(MaterialDuplicateColumns::Name, Group.Canonical.PackageName.ToString());
+		GroupRow->SetText(MaterialDuplicateColumns::Kind, LexToString(Group.Kind));
+		GroupRow->SetValue(MaterialDuplicateColumns::Duplicates, Group.Duplicates.Num(), FString::FromInt(Group.Duplicates.Num()));
+		GroupRow->SetValue(MaterialDuplicateColumns::Referencers, Group.CanonicalReferencerCount, FString::FromInt(Group.CanonicalReferencerCount));
+		GroupRow->AssetPath = Group.Canonical.GetSoftObjectPath();
+
+		// In Duplicates order, the report sorts the children in place
+		TArray<TWeakPtr<FMicroManagerReportRow>> DuplicateRows;
+
+		for (int32 DuplicateIndex = 0; DuplicateIndex < Group.Duplicates.Num(); ++DuplicateIndex)
+		{
+			const int32 ReferencerCount = Group.DuplicateReferencerCounts[DuplicateIndex];
+
+			TSharedPtr<FMicroManagerReportRow> DuplicateRow = MakeShared<FMicroManagerReportRow>();
+			DuplicateRow->SetText(MaterialDuplicateColumns::Name, Group.Duplicates[DuplicateIndex].PackageName.ToString());
+			DuplicateRow->SetText(MaterialDuplicateColumns::Kind, TEXT("Duplicate"));
+			DuplicateRow->SetValue(MaterialDuplicateColumns::Referencers, ReferencerCount, FString::FromInt(ReferencerCount));
+			DuplicateRow->AssetPath = Group.Duplicates[DuplicateIndex].GetSoftObjectPath();
+
+			// A false positive is left out by consolidating the other duplicates one by one
+			FMicroManagerMaterialDuplicateGroup SingleDuplicateGroup;
+			SingleDuplicateGroup.Kind = Group.Kind;
+			SingleDuplicateGroup.Canonical = Group.Canonical;
+			SingleDuplicateGroup.Duplicates.Add(Group.Duplicates[DuplicateIndex]);
+			SingleDuplicateGroup.DuplicateReferencerCounts.Add(ReferencerCount);
+
+			DuplicateRow->ActionLabel = TEXT("Consolidate");
+			DuplicateRow->OnAction.BindLambda([SingleDuplicateGroup, Context]()
+			{
+				return ConsolidateFromReport(SingleDuplicateGroup, Context);
+			});
+			GroupRow->Children.Add(DuplicateRow);
+			DuplicateRows.Add(DuplicateRow);
+		}
+
+		GroupRow->ActionLabel = TEXT("Consolidate All");
+		GroupRow->OnAction.BindLambda([Group, DuplicateRows, Context]()
+		{
+			// Duplicates already consolidated on their own row are redirectors by now
+			FMicroManagerMaterialDuplicateGroup RemainingGroup = Group;
+			RemainingGroup.Duplicates.Reset();
+			RemainingGroup.DuplicateReferencerCounts.Reset();
+			for (int32 DuplicateIndex = 0; DuplicateIndex < Group.Duplicates.Num(); ++DuplicateIndex)
+			{
+				const TSharedPtr<FMicroManagerReportRow> DuplicateRow = DuplicateRows[DuplicateIndex].Pin();
+				if (DuplicateRow.IsValid() && !DuplicateRow->bIsActionDone)
+				{
+					RemainingGroup.Duplicates.Add(Group.Duplicates[DuplicateIndex]);
+					RemainingGroup.DuplicateReferencerCounts.Add(Group.DuplicateReferencerCounts[DuplicateIndex]);
+				}
+			}
+
+			if (!ConsolidateFromReport(RemainingGroup, Context)) return false;
+
+			for (const TWeakPtr<FMicroManagerReportRow>& WeakDuplicateRow : DuplicateRows)
+			{
+				if (const TSharedPtr<FMicroManagerReportRow> DuplicateRow = WeakDuplicateRow.Pin())
+				{
+					DuplicateRow->bIsActionDone = true;
+				}
+			}
+			return true;
+		});
+
+		if (Group.Kind == EMicroManagerMaterialDuplicateKind::Material)
+		{
+			DuplicateMaterialCount += Group.Duplicates.Num();
+		}
+		else
+		{
+			DuplicateInstanceCount += Group.Duplicates.Num();
+		}
+		Rows.Add(GroupRow);
+	}
+
+	const FString Summary = FString::Printf(
+		TEXT("%d duplicate materials and %d duplicate material instances in %d groups.\nEach group keeps its most referenced asset, expand it to see the duplicates. ")
+		TEXT("Consolidate a whole group or single duplicates, references are redirected and duplicate materials with other parameter defaults become instances of the kept material."),
+		DuplicateMaterialCount, DuplicateInstanceCount, Groups.Num());
+
+	SMicroManagerReportView::OpenInWindow(Title, Summary,
+	{
+		{ MaterialDuplicateColumns::Name, TEXT("Kept / Duplicate"), 0.5f, false },
+		{ MaterialDuplicateColumns::Kind, TEXT("Kind"), 0.14f, false },
+		{ MaterialDuplicateColumns::Duplicates, TEXT("Duplicates"), 0.12f, true },
+		{ MaterialDuplicateColumns::Referencers, TEXT("Referencers"), 0.12f, true },
+	}, Rows, MaterialDuplicateColumns::Duplicates);
+}
+
+bool FMicroManagerMaterialDuplicates::ConsolidateFromReport(const FMicroManagerMaterialDuplicateGroup& Group, TSharedRef<FReportContext> Context)
+{
+	if (Group.Duplicates.Num() == 0) return true;
+
+	const EAppReturnType::Type ConfirmResult = DebugHelper::ShowMsgDialog(EAppMsgType::YesNo, FString::Printf(
+		TEXT("Consolidate %d duplicate(s) into %s?\nReferences are redirected, this can't be undone."),
+		Group.Duplicates.Num(), *Group.Canonical.PackageName.ToString()), false);
+	if (ConfirmResult != EAppReturnType::Yes) return false;
+
+	const int32 ConsolidatedCount = ConsolidateGroup(Group);
+	DebugHelper::ShowNotifyInfo(FString::Printf(TEXT("Consolidated %d duplicates and saved the assets referencing them"), ConsolidatedCount));
+
+	if (Group.Kind == EMicroManagerMaterialDuplicateKind::Material && ConsolidatedCount > 0)
+	{
+		// Instances of the consolidated materials now share a parent, some may have become duplicates
+		TArray<FMicroManagerMaterialDuplicateGroup> InstanceGroups;
+		FindDuplicateInstanceGroups(Context->InstanceCandidates, InstanceGroups);
+		InstanceGroups.RemoveAll([&Context](const FMicroManagerMaterialDuplicateGroup& InstanceGroup)
+		{
+			return Context->ReportedGroupKeys.Contains(MakeGroupKey(InstanceGroup));
+		});
+
+		if (InstanceGroups.Num() > 0)
+		{
+			ShowGroupsReport(TEXT("Duplicate Material Instances After Consolidation"), InstanceGroups, Context);
+		}
+	}
+
+	return ConsolidatedCount == Group.Duplicates.Num();
+}
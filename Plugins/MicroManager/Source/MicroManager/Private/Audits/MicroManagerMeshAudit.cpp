@@ -0,0 +1,345 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Audits/MicroManagerMeshAudit.h"
+#include "Audits/MicroManagerAuditBudget.h"
+#include "DebugHelper.h"
+#include "Engine/StaticMesh.h"
+#include "FileHelpers.h"
+#include "Misc/ScopedSlowTask.h"
+#include "PhysicsEngine/BodySetup.h"
+#include "SlateWidgets/MicroManagerReportWidget.h"
+
+namespace MeshAuditColumns
+{
+	static const FName Name(TEXT("Name"));
+	static const FName Triangles(TEXT("Triangles"));
+	static const FName Vertices(TEXT("Vertices"));
+	static const FName LODs(TEXT("LODs"));
+	static const FName Nanite(TEXT("Nanite"));
+	static const FName Collision(TEXT("Collision"));
+	static const FName LightMap(TEXT("LightMap"));
+	static const FName Issues(TEXT("Issues"));
+}
+
+namespace
+{
+	// False when the mesh was saved before the tag existed, or the tag couldn't be parsed
+	bool ReadTags(const FAssetData& AssetData, FMicroManagerMeshAuditEntry& Entry)
+	{
+		bool bHasAllTags = AssetData.GetTagValue(TEXT("Triangles"), Entry.Triangles);
+		bHasAllTags &= AssetData.GetTagValue(TEXT("Vertices"), Entry.Vertices);
+		bHasAllTags &= AssetData.GetTagValue(TEXT("LODs"), Entry.NumLODs);
+		bHasAllTags &= AssetData.GetTagValue(TEXT("NaniteEnabled"), Entry.bNaniteEnabled);
+		bHasAllTags &= AssetData.GetTagValue(TEXT("LightMapResolution"), Entry.LightMapResolution);
+
+		FString CollisionComplexity;
+		if (AssetData.GetTagValue(TEXT("CollisionComplexity"), CollisionComplexity))
+		{
+			const int64 TraceFlag = StaticEnum<ECollisionTraceFlag>()->GetValueByNameString(CollisionComplexity);
+			if (TraceFlag != INDEX_NONE)
+			{
+				Entry.CollisionComplexity = static_cast<ECollisionTraceFlag>(TraceFlag);
+			}
+			else
+			{
+				// No body setup, the mesh has no collision at all
+				bHasAllTags &= CollisionComplexity.IsEmpty();
+			}
+		}
+		else
+		{
+			bHasAllTags = false;
+		}
+		return bHasAllTags;
+	}
+
+	void ReadLoadedMesh(const UStaticMesh* StaticMesh, FMicroManagerMeshAuditEntry& Entry)
+	{
+		Entry.Triangles = StaticMesh->GetNumTriangles(0);
+		Entry.Vertices = StaticMesh->GetNumVertices(0);
+		Entry.NumLODs = StaticMesh->GetNumLODs();
+		Entry.bNaniteEnabled = StaticMesh->IsNaniteEnabled();
+		Entry.LightMapResolution = StaticMesh->GetLightMapResolution();
+		if (const UBodySetup* BodySetup = StaticMesh->GetBodySetup())
+		{
+			Entry.CollisionComplexity = BodySetup->GetCollisionTraceFlag();
+		}
+	}
+
+	FString DescribeCollision(ECollisionTraceFlag CollisionComplexity)
+	{
+		FString CollisionName = LexToString(CollisionComplexity);
+		CollisionName.RemoveFromStart(TEXT("CTF_"));
+		return CollisionName;
+	}
+}
+
+FMicroManagerMeshBudget FMicroManagerMeshBudget::Load()
+{
+	FMicroManagerMeshBudget Budget;
+	FMicroManagerAuditBudget::Read(TEXT("MeshMaxTriangles"), Budget.MaxTriangles);
+	FMicroManagerAuditBudget::Read(TEXT("MeshMinTrianglesForLODs"), Budget.MinTrianglesForLODs);
+	FMicroManagerAuditBudget::Read(TEXT("MeshMaxComplexCollisionTriangles"), Budget.MaxComplexCollisionTriangles);
+	FMicroManagerAuditBudget::Read(TEXT("MeshMaxLightMapResolution"), Budget.MaxLightMapResolution);
+	FMicroManagerAuditBudget::Read(TEXT("MeshGeneratedLODCount"), Budget.GeneratedLODCount);
+	Budget.GeneratedLODCount = FMath::Clamp(Budget.GeneratedLODCount, 2, MAX_STATIC_MESH_LODS);
+	return Budget;
+}
+
+bool FMicroManagerMeshAudit::CollectEntries(const TArray<TSharedPtr<FAssetData>>& AssetsData, TArray<FMicroManagerMeshAuditEntry>& OutEntries)
+{
+	OutEntries.Reset();
+
+	const FTopLevelAssetPath StaticMeshClassPath = UStaticMesh::StaticClass()->GetClassPathName();
+	TArray<int32> EntriesMissingTags;
+	for (const TSharedPtr<FAssetData>& AssetData : AssetsData)
+	{
+		if (!AssetData.IsValid() || AssetData->AssetClassPath != StaticMeshClassPath) continue;
+
+		FMicroManagerMeshAuditEntry& Entry = OutEntries.AddDefaulted_GetRef();
+		Entry.AssetData = *AssetData;
+		if (!ReadTags(*AssetData, Entry))
+		{
+			EntriesMissingTags.Add(OutEntries.Num() - 1);
+		}
+	}
+
+	if (EntriesMissingTags.Num() > 0)
+	{
+		FScopedSlowTask SlowTask(EntriesMissingTags.Num(), FText::FromString(TEXT("Loading meshes saved without registry tags...")));
+		SlowTask.MakeDialog(true);
+
+		for (const int32 EntryIndex : EntriesMissingTags)
+		{
+			if (SlowTask.ShouldCancel()) return false;
+
+			FMicroManagerMeshAuditEntry& Entry = OutEntries[EntryIndex];
+			SlowTask.EnterProgressFrame(1.f, FText::FromName(Entry.AssetData.AssetName));
+
+			if (const UStaticMesh* StaticMesh = Cast<UStaticMesh>(Entry.AssetData.GetAsset()))
+			{
+				ReadLoadedMesh(StaticMesh, Entry);
+			}
+		}
+	}
+
+	return true;
+}
+
+bool FMicroManagerMeshAudit::NeedsNanite(const FMicroManagerMeshAuditEntry& Entry, const FMicroManagerMeshBudget& Budget)
+{
+	return !Entry.bNaniteEnabled && Entry.Triangles > Budget.MaxTriangles;
+}
+
+bool FMicroManagerMeshAudit::NeedsLODs(const FMicroManagerMeshAuditEntry& Entry, const FMicroManagerMeshBudget& Budget)
+{
+	return !Entry.bNaniteEnabled && Entry.NumLODs <= 1 && Entry.Triangles > Budget.MinTrianglesForLODs;
+}
+
+bool FMicroManagerMeshAudit::NeedsSimpleCollision(const FMicroManagerMeshAuditEntry& Entry, const FMicroManagerMeshBudget& Budget)
+{
+	return Entry.CollisionComplexity == CTF_UseComplexAsSimple && Entry.Triangles > Budget.MaxComplexCollisionTriangles;
+}
+
+TArray<FString> FMicroManagerMeshAudit::FindIssues(const FMicroManagerMeshAuditEntry& Entry, const FMicroManagerMeshBudget& Budget)
+{
+	TArray<FString> Issues;
+	if (NeedsNanite(Entry, Budget))
+	{
+		Issues.Add(FString::Printf(TEXT("%d triangles without Nanite"), Entry.Triangles));
+	}
+	if (NeedsLODs(Entry, Budget))
+	{
+		Issues.Add(TEXT("no LODs"));
+	}
+	if (NeedsSimpleCollision(Entry, Budget))
+	{
+		Issues.Add(TEXT("complex collision used as simple"));
+	}
+	if (Entry.LightMapResolution > Budget.MaxLightMapResolution)
+	{
+		Issues.Add(FString::Printf(TEXT("lightmap %d"), Entry.LightMapResolution));
+	}
+	return Issues;
+}
+
+void FMicroManagerMeshAudit::EnableNanite(UStaticMesh* StaticMesh)
+{
+	StaticMesh->Modify();
+	StaticMesh->NaniteSettings.bEnabled = true;
+}
+
+void FMicroManagerMeshAudit::SetupGeneratedLODs(UStaticMesh* StaticMesh, int32 LODCount)
+{
+	StaticMesh->Modify();
+	StaticMesh->SetNumSourceModels(LODCount);
+
+	// The new source models have no mesh description, the build reduces them from LOD 0
+	const FMeshBuildSettings& BaseBuildSettings = StaticMesh->GetSourceModel(0).BuildSettings;
+	for (int32 LODIndex = 1; LODIndex < LODCount; ++LODIndex)
+	{
+		FStaticMeshSourceModel& SourceModel = StaticMesh->GetSourceModel(LODIndex);
+		SourceModel.BuildSettings = BaseBuildSettings;
+		SourceModel.ReductionSettings.BaseLODModel = 0;
+		SourceModel.ReductionSettings.PercentTriangles = FMath::Pow(0.5f, LODIndex);
+	}
+	StaticMesh->bAutoComputeLODScreenSize = true;
+}
+
+void FMicroManagerMeshAudit::SimplifyCollision(UStaticMesh* StaticMesh)
+{
+	UBodySetup* BodySetup = StaticMesh->GetBodySetup();
+	if (!BodySetup) return;
+
+	BodySetup->PreEditChange(nullptr);
+	BodySetup->Modify();
+	if (BodySetup->AggGeom.GetElementCount() == 0)
+	{
+		const FBox Bounds = StaticMesh->GetBoundingBox();
+		const FVector Size = Bounds.GetSize();
+		FKBoxElem& BoxElem = BodySetup->AggGeom.BoxElems.Emplace_GetRef(Size.X, Size.Y, Size.Z);
+		BoxElem.Center = Bounds.GetCenter();
+	}
+
+	// Explicit, the project default may well be the complex as simple setting being fixed
+	BodySetup->CollisionTraceFlag = CTF_UseSimpleAndComplex;
+	BodySetup->InvalidatePhysicsData();
+	BodySetup->CreatePhysicsMeshes();
+	BodySetup->PostEditChange();
+}
+
+void FMicroManagerMeshAudit::RunAndShowReport(const TArray<TSharedPtr<FAssetData>>& AssetsData)
+{
+	TArray<FMicroManagerMeshAuditEntry> Entries;
+	if (!CollectEntries(AssetsData, Entries)) return;
+
+	if (Entries.Num() == 0)
+	{
+		DebugHelper::ShowMsgDialog(EAppMsgType::Ok, TEXT("No static mesh found under the selected folders"));
+		return;
+	}
+
+	const FMicroManagerMeshBudget Budget = FMicroManagerMeshBudget::Load();
+
+	TArray<TSharedPtr<FMicroManagerReportRow>> Rows;
+	TArray<const FMicroManagerMeshAuditEntry*> NaniteCandidates;
+	TArray<const FMicroManagerMeshAuditEntry*> LODCandidates;
+	TArray<const FMicroManagerMeshAuditEntry*> CollisionCandidates;
+	int32 OverBudgetCount = 0;
+
+	for (const FMicroManagerMeshAuditEntry& Entry : Entries)
+	{
+		const TArray<FString> Issues = FindIssues(Entry, Budget);
+		OverBudgetCount += Issues.Num() > 0 ? 1 : 0;
+
+		if (NeedsNanite(Entry, Budget)) NaniteCandidates.Add(&Entry);
+		if (NeedsLODs(Entry, Budget)) LODCandidates.Add(&Entry);
+		if (NeedsSimpleCollision(Entry, Budget)) CollisionCandidates.Add(&Entry);
+
+		TSharedPtr<FMicroManagerReportRow> Row = MakeShared<FMicroManagerReportRow>();
+		Row->SetText(MeshAuditColumns::Name, Entry.AssetData.PackageName.ToString());
+		Row->SetValue(MeshAuditColumns::Triangles, Entry.Triangles, FString::FromInt(Entry.Triangles));
+		Row->SetValue(MeshAuditColumns::Vertices, Entry.Vertices, FString::FromInt(Entry.Vertices));
+		Row->SetValue(MeshAuditColumns::LODs, Entry.NumLODs, FString::FromInt(Entry.NumLODs));
+		Row->SetText(MeshAuditColumns::Nanite, Entry.bNaniteEnabled ? TEXT("Yes") : TEXT("No"));
+		Row->SetText(MeshAuditColumns::Collision, DescribeCollision(Entry.CollisionComplexity));
+		Row->SetValue(MeshAuditColumns::LightMap, Entry.LightMapResolution, FString::FromInt(Entry.LightMapResolution));
+		Row->SetValue(MeshAuditColumns::Issues, Issues.Num(), FString::Join(Issues, TEXT("; ")));
+		Row->AssetPath = Entry.AssetData.GetSoftObjectPath();
+		Rows.Add(Row);
+	}
+
+	const FString Summary = FString::Printf(
+		TEXT("%d static meshes, %d over budget.\nBudgets: %d triangles without Nanite, LODs above %d triangles, complex collision up to %d triangles, lightmap %d. %s"),
+		Entries.Num(), OverBudgetCount, Budget.MaxTriangles, Budget.MinTrianglesForLODs,
+		Budget.MaxComplexCollisionTriangles, Budget.MaxLightMapResolution,
+		FMicroManagerAuditBudget::GetWhereToSetText());
+
+	SMicroManagerReportView::OpenInWindow(TEXT("Static Mesh Audit"), Summary,
+	{
+		{ MeshAuditColumns::Name, TEXT("Static Mesh"), 0.3f, false },
+		{ MeshAuditColumns::Triangles, TEXT("Triangles"), 0.08f, true },
+		{ MeshAuditColumns::Vertices, TEXT("Vertices"), 0.08f, true },
+		{ MeshAuditColumns::LODs, TEXT("LODs"), 0.05f, true },
+		{ MeshAuditColumns::Nanite, TEXT("Nanite"), 0.05f, false },
+		{ MeshAuditColumns::Collision, TEXT("Collision"), 0.12f, false },
+		{ MeshAuditColumns::LightMap, TEXT("Lightmap"), 0.07f, true },
+		{ MeshAuditColumns::Issues, TEXT("Over Budget"), 0.25f, true },
+	}, Rows, MeshAuditColumns::Issues);
+
+	const bool bEnableNanite = NaniteCandidates.Num() > 0 && DebugHelper::ShowMsgDialog(EAppMsgType::YesNo, FString::Printf(
+		TEXT("Enable Nanite on the %d meshes over %d triangles?"), NaniteCandidates.Num(), Budget.MaxTriangles), false) == EAppReturnType::Yes;
+	const bool bGenerateLODs = LODCandidates.Num() > 0 && DebugHelper::ShowMsgDialog(EAppMsgType::YesNo, FString::Printf(
+		TEXT("Generate %d LODs on the %d meshes without any?"), Budget.GeneratedLODCount, LODCandidates.Num()), false) == EAppReturnType::Yes;
+	const bool bSimplifyCollision = CollisionCandidates.Num() > 0 && DebugHelper::ShowMsgDialog(EAppMsgType::YesNo, FString::Printf(
+		TEXT("Use simple collision on the %d meshes using over %d triangles as collision?"), CollisionCandidates.Num(),
+		Budget.MaxComplexCollisionTriangles), false) == EAppReturnType::Yes;
+
+	if (!bEnableNanite && !bGenerateLODs && !bSimplifyCollision) return;
+
+	TArray<UStaticMesh*> MeshesToBuild;
+	TArray<UPackage*> PackagesToSave;
+	{
+		const int32 NumMeshesToLoad = (bEnableNanite ? NaniteCandidates.Num() : 0) + (bGenerateLODs ? LODCandidates.Num() : 0);
+		FScopedSlowTask SlowTask(NumMeshesToLoad, FText::FromString(TEXT("Updating mesh build settings...")));
+		SlowTask.MakeDialog();
+
+		if (bEnableNanite)
+		{
+			for (const FMicroManagerMeshAuditEntry* Entry : NaniteCandidates)
+			{
+				SlowTask.EnterProgressFrame(1.f, FText::FromName(Entry->AssetData.AssetName));
+				if (UStaticMesh* StaticMesh = Cast<UStaticMesh>(Entry->AssetData.GetAsset()))
+				{
+					EnableNanite(StaticMesh);
+					MeshesToBuild.AddUnique(StaticMesh);
+				}
+			}
+		}
+
+		if (bGenerateLODs)
+		{
+			for (const FMicroManagerMeshAuditEntry* Entry : LODCandidates)
+			{
+				SlowTask.EnterProgressFrame(1.f, FText::FromName(Entry->AssetData.AssetName));
+				UStaticMesh* StaticMesh = Cast<UStaticMesh>(Entry->AssetData.GetAsset());
+
+				// Nanite doesn't use the generated LODs, only its fallback mesh does
+				if (!StaticMesh || StaticMesh->IsNaniteEnabled()) continue;
+
+				SetupGeneratedLODs(StaticMesh, Budget.GeneratedLODCount);
+				MeshesToBuild.AddUnique(StaticMesh);
+			}
+		}
+	}
+
+	// Builds the meshes on worker threads, PostEditChange would build them one after the other
+	if (MeshesToBuild.Num() > 0)
+	{
+		UStaticMesh::BatchBuild(MeshesToBuild);
+		for (UStaticMesh* StaticMesh : MeshesToBuild)
+		{
+			PackagesToSave.AddUnique(StaticMesh->GetOutermost());
+		}
+	}
+
+	// Cooks the new physics data, after the build so it reads the final render data
+	if (bSimplifyCollision)
+	{
+		for (const FMicroManagerMeshAuditEntry* Entry : CollisionCandidates)
+		{
+			if (UStaticMesh* StaticMesh = Cast<UStaticMesh>(Entry->AssetData.GetAsset()))
+			{
+				SimplifyCollision(StaticMesh);
+				PackagesToSave.AddUnique(StaticMesh->GetOutermost());
+			}
+		}
+	}
+
+	if (PackagesToSave.Num() > 0)
+	{
+		UEditorLoadingAndSavingUtils::SavePackages(PackagesToSave, false);
+		DebugHelper::ShowNotifyInfo(FString::Printf(TEXT("Rebuilt %d and saved %d static meshes"), MeshesToBuild.Num(), PackagesToSave.Num()));
+	}
+}
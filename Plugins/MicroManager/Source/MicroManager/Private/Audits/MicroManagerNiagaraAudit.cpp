@@ -0,0 +1,251 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Audits/MicroManagerNiagaraAudit.h"
+#include "Algo/AllOf.h"
+#include "Algo/AnyOf.h"
+#include "Algo/Count.h"
+#include "Audits/MicroManagerAuditBudget.h"
+#include "DebugHelper.h"
+#include "Misc/ScopedSlowTask.h"
+#include "NiagaraEffectType.h"
+#include "NiagaraEmitter.h"
+#include "NiagaraEmitterHandle.h"
+#include "NiagaraSystem.h"
+#include "SlateWidgets/MicroManagerReportWidget.h"
+
+namespace NiagaraAuditColumns
+{
+	static const FName Name(TEXT("Name"));
+	static const FName Emitters(TEXT("Emitters"));
+	static const FName SimTarget(TEXT("SimTarget"));
+	static const FName MaxParticles(TEXT("MaxParticles"));
+	static const FName Bounds(TEXT("Bounds"));
+	static const FName Scalability(TEXT("Scalability"));
+	static const FName Warmup(TEXT("Warmup"));
+	static const FName Issues(TEXT("Issues"));
+}
+
+int32 FMicroManagerNiagaraAuditEntry::GetNumGPUEmitters() const
+{
+	return Algo::CountIf(Emitters, [](const FMicroManagerNiagaraEmitterEntry& Emitter) { return Emitter.bIsGPU; });
+}
+
+int32 FMicroManagerNiagaraAuditEntry::GetTotalMaxParticles() const
+{
+	int32 TotalMaxParticles = 0;
+	for (const FMicroManagerNiagaraEmitterEntry& Emitter : Emitters)
+	{
+		TotalMaxParticles += Emitter.MaxParticles;
+	}
+	return TotalMaxParticles;
+}
+
+bool FMicroManagerNiagaraAuditEntry::HasFixedBoundsEverywhere() const
+{
+	return bHasFixedBounds || Algo::AllOf(Emitters, [](const FMicroManagerNiagaraEmitterEntry& Emitter) { return Emitter.bHasFixedBounds; });
+}
+
+FMicroManagerNiagaraBudget FMicroManagerNiagaraBudget::Load()
+{
+	FMicroManagerNiagaraBudget Budget;
+	FMicroManagerAuditBudget::Read(TEXT("NiagaraMaxEmitters"), Budget.MaxEmitters);
+	FMicroManagerAuditBudget::Read(TEXT("NiagaraMaxParticles"), Budget.MaxParticles);
+	FMicroManagerAuditBudget::Read(TEXT("NiagaraMaxCPUEmitterParticles"), Budget.MaxCPUEmitterParticles);
+	FMicroManagerAuditBudget::Read(TEXT("NiagaraMaxWarmupTime"), Budget.MaxWarmupTime);
+	return Budget;
+}
+
+FMicroManagerNiagaraAuditEntry FMicroManagerNiagaraAudit::MeasureSystem(UNiagaraSystem* System)
+{
+	FMicroManagerNiagaraAuditEntry Entry;
+	Entry.AssetData = FAssetData(System);
+	Entry.bHasFixedBounds = System->bFixedBounds;
+	Entry.WarmupTime = System->GetWarmupTime();
+
+	if (const UNiagaraEffectType* EffectType = System->GetEffectType())
+	{
+		Entry.EffectType = EffectType->GetName();
+	}
+
+	// Already resolved for the platform the editor previews, system overrides included
+	const FNiagaraSystemScalabilitySettings& ScalabilitySettings = System->GetScalabilitySettings();
+	Entry.bCullByDistance = ScalabilitySettings.bCullByDistance;
+	Entry.CullDistance = ScalabilitySettings.MaxDistance;
+	Entry.bCullMaxInstanceCount = ScalabilitySettings.bCullMaxInstanceCount;
+	Entry.MaxInstances = ScalabilitySettings.MaxInstances;
+	Entry.bCullByMaxTimeWithoutRender = ScalabilitySettings.bCullByMaxTimeWithoutRender;
+	Entry.MaxTimeWithoutRender = ScalabilitySettings.MaxTimeWithoutRender;
+
+	for (const FNiagaraEmitterHandle& EmitterHandle : System->GetEmitterHandles())
+	{
+		FVersionedNiagaraEmitterData* EmitterData = EmitterHandle.GetEmitterData();
+		if (!EmitterHandle.GetIsEnabled() || !EmitterData) continue;
+
+		FMicroManagerNiagaraEmitterEntry& Emitter = Entry.Emitters.AddDefaulted_GetRef();
+		Emitter.Name = EmitterHandle.GetName();
+		Emitter.bIsGPU = EmitterData->SimTarget == ENiagaraSimTarget::GPUComputeSim;
+		Emitter.bHasFixedBounds = EmitterData->CalculateBoundsMode == ENiagaraEmitterCalculateBoundMode::Fixed;
+		Emitter.MaxParticles = EmitterData->GetMaxParticleCountEstimate();
+	}
+
+	return Entry;
+}
+
+TArray<FString> FMicroManagerNiagaraAudit::FindIssues(const FMicroManagerNiagaraAuditEntry& Entry, const FMicroManagerNiagaraBudget& Budget)
+{
+	TArray<FString> Issues;
+	if (!Entry.bHasFixedBounds)
+	{
+		// GPU particles can't be read back to compute bounds, they fall back to the emitter's fixed bounds or none
+		const bool bHasDynamicGPUEmitter = Algo::AnyOf(Entry.Emitters, [](const FMicroManagerNiagaraEmitterEntry& Emitter)
+		{
+			return Emitter.bIsGPU && !Emitter.bHasFixedBounds;
+		});
+		if (bHasDynamicGPUEmitter)
+		{
+			Issues.Add(TEXT("GPU emitter without fixed bounds"));
+		}
+		else if (!Entry.HasFixedBoundsEverywhere())
+		{
+			Issues.Add(TEXT("bounds computed every frame"));
+		}
+	}
+	if (Entry.Emitters.Num() > Budget.MaxEmitters)
+	{
+		Issues.Add(FString::Printf(TEXT("%d emitters"), Entry.Emitters.Num()));
+	}
+	if (Entry.GetTotalMaxParticles() > Budget.MaxParticles)
+	{
+		Issues.Add(FString::Printf(TEXT("%d particles"), Entry.GetTotalMaxParticles()));
+	}
+	for (const FMicroManagerNiagaraEmitterEntry& Emitter : Entry.Emitters)
+	{
+		if (!Emitter.bIsGPU && Emitter.MaxParticles > Budget.MaxCPUEmitterParticles)
+		{
+			Issues.Add(FString::Printf(TEXT("%s simulates %d particles on the CPU"), *Emitter.Name.ToString(), Emitter.MaxParticles));
+		}
+	}
+	if (Entry.EffectType.IsEmpty())
+	{
+		Issues.Add(TEXT("no effect type"));
+	}
+	else if (!Entry.HasAnyCulling())
+	{
+		Issues.Add(TEXT("never culled"));
+	}
+	if (Entry.WarmupTime > Budget.MaxWarmupTime)
+	{
+		Issues.Add(FString::Printf(TEXT("%.1f s warmup"), Entry.WarmupTime));
+	}
+	return Issues;
+}
+
+FString FMicroManagerNiagaraAudit::DescribeCulling(const FMicroManagerNiagaraAuditEntry& Entry)
+{
+	TArray<FString> Culling;
+	if (Entry.bCullByDistance)
+	{
+		Culling.Add(FString::Printf(TEXT("distance %.0f"), Entry.CullDistance));
+	}
+	if (Entry.bCullMaxInstanceCount)
+	{
+		Culling.Add(FString::Printf(TEXT("%d instances"), Entry.MaxInstances));
+	}
+	if (Entry.bCullByMaxTimeWithoutRender)
+	{
+		Culling.Add(FString::Printf(TEXT("%.1f s unseen"), Entry.MaxTimeWithoutRender));
+	}
+
+	const FString EffectType = Entry.EffectType.IsEmpty() ? TEXT("No effect type") : Entry.EffectType;
+	return Culling.Num() > 0 ? FString::Printf(TEXT("%s: %s"), *EffectType, *FString::Join(Culling, TEXT(", "))) : EffectType;
+}
+
+void FMicroManagerNiagaraAudit::RunAndShowReport(const TArray<TSharedPtr<FAssetData>>& AssetsData)
+{
+	const FTopLevelAssetPath NiagaraSystemClassPath = UNiagaraSystem::StaticClass()->GetClassPathName();
+
+	TArray<const FAssetData*> SystemsData;
+	for (const TSharedPtr<FAssetData>& AssetData : AssetsData)
+	{
+		if (AssetData.IsValid() && AssetData->AssetClassPath == NiagaraSystemClassPath)
+		{
+			SystemsData.Add(AssetData.Get());
+		}
+	}
+
+	if (SystemsData.Num() == 0)
+	{
+		DebugHelper::ShowMsgDialog(EAppMsgType::Ok, TEXT("No Niagara system found under the selected folders"));
+		return;
+	}
+
+	const FMicroManagerNiagaraBudget Budget = FMicroManagerNiagaraBudget::Load();
+
+	TArray<TSharedPtr<FMicroManagerReportRow>> Rows;
+	int32 OverBudgetCount = 0;
+	{
+		FScopedSlowTask SlowTask(SystemsData.Num(), FText::FromString(TEXT("Auditing Niagara systems...")));
+		SlowTask.MakeDialog(true);
+
+		for (const FAssetData* SystemData : SystemsData)
+		{
+			if (SlowTask.ShouldCancel()) break;
+			SlowTask.EnterProgressFrame(1.f, FText::FromName(SystemData->AssetName));
+
+			UNiagaraSystem* System = Cast<UNiagaraSystem>(SystemData->GetAsset());
+			if (!System) continue;
+
+			const FMicroManagerNiagaraAuditEntry Entry = MeasureSystem(System);
+			const TArray<FString> Issues = FindIssues(Entry, Budget);
+			OverBudgetCount += Issues.Num() > 0 ? 1 : 0;
+
+			const int32 NumGPUEmitters = Entry.GetNumGPUEmitters();
+			const int32 NumCPUEmitters = Entry.Emitters.Num() - NumGPUEmitters;
+			const int32 NumFixedBoundsEmitters = Algo::CountIf(Entry.Emitters, [](const FMicroManagerNiagaraEmitterEntry& Emitter) { return Emitter.bHasFixedBounds; });
+
+			TSharedPtr<FMicroManagerReportRow> Row = MakeShared<FMicroManagerReportRow>();
+			Row->SetText(NiagaraAuditColumns::Name, SystemData->PackageName.ToString());
+			Row->SetValue(NiagaraAuditColumns::Emitters, Entry.Emitters.Num(), FString::FromInt(Entry.Emitters.Num()));
+			Row->SetValue(NiagaraAuditColumns::SimTarget, NumGPUEmitters, FString::Printf(TEXT("CPU %d, GPU %d"), NumCPUEmitters, NumGPUEmitters));
+			Row->SetValue(NiagaraAuditColumns::MaxParticles, Entry.GetTotalMaxParticles(), FString::FromInt(Entry.GetTotalMaxParticles()));
+			Row->SetText(NiagaraAuditColumns::Bounds, Entry.bHasFixedBounds
+				? FString(TEXT("Fixed on system"))
+				: FString::Printf(TEXT("Fixed on %d of %d emitters"), NumFixedBoundsEmitters, Entry.Emitters.Num()));
+			Row->SetText(NiagaraAuditColumns::Scalability, DescribeCulling(Entry));
+			Row->SetValue(NiagaraAuditColumns::Warmup, Entry.WarmupTime, FString::Printf(TEXT("%.1f s"), Entry.WarmupTime));
+			Row->SetValue(NiagaraAuditColumns::Issues, Issues.Num(), FString::Join(Issues, TEXT("; ")));
+			Row->AssetPath = SystemData->GetSoftObjectPath();
+
+			for (const FMicroManagerNiagaraEmitterEntry& Emitter : Entry.Emitters)
+			{
+				TSharedPtr<FMicroManagerReportRow> EmitterRow = MakeShared<FMicroManagerReportRow>();
+				EmitterRow->SetText(NiagaraAuditColumns::Name, Emitter.Name.ToString());
+				EmitterRow->SetValue(NiagaraAuditColumns::SimTarget, Emitter.bIsGPU ? 1 : 0, Emitter.bIsGPU ? TEXT("GPU") : TEXT("CPU"));
+				EmitterRow->SetValue(NiagaraAuditColumns::MaxParticles, Emitter.MaxParticles, FString::FromInt(Emitter.MaxParticles));
+				EmitterRow->SetText(NiagaraAuditColumns::Bounds, Emitter.bHasFixedBounds ? TEXT("Fixed") : TEXT("Dynamic"));
+				EmitterRow->AssetPath = Row->AssetPath;
+				Row->Children.Add(EmitterRow);
+			}
+
+			Rows.Add(Row);
+		}
+	}
+
+	const FString Summary = FString::Printf(
+		TEXT("%d Niagara systems, %d over budget. Culling is shown for the platform the editor previews.\nBudgets: %d emitters, %d particles, %d particles per CPU emitter, %.1f s warmup. %s"),
+		Rows.Num(), OverBudgetCount, Budget.MaxEmitters, Budget.MaxParticles, Budget.MaxCPUEmitterParticles, Budget.MaxWarmupTime,
+		FMicroManagerAuditBudget::GetWhereToSetText());
+
+	SMicroManagerReportView::OpenInWindow(TEXT("Niagara System Audit"), Summary,
+	{
+		{ NiagaraAuditColumns::Name, TEXT("Niagara System"), 0.25f, false },
+		{ NiagaraAuditColumns::Emitters, TEXT("Emitters"), 0.06f, true },
+		{ NiagaraAuditColumns::SimTarget, TEXT("Sim Target"), 0.08f, true },
+		{ NiagaraAuditColumns::MaxParticles, TEXT("Max Particles"), 0.08f, true },
+		{ NiagaraAuditColumns::Bounds, TEXT("Bounds"), 0.12f, false },
+		{ NiagaraAuditColumns::Scalability, TEXT("Scalability"), 0.16f, false },
+		{ NiagaraAuditColumns::Warmup, TEXT("Warmup"), 0.06f, true },
+		{ NiagaraAuditColumns::Issues, TEXT("Over Budget"), 0.19f, true },
+	}, Rows, NiagaraAuditColumns::Issues);
+}
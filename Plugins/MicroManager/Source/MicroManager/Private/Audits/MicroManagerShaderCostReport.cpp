@@ -0,0 +1,391 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Audits/MicroManagerShaderCostReport.h"
+#include "Audits/MicroManagerAuditBudget.h"
+#include "DebugHelper.h"
+#include "Editor.h"
+#include "HAL/FileManager.h"
+#include "MaterialEditingLibrary.h"
+#include "MaterialShared.h"
+#include "Materials/Material.h"
+#include "Materials/MaterialExpressionCollectionParameter.h"
+#include "Materials/MaterialExpressionTextureBase.h"
+#include "Materials/MaterialFunctionInterface.h"
+#include "Materials/MaterialParameterCollection.h"
+#include "Misc/EngineVersion.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopedSlowTask.h"
+#include "Misc/SecureHash.h"
+#include "SlateWidgets/MicroManagerReportWidget.h"
+
+namespace ShaderCostColumns
+{
+	static const FName Name(TEXT("Name"));
+	static const FName PixelInstructions(TEXT("PixelInstructions"));
+	static const FName VertexInstructions(TEXT("VertexInstructions"));
+	static const FName Samplers(TEXT("Samplers"));
+	static const FName TextureSamples(TEXT("TextureSamples"));
+	static const FName ShaderCount(TEXT("ShaderCount"));
+	static const FName UsageFlags(TEXT("UsageFlags"));
+	static const FName Issues(TEXT("Issues"));
+}
+
+namespace
+{
+	constexpr uint32 ShaderCostCacheMagic = 0x43534D4D;
+
+	ERHIFeatureLevel::Type GetEditorFeatureLevel()
+	{
+		// UMaterialEditingLibrary::GetStatistics compiles for the editor world, the shader count has to match it
+		const UWorld* EditorWorld = GEditor ? GEditor->GetEditorWorldContext().World() : nullptr;
+		return EditorWorld ? EditorWorld->GetFeatureLevel() : GMaxRHIFeatureLevel;
+	}
+
+	// Costs measured by another engine version or for another feature level don't compare
+	FString MakeCacheKey()
+	{
+		FString FeatureLevelName;
+		GetFeatureLevelName(GetEditorFeatureLevel(), FeatureLevelName);
+		return FeatureLevelName + TEXT("|") + FEngineVersion::Current().ToString();
+	}
+
+	void AddStateId(FSHA1& Hash, const FGuid& StateId)
+	{
+		Hash.Update(reinterpret_cast<const uint8*>(&StateId), sizeof(FGuid));
+	}
+
+	// First texture found walking up from a material input, the one that decides what the channel samples
+	const UTexture* FindSourceTexture(const FExpressionInput* Input)
+	{
+		if (!Input || !Input->Expression) return nullptr;
+
+		TArray<UMaterialExpression*, TInlineAllocator<16>> Frontier = { Input->Expression };
+		TSet<UMaterialExpression*> Visited;
+		for (int32 FrontierIndex = 0; FrontierIndex < Frontier.Num() && FrontierIndex < 64; ++FrontierIndex)
+		{
+			UMaterialExpression* Expression = Frontier[FrontierIndex];
+			bool bAlreadyVisited = false;
+			Visited.Add(Expression, &bAlreadyVisited);
+			if (bAlreadyVisited) continue;
+
+			if (const UMaterialExpressionTextureBase* TextureExpression = Cast<UMaterialExpressionTextureBase>(Expression))
+			{
+				if (TextureExpression->Texture) return TextureExpression->Texture;
+			}
+
+			for (FExpressionInputIterator InputIt{ Expression }; InputIt; ++InputIt)
+			{
+				if (InputIt->Expression)
+				{
+					Frontier.Add(InputIt->Expression);
+				}
+			}
+		}
+		return nullptr;
+	}
+}
+
+FArchive& operator<<(FArchive& Ar, FMicroManagerShaderCost& Cost)
+{
+	Ar << Cost.StateId;
+	Ar << Cost.PixelInstructions << Cost.VertexInstructions << Cost.Samplers << Cost.TextureSamples << Cost.VirtualTextureSamples;
+	Ar << Cost.ShaderCount << Cost.UsageFlags << Cost.SeparateOrmTextures;
+	return Ar;
+}
+
+FGuid FMicroManagerShaderCostReport::MakeStateId(const UMaterial* Material)
+{
+	// The material's own state id doesn't change when a function or parameter collection it uses is edited
+	TArray<UMaterialFunctionInterface*> DependentFunctions;
+	Material->GetDependentFunctions(DependentFunctions);
+
+	TArray<UMaterialExpressionCollectionParameter*> CollectionParameters;
+	Material->GetAllExpressionsInMaterialAndFunctionsOfType(CollectionParameters);
+
+	TArray<FGuid> DependencyStateIds;
+	for (const UMaterialFunctionInterface* Function : DependentFunctions)
+	{
+		if (Function) DependencyStateIds.AddUnique(Function->StateId);
+	}
+	for (const UMaterialExpressionCollectionParameter* CollectionParameter : CollectionParameters)
+	{
+		if (CollectionParameter->Collection) DependencyStateIds.AddUnique(CollectionParameter->Collection->StateId);
+	}
+
+	// Sorted, the walk order is not part of the state
+	DependencyStateIds.Sort([](const FGuid& A, const FGuid& B) { return A < B; });
+
+	FSHA1 Hash;
+	AddStateId(Hash, Material->StateId);
+	for (const FGuid& DependencyStateId : DependencyStateIds)
+	{
+		AddStateId(Hash, DependencyStateId);
+	}
+	Hash.Final();
+
+	uint32 HashWords[5];
+	Hash.GetHash(reinterpret_cast<uint8*>(HashWords));
+	return FGuid(HashWords[0], HashWords[1], HashWords[2], HashWords[3]);
+}
+
+FMicroManagerShaderBudget FMicroManagerShaderBudget::Load()
+{
+	FMicroManagerShaderBudget Budget;
+	FMicroManagerAuditBudget::Read(TEXT("ShaderBudgetPixelInstructions"), Budget.MaxPixelInstructions);
+	FMicroManagerAuditBudget::Read(TEXT("ShaderBudgetSamplers"), Budget.MaxSamplers);
+	FMicroManagerAuditBudget::Read(TEXT("ShaderBudgetShaderCount"), Budget.MaxShaderCount);
+	FMicroManagerAuditBudget::Read(TEXT("ShaderBudgetUsageFlags"), Budget.MaxUsageFlags);
+	return Budget;
+}
+
+FMicroManagerShaderCost FMicroManagerShaderCostReport::MeasureMaterial(UMaterial* Material)
+{
+	FMicroManagerShaderCost Cost;
+	Cost.StateId = MakeStateId(Material);
+
+	const FMaterialStatistics Statistics = UMaterialEditingLibrary::GetStatistics(Material);
+	Cost.PixelInstructions = Statistics.NumPixelShaderInstructions;
+	Cost.VertexInstructions = Statistics.NumVertexShaderInstructions;
+	Cost.Samplers = Statistics.NumSamplers;
+	Cost.TextureSamples = Statistics.NumPixelTextureSamples + Statistics.NumVertexTextureSamples;
+	Cost.VirtualTextureSamples = Statistics.NumVirtualTextureSamples;
+
+	if (FMaterialResource* Resource = Material->GetMaterialResource(GetEditorFeatureLevel()))
+	{
+		Resource->FinishCompilation();
+		if (const FMaterialShaderMap* ShaderMap = Resource->GetGameThreadShaderMap())
+		{
+			TMap<FShaderId, TShaderRef<FShader>> Shaders;
+			ShaderMap->GetShaderList(Shaders);
+			Cost.ShaderCount = Shaders.Num();
+		}
+	}
+
+	for (int32 Usage = 0; Usage < MATUSAGE_MAX; ++Usage)
+	{
+		if (Material->GetUsageByFlag(static_cast<EMaterialUsage>(Usage)))
+		{
+			Cost.UsageFlags |= 1ull << Usage;
+		}
+	}
+
+	TSet<const UTexture*> OrmTextures;
+	for (const EMaterialProperty Property : { MP_AmbientOcclusion, MP_Roughness, MP_Metallic })
+	{
+		if (const UTexture* SourceTexture = FindSourceTexture(Material->GetExpressionInputForProperty(Property)))
+		{
+			OrmTextures.Add(SourceTexture);
+		}
+	}
+	Cost.SeparateOrmTextures = OrmTextures.Num();
+
+	return Cost;
+}
+
+TArray<FString> FMicroManagerShaderCostReport::FindIssues(const FMicroManagerShaderCost& Cost, const FMicroManagerShaderBudget& Budget)
+{
+	TArray<FString> Issues;
+	if (Cost.PixelInstructions > Budget.MaxPixelInstructions)
+	{
+		Issues.Add(FString::Printf(TEXT("%d pixel instructions"), Cost.PixelInstructions));
+	}
+	if (Cost.Samplers > Budget.MaxSamplers)
+	{
+		Issues.Add(FString::Printf(TEXT("%d samplers"), Cost.Samplers));
+	}
+	if (Cost.ShaderCount > Budget.MaxShaderCount)
+	{
+		Issues.Add(FString::Printf(TEXT("%d shaders"), Cost.ShaderCount));
+	}
+	if (FMath::CountBits(Cost.UsageFlags) > static_cast<uint64>(Budget.MaxUsageFlags))
+	{
+		Issues.Add(FString::Printf(TEXT("%d usage flags"), static_cast<int32>(FMath::CountBits(Cost.UsageFlags))));
+	}
+	if (Cost.SeparateOrmTextures > 1)
+	{
+		Issues.Add(FString::Printf(TEXT("AO, roughness and metallic sampled from %d textures, pack them into one ORM"), Cost.SeparateOrmTextures));
+	}
+	return Issues;
+}
+
+FString FMicroManagerShaderCostReport::DescribeUsageFlags(uint64 UsageFlags)
+{
+	TArray<FString> UsageNames;
+	for (int32 Usage = 0; Usage < MATUSAGE_MAX; ++Usage)
+	{
+		if (UsageFlags & (1ull << Usage))
+		{
+			FString UsageName = UMaterial::GetUsageName(static_cast<EMaterialUsage>(Usage));
+			UsageName.RemoveFromStart(TEXT("bUsedWith"));
+			UsageNames.Add(UsageName);
+		}
+	}
+	return FString::Join(UsageNames, TEXT(", "));
+}
+
+FString FMicroManagerShaderCostReport::GetCacheFilePath()
+{
+	return FPaths::ProjectSavedDir() / TEXT("MicroManager") / TEXT("ShaderCostCache.bin");
+}
+
+TMap<FName, FMicroManagerShaderCost> FMicroManagerShaderCostReport::LoadCache(const FString& CacheKey)
+{
+	TMap<FName, FMicroManagerShaderCost> Cache;
+
+	TUniquePtr<FArchive> FileReader(IFileManager::Get().CreateFileReader(*GetCacheFilePath()));
+	if (!FileReader.IsValid()) return Cache;
+
+	FArchive& Ar = *FileReader;
+	uint32 Magic = 0;
+	uint32 Version = 0;
+	FString FileCacheKey;
+	Ar << Magic << Version;
+	if (Magic != ShaderCostCacheMagic || Version != CacheFileVersion) return Cache;
+
+	Ar << FileCacheKey;
+	if (FileCacheKey != CacheKey) return Cache;
+
+	int32 NumEntries = 0;
+	Ar << NumEntries;
+	for (int32 EntryIndex = 0; EntryIndex < NumEntries && !Ar.IsError(); ++EntryIndex)
+	{
+		FString PackageName;
+		FMicroManagerShaderCost Cost;
+		Ar << PackageName << Cost;
+		Cache.Add(FName(*PackageName), Cost);
+	}
+
+	if (Ar.IsError())
+	{
+		Cache.Reset();
+	}
+	return Cache;
+}
+
+void FMicroManagerShaderCostReport::SaveCache(const FString& CacheKey, const TMap<FName, FMicroManagerShaderCost>& Cache)
+{
+	// A report canceled or crashing mid write must not leave a truncated cache in place of the previous one
+	const FString TempFilePath = GetCacheFilePath() + TEXT(".tmp");
+	{
+		TUniquePtr<FArchive> FileWriter(IFileManager::Get().CreateFileWriter(*TempFilePath));
+		if (!FileWriter.IsValid())
+		{
+			DebugHelper::PrintLog(TEXT("Failed to write ") + TempFilePath);
+			return;
+		}
+
+		FArchive& Ar = *FileWriter;
+		uint32 Magic = ShaderCostCacheMagic;
+		uint32 Version = CacheFileVersion;
+		FString FileCacheKey = CacheKey;
+		int32 NumEntries = Cache.Num();
+		Ar << Magic << Version << FileCacheKey << NumEntries;
+
+		for (const TPair<FName, FMicroManagerShaderCost>& Entry : Cache)
+		{
+			FString PackageName = Entry.Key.ToString();
+			FMicroManagerShaderCost Cost = Entry.Value;
+			Ar << PackageName << Cost;
+		}
+
+		if (!FileWriter->Close())
+		{
+			IFileManager::Get().Delete(*TempFilePath);
+			DebugHelper::PrintLog(TEXT("Failed to write ") + TempFilePath);
+			return;
+		}
+	}
+
+	if (!IFileManager::Get().Move(*GetCacheFilePath(), *TempFilePath, true))
+	{
+		DebugHelper::PrintLog(TEXT("Failed to replace ") + GetCacheFilePath());
+	}
+}
+
+void FMicroManagerShaderCostReport::RunAndShowReport(const TArray<TSharedPtr<FAssetData>>& AssetsData)
+{
+	const FTopLevelAssetPath MaterialClassPath = UMaterial::StaticClass()->GetClassPathName();
+
+	TArray<const FAssetData*> MaterialsData;
+	for (const TSharedPtr<FAssetData>& AssetData : AssetsData)
+	{
+		if (AssetData.IsValid() && AssetData->AssetClassPath == MaterialClassPath)
+		{
+			MaterialsData.Add(AssetData.Get());
+		}
+	}
+
+	if (MaterialsData.Num() == 0)
+	{
+		DebugHelper::ShowMsgDialog(EAppMsgType::Ok, TEXT("No material found under the selected folders"));
+		return;
+	}
+
+	const FString CacheKey = MakeCacheKey();
+	TMap<FName, FMicroManagerShaderCost> Cache = LoadCache(CacheKey);
+	const FMicroManagerShaderBudget Budget = FMicroManagerShaderBudget::Load();
+
+	TArray<TSharedPtr<FMicroManagerReportRow>> Rows;
+	int32 MeasuredCount = 0;
+	int32 OverBudgetCount = 0;
+	{
+		FScopedSlowTask SlowTask(MaterialsData.Num(), FText::FromString(TEXT("Compiling materials...")));
+		SlowTask.MakeDialog(true);
+
+		for (const FAssetData* MaterialData : MaterialsData)
+		{
+			if (SlowTask.ShouldCancel()) break;
+			SlowTask.EnterProgressFrame(1.f, FText::FromName(MaterialData->AssetName));
+
+			UMaterial* Material = Cast<UMaterial>(MaterialData->GetAsset());
+			if (!Material) continue;
+
+			// An unchanged material keeps its state id across sessions, its cost can't have changed either
+			FMicroManagerShaderCost* Cost = Cache.Find(MaterialData->PackageName);
+			if (!Cost || Cost->StateId != MakeStateId(Material))
+			{
+				Cost = &Cache.Add(MaterialData->PackageName, MeasureMaterial(Material));
+				++MeasuredCount;
+			}
+
+			const TArray<FString> Issues = FindIssues(*Cost, Budget);
+			OverBudgetCount += Issues.Num() > 0 ? 1 : 0;
+
+			const int32 UsageFlagCount = FMath::CountBits(Cost->UsageFlags);
+
+			TSharedPtr<FMicroManagerReportRow> Row = MakeShared<FMicroManagerReportRow>();
+			Row->SetText(ShaderCostColumns::Name, MaterialData->PackageName.ToString());
+			Row->SetValue(ShaderCostColumns::PixelInstructions, Cost->PixelInstructions, FString::FromInt(Cost->PixelInstructions));
+			Row->SetValue(ShaderCostColumns::VertexInstructions, Cost->VertexInstructions, FString::FromInt(Cost->VertexInstructions));
+			Row->SetValue(ShaderCostColumns::Samplers, Cost->Samplers, FString::FromInt(Cost->Samplers));
+			Row->SetValue(ShaderCostColumns::TextureSamples, Cost->TextureSamples, FString::FromInt(Cost->TextureSamples));
+			Row->SetValue(ShaderCostColumns::ShaderCount, Cost->ShaderCount, FString::FromInt(Cost->ShaderCount));
+			Row->SetValue(ShaderCostColumns::UsageFlags, UsageFlagCount,
+				FString::Printf(TEXT("%d: %s"), UsageFlagCount, *DescribeUsageFlags(Cost->UsageFlags)));
+			Row->SetValue(ShaderCostColumns::Issues, Issues.Num(), FString::Join(Issues, TEXT("; ")));
+			Row->AssetPath = MaterialData->GetSoftObjectPath();
+			Rows.Add(Row);
+		}
+	}
+
+	SaveCache(CacheKey, Cache);
+
+	const FString Summary = FString::Printf(
+		TEXT("%d materials, %d over budget. %d compiled, %d unchanged since the cached run.\nBudgets: %d pixel instructions, %d samplers, %d shaders, %d usage flags. %s"),
+		Rows.Num(), OverBudgetCount, MeasuredCount, Rows.Num() - MeasuredCount,
+		Budget.MaxPixelInstructions, Budget.MaxSamplers, Budget.MaxShaderCount, Budget.MaxUsageFlags,
+		FMicroManagerAuditBudget::GetWhereToSetText());
+
+	SMicroManagerReportView::OpenInWindow(TEXT("Material Shader Cost"), Summary,
+	{
+		{ ShaderCostColumns::Name, TEXT("Material"), 0.3f, false },
+		{ ShaderCostColumns::PixelInstructions, TEXT("PS Instr"), 0.07f, true },
+		{ ShaderCostColumns::VertexInstructions, TEXT("VS Instr"), 0.07f, true },
+		{ ShaderCostColumns::Samplers, TEXT("Samplers"), 0.07f, true },
+		{ ShaderCostColumns::TextureSamples, TEXT("Samples"), 0.07f, true },
+		{ ShaderCostColumns::ShaderCount, TEXT("Shaders"), 0.07f, true },
+		{ ShaderCostColumns::UsageFlags, TEXT("Usage Flags"), 0.15f, true },
+		{ ShaderCostColumns::Issues, TEXT("Over Budget"), 0.2f, true },
+	}, Rows, ShaderCostColumns::Issues);
+}
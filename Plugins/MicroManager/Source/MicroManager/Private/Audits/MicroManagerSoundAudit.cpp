@@ -0,0 +1,286 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Audits/MicroManagerSoundAudit.h"
+#include "Audits/MicroManagerAuditBudget.h"
+#include "DebugHelper.h"
+#include "FileHelpers.h"
+#include "Misc/ScopedSlowTask.h"
+#include "SlateWidgets/MicroManagerReportWidget.h"
+
+namespace SoundAuditColumns
+{
+	static const FName Name(TEXT("Name"));
+	static const FName Duration(TEXT("Duration"));
+	static const FName Channels(TEXT("Channels"));
+	static const FName SampleRate(TEXT("SampleRate"));
+	static const FName Quality(TEXT("Quality"));
+	static const FName Loading(TEXT("Loading"));
+	static const FName PcmSize(TEXT("PcmSize"));
+	static const FName ResidentSize(TEXT("ResidentSize"));
+}
+
+namespace
+{
+	template <typename EnumType>
+	FString EnumToDisplayString(EnumType Value)
+	{
+		return StaticEnum<EnumType>()->GetDisplayNameTextByValue(static_cast<int64>(Value)).ToString();
+	}
+
+	USoundWave* LoadSoundWave(const FMicroManagerSoundAuditEntry& Entry)
+	{
+		return Cast<USoundWave>(Entry.AssetData.GetAsset());
+	}
+
+	template <typename EnumType>
+	bool GetEnumTagValue(const FAssetData& AssetData, FName TagName, EnumType& OutValue)
+	{
+		FString ValueName;
+		if (!AssetData.GetTagValue(TagName, ValueName)) return false;
+
+		const int64 Value = StaticEnum<EnumType>()->GetValueByNameString(ValueName);
+		if (Value == INDEX_NONE) return false;
+
+		OutValue = static_cast<EnumType>(Value);
+		return true;
+	}
+
+	// False when the wave was saved without one of the tags, or its loading behavior has to be resolved from the sound class
+	bool ReadTags(const FAssetData& AssetData, FMicroManagerSoundAuditEntry& Entry)
+	{
+		bool bHasAllTags = AssetData.GetTagValue(TEXT("Duration"), Entry.Duration);
+		bHasAllTags &= AssetData.GetTagValue(TEXT("NumChannels"), Entry.NumChannels);
+		bHasAllTags &= AssetData.GetTagValue(TEXT("SampleRate"), Entry.SampleRate) || AssetData.GetTagValue(TEXT("ImportedSampleRate"), Entry.SampleRate);
+		bHasAllTags &= AssetData.GetTagValue(TEXT("CompressionQuality"), Entry.CompressionQuality);
+		bHasAllTags &= GetEnumTagValue(AssetData, TEXT("SampleRateQuality"), Entry.SampleRateQuality);
+		bHasAllTags &= GetEnumTagValue(AssetData, TEXT("LoadingBehavior"), Entry.LoadingBehavior);
+		bHasAllTags &= Entry.LoadingBehavior != ESoundWaveLoadingBehavior::Inherited && Entry.LoadingBehavior != ESoundWaveLoadingBehavior::Uninitialized;
+
+		Entry.bIsStreaming = Entry.LoadingBehavior != ESoundWaveLoadingBehavior::ForceInline;
+		return bHasAllTags;
+	}
+
+	// Only fills what the tags left unset, a tagged sample rate is the one the wave was saved with
+	void ReadLoadedSoundWave(const USoundWave* SoundWave, FMicroManagerSoundAuditEntry& Entry)
+	{
+		if (Entry.Duration <= 0.f) Entry.Duration = SoundWave->GetDuration();
+		if (Entry.NumChannels <= 0) Entry.NumChannels = SoundWave->NumChannels;
+		if (Entry.SampleRate <= 0) Entry.SampleRate = FMath::RoundToInt(SoundWave->GetSampleRateForCurrentPlatform());
+
+		Entry.CompressionQuality = SoundWave->CompressionQuality;
+		Entry.LoadingBehavior = SoundWave->GetLoadingBehavior();
+		Entry.SampleRateQuality = SoundWave->SampleRateQuality;
+		Entry.bIsStreaming = SoundWave->IsStreaming();
+		Entry.ResidentSize = SoundWave->GetResourceSizeBytes(EResourceSizeMode::EstimatedTotal);
+	}
+}
+
+FMicroManagerSoundBudget FMicroManagerSoundBudget::Load()
+{
+	FMicroManagerSoundBudget Budget;
+	FMicroManagerAuditBudget::Read(TEXT("SoundStreamingDurationThreshold"), Budget.StreamingDurationThreshold);
+	FMicroManagerAuditBudget::ReadEnum(TEXT("SoundSampleRateOverride"), Budget.SampleRateOverride);
+	return Budget;
+}
+
+bool FMicroManagerSoundAudit::CollectEntries(const TArray<TSharedPtr<FAssetData>>& AssetsData, TArray<FMicroManagerSoundAuditEntry>& OutEntries)
+{
+	OutEntries.Reset();
+
+	const FTopLevelAssetPath SoundWaveClassPath = USoundWave::StaticClass()->GetClassPathName();
+	TArray<int32> EntriesToLoad;
+	for (const TSharedPtr<FAssetData>& AssetData : AssetsData)
+	{
+		if (!AssetData.IsValid() || AssetData->AssetClassPath != SoundWaveClassPath) continue;
+
+		FMicroManagerSoundAuditEntry& Entry = OutEntries.AddDefaulted_GetRef();
+		Entry.AssetData = *AssetData;
+		const bool bHasAllTags = ReadTags(*AssetData, Entry);
+
+		// The resident size is not tagged, it is only read from waves that are in memory anyway
+		if (const USoundWave* LoadedSoundWave = Cast<USoundWave>(AssetData->FastGetAsset(false)))
+		{
+			ReadLoadedSoundWave(LoadedSoundWave, Entry);
+		}
+		else if (!bHasAllTags)
+		{
+			EntriesToLoad.Add(OutEntries.Num() - 1);
+		}
+	}
+
+	if (EntriesToLoad.Num() > 0)
+	{
+		FScopedSlowTask SlowTask(EntriesToLoad.Num(), FText::FromString(TEXT("Loading sound waves saved without registry tags...")));
+		SlowTask.MakeDialog(true);
+
+		for (const int32 EntryIndex : EntriesToLoad)
+		{
+			if (SlowTask.ShouldCancel()) return false;
+
+			FMicroManagerSoundAuditEntry& Entry = OutEntries[EntryIndex];
+			SlowTask.EnterProgressFrame(1.f, FText::FromName(Entry.AssetData.AssetName));
+
+			if (const USoundWave* SoundWave = LoadSoundWave(Entry))
+			{
+				ReadLoadedSoundWave(SoundWave, Entry);
+			}
+		}
+	}
+
+	for (FMicroManagerSoundAuditEntry& Entry : OutEntries)
+	{
+		Entry.PcmSize = static_cast<int64>(static_cast<double>(Entry.Duration) * Entry.SampleRate * Entry.NumChannels * sizeof(int16));
+	}
+
+	// Waves not in memory have no resident size, the decompressed size orders them
+	OutEntries.Sort([](const FMicroManagerSoundAuditEntry& A, const FMicroManagerSoundAuditEntry& B)
+	{
+		if (A.ResidentSize != B.ResidentSize)
+		{
+			return A.ResidentSize > B.ResidentSize;
+		}
+		return A.PcmSize > B.PcmSize;
+	});
+
+	return true;
+}
+TArray<UPackage*> FMicroManagerSoundAudit::ForceStreaming(const TArray<FMicroManagerSoundAuditEntry>& Entries, float DurationThreshold)
+{
+	TArray<UPackage*> ModifiedPackages;
+	for (const FMicroManagerSoundAuditEntry& Entry : Entries)
+	{
+		if (Entry.bIsStreaming || Entry.Duration <= DurationThreshold) continue;
+
+		USoundWave* SoundWave = LoadSoundWave(Entry);
+		if (!SoundWave) continue;
+
+		SoundWave->PreEditChange(nullptr);
+		SoundWave->Modify();
+		SoundWave->LoadingBehavior = ESoundWaveLoadingBehavior::LoadOnDemand;
+		SoundWave->PostEditChange();
+		ModifiedPackages.AddUnique(SoundWave->GetOutermost());
+	}
+	return ModifiedPackages;
+}
+
+TArray<UPackage*> FMicroManagerSoundAudit::ApplySampleRateOverride(const TArray<FMicroManagerSoundAuditEntry>& Entries, ESoundwaveSampleRateSettings SampleRateOverride)
+{
+	TArray<UPackage*> ModifiedPackages;
+	for (const FMicroManagerSoundAuditEntry& Entry : Entries)
+	{
+		// An override already set was chosen on purpose
+		if (Entry.SampleRateQuality != ESoundwaveSampleRateSettings::Max) continue;
+
+		USoundWave* SoundWave = LoadSoundWave(Entry);
+		if (!SoundWave) continue;
+
+		SoundWave->PreEditChange(nullptr);
+		SoundWave->Modify();
+		SoundWave->SampleRateQuality = SampleRateOverride;
+		SoundWave->PostEditChange();
+		ModifiedPackages.AddUnique(SoundWave->GetOutermost());
+	}
+	return ModifiedPackages;
+}
+
+void FMicroManagerSoundAudit::RunAndShowReport(const TArray<TSharedPtr<FAssetData>>& AssetsData)
+{
+	TArray<FMicroManagerSoundAuditEntry> Entries;
+	if (!CollectEntries(AssetsData, Entries)) return;
+
+	if (Entries.Num() == 0)
+	{
+		DebugHelper::ShowMsgDialog(EAppMsgType::Ok, TEXT("No sound wave found under the selected folders"));
+		return;
+	}
+
+	const FMicroManagerSoundBudget Budget = FMicroManagerSoundBudget::Load();
+
+	TArray<TSharedPtr<FMicroManagerReportRow>> Rows;
+	int64 TotalResidentSize = 0;
+	int32 LoadedCount = 0;
+	int32 LongInlineCount = 0;
+	int32 MaxSampleRateCount = 0;
+
+	for (const FMicroManagerSoundAuditEntry& Entry : Entries)
+	{
+		TSharedPtr<FMicroManagerReportRow> Row = MakeShared<FMicroManagerReportRow>();
+		Row->SetText(SoundAuditColumns::Name, Entry.AssetData.PackageName.ToString());
+		Row->SetValue(SoundAuditColumns::Duration, Entry.Duration, FString::Printf(TEXT("%.1f s"), Entry.Duration));
+		Row->SetValue(SoundAuditColumns::Channels, Entry.NumChannels, FString::FromInt(Entry.NumChannels));
+		Row->SetValue(SoundAuditColumns::SampleRate, Entry.SampleRate,
+			FString::Printf(TEXT("%d Hz (%s)"), Entry.SampleRate, *EnumToDisplayString(Entry.SampleRateQuality)));
+		Row->SetValue(SoundAuditColumns::Quality, Entry.CompressionQuality, FString::FromInt(Entry.CompressionQuality));
+		Row->SetText(SoundAuditColumns::Loading, FString::Printf(TEXT("%s%s"),
+			*EnumToDisplayString(Entry.LoadingBehavior), Entry.bIsStreaming ? TEXT(", streamed") : TEXT("")));
+		Row->SetSize(SoundAuditColumns::PcmSize, Entry.PcmSize);
+		if (Entry.ResidentSize >= 0)
+		{
+			Row->SetSize(SoundAuditColumns::ResidentSize, Entry.ResidentSize);
+		}
+		else
+		{
+			Row->SetValue(SoundAuditColumns::ResidentSize, -1.0, TEXT("Not loaded"));
+		}
+		Row->AssetPath = Entry.AssetData.GetSoftObjectPath();
+		Rows.Add(Row);
+
+		if (Entry.ResidentSize >= 0)
+		{
+			TotalResidentSize += Entry.ResidentSize;
+			++LoadedCount;
+		}
+		LongInlineCount += !Entry.bIsStreaming && Entry.Duration > Budget.StreamingDurationThreshold ? 1 : 0;
+		MaxSampleRateCount += Entry.SampleRateQuality == ESoundwaveSampleRateSettings::Max ? 1 : 0;
+	}
+
+	const FString Summary = FString::Printf(
+		TEXT("%d sound waves, the %d in memory keep about %s resident. %d are longer than the streaming threshold and not streamed.\nBudgets: %.0f s streaming threshold, %s sample rate override. %s"),
+		Entries.Num(), LoadedCount, *FText::AsMemory(TotalResidentSize).ToString(), LongInlineCount, Budget.StreamingDurationThreshold,
+		*EnumToDisplayString(Budget.SampleRateOverride), FMicroManagerAuditBudget::GetWhereToSetText());
+
+	SMicroManagerReportView::OpenInWindow(TEXT("Sound Wave Audit"), Summary,
+	{
+		{ SoundAuditColumns::Name, TEXT("Sound Wave"), 0.3f, false },
+		{ SoundAuditColumns::Duration, TEXT("Duration"), 0.07f, true },
+		{ SoundAuditColumns::Channels, TEXT("Channels"), 0.07f, true },
+		{ SoundAuditColumns::SampleRate, TEXT("Sample Rate"), 0.12f, true },
+		{ SoundAuditColumns::Quality, TEXT("Quality"), 0.07f, true },
+		{ SoundAuditColumns::Loading, TEXT("Loading"), 0.15f, false },
+		{ SoundAuditColumns::PcmSize, TEXT("PCM Size"), 0.1f, true },
+		{ SoundAuditColumns::ResidentSize, TEXT("Resident"), 0.1f, true },
+	}, Rows, SoundAuditColumns::ResidentSize);
+
+	TArray<UPackage*> PackagesToSave;
+
+	if (LongInlineCount > 0)
+	{
+		const EAppReturnType::Type ConfirmResult = DebugHelper::ShowMsgDialog(EAppMsgType::YesNo, FString::Printf(
+			TEXT("Stream the %d sound waves longer than %.0f s that are loaded whole?"), LongInlineCount, Budget.StreamingDurationThreshold), false);
+		if (ConfirmResult == EAppReturnType::Yes)
+		{
+			PackagesToSave.Append(ForceStreaming(Entries, Budget.StreamingDurationThreshold));
+		}
+	}
+
+	if (MaxSampleRateCount > 0)
+	{
+		const EAppReturnType::Type ConfirmResult = DebugHelper::ShowMsgDialog(EAppMsgType::YesNo, FString::Printf(
+			TEXT("Set the sample rate of the %d sound waves at the maximum to %s?"), MaxSampleRateCount, *EnumToDisplayString(Budget.SampleRateOverride)), false);
+		if (ConfirmResult == EAppReturnType::Yes)
+		{
+			for (UPackage* Package : ApplySampleRateOverride(Entries, Budget.SampleRateOverride))
+			{
+				PackagesToSave.AddUnique(Package);
+			}
+		}
+	}
+
+	if (PackagesToSave.Num() > 0)
+	{
+		// One save for both actions
+		UEditorLoadingAndSavingUtils::SavePackages(PackagesToSave, false);
+		DebugHelper::ShowNotifyInfo(FString::Printf(TEXT("Updated and saved %d sound waves"), PackagesToSave.Num()));
+	}
+}
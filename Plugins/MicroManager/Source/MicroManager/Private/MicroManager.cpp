@@ -10,6 +10,19 @@
 #include "AssetRegistry/AssetRegistryModule.h"
 #include "SlateWidgets/MicroManagerWidget.h"
 #include "CustomStyle/MicroManagerStyle.h"
+#include "AssetAnalysis/MicroManagerSizeCache.h"
+#include "Async/ParallelFor.h"
+#include "MicroManagerCoreAlgorithms.h"
+#include "Audits/MicroManagerAuditBudget.h"
+#include "Audits/MicroManagerBlueprintAudit.h"
+#include "Audits/MicroManagerMaterialDuplicates.h"
+#include "Audits/MicroManagerMeshAudit.h"
+#include "Audits/MicroManagerNiagaraAudit.h"
+#include "Audits/MicroManagerShaderCostReport.h"
+#include "Audits/MicroManagerSoundAudit.h"
+#include "Profiling/MicroManagerLoadProfiler.h"
+#include "Snapshots/MicroManagerSnapshot.h"
+#include "Subsystems/MicroManagerSubsystem.h"
 #include "Widgets/Docking/SDockTab.h"
 // #include "SlateWidgets/SDiscoStarship.h"
 
@@ -25,7 +38,7 @@ void FMicroManagerModule::StartupModule()
 	FMicroManagerStyle::InitializeIcons();
     InitCBMenuExtension();
 	RegisterMicroManagerTab();
-	
+
 
 	// Register the hidden Starship Gallery tab
 	// Register a tab that hosts the Starship Gallery
@@ -125,6 +138,19 @@ void FMicroManagerModule::AddCBMenuEntry(FMenuBuilder& MenuBuilder)
 		FExecuteAction::CreateRaw(this, &FMicroManagerModule::OnDeleteUnusedFoldersButtonClicked)
 	);
 
+	// Text Reference Scan
+	MenuBuilder.AddMenuEntry(
+		FText::FromString(TEXT("Search Config and Source for References")),
+		FText::FromString(TEXT("Also treats assets mentioned by path in Config, Source and Plugins text files as used.")),
+		FSlateIcon(),
+		FUIAction(
+			FExecuteAction::CreateRaw(this, &FMicroManagerModule::OnToggleTextReferenceScanClicked),
+			FCanExecuteAction(),
+			FIsActionChecked::CreateRaw(this, &FMicroManagerModule::IsTextReferenceScanEnabled)),
+		NAME_None,
+		EUserInterfaceActionType::ToggleButton
+	);
+
 	// Launch Micro Manager
 	MenuBuilder.AddMenuEntry(
 		FText::FromString(TEXT("Launch Micro Manager")),
@@ -133,6 +159,15 @@ void FMicroManagerModule::AddCBMenuEntry(FMenuBuilder& MenuBuilder)
 		FExecuteAction::CreateRaw(this, &FMicroManagerModule::OnMicroManagerClicked)
 	);
 
+	// Audits
+	MenuBuilder.AddSubMenu(
+		FText::FromString(TEXT("Micro Manager Audits")),
+		FText::FromString(TEXT("Reports on the assets in the directory.")),
+		FNewMenuDelegate::CreateRaw(this, &FMicroManagerModule::AddCBAuditsSubMenu),
+		false,
+		FSlateIcon(FMicroManagerStyle::GetStyleSetName(), "ContentBrowser.MicroManager")
+	);
+
 	// Bottom separator
 	MenuBuilder.AddMenuSeparator();
 }
@@ -142,60 +177,42 @@ void FMicroManagerModule::AddCBMenuEntry(FMenuBuilder& MenuBuilder)
 void FMicroManagerModule::OnDeleteUnusedAssetsButtonClicked()
 {
 	// DebugHelper::ShowMsgDialog(EAppMsgType::Ok, TEXT("Successfully removed all unused files"));
-	if (FolderPathsSelected.Num() > 1)
+	if (FolderPathsSelected.Num() == 0)
 	{
-		DebugHelper::ShowMsgDialog(EAppMsgType::Ok, TEXT("You can only do this with one directory selected."));
+		DebugHelper::ShowMsgDialog(EAppMsgType::Ok, TEXT("No folder selected."));
 		return;
 	}
-	// DebugHelper::Print(TEXT("Selected folder: ") + FolderPathsSelected[0], FColor::Cyan);
 
-	TArray<FString> AssetPathsNames = UEditorAssetLibrary::ListAssets(FolderPathsSelected[0]);
+	// Every selected folder is gathered on its own worker, results come back merged and de-duplicated
+	TArray<TSharedPtr<FAssetData>> AssetsDataUnderFolders = GetAllAssetDataUnderSelectedFolders();
 
-	if (AssetPathsNames.Num() == 0)
+	if (AssetsDataUnderFolders.Num() == 0)
 	{
-		DebugHelper::ShowMsgDialog(EAppMsgType::Ok, TEXT("No assets found under the selected folder"));
+		DebugHelper::ShowMsgDialog(EAppMsgType::Ok, TEXT("No assets found under the selected folders"));
 		return;
 	}
 
 	EAppReturnType::Type ConfirmedResult =
 		DebugHelper::ShowMsgDialog(EAppMsgType::YesNo,
-								   FString::Printf(TEXT("A Total of %d Assets to be confirmed for deletion.\nDo you want to delete them?"),
-								   AssetPathsNames.Num()), false);
+								   FString::Printf(TEXT("A Total of %d Assets in %d folder(s) to be confirmed for deletion.\nDo you want to delete them?"),
+								   AssetsDataUnderFolders.Num(), FolderPathsSelected.Num()), false);
 
 	if (ConfirmedResult == EAppReturnType::No)
 	{
 		return;
 	}
 	
-	FixUpRedirectors();
+	UMicroManagerSubsystem* MicroManagerSubsystem = UMicroManagerSubsystem::Get();
+	MicroManagerSubsystem->FixUpRedirectors();
 	
-	TArray<FAssetData> UnusedAssetsData;
+	TArray<TSharedPtr<FAssetData>> UnusedAssetsDataPtrs;
+	MicroManagerSubsystem->ListUnusedAssets(AssetsDataUnderFolders, UnusedAssetsDataPtrs);
 
-	for (const FString& AssetPathName : AssetPathsNames)
+	TArray<FAssetData> UnusedAssetsData;
+	UnusedAssetsData.Reserve(UnusedAssetsDataPtrs.Num());
+	for (const TSharedPtr<FAssetData>& UnusedAssetDataPtr : UnusedAssetsDataPtrs)
 	{
-		// Don't touch root folder
-		//Excludes these folders from the delete process
-		if (AssetPathName.Contains(TEXT("Developers")) ||
-			AssetPathName.Contains(TEXT("Collections")) ||
-			AssetPathName.Contains(TEXT("_ExternalActors_"))||
-			AssetPathName.Contains(TEXT("_ExternalObjects_"))||
-			AssetPathName.Contains(TEXT("Maps")))
-		{
-			continue;
-		}
-
-		if (!UEditorAssetLibrary::DoesAssetExist(AssetPathName))
-		{
-			continue;
-		}
-
-		TArray<FString> AssetReferencers = UEditorAssetLibrary::FindPackageReferencersForAsset(AssetPathName);
-
-		if (AssetReferencers.Num() == 0)
-		{
-			const FAssetData UnusedAssetData = UEditorAssetLibrary::FindAssetData(AssetPathName);
-			UnusedAssetsData.Add(UnusedAssetData);
-		}
+		UnusedAssetsData.Add(*UnusedAssetDataPtr);
 	}
 
 	if (UnusedAssetsData.Num() > 0)
@@ -204,52 +221,92 @@ void FMicroManagerModule::OnDeleteUnusedAssetsButtonClicked()
 	}
 	else
 	{
-		DebugHelper::ShowMsgDialog(EAppMsgType::Ok, TEXT("No unused asset found under the selected folder"), false);
+		DebugHelper::ShowMsgDialog(EAppMsgType::Ok, TEXT("No unused asset found under the selected folders"), false);
 	}
 }
 
 /**
- * @brief Deletes all empty folders within the selected directory.
+ * @brief Deletes all empty folders within the selected directories.
  * 
- * This function identifies and deletes all empty folders within the directory specified by the user.
+ * This function identifies and deletes all empty folders within the directories specified by the user.
+ * Each selected directory is scanned on its own worker thread through the Asset Registry, and the
+ * results are merged so nested selections don't report a folder twice.
  * It excludes certain folders from deletion and prompts the user for confirmation before proceeding.
  */
 void FMicroManagerModule::OnDeleteUnusedFoldersButtonClicked()
 {
-    TArray<FString> FolderPathsArray = UEditorAssetLibrary::ListAssets(FolderPathsSelected[0], true, true);
-    uint32 Counter = 0;
+	if (FolderPathsSelected.Num() == 0) return;
+
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+	uint32 Counter = 0;
+
+	// One result array per selected folder so the workers never share a container
+	TArray<TArray<FString>> SubFoldersPerSelectedFolder;
+	SubFoldersPerSelectedFolder.SetNum(FolderPathsSelected.Num());
+
+	ParallelFor(FolderPathsSelected.Num(), [this, &AssetRegistry, &SubFoldersPerSelectedFolder](int32 FolderIndex)
+	{
+		AssetRegistry.GetSubPaths(FolderPathsSelected[FolderIndex], SubFoldersPerSelectedFolder[FolderIndex], true);
+	});
+
+	// Merged and de-duplicated, nested selections list the same sub folders
+	TArray<FString> CandidateFolderPaths;
+	TSet<FString> SeenFolders;
+	for (const TArray<FString>& SubFolders : SubFoldersPerSelectedFolder)
+	{
+		for (const FString& FolderPath : SubFolders)
+		{
+			bool bAlreadySeen = false;
+			SeenFolders.Add(FolderPath, &bAlreadySeen);
+			if (!bAlreadySeen && !UMicroManagerSubsystem::IsPathExcludedFromMicroManager(FolderPath))
+			{
+				CandidateFolderPaths.Add(FolderPath);
+			}
+		}
+	}
+
+	// Every folder directly holding an asset, the core works out which candidates hold none below them
+	FARFilter AssetFolderFilter;
+	AssetFolderFilter.bRecursivePaths = true;
+	for (const FString& FolderPath : FolderPathsSelected)
+	{
+		AssetFolderFilter.PackagePaths.Add(FName(*FolderPath));
+	}
+
+	TSet<FName> AssetFolderNames;
+	AssetRegistry.EnumerateAssets(AssetFolderFilter, [&AssetFolderNames](const FAssetData& AssetData)
+	{
+		AssetFolderNames.Add(AssetData.PackagePath);
+		return true;
+	});
+
+	TArray<FString> AssetFolderPaths;
+	AssetFolderPaths.Reserve(AssetFolderNames.Num());
+	for (const FName AssetFolderName : AssetFolderNames)
+	{
+		AssetFolderPaths.Add(AssetFolderName.ToString());
+	}
+
+	TArray<int32> EmptyFolderIndices;
+	MicroManagerCore::FindEmptyFolders(CandidateFolderPaths, AssetFolderPaths, EmptyFolderIndices);
 
 	// Create a Variable to hold the names of the empty folders
     FString EmptyFolderPathNames;
 	// Create a Variable to hold the paths of the empty folders
     TArray<FString> EmptyFoldersPathsArrray;
-	// Iterates through all the folders in the selected directory
-    for (const FString& FolderPath : FolderPathsArray)
-    {
-        if (FolderPath.Contains(TEXT("Developers")) ||
-            FolderPath.Contains(TEXT("Collections")) ||
-            FolderPath.Contains(TEXT("_ExternalActors_"))||
-            FolderPath.Contains(TEXT("_ExternalObjects_"))||
-            FolderPath.Contains(TEXT("Maps")))
-        {
-            continue;
-        }
-        // Checks if the selected path is a directory
-        if (!UEditorAssetLibrary::DoesDirectoryExist(FolderPath)) continue;
-        if (!UEditorAssetLibrary::DoesDirectoryHaveAssets(FolderPath))
-        {
-            EmptyFolderPathNames.Append(FolderPath);
-            EmptyFolderPathNames.Append(TEXT("\n"));
-
-            EmptyFoldersPathsArrray.Add(FolderPath);
-        };
-        
-    }
+
+	for (const int32 EmptyFolderIndex : EmptyFolderIndices)
+	{
+		EmptyFolderPathNames.Append(CandidateFolderPaths[EmptyFolderIndex]);
+		EmptyFolderPathNames.Append(TEXT("\n"));
+
+		EmptyFoldersPathsArrray.Add(CandidateFolderPaths[EmptyFolderIndex]);
+	}
     
     if (EmptyFoldersPathsArrray.Num() == 0)
     {
-        DebugHelper::ShowMsgDialog(EAppMsgType::Ok, TEXT("No empty folders found under the selected folder"));
-        
+        DebugHelper::ShowMsgDialog(EAppMsgType::Ok, TEXT("No empty folders found under the selected folders"));
+        return;
     }
     EAppReturnType::Type ConfirmedResult =
     DebugHelper::ShowMsgDialog(EAppMsgType::OkCancel, TEXT("Empty Folders found in:\n") + EmptyFolderPathNames + TEXT("\nWould you like to Delete them all?"), false);
@@ -258,6 +315,9 @@ void FMicroManagerModule::OnDeleteUnusedFoldersButtonClicked()
 
     for (const FString& EmptyFolderPath : EmptyFoldersPathsArrray)
     {
+        // A parent may already have been deleted along with this folder
+        if (!UEditorAssetLibrary::DoesDirectoryExist(EmptyFolderPath)) continue;
+
         // Deletes the empty folder recursively.
         //
         UEditorAssetLibrary::DeleteDirectory(EmptyFolderPath)?
@@ -277,33 +337,139 @@ void FMicroManagerModule::OnMicroManagerClicked()
 	FGlobalTabmanager::Get()->TryInvokeTab(FName("Micro Manager"));
 }
 
-void FMicroManagerModule::FixUpRedirectors()
+void FMicroManagerModule::OnToggleTextReferenceScanClicked()
 {
+	if (UMicroManagerSubsystem* MicroManagerSubsystem = UMicroManagerSubsystem::Get())
+	{
+		MicroManagerSubsystem->SetTextReferenceScanEnabled(!MicroManagerSubsystem->IsTextReferenceScanEnabled());
+	}
+}
 
-	TArray<UObjectRedirector*> RedirectorsToFixArray;
-	FAssetRegistryModule& AssetRegistryModule =
-	FModuleManager::Get().LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry"));
+bool FMicroManagerModule::IsTextReferenceScanEnabled() const
+{
+	const UMicroManagerSubsystem* MicroManagerSubsystem = UMicroManagerSubsystem::Get();
+	return MicroManagerSubsystem && MicroManagerSubsystem->IsTextReferenceScanEnabled();
+}
 
-	FARFilter Filter;
-	Filter.bRecursivePaths = true;
-	Filter.PackagePaths.Emplace("/Game");
-	Filter.ClassPaths.Emplace(FTopLevelAssetPath(TEXT("/Script/Engine"), TEXT("ObjectRedirector")));
+void FMicroManagerModule::AddCBAuditsSubMenu(FMenuBuilder& MenuBuilder)
+{
+	// Blueprint Hard References
+	MenuBuilder.AddMenuEntry(
+		FText::FromString(TEXT("Audit Blueprint Hard References")),
+		FText::FromString(TEXT("Ranks the Blueprints in the directory by the size their hard references load.")),
+		FSlateIcon(FMicroManagerStyle::GetStyleSetName(), "ContentBrowser.MicroManager"),
+		FExecuteAction::CreateRaw(this, &FMicroManagerModule::OnAuditBlueprintHardReferencesClicked)
+	);
 
-	TArray<FAssetData> OutRedirectors;
-	AssetRegistryModule.Get().GetAssets(Filter,OutRedirectors);
+	// Asset Load Profile
+	MenuBuilder.AddMenuEntry(
+		FText::FromString(TEXT("Profile Asset Loads")),
+		FText::FromString(TEXT("Loads every asset in the directory in isolation and records load time, packages pulled in and memory.")),
+		FSlateIcon(FMicroManagerStyle::GetStyleSetName(), "ContentBrowser.MicroManager"),
+		FExecuteAction::CreateRaw(this, &FMicroManagerModule::OnProfileAssetLoadsClicked)
+	);
 
-	for(const FAssetData& RedirectorData:OutRedirectors)
-	{
-		if(UObjectRedirector* RedirectorToFix = Cast<UObjectRedirector>(RedirectorData.GetAsset()))
-		{
-			RedirectorsToFixArray.Add(RedirectorToFix);
-		}
-	}
+	// Duplicate Materials
+	MenuBuilder.AddMenuEntry(
+		FText::FromString(TEXT("Find Duplicate Materials")),
+		FText::FromString(TEXT("Groups structurally equivalent materials and instances in the directory and offers to consolidate them.")),
+		FSlateIcon(FMicroManagerStyle::GetStyleSetName(), "ContentBrowser.MicroManager"),
+		FExecuteAction::CreateRaw(this, &FMicroManagerModule::OnFindDuplicateMaterialsClicked)
+	);
 
-	FAssetToolsModule& AssetToolsModule =
-	FModuleManager::LoadModuleChecked<FAssetToolsModule>(TEXT("AssetTools"));
+	// Material Shader Cost
+	MenuBuilder.AddMenuEntry(
+		FText::FromString(TEXT("Report Material Shader Cost")),
+		FText::FromString(TEXT("Compiles the materials in the directory and flags the ones over the instruction, sampler, shader or usage budget.")),
+		FSlateIcon(FMicroManagerStyle::GetStyleSetName(), "ContentBrowser.MicroManager"),
+		FExecuteAction::CreateRaw(this, &FMicroManagerModule::OnReportShaderCostClicked)
+	);
 
-	AssetToolsModule.Get().FixupReferencers(RedirectorsToFixArray);
+	// Sound Memory
+	MenuBuilder.AddMenuEntry(
+		FText::FromString(TEXT("Audit Sound Memory")),
+		FText::FromString(TEXT("Reports the format, loading behavior and memory of the sound waves in the directory and offers to stream the long ones.")),
+		FSlateIcon(FMicroManagerStyle::GetStyleSetName(), "ContentBrowser.MicroManager"),
+		FExecuteAction::CreateRaw(this, &FMicroManagerModule::OnAuditSoundsClicked)
+	);
+
+	// Static Mesh Budget
+	MenuBuilder.AddMenuEntry(
+		FText::FromString(TEXT("Audit Static Meshes")),
+		FText::FromString(TEXT("Flags the static meshes in the directory over the triangle, LOD, collision or lightmap budget and offers batch fixes.")),
+		FSlateIcon(FMicroManagerStyle::GetStyleSetName(), "ContentBrowser.MicroManager"),
+		FExecuteAction::CreateRaw(this, &FMicroManagerModule::OnAuditStaticMeshesClicked)
+	);
+
+	// Niagara Performance
+	MenuBuilder.AddMenuEntry(
+		FText::FromString(TEXT("Audit Niagara Systems")),
+		FText::FromString(TEXT("Reports the bounds, emitters, particle counts, culling and warmup of the Niagara systems in the directory.")),
+		FSlateIcon(FMicroManagerStyle::GetStyleSetName(), "ContentBrowser.MicroManager"),
+		FExecuteAction::CreateRaw(this, &FMicroManagerModule::OnAuditNiagaraSystemsClicked)
+	);
+
+	MenuBuilder.AddMenuSeparator();
+
+	// Project Snapshots
+	MenuBuilder.AddMenuEntry(
+		FText::FromString(TEXT("Take Project Snapshot")),
+		FText::FromString(TEXT("Saves the sizes and references of every asset in the project to compare them with a later milestone.")),
+		FSlateIcon(FMicroManagerStyle::GetStyleSetName(), "ContentBrowser.MicroManager"),
+		FExecuteAction::CreateRaw(this, &FMicroManagerModule::OnTakeProjectSnapshotClicked)
+	);
+
+	MenuBuilder.AddMenuEntry(
+		FText::FromString(TEXT("Diff Project Snapshots")),
+		FText::FromString(TEXT("Shows what was added, grew, became unused or gained heavy dependencies between two snapshots.")),
+		FSlateIcon(FMicroManagerStyle::GetStyleSetName(), "ContentBrowser.MicroManager"),
+		FExecuteAction::CreateRaw(this, &FMicroManagerModule::OnDiffProjectSnapshotsClicked)
+	);
+}
+
+void FMicroManagerModule::OnAuditBlueprintHardReferencesClicked()
+{
+	FMicroManagerBlueprintAudit::RunAndShowReport(GetAllAssetDataUnderSelectedFolders());
+}
+
+void FMicroManagerModule::OnProfileAssetLoadsClicked()
+{
+	FMicroManagerLoadProfiler::RunAndShowReport(GetAllAssetDataUnderSelectedFolders());
+}
+
+void FMicroManagerModule::OnFindDuplicateMaterialsClicked()
+{
+	FMicroManagerMaterialDuplicates::RunAndShowReport(GetAllAssetDataUnderSelectedFolders());
+}
+
+void FMicroManagerModule::OnReportShaderCostClicked()
+{
+	FMicroManagerShaderCostReport::RunAndShowReport(GetAllAssetDataUnderSelectedFolders());
+}
+
+void FMicroManagerModule::OnAuditSoundsClicked()
+{
+	FMicroManagerSoundAudit::RunAndShowReport(GetAllAssetDataUnderSelectedFolders());
+}
+
+void FMicroManagerModule::OnAuditStaticMeshesClicked()
+{
+	FMicroManagerMeshAudit::RunAndShowReport(GetAllAssetDataUnderSelectedFolders());
+}
+
+void FMicroManagerModule::OnAuditNiagaraSystemsClicked()
+{
+	FMicroManagerNiagaraAudit::RunAndShowReport(GetAllAssetDataUnderSelectedFolders());
+}
+
+void FMicroManagerModule::OnTakeProjectSnapshotClicked()
+{
+	FMicroManagerSnapshot::TakeProjectSnapshot();
+}
+
+void FMicroManagerModule::OnDiffProjectSnapshotsClicked()
+{
+	FMicroManagerSnapshot::PickAndShowDiff();
 }
 
 #pragma endregion
@@ -323,17 +489,16 @@ TSharedRef<SDockTab> FMicroManagerModule::OnSpawnMicroManagerTab(const FSpawnTab
 	return
 	SNew(SDockTab).TabRole(ETabRole::NomadTab)
 	[
+		// The tab opens empty and streams the folders in, gathering /Game can take a while
 		SNew(SMicroManagerTab)
-		.AssetsDataArray(GetAllAssetDataUnderSelectedFolders())
-		.CurrentSelectedFolder(FolderPathsSelected[0])
+		.FolderPathsToScan(FolderPathsSelected)
+		.CurrentSelectedFolder(FString::Join(FolderPathsSelected, TEXT("\n")))
 		
 	];
 }
 
 TArray<TSharedPtr<FAssetData>> FMicroManagerModule::GetAllAssetDataUnderSelectedFolders()
 {
-	TArray<TSharedPtr<FAssetData>> AvailableAssetsData;
-
 	// Get all asset paths under the selected folder
 	if (FolderPathsSelected.Num() == 0)
 	{
@@ -341,35 +506,8 @@ TArray<TSharedPtr<FAssetData>> FMicroManagerModule::GetAllAssetDataUnderSelected
 		return {}; // empty array to prevent crash
 	}
 
-	TArray<FString> AssetPathNames = UEditorAssetLibrary::ListAssets(FolderPathsSelected[0]);
-
-	for (const FString& AssetPath : AssetPathNames)
-	{
-		// ✅ Check the actual AssetPath here, not the full array
-		if (AssetPath.Contains(TEXT("Developers")) ||
-			AssetPath.Contains(TEXT("Collections")) ||
-			AssetPath.Contains(TEXT("_ExternalActors_")) ||
-			AssetPath.Contains(TEXT("_ExternalObjects_")) ||
-			AssetPath.Contains(TEXT("Maps")))
-		{
-			continue;
-		}
-
-		if (!UEditorAssetLibrary::DoesAssetExist(AssetPath))
-		{
-			continue;
-		}
-
-		const FAssetData Data = UEditorAssetLibrary::FindAssetData(AssetPath);
-		if (Data.IsValid())
-		{
-			AvailableAssetsData.Add(MakeShared<FAssetData>(Data));
-		}
-	}
-
-	UE_LOG(LogTemp, Warning, TEXT("Collected %d assets."), AvailableAssetsData.Num());
-
-	return AvailableAssetsData;
+	// The subsystem hands back the scan a tab may already hold for the same folders
+	return *UMicroManagerSubsystem::Get()->ScanFolders(FolderPathsSelected);
 }
 
 #pragma endregion
@@ -403,31 +541,6 @@ bool FMicroManagerModule::DeleteMultipleAssetsForAssetList(
 	return false;
 }
 
-void FMicroManagerModule::ListUnusedAssetsForAssetList(
-	const TArray<TSharedPtr<FAssetData>>& AssetsDataToFilter, 
-	TArray<TSharedPtr<FAssetData>>& OutUnusedAssetsData)
-{
-	OutUnusedAssetsData.Empty();
-
-	for (const TSharedPtr<FAssetData>& DataSharedPtr : AssetsDataToFilter)
-	{
-		if (!DataSharedPtr.IsValid())
-		{
-			continue;
-		}
-
-		FString AssetPath = DataSharedPtr->GetObjectPathString();
-
-		TArray<FString> AssetReferencers = 
-			UEditorAssetLibrary::FindPackageReferencersForAsset(AssetPath);
-
-		if (AssetReferencers.Num() == 0)
-		{
-			OutUnusedAssetsData.Add(DataSharedPtr);
-		}
-	}
-}
-
 /**
  * @brief Identifies assets with the same name from a given list and outputs them.
  * 
@@ -446,25 +559,96 @@ void FMicroManagerModule::ListSameNameAssetsForAssetList(const TArray<TSharedPtr
 {
 	OutSameNameAssetsData.Empty();
 
-	TMultiMap<FString, TSharedPtr<FAssetData>> AssetInfoMultiMap;
+	TArray<FString> AssetNames;
+	AssetNames.Reserve(AssetsDataToFilter.Num());
+	for (const TSharedPtr<FAssetData>& DataSharedPtr : AssetsDataToFilter)
+	{
+		AssetNames.Add(DataSharedPtr.IsValid() ? DataSharedPtr->AssetName.ToString() : FString());
+	}
+
+	// Assets sharing a name come out next to each other
+	TArray<int32> SameNameIndices;
+	MicroManagerCore::GroupSameNames(AssetNames, SameNameIndices);
+
+	for (const int32 SameNameIndex : SameNameIndices)
+	{
+		if (AssetsDataToFilter[SameNameIndex].IsValid() && !AssetNames[SameNameIndex].IsEmpty())
+		{
+			OutSameNameAssetsData.Add(AssetsDataToFilter[SameNameIndex]);
+		}
+	}
+}
+
+/**
+ * @brief Lists the biggest assets on disk from a given list.
+ * 
+ * Assets whose size was not computed yet by the size cache rank last, so the listing can be
+ * applied again once the background pass is done.
+ * 
+ * @param AssetsDataToFilter The asset data to rank.
+ * @param NumOfAssetsToList How many assets to keep.
+ * @param OutLargestAssetsData Cleared, then filled with the largest assets, biggest first.
+ */
+void FMicroManagerModule::ListLargestAssetsForAssetList(const TArray<TSharedPtr<FAssetData>>& AssetsDataToFilter,
+                                                        int32 NumOfAssetsToList,
+                                                        TArray<TSharedPtr<FAssetData>>& OutLargestAssetsData)
+{
+	OutLargestAssetsData.Empty();
+
+	const TSharedRef<FMicroManagerSizeCache> AssetSizeCache = UMicroManagerSubsystem::Get()->GetSizeCache();
 
 	for (const TSharedPtr<FAssetData>& DataSharedPtr : AssetsDataToFilter)
 	{
-		AssetInfoMultiMap.Emplace(DataSharedPtr->AssetName.ToString(), DataSharedPtr);
+		if (DataSharedPtr.IsValid())
+		{
+			OutLargestAssetsData.Add(DataSharedPtr);
+		}
+	}
+
+	OutLargestAssetsData.Sort([&AssetSizeCache](const TSharedPtr<FAssetData>& A, const TSharedPtr<FAssetData>& B)
+	{
+		return AssetSizeCache->GetDiskSize(A->PackageName) > AssetSizeCache->GetDiskSize(B->PackageName);
+	});
+
+	if (OutLargestAssetsData.Num() > NumOfAssetsToList)
+	{
+		OutLargestAssetsData.SetNum(FMath::Max(NumOfAssetsToList, 0));
 	}
+}
+
+/**
+ * @brief Lists the assets that drag in the most data through hard references.
+ * 
+ * An asset is flagged when its hard dependency closure, itself excluded, weighs at least
+ * LoadBloatThresholdMB on disk. The threshold is read again on each call, so ini edits apply
+ * without a restart. Worst offenders come first.
+ * 
+ * @param AssetsDataToFilter The asset data to check.
+ * @param OutLoadBloatAssetsData Cleared, then filled with the flagged assets.
+ */
+void FMicroManagerModule::ListLoadBloatAssetsForAssetList(const TArray<TSharedPtr<FAssetData>>& AssetsDataToFilter,
+                                                          TArray<TSharedPtr<FAssetData>>& OutLoadBloatAssetsData)
+{
+	OutLoadBloatAssetsData.Empty();
+
+	int32 ThresholdMB = LoadBloatThresholdMB;
+	FMicroManagerAuditBudget::Read(TEXT("LoadBloatThresholdMB"), ThresholdMB);
+	const int64 LoadBloatSizeThreshold = static_cast<int64>(ThresholdMB) * 1024 * 1024;
+
+	const TSharedRef<FMicroManagerSizeCache> AssetSizeCache = UMicroManagerSubsystem::Get()->GetSizeCache();
+
 	for (const TSharedPtr<FAssetData>& DataSharedPtr : AssetsDataToFilter)
 	{
-		TArray<TSharedPtr<FAssetData>> OutAssetsData;
-		AssetInfoMultiMap.MultiFind(DataSharedPtr->AssetName.ToString(), OutAssetsData);
-		if (OutAssetsData.Num() > 1) continue;
-		for (const TSharedPtr<FAssetData>& SameNameData : OutAssetsData)
+		if (DataSharedPtr.IsValid() && AssetSizeCache->GetDependencySize(DataSharedPtr->PackageName) >= LoadBloatSizeThreshold)
 		{
-			if (SameNameData.IsValid())
-			{
-				OutSameNameAssetsData.AddUnique(SameNameData);
-			}
+			OutLoadBloatAssetsData.Add(DataSharedPtr);
 		}
 	}
+
+	OutLoadBloatAssetsData.Sort([&AssetSizeCache](const TSharedPtr<FAssetData>& A, const TSharedPtr<FAssetData>& B)
+	{
+		return AssetSizeCache->GetDependencySize(A->PackageName) > AssetSizeCache->GetDependencySize(B->PackageName);
+	});
 }
 
 /**
@@ -485,8 +669,6 @@ void FMicroManagerModule::SyncCBToClickedAssetForAssetList(const FString& AssetP
 
 #pragma endregion
 
-
-
 void FMicroManagerModule::ShutdownModule()
 {
 	// This function may be called during shutdown to clean up your module.  For modules that support dynamic reloading,
@@ -0,0 +1,63 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Profiling/MicroManagerLoadProfileCommandlet.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Profiling/MicroManagerLoadProfiler.h"
+#include "Subsystems/MicroManagerSubsystem.h"
+
+UMicroManagerLoadProfileCommandlet::UMicroManagerLoadProfileCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = true;
+	LogToConsole = true;
+}
+
+int32 UMicroManagerLoadProfileCommandlet::Main(const FString& Params)
+{
+	FString PathsParam = TEXT("/Game");
+	FParse::Value(*Params, TEXT("Paths="), PathsParam, false);
+
+	TArray<FString> FolderPaths;
+	PathsParam.ParseIntoArray(FolderPaths, TEXT("+"));
+
+	FString CsvFilePath = FMicroManagerLoadProfiler::MakeDefaultCsvFilePath();
+	FParse::Value(*Params, TEXT("Output="), CsvFilePath);
+
+	// Commandlets start before the registry has discovered anything
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+	AssetRegistry.SearchAllAssets(true);
+
+	TArray<TSharedPtr<FAssetData>> AssetsData;
+	UMicroManagerSubsystem::GatherAssetDataUnderFolders(AssetRegistry, FolderPaths, AssetsData);
+
+	// Stable order so two runs can be compared line by line
+	AssetsData.Sort([](const TSharedPtr<FAssetData>& A, const TSharedPtr<FAssetData>& B)
+	{
+		return A->PackageName.LexicalLess(B->PackageName);
+	});
+
+	FMicroManagerLoadProfiler Profiler(CsvFilePath);
+	if (!Profiler.IsValid())
+	{
+		UE_LOG(LogTemp, Error, TEXT("MicroManagerLoadProfile: failed to create %s"), *CsvFilePath);
+		return 1;
+	}
+
+	UE_LOG(LogTemp, Display, TEXT("MicroManagerLoadProfile: profiling %d assets under %s into %s"),
+		AssetsData.Num(), *PathsParam, *CsvFilePath);
+
+	for (int32 AssetIndex = 0; AssetIndex < AssetsData.Num(); ++AssetIndex)
+	{
+		const FMicroManagerLoadSample Sample = Profiler.ProfileAsset(*AssetsData[AssetIndex]);
+
+		UE_LOG(LogTemp, Display, TEXT("[%d/%d] %s: %s, %.1f ms, %d packages, %lld bytes"),
+			AssetIndex + 1, AssetsData.Num(), *Sample.PackageName.ToString(), FMicroManagerLoadProfiler::LexToString(Sample.Status),
+			Sample.LoadSeconds * 1000.0, Sample.PackagesLoaded, Sample.MemoryDelta);
+	}
+
+	Profiler.Finish();
+
+	return 0;
+}
@@ -0,0 +1,213 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Profiling/MicroManagerLoadProfiler.h"
+#include "DebugHelper.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformMemory.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopedSlowTask.h"
+#include "PackageTools.h"
+#include "SlateWidgets/MicroManagerReportWidget.h"
+#include "UObject/UObjectHash.h"
+
+namespace LoadProfileColumns
+{
+	static const FName Name(TEXT("Name"));
+	static const FName Class(TEXT("Class"));
+	static const FName Status(TEXT("Status"));
+	static const FName LoadTime(TEXT("LoadTime"));
+	static const FName PackagesLoaded(TEXT("PackagesLoaded"));
+	static const FName MemoryDelta(TEXT("MemoryDelta"));
+}
+
+FMicroManagerLoadProfiler::FMicroManagerLoadProfiler(const FString& InCsvFilePath)
+	: CsvFilePath(InCsvFilePath)
+{
+	CsvWriter.Reset(IFileManager::Get().CreateFileWriter(*CsvFilePath));
+	WriteCsvLine(TEXT("Package,Class,Status,LoadMs,PackagesLoaded,MemoryDeltaBytes"));
+}
+
+FMicroManagerLoadProfiler::~FMicroManagerLoadProfiler()
+{
+	if (CsvWriter.IsValid())
+	{
+		CsvWriter->Close();
+	}
+}
+
+FMicroManagerLoadSample FMicroManagerLoadProfiler::ProfileAsset(const FAssetData& AssetData)
+{
+	FMicroManagerLoadSample Sample;
+	Sample.PackageName = AssetData.PackageName;
+	Sample.AssetClass = AssetData.AssetClassPath.GetAssetName().ToString();
+
+	if (FindPackage(nullptr, *AssetData.PackageName.ToString()))
+	{
+		Sample.Status = EMicroManagerLoadSampleStatus::AlreadyLoaded;
+	}
+	else
+	{
+		// Whatever is in memory now belongs to the user or to an earlier sample that could not be unloaded, it stays
+		TSet<UPackage*> PackagesBefore;
+		GetLoadedPackages(PackagesBefore);
+
+		const int64 MemoryBefore = static_cast<int64>(FPlatformMemory::GetStats().UsedPhysical);
+		const double StartSeconds = FPlatformTime::Seconds();
+
+		const UPackage* LoadedPackage = LoadPackage(nullptr, *AssetData.PackageName.ToString(), LOAD_None);
+
+		Sample.LoadSeconds = FPlatformTime::Seconds() - StartSeconds;
+		Sample.MemoryDelta = static_cast<int64>(FPlatformMemory::GetStats().UsedPhysical) - MemoryBefore;
+		Sample.Status = LoadedPackage ? EMicroManagerLoadSampleStatus::Loaded : EMicroManagerLoadSampleStatus::Failed;
+
+		TSet<UPackage*> PackagesAfter;
+		GetLoadedPackages(PackagesAfter);
+
+		TArray<UPackage*> PackagesToUnload;
+		for (UPackage* Package : PackagesAfter)
+		{
+			if (!PackagesBefore.Contains(Package) && Package != GetTransientPackage())
+			{
+				PackagesToUnload.Add(Package);
+			}
+		}
+		Sample.PackagesLoaded = PackagesToUnload.Num();
+
+		// A garbage collection alone would keep them, the editor loads assets with RF_Standalone
+		FText UnloadError;
+		if (PackagesToUnload.Num() > 0 && !UPackageTools::UnloadPackages(PackagesToUnload, UnloadError))
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Load profile of %s: %s"), *AssetData.PackageName.ToString(), *UnloadError.ToString());
+		}
+	}
+
+	WriteCsvLine(FString::Printf(TEXT("%s,%s,%s,%.3f,%d,%lld"),
+		*EscapeCsvField(Sample.PackageName.ToString()), *EscapeCsvField(Sample.AssetClass), LexToString(Sample.Status),
+		Sample.LoadSeconds * 1000.0, Sample.PackagesLoaded, Sample.MemoryDelta));
+
+	return Sample;
+}
+
+void FMicroManagerLoadProfiler::Finish()
+{
+	if (CsvWriter.IsValid())
+	{
+		CsvWriter->Close();
+		CsvWriter.Reset();
+	}
+}
+
+FString FMicroManagerLoadProfiler::MakeDefaultCsvFilePath()
+{
+	return FPaths::ProjectSavedDir() / TEXT("MicroManager") / TEXT("LoadProfiles")
+		/ FString::Printf(TEXT("LoadProfile_%s.csv"), *FDateTime::Now().ToString());
+}
+
+const TCHAR* FMicroManagerLoadProfiler::LexToString(EMicroManagerLoadSampleStatus Status)
+{
+	switch (Status)
+	{
+	case EMicroManagerLoadSampleStatus::Loaded: return TEXT("Loaded");
+	case EMicroManagerLoadSampleStatus::AlreadyLoaded: return TEXT("AlreadyLoaded");
+	default: return TEXT("Failed");
+	}
+}
+
+void FMicroManagerLoadProfiler::RunAndShowReport(const TArray<TSharedPtr<FAssetData>>& AssetsData)
+{
+	if (AssetsData.Num() == 0)
+	{
+		DebugHelper::ShowMsgDialog(EAppMsgType::Ok, TEXT("No asset to profile"));
+		return;
+	}
+
+	const EAppReturnType::Type ConfirmResult = DebugHelper::ShowMsgDialog(EAppMsgType::YesNo, FString::Printf(
+		TEXT("Load %d assets one at a time to profile them?\nWhat each asset loads is unloaded before the next one, this can take a while."),
+		AssetsData.Num()), false);
+	if (ConfirmResult == EAppReturnType::No) return;
+
+	FMicroManagerLoadProfiler Profiler(MakeDefaultCsvFilePath());
+	if (!Profiler.IsValid())
+	{
+		DebugHelper::ShowMsgDialog(EAppMsgType::Ok, TEXT("Failed to create ") + Profiler.GetCsvFilePath());
+		return;
+	}
+
+	TArray<TSharedPtr<FMicroManagerReportRow>> Rows;
+	int32 AlreadyLoadedCount = 0;
+	{
+		FScopedSlowTask SlowTask(AssetsData.Num(), FText::FromString(TEXT("Profiling asset loads...")));
+		SlowTask.MakeDialog(true);
+
+		for (const TSharedPtr<FAssetData>& AssetData : AssetsData)
+		{
+			if (SlowTask.ShouldCancel()) break;
+			SlowTask.EnterProgressFrame(1.f, FText::FromName(AssetData->AssetName));
+
+			const FMicroManagerLoadSample Sample = Profiler.ProfileAsset(*AssetData);
+			AlreadyLoadedCount += Sample.Status == EMicroManagerLoadSampleStatus::AlreadyLoaded ? 1 : 0;
+
+			TSharedPtr<FMicroManagerReportRow> Row = MakeShared<FMicroManagerReportRow>();
+			Row->SetText(LoadProfileColumns::Name, Sample.PackageName.ToString());
+			Row->SetText(LoadProfileColumns::Class, Sample.AssetClass);
+			Row->SetText(LoadProfileColumns::Status, LexToString(Sample.Status));
+			Row->SetValue(LoadProfileColumns::LoadTime, Sample.LoadSeconds, FString::Printf(TEXT("%.1f ms"), Sample.LoadSeconds * 1000.0));
+			Row->SetValue(LoadProfileColumns::PackagesLoaded, Sample.PackagesLoaded, FString::FromInt(Sample.PackagesLoaded));
+			Row->SetSize(LoadProfileColumns::MemoryDelta, Sample.MemoryDelta);
+			Row->AssetPath = AssetData->GetSoftObjectPath();
+			Rows.Add(Row);
+		}
+	}
+
+	Profiler.Finish();
+
+	FString Summary = FString::Printf(TEXT("%d assets profiled, samples written to %s"), Rows.Num(), *Profiler.GetCsvFilePath());
+	if (AlreadyLoadedCount > 0)
+	{
+		Summary += FString::Printf(TEXT("\n%d assets were already in memory and could not be measured, run the MicroManagerLoadProfile commandlet to profile them in isolation."),
+			AlreadyLoadedCount);
+	}
+
+	SMicroManagerReportView::OpenInWindow(TEXT("Asset Load Profile"), Summary,
+	{
+		{ LoadProfileColumns::Name, TEXT("Asset"), 0.4f, false },
+		{ LoadProfileColumns::Class, TEXT("Class"), 0.15f, false },
+		{ LoadProfileColumns::Status, TEXT("Status"), 0.1f, false },
+		{ LoadProfileColumns::LoadTime, TEXT("Load Time"), 0.1f, true },
+		{ LoadProfileColumns::PackagesLoaded, TEXT("Packages"), 0.1f, true },
+		{ LoadProfileColumns::MemoryDelta, TEXT("Memory Delta"), 0.15f, true },
+	}, Rows, LoadProfileColumns::LoadTime);
+}
+
+void FMicroManagerLoadProfiler::WriteCsvLine(const FString& Line)
+{
+	if (!CsvWriter.IsValid()) return;
+
+	FTCHARToUTF8 Utf8Line(*(Line + LINE_TERMINATOR));
+	CsvWriter->Serialize(const_cast<ANSICHAR*>(Utf8Line.Get()), Utf8Line.Length());
+	CsvWriter->Flush();
+}
+
+void FMicroManagerLoadProfiler::GetLoadedPackages(TSet<UPackage*>& OutPackages)
+{
+	TArray<UObject*> Packages;
+	GetObjectsOfClass(UPackage::StaticClass(), Packages, false);
+
+	OutPackages.Reserve(Packages.Num());
+	for (UObject* Package : Packages)
+	{
+		OutPackages.Add(CastChecked<UPackage>(Package));
+	}
+}
+
+FString FMicroManagerLoadProfiler::EscapeCsvField(const FString& Field)
+{
+	bool bNeedsQuotes = false;
+	for (const TCHAR Character : Field)
+	{
+		bNeedsQuotes |= Character == TEXT(',') || Character == TEXT('"') || Character == TEXT('\n') || Character == TEXT('\r');
+	}
+
+	return bNeedsQuotes ? TEXT("\"") + Field.Replace(TEXT("\""), TEXT("\"\"")) + TEXT("\"") : Field;
+}
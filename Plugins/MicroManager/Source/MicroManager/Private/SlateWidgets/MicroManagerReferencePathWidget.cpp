@@ -0,0 +1,152 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "SlateWidgets/MicroManagerReferencePathWidget.h"
+#include "AssetAnalysis/MicroManagerDependencyGraph.h"
+#include "DebugHelper.h"
+#include "MicroManager.h"
+#include "Framework/Application/SlateApplication.h"
+#include "Widgets/SWindow.h"
+
+namespace
+{
+	FString GetRootReasonText(const EMicroManagerRootFlags RootFlags)
+	{
+		TArray<FString> Reasons;
+		if (EnumHasAnyFlags(RootFlags, EMicroManagerRootFlags::Map)) Reasons.Add(TEXT("Map"));
+		if (EnumHasAnyFlags(RootFlags, EMicroManagerRootFlags::PrimaryAsset)) Reasons.Add(TEXT("Primary Asset"));
+		if (EnumHasAnyFlags(RootFlags, EMicroManagerRootFlags::ConfigReference)) Reasons.Add(TEXT("Config Reference"));
+
+		return FString::Join(Reasons, TEXT(", "));
+	}
+}
+
+void SMicroManagerReferencePathView::Construct(const FArguments& InArgs)
+{
+	const TSharedPtr<const FMicroManagerDependencyGraph> DependencyGraph = InArgs._DependencyGraph;
+	const TArray<int32>& ReferencePath = InArgs._ReferencePath;
+
+	FString HeaderText;
+
+	if (!DependencyGraph.IsValid() || ReferencePath.Num() == 0)
+	{
+		HeaderText = InArgs._AssetPackageName.ToString() + TEXT("\nis not reached by any map, primary asset or config reference.");
+	}
+	else
+	{
+		HeaderText = FString::Printf(TEXT("%s\nis used through %d reference(s), found in %.2f ms"),
+			*InArgs._AssetPackageName.ToString(), ReferencePath.Num() - 1, InArgs._QueryMilliseconds);
+
+		// Chain the hops so every item has the next referencer as its only child
+		TSharedPtr<FMicroManagerReferencePathItem> ParentItem;
+		for (const int32 PathNode : ReferencePath)
+		{
+			TSharedPtr<FMicroManagerReferencePathItem> PathItem = MakeShared<FMicroManagerReferencePathItem>();
+			PathItem->PackageName = DependencyGraph->GetPackageName(PathNode);
+			PathItem->RootReason = GetRootReasonText(DependencyGraph->GetRootFlags(PathNode));
+
+			if (ParentItem.IsValid())
+			{
+				ParentItem->Referencers.Add(PathItem);
+			}
+			else
+			{
+				RootItems.Add(PathItem);
+			}
+			ParentItem = PathItem;
+		}
+	}
+
+	ChildSlot
+	[
+		SNew(SVerticalBox)
+
+		+ SVerticalBox::Slot()
+		.AutoHeight()
+		.Padding(5.f)
+		[
+			SNew(STextBlock)
+			.Text(FText::FromString(HeaderText))
+			.AutoWrapText(true)
+		]
+
+		+ SVerticalBox::Slot()
+		.FillHeight(1.f)
+		.Padding(5.f)
+		[
+			SAssignNew(ConstructedTreeView, STreeView<TSharedPtr<FMicroManagerReferencePathItem>>)
+			.TreeItemsSource(&RootItems)
+			.OnGenerateRow(this, &SMicroManagerReferencePathView::OnGenerateRowForTree)
+			.OnGetChildren(this, &SMicroManagerReferencePathView::OnGetChildrenForTree)
+			.OnMouseButtonDoubleClick(this, &SMicroManagerReferencePathView::OnTreeItemDoubleClicked)
+		]
+	];
+
+	for (const TSharedPtr<FMicroManagerReferencePathItem>& RootItem : RootItems)
+	{
+		ExpandAllItems(RootItem);
+	}
+}
+
+void SMicroManagerReferencePathView::OpenInWindow(TSharedRef<const FMicroManagerDependencyGraph> DependencyGraph, FName AssetPackageName)
+{
+	const double QueryStartTime = FPlatformTime::Seconds();
+
+	TArray<int32> ReferencePath;
+	DependencyGraph->FindShortestPathToRoot(DependencyGraph->FindNode(AssetPackageName), ReferencePath);
+
+	const double QueryMilliseconds = (FPlatformTime::Seconds() - QueryStartTime) * 1000.0;
+	DebugHelper::PrintLog(FString::Printf(TEXT("Reference path query for %s took %.2f ms"), *AssetPackageName.ToString(), QueryMilliseconds));
+
+	TSharedRef<SWindow> PathWindow = SNew(SWindow)
+	.Title(FText::FromString(TEXT("Why is this asset used?")))
+	.ClientSize(FVector2D(700.f, 400.f))
+	[
+		SNew(SMicroManagerReferencePathView)
+		.DependencyGraph(DependencyGraph)
+		.ReferencePath(ReferencePath)
+		.AssetPackageName(AssetPackageName)
+		.QueryMilliseconds(QueryMilliseconds)
+	];
+
+	FSlateApplication::Get().AddWindow(PathWindow);
+}
+
+TSharedRef<ITableRow> SMicroManagerReferencePathView::OnGenerateRowForTree(TSharedPtr<FMicroManagerReferencePathItem> Item,
+	const TSharedRef<STableViewBase>& OwnerTable)
+{
+	const FString RowText = Item->RootReason.IsEmpty() ?
+		Item->PackageName.ToString() :
+		FString::Printf(TEXT("%s  [%s]"), *Item->PackageName.ToString(), *Item->RootReason);
+
+	return SNew(STableRow<TSharedPtr<FMicroManagerReferencePathItem>>, OwnerTable).Padding(FMargin(2.0f))
+	[
+		SNew(STextBlock)
+		.Text(FText::FromString(RowText))
+		.ColorAndOpacity(Item->RootReason.IsEmpty() ? FSlateColor(FColor::White) : FSlateColor(FColor::Emerald))
+	];
+}
+
+void SMicroManagerReferencePathView::OnGetChildrenForTree(TSharedPtr<FMicroManagerReferencePathItem> Item,
+	TArray<TSharedPtr<FMicroManagerReferencePathItem>>& OutChildren)
+{
+	OutChildren.Append(Item->Referencers);
+}
+
+void SMicroManagerReferencePathView::OnTreeItemDoubleClicked(TSharedPtr<FMicroManagerReferencePathItem> Item)
+{
+	if (!Item.IsValid()) return;
+
+	FMicroManagerModule& MicroManagerModule = FModuleManager::LoadModuleChecked<FMicroManagerModule>(TEXT("MicroManager"));
+	MicroManagerModule.SyncCBToClickedAssetForAssetList(Item->PackageName.ToString());
+}
+
+void SMicroManagerReferencePathView::ExpandAllItems(const TSharedPtr<FMicroManagerReferencePathItem>& Item)
+{
+	ConstructedTreeView->SetItemExpansion(Item, true);
+
+	for (const TSharedPtr<FMicroManagerReferencePathItem>& Referencer : Item->Referencers)
+	{
+		ExpandAllItems(Referencer);
+	}
+}
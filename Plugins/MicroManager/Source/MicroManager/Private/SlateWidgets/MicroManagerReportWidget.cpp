@@ -0,0 +1,284 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "SlateWidgets/MicroManagerReportWidget.h"
+#include "EditorAssetLibrary.h"
+#include "Framework/Application/SlateApplication.h"
+#include "Widgets/Input/SButton.h"
+#include "Widgets/Input/SSearchBox.h"
+#include "Widgets/SWindow.h"
+
+namespace
+{
+	const FName ActionColumnId(TEXT("ReportAction"));
+
+	/**
+	 * Row of a report, every cell is looked up from the row texts
+	 */
+	class SMicroManagerReportRow : public SMultiColumnTableRow<TSharedPtr<FMicroManagerReportRow>>
+	{
+	public:
+		SLATE_BEGIN_ARGS(SMicroManagerReportRow) {}
+			SLATE_ARGUMENT(TSharedPtr<FMicroManagerReportRow>, Item)
+			SLATE_ARGUMENT(FName, FirstColumn)
+		SLATE_END_ARGS()
+
+		void Construct(const FArguments& InArgs, const TSharedRef<STableViewBase>& OwnerTable)
+		{
+			Item = InArgs._Item;
+			FirstColumn = InArgs._FirstColumn;
+
+			SMultiColumnTableRow<TSharedPtr<FMicroManagerReportRow>>::Construct(FSuperRowType::FArguments().Padding(FMargin(2.0f)), OwnerTable);
+		}
+
+		virtual TSharedRef<SWidget> GenerateWidgetForColumn(const FName& ColumnName) override
+		{
+			if (ColumnName == ActionColumnId)
+			{
+				if (!Item->OnAction.IsBound()) return SNullWidget::NullWidget;
+
+				TSharedPtr<FMicroManagerReportRow> ActionItem = Item;
+				return SNew(SButton)
+					.Text(FText::FromString(Item->ActionLabel))
+					.IsEnabled_Lambda([ActionItem]() { return !ActionItem->bIsActionDone; })
+					.OnClicked_Lambda([ActionItem]()
+					{
+						ActionItem->bIsActionDone = ActionItem->OnAction.Execute();
+						return FReply::Handled();
+					});
+			}
+
+			const FString* CellText = Item->Texts.Find(ColumnName);
+
+			TSharedRef<STextBlock> CellTextBlock = SNew(STextBlock)
+				.Text(FText::FromString(CellText ? *CellText : FString()))
+				.ToolTipText(FText::FromString(CellText ? *CellText : FString()));
+
+			// The first column carries the expander arrow of the children
+			if (ColumnName == FirstColumn)
+			{
+				return SNew(SHorizontalBox)
+				+ SHorizontalBox::Slot()
+				.AutoWidth()
+				[
+					SNew(SExpanderArrow, SharedThis(this))
+				]
+				+ SHorizontalBox::Slot()
+				.FillWidth(1.f)
+				[
+					CellTextBlock
+				];
+			}
+
+			return CellTextBlock;
+		}
+
+	private:
+		TSharedPtr<FMicroManagerReportRow> Item;
+		FName FirstColumn;
+	};
+}
+
+void SMicroManagerReportView::Construct(const FArguments& InArgs)
+{
+	Columns = InArgs._Columns;
+	AllRows = InArgs._Rows;
+
+	if (HasAnyAction(AllRows))
+	{
+		Columns.Add({ ActionColumnId, TEXT("Action"), 0.12f, false });
+	}
+	SortByColumn = InArgs._InitialSortColumn;
+	SortMode = SortByColumn.IsNone() ? EColumnSortMode::None : EColumnSortMode::Descending;
+
+	RefreshRows();
+
+	ChildSlot
+	[
+		SNew(SVerticalBox)
+
+		+ SVerticalBox::Slot()
+		.AutoHeight()
+		.Padding(5.f)
+		[
+			SNew(STextBlock)
+			.Text(FText::FromString(InArgs._Summary))
+			.AutoWrapText(true)
+		]
+
+		+ SVerticalBox::Slot()
+		.AutoHeight()
+		.Padding(5.f, 2.f)
+		[
+			SNew(SSearchBox)
+			.HintText(FText::FromString(TEXT("Filter rows")))
+			.OnTextChanged(this, &SMicroManagerReportView::OnFilterTextChanged)
+		]
+
+		+ SVerticalBox::Slot()
+		.FillHeight(1.f)
+		.Padding(5.f)
+		[
+			SAssignNew(ConstructedTreeView, STreeView<TSharedPtr<FMicroManagerReportRow>>)
+			.TreeItemsSource(&FilteredRows)
+			.HeaderRow(ConstructHeaderRow())
+			.OnGenerateRow(this, &SMicroManagerReportView::OnGenerateRowForTree)
+			.OnGetChildren(this, &SMicroManagerReportView::OnGetChildrenForTree)
+			.OnMouseButtonDoubleClick(this, &SMicroManagerReportView::OnTreeItemDoubleClicked)
+		]
+	];
+}
+
+void SMicroManagerReportView::OpenInWindow(const FString& Title, const FString& Summary, const TArray<FMicroManagerReportColumn>& Columns,
+	const TArray<TSharedPtr<FMicroManagerReportRow>>& Rows, FName InitialSortColumn)
+{
+	TSharedRef<SWindow> ReportWindow = SNew(SWindow)
+	.Title(FText::FromString(Title))
+	.ClientSize(FVector2D(1000.f, 600.f))
+	[
+		SNew(SMicroManagerReportView)
+		.Columns(Columns)
+		.Rows(Rows)
+		.Summary(Summary)
+		.InitialSortColumn(InitialSortColumn)
+	];
+
+	FSlateApplication::Get().AddWindow(ReportWindow);
+}
+
+bool SMicroManagerReportView::HasAnyAction(const TArray<TSharedPtr<FMicroManagerReportRow>>& Rows)
+{
+	return Rows.ContainsByPredicate([](const TSharedPtr<FMicroManagerReportRow>& Row)
+	{
+		return Row->OnAction.IsBound() || HasAnyAction(Row->Children);
+	});
+}
+
+TSharedRef<SHeaderRow> SMicroManagerReportView::ConstructHeaderRow()
+{
+	TSharedRef<SHeaderRow> HeaderRow = SNew(SHeaderRow);
+
+	for (const FMicroManagerReportColumn& Column : Columns)
+	{
+		HeaderRow->AddColumn(SHeaderRow::Column(Column.Id)
+			.DefaultLabel(FText::FromString(Column.Label))
+			.FillWidth(Column.FillWidth)
+			.SortMode(this, &SMicroManagerReportView::GetSortModeForColumn, Column.Id)
+			.OnSort(this, &SMicroManagerReportView::OnColumnSortModeChanged));
+	}
+
+	return HeaderRow;
+}
+
+TSharedRef<ITableRow> SMicroManagerReportView::OnGenerateRowForTree(TSharedPtr<FMicroManagerReportRow> Item,
+	const TSharedRef<STableViewBase>& OwnerTable)
+{
+	return SNew(SMicroManagerReportRow, OwnerTable)
+	.Item(Item)
+	.FirstColumn(Columns.Num() > 0 ? Columns[0].Id : NAME_None);
+}
+
+void SMicroManagerReportView::OnGetChildrenForTree(TSharedPtr<FMicroManagerReportRow> Item,
+	TArray<TSharedPtr<FMicroManagerReportRow>>& OutChildren)
+{
+	OutChildren.Append(Item->Children);
+}
+
+void SMicroManagerReportView::OnTreeItemDoubleClicked(TSharedPtr<FMicroManagerReportRow> Item)
+{
+	if (!Item.IsValid()) return;
+
+	if (Item->OnNavigate.IsBound())
+	{
+		Item->OnNavigate.Execute();
+		return;
+	}
+
+	if (Item->AssetPath.IsValid())
+	{
+		UEditorAssetLibrary::SyncBrowserToObjects({ Item->AssetPath.ToString() });
+	}
+}
+
+void SMicroManagerReportView::OnFilterTextChanged(const FText& NewFilterText)
+{
+	FilterText = NewFilterText.ToString();
+	RefreshRows();
+}
+
+EColumnSortMode::Type SMicroManagerReportView::GetSortModeForColumn(const FName ColumnId) const
+{
+	return SortByColumn == ColumnId ? SortMode : EColumnSortMode::None;
+}
+
+void SMicroManagerReportView::OnColumnSortModeChanged(const EColumnSortPriority::Type SortPriority, const FName& ColumnId,
+	const EColumnSortMode::Type NewSortMode)
+{
+	SortByColumn = ColumnId;
+	SortMode = NewSortMode;
+	RefreshRows();
+}
+
+void SMicroManagerReportView::RefreshRows()
+{
+	FilteredRows.Reset();
+
+	for (const TSharedPtr<FMicroManagerReportRow>& Row : AllRows)
+	{
+		bool bPassesFilter = FilterText.IsEmpty();
+		for (const TPair<FName, FString>& Text : Row->Texts)
+		{
+			if (bPassesFilter) break;
+			bPassesFilter = Text.Value.Contains(FilterText);
+		}
+
+		if (bPassesFilter)
+		{
+			FilteredRows.Add(Row);
+		}
+	}
+
+	SortRows(FilteredRows);
+
+	if (ConstructedTreeView.IsValid())
+	{
+		ConstructedTreeView->RequestTreeRefresh();
+	}
+}
+
+void SMicroManagerReportView::SortRows(TArray<TSharedPtr<FMicroManagerReportRow>>& RowsToSort) const
+{
+	if (SortMode == EColumnSortMode::None || SortByColumn.IsNone()) return;
+
+	const FMicroManagerReportColumn* SortColumn = Columns.FindByPredicate([this](const FMicroManagerReportColumn& Column)
+	{
+		return Column.Id == SortByColumn;
+	});
+	if (!SortColumn) return;
+
+	const bool bAscending = SortMode == EColumnSortMode::Ascending;
+	const bool bIsNumeric = SortColumn->bIsNumeric;
+	const FName ColumnId = SortByColumn;
+
+	RowsToSort.StableSort([bAscending, bIsNumeric, ColumnId](const TSharedPtr<FMicroManagerReportRow>& A, const TSharedPtr<FMicroManagerReportRow>& B)
+	{
+		int32 Comparison = 0;
+		if (bIsNumeric)
+		{
+			const double ValueA = A->Values.FindRef(ColumnId);
+			const double ValueB = B->Values.FindRef(ColumnId);
+			Comparison = ValueA < ValueB ? -1 : (ValueA > ValueB ? 1 : 0);
+		}
+		else
+		{
+			Comparison = A->Texts.FindRef(ColumnId).Compare(B->Texts.FindRef(ColumnId), ESearchCase::IgnoreCase);
+		}
+
+		return bAscending ? Comparison < 0 : Comparison > 0;
+	});
+
+	for (const TSharedPtr<FMicroManagerReportRow>& Row : RowsToSort)
+	{
+		SortRows(Row->Children);
+	}
+}
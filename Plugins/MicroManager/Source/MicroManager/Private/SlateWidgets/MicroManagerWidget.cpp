@@ -2,41 +2,99 @@
 //#include "SlateBasics.h"
 #include "DebugHelper.h"
 #include "MicroManager.h"
+#include "AssetAnalysis/MicroManagerNameIndex.h"
+#include "AssetAnalysis/MicroManagerScanExport.h"
+#include "AssetAnalysis/MicroManagerSizeCache.h"
+#include "Async/Async.h"
+#include "DesktopPlatformModule.h"
+#include "Framework/Application/SlateApplication.h"
+#include "IDesktopPlatform.h"
+#include "SlateWidgets/MicroManagerReferencePathWidget.h"
+#include "Misc/ConfigCacheIni.h"
+#include "Misc/Paths.h"
+#include "Profiling/MicroManagerLoadProfiler.h"
+#include "Widgets/Input/SEditableTextBox.h"
+#include "Widgets/Input/SSearchBox.h"
+#include "Widgets/Input/SSpinBox.h"
+#include "Widgets/Notifications/SProgressBar.h"
 
 
 
 #define ListAll TEXT("List All Available Assets")
 #define ListUnused TEXT("List Unused Assets")
 #define ListSameName TEXT("List Assets with Same Name")
+#define ListLargest TEXT("List Top N Assets by Size")
+#define ListLoadBloat TEXT("List Load-Bloat Offenders")
+
+namespace MicroManagerColumns
+{
+	static const FName CheckBox(TEXT("CheckBox"));
+	static const FName Class(TEXT("Class"));
+	static const FName Name(TEXT("Name"));
+	static const FName DiskSize(TEXT("DiskSize"));
+	static const FName ResourceSize(TEXT("ResourceSize"));
+	static const FName DependencySize(TEXT("DependencySize"));
+	static const FName Actions(TEXT("Actions"));
+}
+
+/**
+ * Row of the asset list, the tab builds every cell so all the row logic stays in SMicroManagerTab
+ */
+class SMicroManagerAssetRow : public SMultiColumnTableRow<TSharedPtr<FAssetData>>
+{
+public:
+	DECLARE_DELEGATE_RetVal_TwoParams(TSharedRef<SWidget>, FOnGenerateCell, TSharedPtr<FAssetData>, const FName&);
+
+	SLATE_BEGIN_ARGS(SMicroManagerAssetRow) {}
+		SLATE_ARGUMENT(TSharedPtr<FAssetData>, AssetData)
+		SLATE_EVENT(FOnGenerateCell, OnGenerateCell)
+	SLATE_END_ARGS()
+
+	void Construct(const FArguments& InArgs, const TSharedRef<STableViewBase>& OwnerTable)
+	{
+		AssetData = InArgs._AssetData;
+		OnGenerateCell = InArgs._OnGenerateCell;
+
+		SMultiColumnTableRow<TSharedPtr<FAssetData>>::Construct(FSuperRowType::FArguments().Padding(FMargin(2.0f)), OwnerTable);
+	}
+
+	virtual TSharedRef<SWidget> GenerateWidgetForColumn(const FName& ColumnName) override
+	{
+		return OnGenerateCell.IsBound() ? OnGenerateCell.Execute(AssetData, ColumnName) : SNullWidget::NullWidget;
+	}
+
+private:
+	TSharedPtr<FAssetData> AssetData;
+	FOnGenerateCell OnGenerateCell;
+};
 
 
 void SMicroManagerTab::Construct(const FArguments& InArgs)
 {
 	bCanSupportFocus = true;
 
-	// Store the incoming asset data into a member variable
-	StoredAssetsData = InArgs._AssetsDataArray;
-	DisplayedAssetsData = StoredAssetsData;
+	// The list starts empty, incoming asset data is streamed in once the tab is up
+	StoredAssetsData.Empty();
+	DisplayedAssetsData.Empty();
 	
 	// Ensure the array is empty if the tab is closed or another window is created
 	CheckedBoxesArray.Empty();
 	AssetDataToDeleteArray.Empty();
+	CheckedAssetPaths.Empty();
 
 
 	//ComboBox Elements 
 	ComboBoxSourceItems.Add(MakeShared<FString>(ListAll));
 	ComboBoxSourceItems.Add(MakeShared<FString>(ListUnused));
 	ComboBoxSourceItems.Add(MakeShared<FString>(ListSameName));
+	ComboBoxSourceItems.Add(MakeShared<FString>(ListLargest));
+	ComboBoxSourceItems.Add(MakeShared<FString>(ListLoadBloat));
+	ActiveListingCondition = ListAll;
 
 	DebugHelper::PrintLog(TEXT("MicroManagerTab::Construct called"));
-	DebugHelper::PrintLog(FString::Printf(TEXT("StoredAssetsData count: %d"), StoredAssetsData.Num()));
 
-	// If no assets were passed in, insert a dummy asset so the UI doesn't look broken
-	if (StoredAssetsData.Num() == 0)
-	{
-		DebugHelper::ShowNotifyInfo(TEXT("No assets found — adding dummy asset for display"));
-		StoredAssetsData.Add(MakeShared<FAssetData>());
-	}
+	AssetColumns.ResolveUnusedFlags.BindSP(this, &SMicroManagerTab::ResolveUnusedFlagsForRows);
+	LoadQueryPresets();
 
 	// Set up the font style for the title
 	FSlateFontInfo TitleTextFont = FCoreStyle::Get().GetFontStyle(FName("EmbossedText"));
@@ -70,6 +128,27 @@ void SMicroManagerTab::Construct(const FArguments& InArgs)
 			[
 				ConstructComboBox()
 			]
+
+			// Number of assets listed by the top N condition
+			+ SHorizontalBox::Slot()
+			.AutoWidth()
+			.Padding(5.f, 0.f)
+			[
+				SNew(SSpinBox<int32>)
+				.MinValue(1)
+				.MaxValue(100000)
+				.MinDesiredWidth(60.f)
+				.ToolTipText(FText::FromString(TEXT("Number of assets listed by the top N by size condition")))
+				.Value_Lambda([this]() { return NumOfLargestAssetsToList; })
+				.OnValueCommitted_Lambda([this](int32 NewValue, ETextCommit::Type)
+				{
+					NumOfLargestAssetsToList = NewValue;
+					if (ActiveListingCondition == ListLargest)
+					{
+						ApplyListingCondition(ListLargest);
+					}
+				})
+			]
 			+ SHorizontalBox::Slot()
 			.FillWidth(.6f)
 			[
@@ -85,17 +164,56 @@ void SMicroManagerTab::Construct(const FArguments& InArgs)
 			]
 		]
 
-		// Third Slot Asset List
+		// Search over asset names and paths
 		+ SVerticalBox::Slot()
-		.VAlign(VAlign_Fill)
+		.AutoHeight()
+		.Padding(5.f, 2.f)
 		[
-			SNew(SScrollBox)
-			+ SScrollBox::Slot()
+			SNew(SSearchBox)
+			.HintText(FText::FromString(TEXT("Search assets by name or path")))
+			.OnTextChanged(this, &SMicroManagerTab::OnSearchTextChanged)
+		]
+
+		// Filter query and its presets
+		+ SVerticalBox::Slot()
+		.AutoHeight()
+		.Padding(5.f, 2.f)
+		[
+			ConstructQueryBar()
+		]
+
+		// Progress of the background gather and of the paged population
+		+ SVerticalBox::Slot()
+		.AutoHeight()
+		.Padding(5.f, 2.f)
+		[
+			SNew(SHorizontalBox)
+			.Visibility_Lambda([this]() { return IsPopulatingAssets() ? EVisibility::Visible : EVisibility::Collapsed; })
+
+			+ SHorizontalBox::Slot()
+			.FillWidth(1.f)
+			.VAlign(VAlign_Center)
+			[
+				SNew(SProgressBar)
+				.Percent(this, &SMicroManagerTab::GetPopulationPercent)
+			]
+
+			+ SHorizontalBox::Slot()
+			.AutoWidth()
+			.Padding(5.f, 0.f)
 			[
-				ConstructAssetListView()
+				SNew(STextBlock)
+				.Text(this, &SMicroManagerTab::GetPopulationText)
 			]
 		]
 
+		// Third Slot Asset List, the list view scrolls and virtualizes its rows by itself
+		+ SVerticalBox::Slot()
+		.FillHeight(1.f)
+		[
+			ConstructAssetListView()
+		]
+
 		// Fourth Slot Placeholder Buttons
 		+ SVerticalBox::Slot()
 		.AutoHeight()
@@ -122,8 +240,33 @@ void SMicroManagerTab::Construct(const FArguments& InArgs)
 				ConstructDeselectAllButton()
 				
 			]
+			+ SHorizontalBox::Slot()
+			.FillWidth(10.f)
+			.Padding(5.f)
+			[
+				ConstructProfileLoadsButton()
+			]
+			+ SHorizontalBox::Slot()
+			.FillWidth(10.f)
+			.Padding(5.f)
+			[
+				ConstructExportButton()
+			]
 		]
 	];
+
+	if (InArgs._FolderPathsToScan.Num() > 0)
+	{
+		bIsGatheringAssets = true;
+
+		// A second tab on the same folders shares the first one's scan
+		UMicroManagerSubsystem::Get()->RequestAssetScan(InArgs._FolderPathsToScan,
+			FOnMicroManagerAssetScanComplete::CreateSP(this, &SMicroManagerTab::OnAssetScanComplete));
+	}
+	else
+	{
+		OnAssetsDataGathered(InArgs._AssetsDataArray);
+	}
 }
 
 TSharedRef<SListView<TSharedPtr<FAssetData>>> SMicroManagerTab::ConstructAssetListView()
@@ -131,6 +274,7 @@ TSharedRef<SListView<TSharedPtr<FAssetData>>> SMicroManagerTab::ConstructAssetLi
 	ConstructedAssetListView = SNew(SListView<TSharedPtr<FAssetData>>)
 		.ItemHeight(24.f)
 		.ListItemsSource(&DisplayedAssetsData)
+		.HeaderRow(ConstructHeaderRow())
 		.OnGenerateRow(this, &SMicroManagerTab::OnGenerateRowForList)
 		.OnMouseButtonClick(this, &SMicroManagerTab::OnRowWidgetMouseButtonClicked);
 	return ConstructedAssetListView.ToSharedRef();
@@ -139,6 +283,7 @@ TSharedRef<SListView<TSharedPtr<FAssetData>>> SMicroManagerTab::ConstructAssetLi
 void SMicroManagerTab::RefreshAssetListView()
 {
 	AssetDataToDeleteArray.Empty();
+	CheckedAssetPaths.Empty();
 	CheckedBoxesArray.Empty();
 	if (ConstructedAssetListView.IsValid())
 	{
@@ -148,6 +293,598 @@ void SMicroManagerTab::RefreshAssetListView()
 }
 
 
+#pragma region ProgressivePopulation
+
+void SMicroManagerTab::OnAssetScanComplete(TSharedRef<const FMicroManagerAssetScan> CompletedScan)
+{
+	// Holding the scan keeps it shared with the other clients of the same folders
+	AssetScan = CompletedScan;
+	OnAssetsDataGathered(*CompletedScan);
+}
+
+void SMicroManagerTab::OnAssetsDataGathered(const TArray<TSharedPtr<FAssetData>>& GatheredAssetsData)
+{
+	bIsGatheringAssets = false;
+
+	DebugHelper::PrintLog(FString::Printf(TEXT("Gathered assets count: %d"), GatheredAssetsData.Num()));
+
+	// If no assets were found, insert a dummy asset so the UI doesn't look broken
+	if (GatheredAssetsData.Num() == 0 && StoredAssetsData.Num() == 0 && PendingAssetsData.Num() == 0)
+	{
+		DebugHelper::ShowNotifyInfo(TEXT("No assets found — adding dummy asset for display"));
+		PendingAssetsData.Add(MakeShared<FAssetData>());
+	}
+
+	PendingAssetsData.Append(GatheredAssetsData);
+
+	BuildNameIndex(GatheredAssetsData);
+
+	// Sizes are gathered on worker threads, the size columns fill in as soon as they arrive
+	UMicroManagerSubsystem::Get()->RequestAssetSizes(GatheredAssetsData,
+		FSimpleDelegate::CreateSP(this, &SMicroManagerTab::OnAssetSizesUpdated));
+
+	if (!StreamingTimerHandle.IsValid())
+	{
+		StreamingTimerHandle = RegisterActiveTimer(0.f,
+			FWidgetActiveTimerDelegate::CreateSP(this, &SMicroManagerTab::StreamPendingAssetsData));
+	}
+}
+
+EActiveTimerReturnType SMicroManagerTab::StreamPendingAssetsData(double InCurrentTime, float InDeltaTime)
+{
+	// Unused pages are checked against the text reference scan, which runs on a worker, so streaming waits for it
+	if (ActiveListingCondition == ListUnused && !UMicroManagerSubsystem::Get()->IsTextReferenceScanReady())
+	{
+		UMicroManagerSubsystem::Get()->RequestTextReferenceScan(FSimpleDelegate());
+		return EActiveTimerReturnType::Continue;
+	}
+
+	const double StreamingStartTime = FPlatformTime::Seconds();
+	TArray<TSharedPtr<FAssetData>> PageAssetsData;
+	PageAssetsData.Reserve(AssetsPerPage);
+
+	// At least one page per frame so the list always makes progress, more while the budget allows
+	do
+	{
+		const int32 PageEnd = FMath::Min(NextPendingAssetIndex + AssetsPerPage, PendingAssetsData.Num());
+
+		PageAssetsData.Reset();
+		for (int32 AssetIndex = NextPendingAssetIndex; AssetIndex < PageEnd; ++AssetIndex)
+		{
+			PageAssetsData.Add(PendingAssetsData[AssetIndex]);
+		}
+		NextPendingAssetIndex = PageEnd;
+
+		StoredAssetsData.Append(PageAssetsData);
+		AssetColumns.AddAssets(PageAssetsData);
+		AppendPageToDisplayedAssets(PageAssetsData);
+	}
+	while (NextPendingAssetIndex < PendingAssetsData.Num() &&
+		FPlatformTime::Seconds() - StreamingStartTime < StreamingBudgetSeconds);
+
+	const bool bFinishedStreaming = NextPendingAssetIndex >= PendingAssetsData.Num();
+
+	if (bFinishedStreaming)
+	{
+		PendingAssetsData.Empty();
+		NextPendingAssetIndex = 0;
+		StreamingTimerHandle.Reset();
+
+		// Conditions looking at the whole set were only applied to what was there, redo them on the complete list
+		if (ActiveListingCondition != ListAll && ActiveListingCondition != ListUnused)
+		{
+			ApplyListingCondition(ActiveListingCondition);
+			return EActiveTimerReturnType::Stop;
+		}
+	}
+
+	// New items only, the rows already generated are kept
+	SortDisplayedAssetsData();
+	if (ConstructedAssetListView.IsValid())
+	{
+		ConstructedAssetListView->RequestListRefresh();
+	}
+
+	return bFinishedStreaming ? EActiveTimerReturnType::Stop : EActiveTimerReturnType::Continue;
+}
+
+void SMicroManagerTab::AppendPageToDisplayedAssets(const TArray<TSharedPtr<FAssetData>>& PageAssetsData)
+{
+	TArray<TSharedPtr<FAssetData>> ListedPageAssetsData;
+
+	if (ActiveListingCondition == ListAll)
+	{
+		ListedPageAssetsData = PageAssetsData;
+	}
+	else if (ActiveListingCondition == ListUnused)
+	{
+		// Whether an asset is referenced doesn't depend on the other assets, so the page can be filtered alone
+		UMicroManagerSubsystem::Get()->ListUnusedAssets(PageAssetsData, ListedPageAssetsData);
+	}
+
+	ApplySearchFilter(ListedPageAssetsData);
+	ApplyQueryFilter(ListedPageAssetsData);
+	DisplayedAssetsData.Append(ListedPageAssetsData);
+}
+
+bool SMicroManagerTab::IsPopulatingAssets() const
+{
+	return bIsGatheringAssets || NextPendingAssetIndex < PendingAssetsData.Num();
+}
+
+TOptional<float> SMicroManagerTab::GetPopulationPercent() const
+{
+	// Unset while gathering, the bar then shows an indeterminate marquee
+	if (bIsGatheringAssets || PendingAssetsData.Num() == 0)
+	{
+		return TOptional<float>();
+	}
+
+	return static_cast<float>(NextPendingAssetIndex) / PendingAssetsData.Num();
+}
+
+FText SMicroManagerTab::GetPopulationText() const
+{
+	if (bIsGatheringAssets)
+	{
+		return FText::FromString(TEXT("Gathering assets..."));
+	}
+
+	return FText::FromString(FString::Printf(TEXT("Listing %d / %d assets"), NextPendingAssetIndex, PendingAssetsData.Num()));
+}
+
+#pragma endregion
+
+
+#pragma region SearchBox
+
+void SMicroManagerTab::BuildNameIndex(const TArray<TSharedPtr<FAssetData>>& AssetsDataToIndex)
+{
+	TWeakPtr<SMicroManagerTab> WeakTab = SharedThis(this);
+
+	Async(EAsyncExecution::ThreadPool, [WeakTab, AssetsDataToIndex]()
+	{
+		// Package names hold both the path and the asset name
+		TArray<FString> ItemTexts;
+		TMap<TSharedPtr<FAssetData>, int32> BuiltIndexIds;
+		ItemTexts.Reserve(AssetsDataToIndex.Num());
+		BuiltIndexIds.Reserve(AssetsDataToIndex.Num());
+
+		for (const TSharedPtr<FAssetData>& AssetData : AssetsDataToIndex)
+		{
+			BuiltIndexIds.Add(AssetData, ItemTexts.Num());
+			ItemTexts.Add(AssetData->PackageName.ToString());
+		}
+
+		TSharedRef<FMicroManagerNameIndex> BuiltIndex = MakeShared<FMicroManagerNameIndex>();
+		BuiltIndex->Build(ItemTexts);
+
+		AsyncTask(ENamedThreads::GameThread, [WeakTab, BuiltIndex, BuiltIndexIds = MoveTemp(BuiltIndexIds)]() mutable
+		{
+			if (TSharedPtr<SMicroManagerTab> Tab = WeakTab.Pin())
+			{
+				Tab->OnNameIndexBuilt(BuiltIndex, MoveTemp(BuiltIndexIds));
+			}
+		});
+	});
+}
+
+void SMicroManagerTab::OnNameIndexBuilt(TSharedRef<const FMicroManagerNameIndex> BuiltIndex, TMap<TSharedPtr<FAssetData>, int32>&& BuiltIndexIds)
+{
+	NameIndex = BuiltIndex;
+	NameIndexIds = MoveTemp(BuiltIndexIds);
+
+	DebugHelper::PrintLog(FString::Printf(TEXT("Name index built for %d assets"), NameIndex->Num()));
+
+	// Text typed while the index was building is applied now
+	if (!SearchText.IsEmpty())
+	{
+		const FString PendingSearchText = SearchText;
+		SearchText.Empty();
+		OnSearchTextChanged(FText::FromString(PendingSearchText));
+	}
+}
+
+void SMicroManagerTab::OnSearchTextChanged(const FText& NewSearchText)
+{
+	const FString NewLowerSearchText = NewSearchText.ToString().ToLower();
+
+	if (!NameIndex.IsValid())
+	{
+		SearchText = NewLowerSearchText;
+		return;
+	}
+
+	const bool bNarrowsPreviousSearch = !SearchText.IsEmpty() && NewLowerSearchText.Contains(SearchText);
+	SearchText = NewLowerSearchText;
+
+	if (SearchText.IsEmpty())
+	{
+		SearchMatchIds.Empty();
+		SearchMatches.Empty();
+		ApplyListingCondition(ActiveListingCondition);
+		return;
+	}
+
+	if (bNarrowsPreviousSearch)
+	{
+		// Only the previous matches can still match, and the displayed rows are already a subset of them
+		NameIndex->Narrow(SearchText, SearchMatchIds);
+	}
+	else
+	{
+		NameIndex->Search(SearchText, SearchMatchIds);
+	}
+
+	SearchMatches.Init(false, NameIndex->Num());
+	for (const int32 MatchId : SearchMatchIds)
+	{
+		SearchMatches[MatchId] = true;
+	}
+
+	if (bNarrowsPreviousSearch)
+	{
+		ApplySearchFilter(DisplayedAssetsData);
+		if (ConstructedAssetListView.IsValid())
+		{
+			ConstructedAssetListView->RequestListRefresh();
+		}
+	}
+	else
+	{
+		ApplyListingCondition(ActiveListingCondition);
+	}
+}
+
+void SMicroManagerTab::ApplySearchFilter(TArray<TSharedPtr<FAssetData>>& AssetsDataToFilter) const
+{
+	if (SearchText.IsEmpty() || !NameIndex.IsValid()) return;
+
+	AssetsDataToFilter.RemoveAll([this](const TSharedPtr<FAssetData>& AssetData)
+	{
+		return !PassesSearchFilter(AssetData);
+	});
+}
+
+bool SMicroManagerTab::PassesSearchFilter(const TSharedPtr<FAssetData>& AssetData) const
+{
+	const int32* NameIndexId = NameIndexIds.Find(AssetData);
+	return NameIndexId && SearchMatches[*NameIndexId];
+}
+
+#pragma endregion
+
+
+#pragma region FilterQuery
+
+TSharedRef<SWidget> SMicroManagerTab::ConstructQueryBar()
+{
+	return SNew(SHorizontalBox)
+
+	+ SHorizontalBox::Slot()
+	.FillWidth(1.f)
+	[
+		SAssignNew(QueryTextBox, SEditableTextBox)
+		.HintText(FText::FromString(TEXT("Filter query, e.g. unused AND class:Texture2D AND size>4MB AND path:/Game/Env")))
+		.ToolTipText(FText::FromString(TEXT("Terms: unused, samename, class:, path:, name:, size<op><Size>, deps<op><Size>. Join with AND, negate with NOT or '-'. Press Enter to apply.")))
+		.OnTextCommitted(this, &SMicroManagerTab::OnQueryTextCommitted)
+	]
+
+	+ SHorizontalBox::Slot()
+	.AutoWidth()
+	.Padding(5.f, 0.f)
+	[
+		SAssignNew(QueryPresetComboBox, SComboBox<TSharedPtr<FString>>)
+		.OptionsSource(&QueryPresets)
+		.OnGenerateWidget(this, &SMicroManagerTab::OnGenerateComboContent)
+		.OnSelectionChanged(this, &SMicroManagerTab::OnQueryPresetSelected)
+		[
+			SNew(STextBlock)
+			.Text(FText::FromString(TEXT("Presets")))
+		]
+	]
+
+	+ SHorizontalBox::Slot()
+	.AutoWidth()
+	[
+		SNew(SButton)
+		.Text(FText::FromString(TEXT("Save Preset")))
+		.OnClicked(this, &SMicroManagerTab::OnSaveQueryPresetButtonClicked)
+	];
+}
+
+void SMicroManagerTab::OnQueryTextCommitted(const FText& NewQueryText, ETextCommit::Type CommitType)
+{
+	if (CommitType == ETextCommit::OnCleared) return;
+
+	SetActiveQuery(NewQueryText.ToString());
+}
+
+bool SMicroManagerTab::SetActiveQuery(const FString& QueryText)
+{
+	if (QueryText == ActiveQueryText) return true;
+
+	FMicroManagerAssetQuery CompiledQuery;
+	FString QueryError;
+	if (!FMicroManagerAssetQuery::Compile(QueryText, CompiledQuery, QueryError))
+	{
+		DebugHelper::ShowNotifyInfo(TEXT("Invalid query: ") + QueryError);
+		return false;
+	}
+
+	ActiveQuery = MoveTemp(CompiledQuery);
+	ActiveQueryText = QueryText;
+
+	ApplyListingCondition(ActiveListingCondition);
+	return true;
+}
+
+void SMicroManagerTab::ApplyQueryFilter(TArray<TSharedPtr<FAssetData>>& AssetsDataToFilter)
+{
+	if (ActiveQuery.IsEmpty()) return;
+
+	TArray<int32> Rows;
+	Rows.Reserve(AssetsDataToFilter.Num());
+	for (const TSharedPtr<FAssetData>& AssetData : AssetsDataToFilter)
+	{
+		const int32 Row = AssetColumns.FindRow(AssetData);
+		if (Row != INDEX_NONE)
+		{
+			Rows.Add(Row);
+		}
+	}
+
+	ActiveQuery.Execute(AssetColumns, Rows);
+
+	AssetsDataToFilter.Reset(Rows.Num());
+	for (const int32 Row : Rows)
+	{
+		AssetsDataToFilter.Add(AssetColumns.Assets[Row]);
+	}
+}
+
+void SMicroManagerTab::ResolveUnusedFlagsForRows(const TArray<int32>& Rows, FMicroManagerAssetColumns& Columns)
+{
+	TArray<TSharedPtr<FAssetData>> AssetsDataToResolve;
+	AssetsDataToResolve.Reserve(Rows.Num());
+	for (const int32 Row : Rows)
+	{
+		AssetsDataToResolve.Add(Columns.Assets[Row]);
+	}
+
+	TArray<TSharedPtr<FAssetData>> UnusedAssetsData;
+	UMicroManagerSubsystem::Get()->ListUnusedAssets(AssetsDataToResolve, UnusedAssetsData);
+
+	for (const int32 Row : Rows)
+	{
+		Columns.UnusedFlags[Row] = 0;
+	}
+	for (const TSharedPtr<FAssetData>& UnusedAssetData : UnusedAssetsData)
+	{
+		Columns.UnusedFlags[Columns.FindRow(UnusedAssetData)] = 1;
+	}
+}
+
+void SMicroManagerTab::OnQueryPresetSelected(TSharedPtr<FString> SelectedPreset, ESelectInfo::Type InSelectInfo)
+{
+	if (!SelectedPreset.IsValid()) return;
+
+	QueryTextBox->SetText(FText::FromString(*SelectedPreset));
+	SetActiveQuery(*SelectedPreset);
+}
+
+FReply SMicroManagerTab::OnSaveQueryPresetButtonClicked()
+{
+	const FString QueryText = QueryTextBox->GetText().ToString().TrimStartAndEnd();
+	if (QueryText.IsEmpty()) return FReply::Handled();
+
+	// Only valid queries are worth keeping
+	if (!SetActiveQuery(QueryText)) return FReply::Handled();
+
+	for (const TSharedPtr<FString>& QueryPreset : QueryPresets)
+	{
+		if (*QueryPreset == QueryText) return FReply::Handled();
+	}
+
+	QueryPresets.Add(MakeShared<FString>(QueryText));
+	QueryPresetComboBox->RefreshOptions();
+	SaveQueryPresets();
+
+	DebugHelper::ShowNotifyInfo(TEXT("Saved query preset: ") + QueryText);
+	return FReply::Handled();
+}
+
+void SMicroManagerTab::LoadQueryPresets()
+{
+	QueryPresets.Empty();
+
+	TArray<FString> SavedQueryPresets;
+	GConfig->GetArray(TEXT("MicroManager"), TEXT("QueryPresets"), SavedQueryPresets, GEditorPerProjectIni);
+
+	for (const FString& SavedQueryPreset : SavedQueryPresets)
+	{
+		QueryPresets.Add(MakeShared<FString>(SavedQueryPreset));
+	}
+}
+
+void SMicroManagerTab::SaveQueryPresets() const
+{
+	TArray<FString> QueryPresetsToSave;
+	for (const TSharedPtr<FString>& QueryPreset : QueryPresets)
+	{
+		QueryPresetsToSave.Add(*QueryPreset);
+	}
+
+	GConfig->SetArray(TEXT("MicroManager"), TEXT("QueryPresets"), QueryPresetsToSave, GEditorPerProjectIni);
+	GConfig->Flush(false, GEditorPerProjectIni);
+}
+
+#pragma endregion
+
+
+#pragma region SortableColumns
+
+TSharedRef<SHeaderRow> SMicroManagerTab::ConstructHeaderRow()
+{
+	return SNew(SHeaderRow)
+
+	+ SHeaderRow::Column(MicroManagerColumns::CheckBox)
+	.DefaultLabel(FText::GetEmpty())
+	.FixedWidth(30.f)
+
+	+ SHeaderRow::Column(MicroManagerColumns::Class)
+	.DefaultLabel(FText::FromString(TEXT("Class")))
+	.FillWidth(0.2f)
+	.SortMode(this, &SMicroManagerTab::GetSortModeForColumn, MicroManagerColumns::Class)
+	.OnSort(this, &SMicroManagerTab::OnColumnSortModeChanged)
+
+	+ SHeaderRow::Column(MicroManagerColumns::Name)
+	.DefaultLabel(FText::FromString(TEXT("Name")))
+	.FillWidth(0.35f)
+	.SortMode(this, &SMicroManagerTab::GetSortModeForColumn, MicroManagerColumns::Name)
+	.OnSort(this, &SMicroManagerTab::OnColumnSortModeChanged)
+
+	+ SHeaderRow::Column(MicroManagerColumns::DiskSize)
+	.DefaultLabel(FText::FromString(TEXT("Disk Size")))
+	.FillWidth(0.1f)
+	.SortMode(this, &SMicroManagerTab::GetSortModeForColumn, MicroManagerColumns::DiskSize)
+	.OnSort(this, &SMicroManagerTab::OnColumnSortModeChanged)
+
+	+ SHeaderRow::Column(MicroManagerColumns::ResourceSize)
+	.DefaultLabel(FText::FromString(TEXT("Resource Size")))
+	.FillWidth(0.1f)
+	.SortMode(this, &SMicroManagerTab::GetSortModeForColumn, MicroManagerColumns::ResourceSize)
+	.OnSort(this, &SMicroManagerTab::OnColumnSortModeChanged)
+
+	+ SHeaderRow::Column(MicroManagerColumns::DependencySize)
+	.DefaultLabel(FText::FromString(TEXT("Dependency Size")))
+	.FillWidth(0.1f)
+	.SortMode(this, &SMicroManagerTab::GetSortModeForColumn, MicroManagerColumns::DependencySize)
+	.OnSort(this, &SMicroManagerTab::OnColumnSortModeChanged)
+
+	+ SHeaderRow::Column(MicroManagerColumns::Actions)
+	.DefaultLabel(FText::GetEmpty())
+	.FixedWidth(130.f);
+}
+
+EColumnSortMode::Type SMicroManagerTab::GetSortModeForColumn(const FName ColumnId) const
+{
+	return SortByColumn == ColumnId ? SortMode : EColumnSortMode::None;
+}
+
+void SMicroManagerTab::OnColumnSortModeChanged(const EColumnSortPriority::Type SortPriority, const FName& ColumnId,
+	const EColumnSortMode::Type NewSortMode)
+{
+	SortByColumn = ColumnId;
+	SortMode = NewSortMode;
+
+	SortDisplayedAssetsData();
+
+	// Same items, new order: the list reuses the generated rows instead of rebuilding them
+	if (ConstructedAssetListView.IsValid())
+	{
+		ConstructedAssetListView->RequestListRefresh();
+	}
+}
+
+void SMicroManagerTab::SortDisplayedAssetsData()
+{
+	if (SortMode == EColumnSortMode::None || SortByColumn.IsNone()) return;
+
+	const TSharedRef<FMicroManagerSizeCache> SizeCache =
+	UMicroManagerSubsystem::Get()->GetSizeCache();
+	const bool bAscending = SortMode == EColumnSortMode::Ascending;
+	const FName ColumnId = SortByColumn;
+
+	DisplayedAssetsData.StableSort([&SizeCache, bAscending, ColumnId](const TSharedPtr<FAssetData>& A, const TSharedPtr<FAssetData>& B)
+	{
+		int64 Comparison = 0;
+
+		if (ColumnId == MicroManagerColumns::Class)
+		{
+			Comparison = A->AssetClassPath.GetAssetName().Compare(B->AssetClassPath.GetAssetName());
+		}
+		else if (ColumnId == MicroManagerColumns::Name)
+		{
+			Comparison = A->AssetName.Compare(B->AssetName);
+		}
+		else if (ColumnId == MicroManagerColumns::DiskSize)
+		{
+			Comparison = SizeCache->GetDiskSize(A->PackageName) - SizeCache->GetDiskSize(B->PackageName);
+		}
+		else if (ColumnId == MicroManagerColumns::ResourceSize)
+		{
+			Comparison = SizeCache->GetResourceSize(A->PackageName) - SizeCache->GetResourceSize(B->PackageName);
+		}
+		else if (ColumnId == MicroManagerColumns::DependencySize)
+		{
+			Comparison = SizeCache->GetDependencySize(A->PackageName) - SizeCache->GetDependencySize(B->PackageName);
+		}
+
+		return bAscending ? Comparison < 0 : Comparison > 0;
+	});
+}
+
+void SMicroManagerTab::OnAssetSizesUpdated()
+{
+	AssetColumns.RefreshSizes(*UMicroManagerSubsystem::Get()->GetSizeCache());
+
+	// The size texts are bound attributes and refresh on their own, only the ordering may need work
+	if (ActiveListingCondition == ListLargest || ActiveListingCondition == ListLoadBloat || !ActiveQuery.IsEmpty())
+	{
+		// Which assets pass depends on the sizes. The rows are listed again in place, the user's checks are kept
+		// and only apply to what is still listed, so a delete never hits an asset the list no longer shows.
+		ListAssetsForCondition(ActiveListingCondition);
+		AssetDataToDeleteArray = DisplayedAssetsData.FilterByPredicate([this](const TSharedPtr<FAssetData>& AssetData)
+		{
+			return AssetData.IsValid() && CheckedAssetPaths.Contains(AssetData->ToSoftObjectPath());
+		});
+	}
+	else if (SortByColumn == MicroManagerColumns::DiskSize ||
+		SortByColumn == MicroManagerColumns::ResourceSize ||
+		SortByColumn == MicroManagerColumns::DependencySize)
+	{
+		SortDisplayedAssetsData();
+	}
+	else
+	{
+		return;
+	}
+
+	if (ConstructedAssetListView.IsValid())
+	{
+		ConstructedAssetListView->RequestListRefresh();
+	}
+}
+
+FText SMicroManagerTab::GetSizeTextForAsset(TSharedPtr<FAssetData> AssetData, const FName ColumnId) const
+{
+	if (!AssetData.IsValid()) return FText::GetEmpty();
+
+	const FMicroManagerAssetSizeInfo* SizeInfo =
+	UMicroManagerSubsystem::Get()->GetSizeCache()->FindSizeInfo(AssetData->PackageName);
+
+	if (!SizeInfo)
+	{
+		return FText::FromString(TEXT("..."));
+	}
+
+	int64 SizeToDisplay = SizeInfo->DiskSize;
+	if (ColumnId == MicroManagerColumns::ResourceSize)
+	{
+		SizeToDisplay = SizeInfo->ResourceSize;
+	}
+	else if (ColumnId == MicroManagerColumns::DependencySize)
+	{
+		SizeToDisplay = SizeInfo->DependencySize;
+	}
+
+	return FText::AsMemory(FMath::Max<int64>(SizeToDisplay, 0));
+}
+
+#pragma endregion
+
+
 #pragma region ComboBoxForListingCondition
 
 TSharedRef<SComboBox<TSharedPtr<FString>>> SMicroManagerTab::ConstructComboBox()
@@ -181,29 +918,72 @@ ESelectInfo::Type InSelectInfo)
 
 	ComboDisplayTextBlock->SetText(FText::FromString(*SelectedOption.Get()));
 
+	ApplyListingCondition(*SelectedOption.Get());
+}
+
+void SMicroManagerTab::ApplyListingCondition(const FString& ListingCondition)
+{
+	ActiveListingCondition = ListingCondition;
+
+	ListAssetsForCondition(ListingCondition);
+	RefreshAssetListView();
+}
+
+void SMicroManagerTab::ListAssetsForCondition(const FString& ListingCondition)
+{
 	// Pass data for our module to filter the asset list
 	
 	FMicroManagerModule& MicroManagerModule = 
 	FModuleManager::LoadModuleChecked<FMicroManagerModule>(TEXT("MicroManager"));
 
 	//Pass data for our module to filter based on the selected option
-	if(*SelectedOption.Get() == ListAll)
+	if(ListingCondition == ListAll)
 	{
 		//List all stored asset data
+		DisplayedAssetsData = StoredAssetsData;
 	}
-	else if(*SelectedOption.Get() == ListUnused)
+	else if(ListingCondition == ListUnused)
 	{
-		//List all unused assets
-		MicroManagerModule.ListUnusedAssetsForAssetList(StoredAssetsData,DisplayedAssetsData);
-		RefreshAssetListView();
+		if (UMicroManagerSubsystem::Get()->IsTextReferenceScanReady())
+		{
+			//List all unused assets
+			UMicroManagerSubsystem::Get()->ListUnusedAssets(StoredAssetsData,DisplayedAssetsData);
+		}
+		else
+		{
+			// Nothing is listed until the text reference scan is done on its worker
+			DisplayedAssetsData.Empty();
+			UMicroManagerSubsystem::Get()->RequestTextReferenceScan(
+				FSimpleDelegate::CreateSP(this, &SMicroManagerTab::OnTextReferenceScanComplete));
+		}
 	}
-	else if (*SelectedOption.Get() == ListSameName)
+	else if (ListingCondition == ListSameName)
 	{
 		//List all assets with the same name
 		MicroManagerModule.ListSameNameAssetsForAssetList(StoredAssetsData,DisplayedAssetsData);
-		RefreshAssetListView();
 	}
-	
+	else if (ListingCondition == ListLargest)
+	{
+		//List the biggest assets on disk, already ordered by size
+		MicroManagerModule.ListLargestAssetsForAssetList(StoredAssetsData,NumOfLargestAssetsToList,DisplayedAssetsData);
+	}
+	else if (ListingCondition == ListLoadBloat)
+	{
+		//List the assets dragging in the most data through hard references, worst first
+		MicroManagerModule.ListLoadBloatAssetsForAssetList(StoredAssetsData,DisplayedAssetsData);
+	}
+
+	ApplySearchFilter(DisplayedAssetsData);
+	ApplyQueryFilter(DisplayedAssetsData);
+	SortDisplayedAssetsData();
+}
+
+void SMicroManagerTab::OnTextReferenceScanComplete()
+{
+	if (ActiveListingCondition == ListUnused)
+	{
+		ApplyListingCondition(ListUnused);
+	}
 }
 
 TSharedRef<STextBlock> SMicroManagerTab::ConstructComboHelpTexts(const FString & TextContent, 
@@ -227,64 +1007,87 @@ TSharedRef<ITableRow> SMicroManagerTab::OnGenerateRowForList(
 	TSharedPtr<FAssetData> AssetDataToDisplay,
 	const TSharedRef<STableViewBase>& OwnerTable)
 {
-	const FString DisplayAssetClassName = AssetDataToDisplay->AssetClassPath.GetAssetName().ToString();
-	FString DisplayAssetName = TEXT("[Invalid Asset]");
-
-	FSlateFontInfo AssetClassNameFont = GetEmbossedTextFont();
-	AssetClassNameFont.Size = 10;
+	return SNew(SMicroManagerAssetRow, OwnerTable)
+	.AssetData(AssetDataToDisplay)
+	.OnGenerateCell(this, &SMicroManagerTab::OnGenerateCellForColumn);
+}
 
-	FSlateFontInfo AssetNameFont = GetEmbossedTextFont();
-	AssetNameFont.Size = 15;
+TSharedRef<SWidget> SMicroManagerTab::OnGenerateCellForColumn(TSharedPtr<FAssetData> AssetDataToDisplay, const FName& ColumnId)
+{
+	FString DisplayAssetName = TEXT("[Invalid Asset]");
+	FString DisplayAssetClassName;
 
 	if (AssetDataToDisplay.IsValid())
 	{
 		DisplayAssetName = AssetDataToDisplay->AssetName.ToString();
+		DisplayAssetClassName = AssetDataToDisplay->AssetClassPath.GetAssetName().ToString();
 	}
-	if (!AssetDataToDisplay.IsValid())
-	{
-		
-	}
-
-	DebugHelper::PrintLog(FString::Printf(TEXT("Generating row for: %s"), *DisplayAssetName));
-
-	return SNew(STableRow<TSharedPtr<FAssetData>>, OwnerTable).Padding(FMargin(2.0f))
-	[
-		SNew(SHorizontalBox)
 
-		// First Slot for Checkbox
-		+ SHorizontalBox::Slot()
+	if (ColumnId == MicroManagerColumns::CheckBox)
+	{
+		return SNew(SBox)
 		.HAlign(HAlign_Left)
 		.VAlign(VAlign_Center)
-		.FillWidth(0.05f)
 		[
 			ConstructCheckBox(AssetDataToDisplay)
-		]
+		];
+	}
 
-		// Second Slot for Asset Class Name
-		+ SHorizontalBox::Slot()
+	if (ColumnId == MicroManagerColumns::Class)
+	{
+		FSlateFontInfo AssetClassNameFont = GetEmbossedTextFont();
+		AssetClassNameFont.Size = 10;
+
+		return SNew(SBox)
 		.HAlign(HAlign_Center)
-		.VAlign(VAlign_Fill)
-		.FillWidth(0.5f)
+		.VAlign(VAlign_Center)
 		[
 			ConstructTextForRowWidget(DisplayAssetClassName, AssetClassNameFont)
-		]
+		];
+	}
 
-		// Third slot for Asset Name
+	if (ColumnId == MicroManagerColumns::Name)
+	{
+		FSlateFontInfo AssetNameFont = GetEmbossedTextFont();
+		AssetNameFont.Size = 15;
+
+		DebugHelper::PrintLog(FString::Printf(TEXT("Generating row for: %s"), *DisplayAssetName));
+
+		return ConstructTextForRowWidget(DisplayAssetName, AssetNameFont);
+	}
+
+	if (ColumnId == MicroManagerColumns::DiskSize ||
+		ColumnId == MicroManagerColumns::ResourceSize ||
+		ColumnId == MicroManagerColumns::DependencySize)
+	{
+		// Bound to the size cache, so the text fills in once the worker threads are done without rebuilding the row
+		return SNew(SBox)
+		.VAlign(VAlign_Center)
+		[
+			SNew(STextBlock)
+			.Text(this, &SMicroManagerTab::GetSizeTextForAsset, AssetDataToDisplay, ColumnId)
+			.ColorAndOpacity(FSlateColor(FColor::White))
+		];
+	}
+
+	if (ColumnId == MicroManagerColumns::Actions)
+	{
+		return SNew(SHorizontalBox)
 		+ SHorizontalBox::Slot()
-		.HAlign(HAlign_Left)
-		.VAlign(VAlign_Fill)
+		.AutoWidth()
+		.Padding(2.f, 0.f)
 		[
-			ConstructTextForRowWidget(DisplayAssetName, AssetNameFont)
+			ConstructWhyUsedButtonForRowWidget(AssetDataToDisplay)
 		]
-
-		// Fourth slot for Buttons
 		+ SHorizontalBox::Slot()
-		.HAlign(HAlign_Right)
-		.VAlign(VAlign_Fill)
+		.AutoWidth()
+		.Padding(2.f, 0.f)
 		[
 			ConstructButtonForRowWidget(AssetDataToDisplay)
-		]
-	];
+		];
+	}
+
+	return SNullWidget::NullWidget;
 }
 
 
@@ -301,6 +1104,7 @@ TSharedRef<SCheckBox> SMicroManagerTab::ConstructCheckBox(const TSharedPtr<FAsse
 {
 	TSharedRef<SCheckBox> ConstructedCheckBox = SNew(SCheckBox)
 		.Type(ESlateCheckBoxType::CheckBox)
+		.IsChecked(this, &SMicroManagerTab::GetCheckBoxState, AssetDataToDisplay)
 		.OnCheckStateChanged(this, &SMicroManagerTab::OnCheckBoxStateChanged, AssetDataToDisplay)
 		.Visibility(EVisibility::Visible);
 	CheckedBoxesArray.Add(ConstructedCheckBox);
@@ -322,6 +1126,7 @@ void SMicroManagerTab::OnCheckBoxStateChanged(ECheckBoxState NewState, TSharedPt
 		{
 			AssetDataToDeleteArray.Remove(AssetData);
 		}
+		CheckedAssetPaths.Remove(AssetData->ToSoftObjectPath());
 		
 		
 		//DebugHelper::Print(AssetData->AssetName.ToString() + TEXT(" is unchecked"), FColor::Red);
@@ -329,6 +1134,7 @@ void SMicroManagerTab::OnCheckBoxStateChanged(ECheckBoxState NewState, TSharedPt
 
 	case ECheckBoxState::Checked:
 		AssetDataToDeleteArray.AddUnique(AssetData);
+		CheckedAssetPaths.Add(AssetData->ToSoftObjectPath());
 		//DebugHelper::Print(AssetData->AssetName.ToString() + TEXT(" is checked"), FColor::Green);
 		break;
 
@@ -337,6 +1143,11 @@ void SMicroManagerTab::OnCheckBoxStateChanged(ECheckBoxState NewState, TSharedPt
 	}
 }
 
+ECheckBoxState SMicroManagerTab::GetCheckBoxState(TSharedPtr<FAssetData> AssetData) const
+{
+	return AssetData.IsValid() && CheckedAssetPaths.Contains(AssetData->ToSoftObjectPath()) ? ECheckBoxState::Checked : ECheckBoxState::Unchecked;
+}
+
 TSharedRef<STextBlock> SMicroManagerTab::ConstructTextForRowWidget(const FString& TextContent, const FSlateFontInfo FontToUse) const
 {
 	return SNew(STextBlock)
@@ -395,6 +1206,31 @@ FReply SMicroManagerTab::OnDeleteButtonClicked(TSharedPtr<FAssetData> ClickedAss
 
     return FReply::Handled();
 }
+
+TSharedRef<SButton> SMicroManagerTab::ConstructWhyUsedButtonForRowWidget(const TSharedPtr<FAssetData>& AssetDataToDisplay)
+{
+	TSharedRef<SButton> ConstructedButton = SNew(SButton)
+		.Text(FText::FromString(TEXT("Why?")))
+		.ToolTipText(FText::FromString(TEXT("Show the shortest reference chain keeping this asset in use")))
+		.OnClicked(this, &SMicroManagerTab::OnWhyUsedButtonClicked, AssetDataToDisplay);
+	return ConstructedButton;
+}
+
+FReply SMicroManagerTab::OnWhyUsedButtonClicked(TSharedPtr<FAssetData> ClickedAssetData)
+{
+	if (!ClickedAssetData.IsValid()) return FReply::Handled();
+
+	// The graph is cached by the subsystem, only the first query after a registry change waits for a rebuild
+	const FName AssetPackageName = ClickedAssetData->PackageName;
+
+	UMicroManagerSubsystem::Get()->RequestDependencyGraph(FOnMicroManagerDependencyGraphReady::CreateLambda(
+		[AssetPackageName](TSharedRef<const FMicroManagerDependencyGraph> DependencyGraph)
+		{
+			SMicroManagerReferencePathView::OpenInWindow(DependencyGraph, AssetPackageName);
+		}));
+
+	return FReply::Handled();
+}
 #pragma endregion
 
 
@@ -426,6 +1262,26 @@ TSharedRef<SButton> SMicroManagerTab::ConstructDeselectAllButton()
 	return DeselectAllButton;  
 }
 
+TSharedRef<SButton> SMicroManagerTab::ConstructProfileLoadsButton()
+{
+	TSharedRef<SButton> ProfileLoadsButton = SNew(SButton)
+		.ContentPadding(FMargin(5.0f))
+		.ToolTipText(FText::FromString(TEXT("Loads the checked assets, or every listed one, one at a time and records what each load costs")))
+		.OnClicked(this, &SMicroManagerTab::OnProfileLoadsButtonClicked);
+	ProfileLoadsButton->SetContent(ConstructTextForTabButtons(TEXT("Profile Loads")));
+	return ProfileLoadsButton;
+}
+
+TSharedRef<SButton> SMicroManagerTab::ConstructExportButton()
+{
+	TSharedRef<SButton> ExportButton = SNew(SButton)
+		.ContentPadding(FMargin(5.0f))
+		.ToolTipText(FText::FromString(TEXT("Writes every listed asset with its sizes to a CSV or JSON file")))
+		.OnClicked(this, &SMicroManagerTab::OnExportButtonClicked);
+	ExportButton->SetContent(ConstructTextForTabButtons(TEXT("Export")));
+	return ExportButton;
+}
+
 
 FReply SMicroManagerTab::OnDeleteAllButtonClicked()
 {
@@ -507,6 +1363,79 @@ FReply SMicroManagerTab::OnDeselectAllButtonClicked()
 	return FReply::Handled();
 }
 
+FReply SMicroManagerTab::OnProfileLoadsButtonClicked()
+{
+	TArray<TSharedPtr<FAssetData>> AssetsDataToProfile = AssetDataToDeleteArray.Num() > 0 ? AssetDataToDeleteArray : DisplayedAssetsData;
+
+	// Drop the placeholder row shown while nothing was found
+	AssetsDataToProfile.RemoveAll([](const TSharedPtr<FAssetData>& AssetData)
+	{
+		return !AssetData.IsValid() || !AssetData->IsValid();
+	});
+
+	FMicroManagerLoadProfiler::RunAndShowReport(AssetsDataToProfile);
+	return FReply::Handled();
+}
+
+FReply SMicroManagerTab::OnExportButtonClicked()
+{
+	TArray<TSharedPtr<FAssetData>> AssetsDataToExport = DisplayedAssetsData;
+	AssetsDataToExport.RemoveAll([](const TSharedPtr<FAssetData>& AssetData)
+	{
+		return !AssetData.IsValid() || !AssetData->IsValid();
+	});
+
+	if (AssetsDataToExport.Num() == 0)
+	{
+		DebugHelper::ShowMsgDialog(EAppMsgType::Ok, TEXT("No assets listed to export"));
+		return FReply::Handled();
+	}
+
+	IDesktopPlatform* DesktopPlatform = FDesktopPlatformModule::Get();
+	if (!DesktopPlatform) return FReply::Handled();
+
+	TArray<FString> SelectedFiles;
+	DesktopPlatform->SaveFileDialog(
+		FSlateApplication::Get().FindBestParentWindowHandleForDialogs(nullptr),
+		TEXT("Export the listed assets"),
+		FMicroManagerScanExport::GetExportDir(),
+		TEXT("MicroManagerScan.csv"),
+		TEXT("CSV (*.csv)|*.csv|JSON (*.json)|*.json"),
+		EFileDialogFlags::None,
+		SelectedFiles);
+
+	if (SelectedFiles.Num() == 0) return FReply::Handled();
+	const FString ExportFilePath = FPaths::ConvertRelativePathToFull(SelectedFiles[0]);
+
+	// Sizes still being computed are waited for, the rows are then handed to a worker so the editor stays responsive
+	UMicroManagerSubsystem::Get()->RequestAssetSizes(AssetsDataToExport, FSimpleDelegate::CreateLambda([AssetsDataToExport, ExportFilePath]()
+	{
+		TArray<FMicroManagerExportRow> Rows;
+		if (!FMicroManagerScanExport::MakeRows(AssetsDataToExport, *UMicroManagerSubsystem::Get()->GetSizeCache(), Rows))
+		{
+			DebugHelper::ShowMsgDialog(EAppMsgType::Ok,
+				FString::Printf(TEXT("Some sizes could not be computed, %s was not written. Try the export again."), *ExportFilePath), true);
+			return;
+		}
+		const int32 NumRows = Rows.Num();
+
+		FMicroManagerScanExport::WriteToFileAsync(ExportFilePath, MoveTemp(Rows),
+			FOnMicroManagerExportComplete::CreateLambda([ExportFilePath, NumRows](bool bSucceeded)
+		{
+			if (bSucceeded)
+			{
+				DebugHelper::ShowNotifyInfo(FString::Printf(TEXT("Exported %d assets to %s"), NumRows, *ExportFilePath));
+			}
+			else
+			{
+				DebugHelper::ShowMsgDialog(EAppMsgType::Ok, FString::Printf(TEXT("Failed to write %s"), *ExportFilePath), true);
+			}
+		}));
+	}));
+
+	return FReply::Handled();
+}
+
 TSharedRef<STextBlock> SMicroManagerTab::ConstructTextForTabButtons(const FString& TextContent)
 {
 	FSlateFontInfo ButtonTextFont = GetEmbossedTextFont();
@@ -0,0 +1,550 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Snapshots/MicroManagerSnapshot.h"
+#include "AssetAnalysis/MicroManagerDependencyGraph.h"
+#include "Async/Async.h"
+#include "DebugHelper.h"
+#include "DesktopPlatformModule.h"
+#include "Framework/Application/SlateApplication.h"
+#include "HAL/FileManager.h"
+#include "Hash/CityHash.h"
+#include "IDesktopPlatform.h"
+#include "Misc/Paths.h"
+#include "SlateWidgets/MicroManagerReportWidget.h"
+#include "Subsystems/MicroManagerSubsystem.h"
+
+namespace SnapshotColumns
+{
+	static const FName Name(TEXT("Name"));
+	static const FName Change(TEXT("Change"));
+	static const FName Class(TEXT("Class"));
+	static const FName OldSize(TEXT("OldSize"));
+	static const FName NewSize(TEXT("NewSize"));
+	static const FName SizeDelta(TEXT("SizeDelta"));
+	static const FName InclusiveSizeDelta(TEXT("InclusiveSizeDelta"));
+	static const FName NewDependencies(TEXT("NewDependencies"));
+}
+
+namespace
+{
+	// "MMSN"
+	constexpr uint32 SnapshotMagic = 0x4E534D4D;
+
+	enum ESnapshotRecordFlags : uint8
+	{
+		RecordFlag_None = 0,
+		RecordFlag_Root = 1 << 0,
+	};
+
+	// Records are ordered case-sensitively by both the writer and the merge, whatever the platform
+	int32 ComparePackageNames(const FString& A, const FString& B)
+	{
+		return A.Compare(B, ESearchCase::CaseSensitive);
+	}
+
+	int32 CommonPrefixLength(const FString& A, const FString& B)
+	{
+		const int32 MaxLength = FMath::Min3(A.Len(), B.Len(), static_cast<int32>(MAX_uint16));
+		int32 Length = 0;
+		while (Length < MaxLength && A[Length] == B[Length])
+		{
+			++Length;
+		}
+		return Length;
+	}
+
+	// Identifies a package across snapshots, hashed from UTF-8 so files compare whatever the platform's TCHAR
+	uint64 HashPackageName(const FString& PackageName)
+	{
+		const FTCHARToUTF8 Utf8PackageName(*PackageName);
+		return CityHash64(Utf8PackageName.Get(), Utf8PackageName.Length());
+	}
+
+	// Dependencies of the new record missing from the old one, both lists ascending
+	int32 CountNewDependencies(const TArray<uint64>& OldDependencies, const TArray<uint64>& NewDependencies)
+	{
+		int32 NewCount = 0;
+		int32 OldIndex = 0;
+		for (const uint64 NewDependency : NewDependencies)
+		{
+			while (OldIndex < OldDependencies.Num() && OldDependencies[OldIndex] < NewDependency)
+			{
+				++OldIndex;
+			}
+			if (OldIndex == OldDependencies.Num() || OldDependencies[OldIndex] != NewDependency)
+			{
+				++NewCount;
+			}
+		}
+		return NewCount;
+	}
+
+	void SerializePacked(FArchive& Ar, int32& Value)
+	{
+		uint32 PackedValue = static_cast<uint32>(Value);
+		Ar.SerializeIntPacked(PackedValue);
+		Value = static_cast<int32>(PackedValue);
+	}
+}
+
+#pragma region SnapshotReader
+
+FMicroManagerSnapshotReader::FMicroManagerSnapshotReader(const FString& FilePath)
+{
+	FileReader.Reset(IFileManager::Get().CreateFileReader(*FilePath));
+	if (!FileReader.IsValid())
+	{
+		Error = TEXT("Failed to open ") + FilePath;
+		return;
+	}
+
+	FArchive& Ar = *FileReader;
+
+	uint32 Magic = 0;
+	uint32 Version = 0;
+	Ar << Magic << Version;
+	if (Magic != SnapshotMagic)
+	{
+		Error = FilePath + TEXT(" is not a MicroManager snapshot");
+		return;
+	}
+	if (Version != FMicroManagerSnapshot::FileVersion)
+	{
+		Error = FString::Printf(TEXT("%s has version %u, this MicroManager reads version %u"), *FilePath, Version, FMicroManagerSnapshot::FileVersion);
+		return;
+	}
+
+	int64 TimestampTicks = 0;
+	Ar << TimestampTicks << NumRecords << ClassNames;
+	Timestamp = FDateTime(TimestampTicks);
+
+	if (Ar.IsError())
+	{
+		Error = FilePath + TEXT(" is corrupt");
+	}
+}
+
+bool FMicroManagerSnapshotReader::Next(FMicroManagerSnapshotRecord& OutRecord)
+{
+	if (!IsValid() || NumRecordsRead >= NumRecords) return false;
+
+	FArchive& Ar = *FileReader;
+
+	// The package name shares a prefix with the one of the previous record, still held in OutRecord
+	uint16 PrefixLength = 0;
+	FString Suffix;
+	Ar << PrefixLength << Suffix;
+	OutRecord.PackageName = OutRecord.PackageName.Left(PrefixLength) + Suffix;
+
+	int32 ClassIndex = 0;
+	uint8 Flags = RecordFlag_None;
+	SerializePacked(Ar, ClassIndex);
+	Ar << OutRecord.DiskSize << OutRecord.InclusiveSize << Flags;
+	SerializePacked(Ar, OutRecord.ReferencerCount);
+
+	int32 NumDependencies = 0;
+	SerializePacked(Ar, NumDependencies);
+	if (Ar.IsError() || !ClassNames.IsValidIndex(ClassIndex) || NumDependencies < 0 || NumDependencies > NumRecords)
+	{
+		Error = TEXT("Snapshot is corrupt");
+		return false;
+	}
+
+	OutRecord.ClassName = ClassNames[ClassIndex];
+	OutRecord.bIsRoot = (Flags & RecordFlag_Root) != 0;
+
+	OutRecord.HardDependencyHashes.SetNumUninitialized(NumDependencies, false);
+	for (uint64& DependencyHash : OutRecord.HardDependencyHashes)
+	{
+		Ar << DependencyHash;
+	}
+
+	// A truncated file must not pass for the end of the records, the merge would report the rest as removed or added
+	if (Ar.IsError())
+	{
+		Error = TEXT("Snapshot is corrupt");
+		return false;
+	}
+
+	++NumRecordsRead;
+	return true;
+}
+
+#pragma endregion
+
+#pragma region SnapshotFile
+
+FString FMicroManagerSnapshot::GetSnapshotsDir()
+{
+	return FPaths::ProjectSavedDir() / TEXT("MicroManager") / TEXT("Snapshots");
+}
+
+bool FMicroManagerSnapshot::Write(const FMicroManagerDependencyGraph& DependencyGraph, const TArray<TSharedPtr<FAssetData>>& AssetsData,
+	const FString& FilePath, FString& OutError)
+{
+	// One record per package, a package holding several assets is classed by its first one
+	TMap<int32, FString> PackageClasses;
+	for (const TSharedPtr<FAssetData>& AssetData : AssetsData)
+	{
+		const int32 NodeIndex = DependencyGraph.FindNode(AssetData->PackageName);
+		if (NodeIndex != INDEX_NONE && !PackageClasses.Contains(NodeIndex))
+		{
+			PackageClasses.Add(NodeIndex, AssetData->AssetClassPath.GetAssetName().ToString());
+		}
+	}
+
+	TArray<int32> Nodes;
+	PackageClasses.GenerateKeyArray(Nodes);
+
+	TArray<FString> PackageNames;
+	PackageNames.Reserve(Nodes.Num());
+	for (const int32 NodeIndex : Nodes)
+	{
+		PackageNames.Add(DependencyGraph.GetPackageName(NodeIndex).ToString());
+	}
+
+	// Sort the records by name, the merge in Diff relies on it
+	TArray<int32> Order;
+	Order.SetNumUninitialized(Nodes.Num());
+	for (int32 Index = 0; Index < Order.Num(); ++Index) Order[Index] = Index;
+	Order.Sort([&PackageNames](const int32 A, const int32 B)
+	{
+		return ComparePackageNames(PackageNames[A], PackageNames[B]) < 0;
+	});
+
+	TMap<int32, uint64> RecordHashes;
+	RecordHashes.Reserve(Nodes.Num());
+	for (int32 NodeArrayIndex = 0; NodeArrayIndex < Nodes.Num(); ++NodeArrayIndex)
+	{
+		RecordHashes.Add(Nodes[NodeArrayIndex], HashPackageName(PackageNames[NodeArrayIndex]));
+	}
+
+	TArray<int64> InclusiveSizes;
+	DependencyGraph.ComputeInclusiveSizes(Nodes, InclusiveSizes);
+
+	TArray<FString> ClassNames;
+	TMap<FString, int32> ClassIndices;
+	for (const TPair<int32, FString>& PackageClass : PackageClasses)
+	{
+		if (!ClassIndices.Contains(PackageClass.Value))
+		{
+			ClassIndices.Add(PackageClass.Value, ClassNames.Add(PackageClass.Value));
+		}
+	}
+
+	const FString TempFilePath = FilePath + TEXT(".tmp");
+	{
+		TUniquePtr<FArchive> FileWriter(IFileManager::Get().CreateFileWriter(*TempFilePath));
+		if (!FileWriter.IsValid())
+		{
+			OutError = TEXT("Failed to create ") + TempFilePath;
+			return false;
+		}
+
+		FArchive& Ar = *FileWriter;
+
+		uint32 Magic = SnapshotMagic;
+		uint32 Version = FileVersion;
+		int64 TimestampTicks = FDateTime::UtcNow().GetTicks();
+		int32 NumRecords = Nodes.Num();
+		Ar << Magic << Version << TimestampTicks << NumRecords << ClassNames;
+
+		FString PreviousPackageName;
+		TArray<uint64> Dependencies;
+		for (const int32 OrderIndex : Order)
+		{
+			const int32 NodeIndex = Nodes[OrderIndex];
+			FString& PackageName = PackageNames[OrderIndex];
+
+			uint16 PrefixLength = static_cast<uint16>(CommonPrefixLength(PreviousPackageName, PackageName));
+			FString Suffix = PackageName.Mid(PrefixLength);
+			Ar << PrefixLength << Suffix;
+
+			int32 ClassIndex = ClassIndices[PackageClasses[NodeIndex]];
+			int64 DiskSize = DependencyGraph.GetDiskSize(NodeIndex);
+			int64 InclusiveSize = InclusiveSizes[OrderIndex];
+			uint8 Flags = DependencyGraph.IsRoot(NodeIndex) ? RecordFlag_Root : RecordFlag_None;
+			int32 ReferencerCount = DependencyGraph.GetReferencers(NodeIndex).Num();
+			SerializePacked(Ar, ClassIndex);
+			Ar << DiskSize << InclusiveSize << Flags;
+			SerializePacked(Ar, ReferencerCount);
+
+			// Only dependencies that are records themselves, engine and script packages don't change between milestones
+			Dependencies.Reset();
+			for (const int32 DependencyNode : DependencyGraph.GetHardDependencies(NodeIndex))
+			{
+				if (const uint64* DependencyHash = RecordHashes.Find(DependencyNode))
+				{
+					Dependencies.Add(*DependencyHash);
+				}
+			}
+			Dependencies.Sort();
+
+			int32 NumDependencies = Dependencies.Num();
+			SerializePacked(Ar, NumDependencies);
+			for (uint64& DependencyHash : Dependencies)
+			{
+				Ar << DependencyHash;
+			}
+
+			PreviousPackageName = MoveTemp(PackageName);
+		}
+
+		if (!FileWriter->Close())
+		{
+			OutError = TEXT("Failed to write ") + TempFilePath;
+			IFileManager::Get().Delete(*TempFilePath);
+			return false;
+		}
+	}
+
+	if (!IFileManager::Get().Move(*FilePath, *TempFilePath))
+	{
+		OutError = TEXT("Failed to move the snapshot to ") + FilePath;
+		return false;
+	}
+
+	return true;
+}
+
+bool FMicroManagerSnapshot::Diff(const FString& OldFilePath, const FString& NewFilePath, TArray<FMicroManagerSnapshotDiffEntry>& OutEntries, FString& OutError)
+{
+	OutEntries.Reset();
+
+	FMicroManagerSnapshotReader OldReader(OldFilePath);
+	FMicroManagerSnapshotReader NewReader(NewFilePath);
+	if (!OldReader.IsValid() || !NewReader.IsValid())
+	{
+		OutError = !OldReader.IsValid() ? OldReader.GetError() : NewReader.GetError();
+		return false;
+	}
+
+	auto AddEntry = [&OutEntries](const FMicroManagerSnapshotRecord* OldRecord, const FMicroManagerSnapshotRecord* NewRecord,
+		EMicroManagerSnapshotChange Change, int32 NewDependencyCount = 0)
+	{
+		const FMicroManagerSnapshotRecord& Record = NewRecord ? *NewRecord : *OldRecord;
+
+		FMicroManagerSnapshotDiffEntry& Entry = OutEntries.AddDefaulted_GetRef();
+		Entry.PackageName = Record.PackageName;
+		Entry.ClassName = Record.ClassName;
+		Entry.Change = Change;
+		Entry.OldDiskSize = OldRecord ? OldRecord->DiskSize : 0;
+		Entry.NewDiskSize = NewRecord ? NewRecord->DiskSize : 0;
+		Entry.InclusiveSizeDelta = (NewRecord ? NewRecord->InclusiveSize : 0) - (OldRecord ? OldRecord->InclusiveSize : 0);
+		Entry.NewDependencyCount = NewDependencyCount;
+	};
+
+	// Merge both sorted streams, only the current record of each side is held
+	FMicroManagerSnapshotRecord OldRecord;
+	FMicroManagerSnapshotRecord NewRecord;
+	bool bHasOld = OldReader.Next(OldRecord);
+	bool bHasNew = NewReader.Next(NewRecord);
+
+	while (bHasOld || bHasNew)
+	{
+		const int32 Comparison = !bHasOld ? 1 : (!bHasNew ? -1 : ComparePackageNames(OldRecord.PackageName, NewRecord.PackageName));
+
+		if (Comparison < 0)
+		{
+			AddEntry(&OldRecord, nullptr, EMicroManagerSnapshotChange::Removed);
+			bHasOld = OldReader.Next(OldRecord);
+		}
+		else if (Comparison > 0)
+		{
+			AddEntry(nullptr, &NewRecord, EMicroManagerSnapshotChange::Added);
+			bHasNew = NewReader.Next(NewRecord);
+		}
+		else
+		{
+			// A package can show up under several changes at once
+			if (NewRecord.DiskSize - OldRecord.DiskSize >= GrowthThreshold)
+			{
+				AddEntry(&OldRecord, &NewRecord, EMicroManagerSnapshotChange::Grew);
+			}
+			if (NewRecord.IsUnused() && !OldRecord.IsUnused())
+			{
+				AddEntry(&OldRecord, &NewRecord, EMicroManagerSnapshotChange::BecameUnused);
+			}
+			// The closure may also grow because an existing dependency did, only new direct dependencies count here
+			if (NewRecord.InclusiveSize - OldRecord.InclusiveSize >= HeavyDependencyThreshold)
+			{
+				const int32 NewDependencyCount = CountNewDependencies(OldRecord.HardDependencyHashes, NewRecord.HardDependencyHashes);
+				if (NewDependencyCount > 0)
+				{
+					AddEntry(&OldRecord, &NewRecord, EMicroManagerSnapshotChange::GainedHeavyDependencies, NewDependencyCount);
+				}
+			}
+
+			bHasOld = OldReader.Next(OldRecord);
+			bHasNew = NewReader.Next(NewRecord);
+		}
+	}
+
+	if (!OldReader.GetError().IsEmpty() || !NewReader.GetError().IsEmpty())
+	{
+		OutError = !OldReader.GetError().IsEmpty() ? OldReader.GetError() : NewReader.GetError();
+		return false;
+	}
+
+	return true;
+}
+
+const TCHAR* FMicroManagerSnapshot::LexToString(EMicroManagerSnapshotChange Change)
+{
+	switch (Change)
+	{
+	case EMicroManagerSnapshotChange::Added: return TEXT("Added");
+	case EMicroManagerSnapshotChange::Removed: return TEXT("Removed");
+	case EMicroManagerSnapshotChange::Grew: return TEXT("Grew");
+	case EMicroManagerSnapshotChange::BecameUnused: return TEXT("Became Unused");
+	default: return TEXT("Gained Heavy Dependencies");
+	}
+}
+
+#pragma endregion
+
+#pragma region SnapshotActions
+
+void FMicroManagerSnapshot::TakeProjectSnapshot()
+{
+	UMicroManagerSubsystem* Subsystem = UMicroManagerSubsystem::Get();
+	if (!Subsystem) return;
+
+	const FString FilePath = GetSnapshotsDir() / FString::Printf(TEXT("Snapshot_%s.mmsnap"), *FDateTime::Now().ToString());
+
+	DebugHelper::ShowNotifyInfo(TEXT("Taking project snapshot..."));
+
+	Subsystem->RequestAssetScan({ TEXT("/Game") }, FOnMicroManagerAssetScanComplete::CreateLambda(
+		[FilePath](TSharedRef<const FMicroManagerAssetScan> AssetScan)
+		{
+			UMicroManagerSubsystem* Subsystem = UMicroManagerSubsystem::Get();
+			if (!Subsystem) return;
+
+			Subsystem->RequestDependencyGraph(FOnMicroManagerDependencyGraphReady::CreateLambda(
+				[FilePath, AssetScan](TSharedRef<const FMicroManagerDependencyGraph> DependencyGraph)
+				{
+					Async(EAsyncExecution::ThreadPool, [FilePath, AssetScan, DependencyGraph]()
+					{
+						FString Error;
+						const bool bWritten = Write(*DependencyGraph, *AssetScan, FilePath, Error);
+
+						AsyncTask(ENamedThreads::GameThread, [FilePath, Error, bWritten]()
+						{
+							if (bWritten)
+							{
+								DebugHelper::ShowNotifyInfo(TEXT("Snapshot written to ") + FilePath);
+							}
+							else
+							{
+								DebugHelper::ShowMsgDialog(EAppMsgType::Ok, TEXT("Snapshot failed: ") + Error);
+							}
+						});
+					});
+				}));
+		}));
+}
+
+void FMicroManagerSnapshot::PickAndShowDiff()
+{
+	IDesktopPlatform* DesktopPlatform = FDesktopPlatformModule::Get();
+	if (!DesktopPlatform) return;
+
+	TArray<FString> SelectedFiles;
+	DesktopPlatform->OpenFileDialog(
+		FSlateApplication::Get().FindBestParentWindowHandleForDialogs(nullptr),
+		TEXT("Pick the two snapshots to compare"),
+		GetSnapshotsDir(),
+		TEXT(""),
+		TEXT("MicroManager Snapshot (*.mmsnap)|*.mmsnap"),
+		EFileDialogFlags::Multiple,
+		SelectedFiles);
+
+	if (SelectedFiles.Num() == 0) return;
+	if (SelectedFiles.Num() != 2)
+	{
+		DebugHelper::ShowMsgDialog(EAppMsgType::Ok, TEXT("Pick exactly two snapshots to compare"));
+		return;
+	}
+
+	// Compare from the older snapshot to the newer one, whatever the pick order
+	FString OldFilePath = SelectedFiles[0];
+	FString NewFilePath = SelectedFiles[1];
+	{
+		FMicroManagerSnapshotReader FirstReader(OldFilePath);
+		FMicroManagerSnapshotReader SecondReader(NewFilePath);
+		if (FirstReader.IsValid() && SecondReader.IsValid() && FirstReader.GetTimestamp() > SecondReader.GetTimestamp())
+		{
+			Swap(OldFilePath, NewFilePath);
+		}
+	}
+
+	DebugHelper::ShowNotifyInfo(TEXT("Comparing snapshots..."));
+
+	Async(EAsyncExecution::ThreadPool, [OldFilePath, NewFilePath]()
+	{
+		TArray<FMicroManagerSnapshotDiffEntry> Entries;
+		FString Error;
+		const bool bDiffed = Diff(OldFilePath, NewFilePath, Entries, Error);
+
+		AsyncTask(ENamedThreads::GameThread, [OldFilePath, NewFilePath, Entries = MoveTemp(Entries), Error, bDiffed]()
+		{
+			if (!bDiffed)
+			{
+				DebugHelper::ShowMsgDialog(EAppMsgType::Ok, TEXT("Snapshot diff failed: ") + Error);
+				return;
+			}
+
+			TArray<TSharedPtr<FMicroManagerReportRow>> Rows;
+			Rows.Reserve(Entries.Num());
+			int32 ChangeCounts[5] = {};
+
+			for (const FMicroManagerSnapshotDiffEntry& Entry : Entries)
+			{
+				TSharedPtr<FMicroManagerReportRow> Row = MakeShared<FMicroManagerReportRow>();
+				Row->SetText(SnapshotColumns::Name, Entry.PackageName);
+				Row->SetText(SnapshotColumns::Change, LexToString(Entry.Change));
+				Row->SetText(SnapshotColumns::Class, Entry.ClassName);
+				Row->SetSize(SnapshotColumns::OldSize, Entry.OldDiskSize);
+				Row->SetSize(SnapshotColumns::NewSize, Entry.NewDiskSize);
+
+				const int64 SizeDelta = Entry.NewDiskSize - Entry.OldDiskSize;
+				Row->SetValue(SnapshotColumns::SizeDelta, SizeDelta,
+					(SizeDelta < 0 ? TEXT("-") : TEXT("+")) + FText::AsMemory(FMath::Abs(SizeDelta)).ToString());
+				Row->SetValue(SnapshotColumns::InclusiveSizeDelta, Entry.InclusiveSizeDelta,
+					(Entry.InclusiveSizeDelta < 0 ? TEXT("-") : TEXT("+")) + FText::AsMemory(FMath::Abs(Entry.InclusiveSizeDelta)).ToString());
+				if (Entry.Change == EMicroManagerSnapshotChange::GainedHeavyDependencies)
+				{
+					Row->SetValue(SnapshotColumns::NewDependencies, Entry.NewDependencyCount, FString::FromInt(Entry.NewDependencyCount));
+				}
+
+				if (Entry.Change != EMicroManagerSnapshotChange::Removed)
+				{
+					Row->AssetPath = FSoftObjectPath(Entry.PackageName);
+				}
+
+				++ChangeCounts[static_cast<int32>(Entry.Change)];
+				Rows.Add(Row);
+			}
+
+			const FString Summary = FString::Printf(
+				TEXT("%s -> %s\n%d added, %d removed, %d grew, %d became unused, %d gained heavy dependencies"),
+				*FPaths::GetBaseFilename(OldFilePath), *FPaths::GetBaseFilename(NewFilePath),
+				ChangeCounts[0], ChangeCounts[1], ChangeCounts[2], ChangeCounts[3], ChangeCounts[4]);
+
+			SMicroManagerReportView::OpenInWindow(TEXT("Project Snapshot Diff"), Summary,
+			{
+				{ SnapshotColumns::Name, TEXT("Package"), 0.3f, false },
+				{ SnapshotColumns::Change, TEXT("Change"), 0.12f, false },
+				{ SnapshotColumns::Class, TEXT("Class"), 0.12f, false },
+				{ SnapshotColumns::OldSize, TEXT("Old Size"), 0.1f, true },
+				{ SnapshotColumns::NewSize, TEXT("New Size"), 0.1f, true },
+				{ SnapshotColumns::SizeDelta, TEXT("Size Delta"), 0.1f, true },
+				{ SnapshotColumns::InclusiveSizeDelta, TEXT("Hard Closure Delta"), 0.11f, true },
+				{ SnapshotColumns::NewDependencies, TEXT("New Dependencies"), 0.05f, true },
+			}, Rows, SnapshotColumns::SizeDelta);
+		});
+	});
+}
+
+#pragma endregion
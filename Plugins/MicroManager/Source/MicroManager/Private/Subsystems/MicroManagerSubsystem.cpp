@@ -0,0 +1,636 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Subsystems/MicroManagerSubsystem.h"
+#include "AssetAnalysis/MicroManagerSizeCache.h"
+#include "AssetAnalysis/MicroManagerTextReferenceScanner.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "AssetToolsModule.h"
+#include "Async/Async.h"
+#include "Async/ParallelFor.h"
+#include "DirectoryWatcherModule.h"
+#include "Editor.h"
+#include "HAL/FileManager.h"
+#include "IDirectoryWatcher.h"
+#include "MicroManagerCoreAlgorithms.h"
+#include "Misc/ConfigCacheIni.h"
+#include "Misc/Paths.h"
+#include "UObject/ObjectRedirector.h"
+
+void UMicroManagerSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+	AssetRegistry.OnAssetAdded().AddUObject(this, &UMicroManagerSubsystem::OnAssetRegistryAdded);
+	AssetRegistry.OnAssetRemoved().AddUObject(this, &UMicroManagerSubsystem::OnAssetRegistryChanged);
+	AssetRegistry.OnAssetUpdated().AddUObject(this, &UMicroManagerSubsystem::OnAssetRegistryChanged);
+	AssetRegistry.OnAssetRenamed().AddUObject(this, &UMicroManagerSubsystem::OnAssetRegistryRenamed);
+	AssetRegistry.OnFilesLoaded().AddUObject(this, &UMicroManagerSubsystem::OnAssetRegistryFilesLoaded);
+
+	GConfig->GetBool(TEXT("MicroManager"), TEXT("ScanTextReferences"), bTextReferenceScanEnabled, GEditorPerProjectIni);
+
+	WatchTextDirectories();
+}
+
+void UMicroManagerSubsystem::Deinitialize()
+{
+	if (FModuleManager::Get().IsModuleLoaded(TEXT("AssetRegistry")))
+	{
+		IAssetRegistry& AssetRegistry = FModuleManager::GetModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+		AssetRegistry.OnAssetAdded().RemoveAll(this);
+		AssetRegistry.OnAssetRemoved().RemoveAll(this);
+		AssetRegistry.OnAssetUpdated().RemoveAll(this);
+		AssetRegistry.OnAssetRenamed().RemoveAll(this);
+		AssetRegistry.OnFilesLoaded().RemoveAll(this);
+	}
+
+	UnwatchTextDirectories();
+
+	CachedScans.Empty();
+	PendingScanRequests.Empty();
+	PendingDependencyGraphRequests.Empty();
+	PendingTextReferenceScanRequests.Empty();
+	SizeCache.Reset();
+	DependencyGraph.Reset();
+
+	Super::Deinitialize();
+}
+
+UMicroManagerSubsystem* UMicroManagerSubsystem::Get()
+{
+	return GEditor ? GEditor->GetEditorSubsystem<UMicroManagerSubsystem>() : nullptr;
+}
+
+#pragma region AssetScans
+
+void UMicroManagerSubsystem::RequestAssetScan(const TArray<FString>& FolderPaths, FOnMicroManagerAssetScanComplete OnScanComplete)
+{
+	FlushRegistryChanges();
+
+	const FString ScanKey = MakeScanKey(FolderPaths);
+
+	if (TSharedPtr<const FMicroManagerAssetScan> CachedScan = CachedScans.FindRef(ScanKey).Pin())
+	{
+		OnScanComplete.ExecuteIfBound(CachedScan.ToSharedRef());
+		return;
+	}
+
+	// Identical scans already running just get one more client
+	if (TArray<FOnMicroManagerAssetScanComplete>* PendingRequests = PendingScanRequests.Find(ScanKey))
+	{
+		PendingRequests->Add(OnScanComplete);
+		return;
+	}
+
+	PendingScanRequests.Add(ScanKey).Add(OnScanComplete);
+
+	const IAssetRegistry* AssetRegistry = &FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+	TWeakObjectPtr<UMicroManagerSubsystem> WeakSubsystem = this;
+	const uint32 ScanGeneration = RegistryGeneration;
+
+	Async(EAsyncExecution::ThreadPool, [WeakSubsystem, AssetRegistry, FolderPaths, ScanKey, ScanGeneration]()
+	{
+		TSharedRef<FMicroManagerAssetScan> CompletedScan = MakeShared<FMicroManagerAssetScan>();
+		GatherAssetDataUnderFolders(*AssetRegistry, FolderPaths, *CompletedScan);
+
+		AsyncTask(ENamedThreads::GameThread, [WeakSubsystem, ScanKey, ScanGeneration, CompletedScan]()
+		{
+			if (UMicroManagerSubsystem* Subsystem = WeakSubsystem.Get())
+			{
+				Subsystem->OnAssetScanComplete(ScanKey, ScanGeneration, CompletedScan);
+			}
+		});
+	});
+}
+
+TSharedRef<const FMicroManagerAssetScan> UMicroManagerSubsystem::ScanFolders(const TArray<FString>& FolderPaths)
+{
+	FlushRegistryChanges();
+
+	const FString ScanKey = MakeScanKey(FolderPaths);
+
+	if (TSharedPtr<const FMicroManagerAssetScan> CachedScan = CachedScans.FindRef(ScanKey).Pin())
+	{
+		return CachedScan.ToSharedRef();
+	}
+
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+
+	TSharedRef<FMicroManagerAssetScan> CompletedScan = MakeShared<FMicroManagerAssetScan>();
+	GatherAssetDataUnderFolders(AssetRegistry, FolderPaths, *CompletedScan);
+
+	CachedScans.Add(ScanKey, CompletedScan);
+
+	UE_LOG(LogTemp, Log, TEXT("Collected %d assets from %d folder(s)."), CompletedScan->Num(), FolderPaths.Num());
+
+	return CompletedScan;
+}
+
+void UMicroManagerSubsystem::OnAssetScanComplete(const FString& ScanKey, uint32 ScanGeneration, TSharedRef<const FMicroManagerAssetScan> CompletedScan)
+{
+	if (ScanGeneration == RegistryGeneration)
+	{
+		CachedScans.Add(ScanKey, CompletedScan);
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("Asset scan %s collected %d assets."), *ScanKey, CompletedScan->Num());
+
+	TArray<FOnMicroManagerAssetScanComplete> RequestsToNotify;
+	PendingScanRequests.RemoveAndCopyValue(ScanKey, RequestsToNotify);
+
+	for (FOnMicroManagerAssetScanComplete& Request : RequestsToNotify)
+	{
+		Request.ExecuteIfBound(CompletedScan);
+	}
+}
+
+void UMicroManagerSubsystem::GatherAssetDataUnderFolders(const IAssetRegistry& AssetRegistry, const TArray<FString>& FolderPaths,
+	TArray<TSharedPtr<FAssetData>>& OutAssetsData)
+{
+	OutAssetsData.Empty();
+	const FTopLevelAssetPath RedirectorClassPath(TEXT("/Script/Engine"), TEXT("ObjectRedirector"));
+
+	// Partition per folder: every worker queries and filters its own folder into its own array
+	TArray<TArray<FAssetData>> AssetsDataPerFolder;
+	AssetsDataPerFolder.SetNum(FolderPaths.Num());
+
+	ParallelFor(FolderPaths.Num(), [&FolderPaths, &AssetRegistry, &AssetsDataPerFolder, &RedirectorClassPath](int32 FolderIndex)
+	{
+		TArray<FAssetData> FolderAssetsData;
+		AssetRegistry.GetAssetsByPath(FName(*FolderPaths[FolderIndex]), FolderAssetsData, true, true);
+
+		TArray<FAssetData>& KeptAssetsData = AssetsDataPerFolder[FolderIndex];
+		KeptAssetsData.Reserve(FolderAssetsData.Num());
+
+		for (FAssetData& AssetData : FolderAssetsData)
+		{
+			if (AssetData.AssetClassPath == RedirectorClassPath) continue;
+			if (IsPathExcludedFromMicroManager(AssetData.PackageName.ToString())) continue;
+
+			KeptAssetsData.Add(MoveTemp(AssetData));
+		}
+	});
+
+	// Merge in folder order, nested or repeated selections would otherwise list an asset twice
+	TSet<FSoftObjectPath> SeenAssets;
+	for (TArray<FAssetData>& FolderAssetsData : AssetsDataPerFolder)
+	{
+		for (FAssetData& AssetData : FolderAssetsData)
+		{
+			bool bAlreadySeen = false;
+			SeenAssets.Add(AssetData.GetSoftObjectPath(), &bAlreadySeen);
+			if (!bAlreadySeen)
+			{
+				OutAssetsData.Add(MakeShared<FAssetData>(MoveTemp(AssetData)));
+			}
+		}
+	}
+}
+
+bool UMicroManagerSubsystem::IsPathExcludedFromMicroManager(const FString& Path)
+{
+	return MicroManagerCore::IsPathExcluded(Path);
+}
+
+FString UMicroManagerSubsystem::MakeScanKey(const TArray<FString>& FolderPaths)
+{
+	// The same folders picked in another order are the same scan
+	TArray<FString> SortedFolderPaths = FolderPaths;
+	SortedFolderPaths.Sort();
+	return FString::Join(SortedFolderPaths, TEXT("|"));
+}
+
+#pragma endregion
+
+#pragma region SharedAssetOperations
+
+void UMicroManagerSubsystem::ListUnusedAssets(const TArray<TSharedPtr<FAssetData>>& AssetsDataToFilter,
+	TArray<TSharedPtr<FAssetData>>& OutUnusedAssetsData)
+{
+	OutUnusedAssetsData.Empty();
+
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+
+	// The registry lookups are independent, so they are spread across the workers, each writing its own slot
+	TArray<TArray<FName>> ReferencersPerAsset;
+	ReferencersPerAsset.SetNum(AssetsDataToFilter.Num());
+
+	ParallelFor(AssetsDataToFilter.Num(), [&AssetsDataToFilter, &AssetRegistry, &ReferencersPerAsset](int32 AssetIndex)
+	{
+		const TSharedPtr<FAssetData>& DataSharedPtr = AssetsDataToFilter[AssetIndex];
+		if (DataSharedPtr.IsValid() && !DataSharedPtr->PackageName.IsNone())
+		{
+			AssetRegistry.GetReferencers(DataSharedPtr->PackageName, ReferencersPerAsset[AssetIndex]);
+		}
+	});
+
+	// Hand the references to the core as package ids, the filtered assets' packages first
+	TMap<FName, int32> PackageIds;
+	TArray<int32> AssetPackageIds;
+	AssetPackageIds.Init(INDEX_NONE, AssetsDataToFilter.Num());
+	for (int32 AssetIndex = 0; AssetIndex < AssetsDataToFilter.Num(); ++AssetIndex)
+	{
+		const TSharedPtr<FAssetData>& DataSharedPtr = AssetsDataToFilter[AssetIndex];
+		if (DataSharedPtr.IsValid() && !DataSharedPtr->PackageName.IsNone())
+		{
+			AssetPackageIds[AssetIndex] = PackageIds.FindOrAdd(DataSharedPtr->PackageName, PackageIds.Num());
+		}
+	}
+	const int32 NumCandidatePackages = PackageIds.Num();
+
+	TArray<FMicroManagerPackageEdge> Edges;
+	for (int32 AssetIndex = 0; AssetIndex < AssetsDataToFilter.Num(); ++AssetIndex)
+	{
+		for (const FName Referencer : ReferencersPerAsset[AssetIndex])
+		{
+			Edges.Add({ PackageIds.FindOrAdd(Referencer, PackageIds.Num()), AssetPackageIds[AssetIndex] });
+		}
+	}
+
+	TBitArray<> IsPackageUnreferenced;
+	MicroManagerCore::FindUnreferencedPackages(NumCandidatePackages, Edges, IsPackageUnreferenced);
+
+	TArray<bool> IsAssetUnused;
+	IsAssetUnused.SetNumZeroed(AssetsDataToFilter.Num());
+	for (int32 AssetIndex = 0; AssetIndex < AssetsDataToFilter.Num(); ++AssetIndex)
+	{
+		IsAssetUnused[AssetIndex] = AssetPackageIds[AssetIndex] != INDEX_NONE && IsPackageUnreferenced[AssetPackageIds[AssetIndex]];
+	}
+
+	if (bTextReferenceScanEnabled)
+	{
+		const TSet<FName>& ReferencedByText = GetTextReferencedPackages();
+		for (int32 AssetIndex = 0; AssetIndex < AssetsDataToFilter.Num(); ++AssetIndex)
+		{
+			if (IsAssetUnused[AssetIndex] && ReferencedByText.Contains(AssetsDataToFilter[AssetIndex]->PackageName))
+			{
+				IsAssetUnused[AssetIndex] = false;
+			}
+		}
+	}
+
+	for (int32 AssetIndex = 0; AssetIndex < AssetsDataToFilter.Num(); ++AssetIndex)
+	{
+		if (IsAssetUnused[AssetIndex])
+		{
+			OutUnusedAssetsData.Add(AssetsDataToFilter[AssetIndex]);
+		}
+	}
+}
+
+void UMicroManagerSubsystem::SetTextReferenceScanEnabled(bool bEnabled)
+{
+	bTextReferenceScanEnabled = bEnabled;
+	GConfig->SetBool(TEXT("MicroManager"), TEXT("ScanTextReferences"), bTextReferenceScanEnabled, GEditorPerProjectIni);
+
+	// Edits made while the option was off were not tracked by a running scan, turning it on again starts over
+	MarkTextReferencesOutdated();
+}
+
+void UMicroManagerSubsystem::RequestTextReferenceScan(FSimpleDelegate OnScanComplete)
+{
+	if (IsTextReferenceScanReady())
+	{
+		OnScanComplete.ExecuteIfBound();
+		return;
+	}
+
+	if (OnScanComplete.IsBound())
+	{
+		PendingTextReferenceScanRequests.Add(OnScanComplete);
+	}
+
+	// Requests arriving while a scan is running just wait for it
+	if (bIsScanningTextReferences) return;
+	bIsScanningTextReferences = true;
+
+	const IAssetRegistry* AssetRegistry = &FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+	TWeakObjectPtr<UMicroManagerSubsystem> WeakSubsystem = this;
+	const uint32 ScanGeneration = TextReferenceGeneration;
+
+	Async(EAsyncExecution::ThreadPool, [WeakSubsystem, AssetRegistry, ScanGeneration]()
+	{
+		TSet<FName> ReferencedPackages;
+		ScanTextReferencedPackages(*AssetRegistry, ReferencedPackages);
+
+		AsyncTask(ENamedThreads::GameThread, [WeakSubsystem, ScanGeneration, ReferencedPackages = MoveTemp(ReferencedPackages)]() mutable
+		{
+			if (UMicroManagerSubsystem* Subsystem = WeakSubsystem.Get())
+			{
+				Subsystem->OnTextReferenceScanComplete(ScanGeneration, MoveTemp(ReferencedPackages));
+			}
+		});
+	});
+}
+
+void UMicroManagerSubsystem::OnTextReferenceScanComplete(uint32 ScanGeneration, TSet<FName>&& ReferencedPackages)
+{
+	bIsScanningTextReferences = false;
+
+	if (ScanGeneration == TextReferenceGeneration)
+	{
+		TextReferencedPackages = MoveTemp(ReferencedPackages);
+		bTextReferencedPackagesOutdated = false;
+	}
+	else
+	{
+		// Outdated while running, the waiters want the current state of the files
+		RequestTextReferenceScan(FSimpleDelegate());
+		return;
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("Text reference scan found %d referenced packages."), TextReferencedPackages.Num());
+
+	TArray<FSimpleDelegate> RequestsToNotify = MoveTemp(PendingTextReferenceScanRequests);
+	for (FSimpleDelegate& Request : RequestsToNotify)
+	{
+		Request.ExecuteIfBound();
+	}
+}
+
+const TSet<FName>& UMicroManagerSubsystem::GetTextReferencedPackages()
+{
+	if (!bTextReferencedPackagesOutdated) return TextReferencedPackages;
+
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+	ScanTextReferencedPackages(AssetRegistry, TextReferencedPackages);
+	bTextReferencedPackagesOutdated = false;
+
+	// A scan still running started from older files, it must not overwrite this one
+	++TextReferenceGeneration;
+
+	TArray<FSimpleDelegate> RequestsToNotify = MoveTemp(PendingTextReferenceScanRequests);
+	for (FSimpleDelegate& Request : RequestsToNotify)
+	{
+		Request.ExecuteIfBound();
+	}
+
+	return TextReferencedPackages;
+}
+
+void UMicroManagerSubsystem::ScanTextReferencedPackages(const IAssetRegistry& AssetRegistry, TSet<FName>& OutReferencedPackages)
+{
+	// One automaton for every project package, so the tab's page by page lookups all share the same scan
+	TArray<FAssetData> AllAssetsData;
+	AssetRegistry.GetAllAssets(AllAssetsData, true);
+
+	TSet<FName> CandidatePackageSet;
+	for (const FAssetData& AssetData : AllAssetsData)
+	{
+		const FString PackagePath = AssetData.PackageName.ToString();
+		if (!PackagePath.StartsWith(TEXT("/Script/")) && !PackagePath.StartsWith(TEXT("/Engine/")) && !PackagePath.StartsWith(TEXT("/Temp/")))
+		{
+			CandidatePackageSet.Add(AssetData.PackageName);
+		}
+	}
+
+	FMicroManagerTextReferenceScanner::FindReferencedPackages(CandidatePackageSet.Array(), OutReferencedPackages);
+}
+
+void UMicroManagerSubsystem::MarkTextReferencesOutdated()
+{
+	bTextReferencedPackagesOutdated = true;
+	++TextReferenceGeneration;
+}
+
+void UMicroManagerSubsystem::WatchTextDirectories()
+{
+	IDirectoryWatcher* DirectoryWatcher = FModuleManager::LoadModuleChecked<FDirectoryWatcherModule>(TEXT("DirectoryWatcher")).Get();
+	if (!DirectoryWatcher) return;
+
+	TArray<FString> TextDirectories;
+	FMicroManagerTextReferenceScanner::GetTextDirectories(TextDirectories);
+
+	for (const FString& TextDirectory : TextDirectories)
+	{
+		if (!IFileManager::Get().DirectoryExists(*TextDirectory)) continue;
+
+		FDelegateHandle WatchHandle;
+		DirectoryWatcher->RegisterDirectoryChangedCallback_Handle(TextDirectory,
+			IDirectoryWatcher::FDirectoryChanged::CreateUObject(this, &UMicroManagerSubsystem::OnTextDirectoryChanged), WatchHandle);
+		TextDirectoryWatchHandles.Emplace(TextDirectory, WatchHandle);
+	}
+}
+
+void UMicroManagerSubsystem::UnwatchTextDirectories()
+{
+	if (FDirectoryWatcherModule* DirectoryWatcherModule = FModuleManager::GetModulePtr<FDirectoryWatcherModule>(TEXT("DirectoryWatcher")))
+	{
+		if (IDirectoryWatcher* DirectoryWatcher = DirectoryWatcherModule->Get())
+		{
+			for (const TPair<FString, FDelegateHandle>& WatchHandle : TextDirectoryWatchHandles)
+			{
+				DirectoryWatcher->UnregisterDirectoryChangedCallback_Handle(WatchHandle.Key, WatchHandle.Value);
+			}
+		}
+	}
+	TextDirectoryWatchHandles.Empty();
+}
+
+void UMicroManagerSubsystem::OnTextDirectoryChanged(const TArray<FFileChangeData>& FileChanges)
+{
+	for (const FFileChangeData& FileChange : FileChanges)
+	{
+		if (FMicroManagerTextReferenceScanner::IsScannedFile(FPaths::ConvertRelativePathToFull(FileChange.Filename)))
+		{
+			MarkTextReferencesOutdated();
+			return;
+		}
+	}
+}
+
+/**
+ * @brief Fixes up redirectors in the asset registry.
+ *
+ * This function searches for all object redirectors within the given paths
+ * and attempts to fix up their referencers. This is useful for cleaning up
+ * redirectors that may have been left behind after renaming or moving assets.
+ *
+ * @param PackagePaths Paths searched recursively for redirectors.
+ */
+void UMicroManagerSubsystem::FixUpRedirectors(const TArray<FString>& PackagePaths)
+{
+	TArray<UObjectRedirector*> RedirectorsToFixArray;
+
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+
+	FARFilter Filter;
+	Filter.bRecursivePaths = true;
+	for (const FString& PackagePath : PackagePaths)
+	{
+		Filter.PackagePaths.Emplace(*PackagePath);
+	}
+	Filter.ClassPaths.Emplace(FTopLevelAssetPath(TEXT("/Script/Engine"), TEXT("ObjectRedirector")));
+
+	TArray<FAssetData> OutRedirectors;
+	AssetRegistry.GetAssets(Filter, OutRedirectors);
+
+	for (const FAssetData& RedirectorData : OutRedirectors)
+	{
+		if (UObjectRedirector* RedirectorToFix = Cast<UObjectRedirector>(RedirectorData.GetAsset()))
+		{
+			RedirectorsToFixArray.Add(RedirectorToFix);
+		}
+	}
+
+	if (RedirectorsToFixArray.Num() == 0) return;
+
+	FAssetToolsModule& AssetToolsModule =
+	FModuleManager::LoadModuleChecked<FAssetToolsModule>(TEXT("AssetTools"));
+
+	AssetToolsModule.Get().FixupReferencers(RedirectorsToFixArray);
+}
+
+#pragma endregion
+
+#pragma region SizesAndDependencies
+
+TSharedRef<FMicroManagerSizeCache> UMicroManagerSubsystem::GetSizeCache()
+{
+	if (!SizeCache.IsValid())
+	{
+		SizeCache = MakeShared<FMicroManagerSizeCache>();
+	}
+	return SizeCache.ToSharedRef();
+}
+
+void UMicroManagerSubsystem::RequestAssetSizes(const TArray<TSharedPtr<FAssetData>>& AssetsData, FSimpleDelegate OnSizesUpdated)
+{
+	TWeakPtr<FMicroManagerSizeCache> WeakSizeCache = GetSizeCache();
+
+	RequestDependencyGraph(FOnMicroManagerDependencyGraphReady::CreateLambda(
+		[WeakSizeCache, AssetsData, OnSizesUpdated](TSharedRef<const FMicroManagerDependencyGraph> Graph)
+		{
+			if (TSharedPtr<FMicroManagerSizeCache> PinnedSizeCache = WeakSizeCache.Pin())
+			{
+				PinnedSizeCache->RequestSizes(AssetsData, Graph, OnSizesUpdated);
+			}
+		}));
+}
+
+void UMicroManagerSubsystem::RequestDependencyGraph(FOnMicroManagerDependencyGraphReady OnGraphReady)
+{
+	FlushRegistryChanges();
+
+	if (DependencyGraph.IsValid())
+	{
+		OnGraphReady.ExecuteIfBound(DependencyGraph.ToSharedRef());
+		return;
+	}
+
+	PendingDependencyGraphRequests.Add(OnGraphReady);
+
+	// Requests arriving while a build is running just wait for it
+	if (bIsBuildingDependencyGraph) return;
+
+	bIsBuildingDependencyGraph = true;
+	bDependencyGraphOutdated = false;
+
+	const IAssetRegistry* AssetRegistry = &FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+	TWeakObjectPtr<UMicroManagerSubsystem> WeakSubsystem = this;
+
+	// Config is only safe to read here, the worker just gets the result
+	TSet<FName> ConfigReferencedPackages = FMicroManagerDependencyGraph::GatherConfigReferencedPackages();
+
+	Async(EAsyncExecution::ThreadPool, [WeakSubsystem, AssetRegistry, ConfigReferencedPackages = MoveTemp(ConfigReferencedPackages)]()
+	{
+		TSharedRef<const FMicroManagerDependencyGraph> BuiltGraph =
+			FMicroManagerDependencyGraph::Build(*AssetRegistry, ConfigReferencedPackages);
+
+		AsyncTask(ENamedThreads::GameThread, [WeakSubsystem, BuiltGraph]()
+		{
+			if (UMicroManagerSubsystem* Subsystem = WeakSubsystem.Get())
+			{
+				Subsystem->OnDependencyGraphBuilt(BuiltGraph);
+			}
+		});
+	});
+}
+
+void UMicroManagerSubsystem::OnDependencyGraphBuilt(TSharedRef<const FMicroManagerDependencyGraph> BuiltGraph)
+{
+	bIsBuildingDependencyGraph = false;
+
+	if (!bDependencyGraphOutdated)
+	{
+		DependencyGraph = BuiltGraph;
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("Dependency graph built with %d packages."), BuiltGraph->Num());
+
+	TArray<FOnMicroManagerDependencyGraphReady> RequestsToNotify = MoveTemp(PendingDependencyGraphRequests);
+	for (FOnMicroManagerDependencyGraphReady& Request : RequestsToNotify)
+	{
+		Request.ExecuteIfBound(BuiltGraph);
+	}
+}
+
+#pragma endregion
+
+void UMicroManagerSubsystem::OnAssetRegistryChanged(const FAssetData& ChangedAssetData)
+{
+	// The initial discovery adds every asset of the project one by one, OnFilesLoaded covers it in one go
+	if (FModuleManager::GetModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get().IsLoadingAssets()) return;
+
+	MarkRegistryChanged();
+}
+
+void UMicroManagerSubsystem::OnAssetRegistryAdded(const FAssetData& AddedAssetData)
+{
+	if (FModuleManager::GetModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get().IsLoadingAssets()) return;
+
+	// The text files did not change, but the last scan did not look for this package
+	MarkTextReferencesOutdated();
+	MarkRegistryChanged();
+}
+
+void UMicroManagerSubsystem::OnAssetRegistryFilesLoaded()
+{
+	MarkTextReferencesOutdated();
+	MarkRegistryChanged();
+}
+
+void UMicroManagerSubsystem::MarkRegistryChanged()
+{
+	// Only what running jobs check is updated here, a save or a bulk import fires one event per asset
+	++RegistryGeneration;
+	bDependencyGraphOutdated = bIsBuildingDependencyGraph;
+	bRegistryChangePending = true;
+}
+
+void UMicroManagerSubsystem::FlushRegistryChanges()
+{
+	if (!bRegistryChangePending) return;
+	bRegistryChangePending = false;
+
+	// Clients keep the scans they hold, they just stop being handed out
+	CachedScans.Empty();
+
+	DependencyGraph.Reset();
+
+	// Dependency sizes of every referencer depend on the changed packages, so nothing in the cache can be trusted
+	if (SizeCache.IsValid())
+	{
+		SizeCache->InvalidateAll();
+
+		// Requests still in flight are computed again once the new graph is built, their clients keep waiting
+		if (SizeCache->HasInvalidatedRequests())
+		{
+			TWeakPtr<FMicroManagerSizeCache> WeakSizeCache = SizeCache;
+			RequestDependencyGraph(FOnMicroManagerDependencyGraphReady::CreateLambda(
+				[WeakSizeCache](TSharedRef<const FMicroManagerDependencyGraph> Graph)
+				{
+					if (TSharedPtr<FMicroManagerSizeCache> PinnedSizeCache = WeakSizeCache.Pin())
+					{
+						PinnedSizeCache->RequeueInvalidatedRequests(Graph);
+					}
+				}));
+		}
+	}
+}
+
+void UMicroManagerSubsystem::OnAssetRegistryRenamed(const FAssetData& RenamedAssetData, const FString& OldObjectPath)
+{
+	OnAssetRegistryAdded(RenamedAssetData);
+}
@@ -0,0 +1,64 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UWorldPartition;
+class UWorldPartitionEditorLoaderAdapter;
+
+// What the actor operations need to know about an actor, available without loading it
+struct FMicroManagerActorSummary
+{
+	// Only valid on World Partition maps
+	FGuid Guid;
+
+	FString Label;
+
+	// The Blueprint class when there is one, the native class otherwise
+	FString ClassName;
+	bool bIsBlueprintClass = false;
+
+	// Null while the actor sits in an unloaded cell
+	TWeakObjectPtr<AActor> LoadedActor;
+};
+
+/**
+ * FMicroManagerWorldActors
+ * Lists every actor of the editor world. On World Partition maps the list comes from the actor descriptors, so
+ * actors in unloaded cells are included and nothing gets loaded. Actors are then loaded one by one when an
+ * operation has to edit them, through an actor list loader registered with the World Partition editor. The editor
+ * owns it, so the actors stay loaded once this object is gone and the user unloads them from the World Partition
+ * editor, which asks to save their changes first. Game thread only.
+ */
+class FMicroManagerWorldActors
+{
+public:
+	FMicroManagerWorldActors();
+	~FMicroManagerWorldActors();
+
+	UE_NONCOPYABLE(FMicroManagerWorldActors);
+
+	bool IsPartitioned() const { return WorldPartition.IsValid(); }
+
+	// False once the editor opened another map
+	bool IsForEditorWorld() const;
+
+	TArray<FMicroManagerActorSummary> GatherActors() const;
+
+	static FMicroManagerActorSummary MakeSummary(AActor* Actor);
+
+	// Loaded actors for the summaries, loading the ones still in unloaded cells
+	TArray<AActor*> LoadActors(TConstArrayView<FMicroManagerActorSummary> Summaries);
+
+private:
+	// The loader belongs to the partition of the map being closed, which releases it
+	void OnMapChange(uint32 MapChangeFlags);
+
+	TWeakObjectPtr<UWorld> World;
+
+	TWeakObjectPtr<UWorldPartition> WorldPartition;
+
+	// Holds the actors loaded on demand, created with the first of them
+	TWeakObjectPtr<UWorldPartitionEditorLoaderAdapter> EditorLoaderAdapter;
+};
@@ -16,6 +16,16 @@ enum class E_DuplicationAxis : uint8
     EDA_ZAxis UMETA(DisplayName = "Z Axis"),
 	EDA_MAX UMETA(DisplayName = "Default Max")
 };
+
+UENUM(BlueprintType)
+enum class E_LevelAuditCategory : uint8
+{
+	ELAC_UnneededTick UMETA(DisplayName = "Ticking Without Tick Event"),
+	ELAC_OverlappingShadowLights UMETA(DisplayName = "Overlapping Movable Shadow Lights"),
+	ELAC_NoCullDistance UMETA(DisplayName = "Meshes Without Cull Distance"),
+	ELAC_InstancingCandidates UMETA(DisplayName = "Identical Meshes To Instance"),
+	ELAC_MAX UMETA(Hidden)
+};
 /**
  * 
  */
@@ -46,10 +56,73 @@ public:
 	float OffsetDistance= 300.f;
 	
 
+#pragma endregion
+
+#pragma region ActorBatchInstancing
+	// Groups the selected static mesh actors by level, mesh and material overrides and replaces every group
+	// with a single actor hosting one (H)ISM component, with the mobility and collision of the group's first actor.
+	// Runs as one undoable transaction.
+	UFUNCTION(BlueprintCallable)
+	void MergeActorsIntoInstances();
+
+	UPROPERTY(EditAnywhere,BlueprintReadWrite,Category = "ActorBatchInstancing")
+	bool bUseHierarchicalInstances = true;
+
+	// Groups smaller than this are left untouched, merging a single actor gains nothing
+	UPROPERTY(EditAnywhere,BlueprintReadWrite,Category = "ActorBatchInstancing", meta = (ClampMin = "2"))
+	int32 MinimumActorsPerGroup = 2;
+
+#pragma endregion
+
+#pragma region ActorDuplicateDetection
+	// Selects the static mesh actors stacked on an identical one: same level, class, mesh and materials at the same transform.
+	// Only loaded actors are compared, on a World Partition map load the region to check first.
+	UFUNCTION(BlueprintCallable)
+	void SelectOverlappingDuplicates();
+
+	// Deletes the stacked duplicates found by SelectOverlappingDuplicates as one undoable transaction, the first copy in the level stays
+	UFUNCTION(BlueprintCallable)
+	void DeleteOverlappingDuplicates();
+
+	UPROPERTY(EditAnywhere,BlueprintReadWrite,Category = "ActorDuplicateDetection", meta = (ClampMin = "0.1"))
+	float DuplicateLocationTolerance = 1.f;
+
+	UPROPERTY(EditAnywhere,BlueprintReadWrite,Category = "ActorDuplicateDetection", meta = (ClampMin = "0", ClampMax = "180"))
+	float DuplicateRotationTolerance = 1.f;
+
+	UPROPERTY(EditAnywhere,BlueprintReadWrite,Category = "ActorDuplicateDetection", meta = (ClampMin = "0"))
+	float DuplicateScaleTolerance = 0.01f;
+
+#pragma endregion
+
+#pragma region LevelAudit
+	// Walks the level once and reports actor counts per class and every actor falling in an E_LevelAuditCategory
+	UFUNCTION(BlueprintCallable)
+	void AuditLevelPerformance();
+
+	// Replaces the selection with every actor of CategoryToSelect, ready for a bulk edit in the details panel
+	UFUNCTION(BlueprintCallable)
+	void SelectLevelAuditCategory();
+
+	UPROPERTY(EditAnywhere,BlueprintReadWrite,Category = "LevelAudit")
+	bool bAuditSelectedActorsOnly = false;
+
+	UPROPERTY(EditAnywhere,BlueprintReadWrite,Category = "LevelAudit")
+	E_LevelAuditCategory CategoryToSelect = E_LevelAuditCategory::ELAC_UnneededTick;
+
 #pragma endregion
 private:
 	UPROPERTY()
 	class UEditorActorSubsystem* EditorActorSubsystem;
 
 	bool GetEditorActorSubsystem();
+
+	TArray<AActor*> GetActorsToAudit();
+
+	TArray<AActor*> FindOverlappingDuplicateActors();
+
+	// Actors loaded on demand stay loaded as long as this lives, it is replaced when another map opens
+	TSharedPtr<class FMicroManagerWorldActors> WorldActors;
+
+	FMicroManagerWorldActors& GetWorldActors();
 };
@@ -129,7 +129,5 @@ private:
     { ALight::StaticClass(), TEXT("Light_") },
     { AStaticMeshActor::StaticClass(), TEXT("SMA_") },
 };
-	void FixUpRedirectors();
-
 	
 };
@@ -4,9 +4,12 @@
 
 #include "CoreMinimal.h"
 #include "EditorUtilityWidget.h"
+#include "Engine/DataTable.h"
+#include "Engine/Texture.h"
 #include "Materials/Material.h"
 #include "Materials/MaterialExpressionTextureSample.h"
 #include "Materials/MaterialInstanceConstant.h"
+#include "MicroManagerTextureSetClassifier.h"
 #include "QuickMaterialCreationWidget.generated.h"
 
 
@@ -19,6 +22,38 @@ enum class E_ChannelPackingType : uint8
 
 	ECPT_MAX UMETA (DisplayName = "DefaultMAX")
 };
+// One material instance of a batch, imported from a data table or a CSV file with these columns
+USTRUCT(BlueprintType)
+struct FMicroManagerMaterialInstanceRow : public FTableRowBase
+{
+	GENERATED_BODY()
+
+	// MI_<row name> when empty
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "MaterialInstance")
+	FString InstanceName;
+
+	// Any material or material instance
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "MaterialInstance")
+	TSoftObjectPtr<UMaterialInterface> Parent;
+
+	// Folder the instance is created in, the texture set's folder when empty
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "MaterialInstance")
+	FString DestinationPath;
+
+	// Path prefix of a texture set, e.g. /Game/Textures/T_Rock, every texture goes to the parameter its suffix maps to
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "MaterialInstance")
+	FString TextureSet;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "MaterialInstance")
+	TMap<FName, TSoftObjectPtr<UTexture>> TextureParameters;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "MaterialInstance")
+	TMap<FName, float> ScalarParameters;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "MaterialInstance")
+	TMap<FName, FLinearColor> VectorParameters;
+};
+
 /**
  * 
  */
@@ -60,6 +95,25 @@ public:
 
 #pragma endregion
 
+#pragma region BatchMaterialInstances
+
+	// Rows of FMicroManagerMaterialInstanceRow
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "BatchMaterialInstances",
+		meta = (RequiredAssetDataTags = "RowStructure=/Script/MicroManager.MicroManagerMaterialInstanceRow"))
+	TObjectPtr<UDataTable> MaterialInstanceTable;
+
+	// CSV with a header line naming the FMicroManagerMaterialInstanceRow columns, the first column is the row name
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "BatchMaterialInstances", meta = (FilePathFilter = "csv"))
+	FFilePath MaterialInstanceCsvFile;
+
+	UFUNCTION(BlueprintCallable, Category = "BatchMaterialInstances")
+	void CreateMaterialInstancesFromTable();
+
+	UFUNCTION(BlueprintCallable, Category = "BatchMaterialInstances")
+	void CreateMaterialInstancesFromCsv();
+
+#pragma endregion
+
 	
 #pragma region SupportedTextureNames
 
@@ -117,18 +171,26 @@ private:
 	UMaterial* CreateMaterialAsset(const FString& NameOfTheMaterial, const FString& PathToPutMaterial);
 	void Default_CreateMaterialNodes(UMaterial* CreatedMaterial,UTexture2D* SelectedTexture,uint32& PinsConnectedCounter);
 
+	// Compiles the supported texture name arrays, which can be edited between two material creations
+	void CompileTextureSetClassifier();
+
+	// Texture parameter a classified texture is bound to, the names the parameterized material nodes use
+	FName GetParameterNameForChannel(EMicroManagerTextureChannel Channel) const;
+
+	FMicroManagerTextureSetClassifier TextureSetClassifier;
+
 	
 
 #pragma endregion
 
 #pragma region CreateMaterialNodes
 
-	bool TryConnectBaseColor(UMaterialExpressionTextureSample* TextureSampleNode,UTexture2D* SelectedTexture,UMaterial* CreatedMaterial);
-	bool TryConnectMetalic(UMaterialExpressionTextureSample* TextureSampleNode,UTexture2D* SelectedTexture,UMaterial* CreatedMaterial);
-	bool TryConnectRoughness(UMaterialExpressionTextureSample* TextureSampleNode,UTexture2D* SelectedTexture,UMaterial* CreatedMaterial);
-	bool TryConnectNormal(UMaterialExpressionTextureSample* TextureSampleNode,UTexture2D* SelectedTexture,UMaterial* CreatedMaterial);
-	bool TryConnectAO(UMaterialExpressionTextureSample* TextureSampleNode,UTexture2D* SelectedTexture,UMaterial* CreatedMaterial);
-	bool TryConnectORM(UMaterialExpressionTextureSample* TextureSampleNode,UTexture2D* SelectedTexture,UMaterial* CreatedMaterial);
+	void ConnectBaseColor(UMaterialExpressionTextureSample* TextureSampleNode,UTexture2D* SelectedTexture,UMaterial* CreatedMaterial);
+	void ConnectMetalic(UMaterialExpressionTextureSample* TextureSampleNode,UTexture2D* SelectedTexture,UMaterial* CreatedMaterial);
+	void ConnectRoughness(UMaterialExpressionTextureSample* TextureSampleNode,UTexture2D* SelectedTexture,UMaterial* CreatedMaterial);
+	void ConnectNormal(UMaterialExpressionTextureSample* TextureSampleNode,UTexture2D* SelectedTexture,UMaterial* CreatedMaterial);
+	void ConnectAO(UMaterialExpressionTextureSample* TextureSampleNode,UTexture2D* SelectedTexture,UMaterial* CreatedMaterial);
+	void ConnectORM(UMaterialExpressionTextureSample* TextureSampleNode,UTexture2D* SelectedTexture,UMaterial* CreatedMaterial);
 
 
 #pragma endregion
@@ -137,4 +199,17 @@ private:
 	
 	UMaterialInstanceConstant* CreateMaterialInstanceAsset(UMaterial* CreatedMaterial, FString MaterialInstanceName, const FString& PathToPutMI);  
 
+#pragma region BatchMaterialInstances
+
+	// Creates every row's instance in one pass and saves them all at once, returns the number created
+	int32 CreateMaterialInstancesFromRows(const UDataTable* Table);
+
+	// Bypasses AssetTools so thousands of instances don't each sync the Content Browser nor recache the parent's shaders
+	UMaterialInstanceConstant* CreateMaterialInstanceInPackage(UMaterialInterface* Parent, const FString& PackagePath, const FString& AssetName);
+
+	// Textures of a texture set, by the parameter their suffix maps to
+	void ResolveTextureSet(const FString& TextureSetPrefix, TMap<FName, TArray<FAssetData>>& FolderAssetsCache, TMap<FName, UTexture*>& OutTexturesByParameter) const;
+
+#pragma endregion
+
 };
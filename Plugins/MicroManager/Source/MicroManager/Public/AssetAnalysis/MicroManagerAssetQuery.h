@@ -0,0 +1,135 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetRegistry/AssetData.h"
+
+class FMicroManagerSizeCache;
+
+/**
+ * FMicroManagerAssetColumns
+ * Metadata of the listed assets stored column by column, so every query predicate walks one flat array.
+ * Rows are added as assets come in and never move.
+ */
+class FMicroManagerAssetColumns
+{
+public:
+	// Called back by the query for the rows whose unused flag is still unknown
+	DECLARE_DELEGATE_TwoParams(FResolveUnusedFlags, const TArray<int32>& /*Rows*/, FMicroManagerAssetColumns& /*Columns*/);
+
+	void AddAssets(const TArray<TSharedPtr<FAssetData>>& AssetsDataToAdd);
+
+	// Copies the sizes the cache has computed so far into the size columns
+	void RefreshSizes(const FMicroManagerSizeCache& SizeCache);
+
+	int32 Num() const { return Assets.Num(); }
+
+	// Returns INDEX_NONE for assets that were never added
+	int32 FindRow(const TSharedPtr<FAssetData>& AssetData) const;
+
+	TArray<TSharedPtr<FAssetData>> Assets;
+	TArray<FName> ClassNames;
+	TArray<FName> AssetNames;
+
+	// Lowercased once, so path and name predicates don't allocate per row
+	TArray<FString> LowerPackagePaths;
+	TArray<FString> LowerAssetNames;
+
+	// -1 while unknown
+	TArray<int64> DiskSizes;
+	TArray<int64> DependencySizes;
+
+	// How many listed assets have each asset name
+	TMap<FName, int32> AssetNameCounts;
+
+	// 1 unused, 0 referenced, -1 not resolved yet. Filled on demand, resolving needs registry lookups.
+	TArray<int8> UnusedFlags;
+
+	FResolveUnusedFlags ResolveUnusedFlags;
+
+private:
+	TMap<TSharedPtr<FAssetData>, int32> RowIndices;
+};
+
+/**
+ * FMicroManagerAssetQuery
+ * Compiled filter query, for example: unused AND class:Texture2D AND size>4MB AND path:/Game/Env
+ *
+ * Terms are joined by AND, either spelled out or implied by a space. A term is negated by NOT or a leading '-'.
+ *   unused            nothing references the asset
+ *   samename          another listed asset has the same name
+ *   class:<Class>     asset class name
+ *   path:<Path>       package path starts with <Path>
+ *   name:<Text>       asset name contains <Text>
+ *   size<op><Size>    disk size, <op> is one of > >= < <= =, <Size> takes a B, KB, MB or GB suffix
+ *   deps<op><Size>    size pulled in through hard references
+ */
+class FMicroManagerAssetQuery
+{
+public:
+	/**
+	 * Parses the query text into a predicate pipeline ordered cheapest first.
+	 *
+	 * @param QueryText Query to compile, an empty query matches everything.
+	 * @param OutQuery The compiled query.
+	 * @param OutError Why the query could not be compiled.
+	 * @return False if the query text is invalid.
+	 */
+	static bool Compile(const FString& QueryText, FMicroManagerAssetQuery& OutQuery, FString& OutError);
+
+	bool IsEmpty() const { return Predicates.Num() == 0; }
+
+	/**
+	 * Runs the pipeline over the given rows. Every predicate compacts the surviving rows in one pass
+	 * over its column, so expensive predicates only ever see what the cheap ones let through.
+	 *
+	 * @param Columns Metadata of the rows, unused flags are resolved on demand.
+	 * @param InOutRows Row indices to test, left with the matching ones in the same order.
+	 */
+	void Execute(FMicroManagerAssetColumns& Columns, TArray<int32>& InOutRows) const;
+
+private:
+	enum class EPredicateKind : uint8
+	{
+		Unused,
+		SameName,
+		Class,
+		Path,
+		Name,
+		DiskSize,
+		DependencySize,
+	};
+
+	enum class ESizeComparison : uint8
+	{
+		Greater,
+		GreaterOrEqual,
+		Less,
+		LessOrEqual,
+		Equal,
+	};
+
+	struct FPredicate
+	{
+		EPredicateKind Kind = EPredicateKind::Unused;
+		bool bNegated = false;
+		FName NameValue;
+		FString StringValue;
+		int64 SizeValue = 0;
+		ESizeComparison SizeComparison = ESizeComparison::Greater;
+
+		// Relative cost per row, the pipeline runs the cheapest first
+		int32 Cost = 0;
+	};
+
+	static bool ParseTerm(const FString& Term, FPredicate& OutPredicate, FString& OutError);
+
+	static bool ParseSizeTerm(const FString& Term, FPredicate& OutPredicate, FString& OutError);
+
+	static bool EvaluateSize(const FPredicate& Predicate, int64 Size);
+
+	void ExecutePredicate(const FPredicate& Predicate, FMicroManagerAssetColumns& Columns, TArray<int32>& InOutRows) const;
+
+	TArray<FPredicate> Predicates;
+};
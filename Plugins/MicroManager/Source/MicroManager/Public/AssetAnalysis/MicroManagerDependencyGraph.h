@@ -0,0 +1,97 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class IAssetRegistry;
+class FMicroManagerDependencyGraph;
+
+DECLARE_DELEGATE_OneParam(FOnMicroManagerDependencyGraphReady, TSharedRef<const FMicroManagerDependencyGraph>);
+
+// Why a package keeps everything it references alive
+enum class EMicroManagerRootFlags : uint8
+{
+	None = 0,
+	Map = 1 << 0,
+	PrimaryAsset = 1 << 1,
+	ConfigReference = 1 << 2,
+};
+ENUM_CLASS_FLAGS(EMicroManagerRootFlags);
+
+/**
+ * FMicroManagerDependencyGraph
+ * Immutable snapshot of the package dependency graph held by the Asset Registry.
+ * Packages are dense node indices and edges are stored in flat offset/target arrays, so walking
+ * the graph never touches the registry lock nor allocates per node.
+ */
+class FMicroManagerDependencyGraph
+{
+public:
+	// Snapshots every on-disk package known to the registry. Safe to run on a worker thread.
+	// ConfigReferencedPackages are flagged as roots, gather them on the game thread with GatherConfigReferencedPackages.
+	static TSharedRef<FMicroManagerDependencyGraph> Build(const IAssetRegistry& AssetRegistry, const TSet<FName>& ConfigReferencedPackages);
+
+	// Collects every long package name mentioned in the loaded game, engine and editor config. Game thread only.
+	static TSet<FName> GatherConfigReferencedPackages();
+
+	int32 Num() const { return PackageNames.Num(); }
+
+	// Returns INDEX_NONE if the package is not part of the snapshot
+	int32 FindNode(FName PackageName) const;
+
+	FName GetPackageName(int32 NodeIndex) const { return PackageNames[NodeIndex]; }
+	int64 GetDiskSize(int32 NodeIndex) const { return DiskSizes[NodeIndex]; }
+
+	TConstArrayView<int32> GetHardDependencies(int32 NodeIndex) const;
+	TConstArrayView<int32> GetSoftDependencies(int32 NodeIndex) const;
+
+	// Every package referencing this one, hard or soft
+	TConstArrayView<int32> GetReferencers(int32 NodeIndex) const;
+
+	EMicroManagerRootFlags GetRootFlags(int32 NodeIndex) const { return RootFlags[NodeIndex]; }
+	bool IsRoot(int32 NodeIndex) const { return RootFlags[NodeIndex] != EMicroManagerRootFlags::None; }
+
+	/**
+	 * Finds the shortest reference chain from a package up to the nearest root (map, primary asset or config reference).
+	 * Runs a bidirectional BFS: referencers forward from the package, dependencies backward from every root at once,
+	 * always growing the smaller frontier. Only the visited nodes are tracked, so a query doesn't scale with the graph.
+	 *
+	 * @param StartNode The package to explain.
+	 * @param OutPath Start node first, root last. Empty if no root reaches the package.
+	 * @return True if a chain was found.
+	 */
+	bool FindShortestPathToRoot(int32 StartNode, TArray<int32>& OutPath) const;
+
+	/**
+	 * Computes the inclusive hard dependency closure size of every root, the root itself included.
+	 * The reachable subgraph is collapsed into strongly connected components so cycles are counted
+	 * once, then the condensed DAG is walked in one topological pass, memoizing what every
+	 * component reaches.
+	 *
+	 * @param RootNodes Node indices to compute the closure for.
+	 * @param OutInclusiveSizes Same order as RootNodes.
+	 */
+	void ComputeInclusiveSizes(const TArray<int32>& RootNodes, TArray<int64>& OutInclusiveSizes) const;
+
+private:
+	// Over this many components the memoized reach sets would cost too much memory and
+	// the pass falls back to one walk of the condensed DAG per root
+	static constexpr int32 MaxComponentsForMemoizedPass = 16384;
+
+	TArray<FName> PackageNames;
+	TMap<FName, int32> NodeIndices;
+	TArray<int64> DiskSizes;
+	TArray<EMicroManagerRootFlags> RootFlags;
+
+	// Every node with root flags, the starting frontier of the backward search
+	TArray<int32> RootNodeIndices;
+
+	// Edge lists, the edges of node N are Targets[Offsets[N] .. Offsets[N + 1]]
+	TArray<int32> HardDependencyOffsets;
+	TArray<int32> HardDependencies;
+	TArray<int32> SoftDependencyOffsets;
+	TArray<int32> SoftDependencies;
+	TArray<int32> ReferencerOffsets;
+	TArray<int32> Referencers;
+};
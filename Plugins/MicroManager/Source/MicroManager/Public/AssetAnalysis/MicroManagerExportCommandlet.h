@@ -0,0 +1,25 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "MicroManagerExportCommandlet.generated.h"
+
+/**
+ * UMicroManagerExportCommandlet
+ * Writes the assets under the given folders with their sizes to CSV or JSON, the same file the tab's Export button
+ * writes, so a build machine can diff two exports.
+ *
+ * Usage: UnrealEditor-Cmd.exe <Project> -run=MicroManagerExport -Paths=/Game/A+/Game/B [-Listing=All|Unused|SameName] [-Output=<File.csv|File.json>]
+ */
+UCLASS()
+class MICROMANAGER_API UMicroManagerExportCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UMicroManagerExportCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
@@ -0,0 +1,47 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * FMicroManagerNameIndex
+ * Immutable trigram index for case-insensitive substring search over a list of texts (asset names and paths).
+ * All texts are lowercased once into a single buffer, so queries never allocate per item.
+ * Items are identified by their position in the array given to Build.
+ */
+class FMicroManagerNameIndex
+{
+public:
+	// Builds the index. Safe to run on a worker thread.
+	void Build(const TArray<FString>& ItemTexts);
+
+	int32 Num() const { return ItemOffsets.Num() > 0 ? ItemOffsets.Num() - 1 : 0; }
+
+	/**
+	 * Finds every item containing the search text, using the trigram postings to skip items that can't match.
+	 *
+	 * @param SearchText Text to look for, case-insensitive.
+	 * @param OutMatches Ascending item ids.
+	 */
+	void Search(FStringView SearchText, TArray<int32>& OutMatches) const;
+
+	/**
+	 * Keeps only the matches still containing the search text. Used when the text was extended,
+	 * since every match of the longer text is already among the matches of the shorter one.
+	 */
+	void Narrow(FStringView SearchText, TArray<int32>& InOutMatches) const;
+
+private:
+	// Three lowercased characters packed into one key
+	static uint64 MakeTrigramKey(const TCHAR* Characters);
+
+	bool ItemContains(int32 ItemId, FStringView LowerSearchText) const;
+
+	// Lowercased texts back to back, the text of item N is TextBuffer[ItemOffsets[N] .. ItemOffsets[N + 1]]
+	TArray<TCHAR> TextBuffer;
+	TArray<int32> ItemOffsets;
+
+	// Ascending item ids per trigram
+	TMap<uint64, TArray<int32>> TrigramPostings;
+};
@@ -0,0 +1,67 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetRegistry/AssetData.h"
+
+class FMicroManagerSizeCache;
+
+enum class EMicroManagerExportFormat : uint8
+{
+	Csv,
+	Json
+};
+
+// One exported asset. Names stay FNames until the writer formats them, so a snapshot of a large list stays cheap.
+struct FMicroManagerExportRow
+{
+	FName PackageName;
+	FName AssetName;
+	FName AssetClass;
+
+	// -1 when not computed, MakeRows then fails. Written as an empty cell or null.
+	int64 DiskSize = -1;
+	int64 DependencySize = -1;
+};
+
+DECLARE_DELEGATE_OneParam(FOnMicroManagerExportComplete, bool /*bSucceeded*/);
+
+/**
+ * FMicroManagerScanExport
+ * Writes a list of scanned assets to CSV or JSON, streamed to disk in fixed size chunks so the document is never
+ * held in memory. The output only depends on the assets listed: rows are sorted by package, numbers are plain
+ * integers, line endings are \n and the encoding is UTF-8 without BOM, so two exports of the same list match byte
+ * for byte. The resource size is left out as it changes with what happens to be loaded in the editor.
+ */
+class FMicroManagerScanExport
+{
+public:
+	// Snapshot of the assets with their cached sizes, sorted. Game thread only.
+	// False when a size is not cached yet, the export would then be missing it and should not be written.
+	static bool MakeRows(const TArray<TSharedPtr<FAssetData>>& AssetsData, const FMicroManagerSizeCache& SizeCache,
+		TArray<FMicroManagerExportRow>& OutRows);
+
+	// JSON for a .json file, CSV otherwise
+	static EMicroManagerExportFormat GetFormatForFile(const FString& FilePath);
+
+	// Writes to a temporary file moved over FilePath once complete. Safe to run on a worker thread.
+	static bool WriteToFile(const FString& FilePath, EMicroManagerExportFormat Format, const TArray<FMicroManagerExportRow>& Rows);
+
+	// WriteToFile on a worker thread, OnComplete runs on the game thread
+	static void WriteToFileAsync(const FString& FilePath, TArray<FMicroManagerExportRow>&& Rows, FOnMicroManagerExportComplete OnComplete);
+
+	// Default location of an export picked from the tab or the commandlet
+	static FString GetExportDir();
+
+private:
+	// Formatted text is converted and written once it passes this many characters
+	static constexpr int32 ChunkSize = 64 * 1024;
+
+	// Room for the last row appended before a flush, the chunk buffer is reserved once on the heap
+	static constexpr int32 ChunkSlack = 1024;
+
+	static void AppendCsvField(FStringBuilderBase& Builder, FStringView Field);
+
+	static void AppendJsonString(FStringBuilderBase& Builder, FStringView Text);
+};
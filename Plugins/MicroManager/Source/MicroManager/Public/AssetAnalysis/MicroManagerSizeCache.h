@@ -0,0 +1,83 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetRegistry/AssetData.h"
+#include "MicroManagerSizeWaiters.h"
+
+class FMicroManagerDependencyGraph;
+
+/**
+ * Size figures for one package. Every value stays at -1 until the background pass filled it in.
+ */
+struct FMicroManagerAssetSizeInfo
+{
+	// Size of the .uasset/.umap file on disk
+	int64 DiskSize = -1;
+
+	// Estimated in-memory resource size. Exact for loaded assets, falls back to the disk size otherwise
+	int64 ResourceSize = -1;
+
+	// Disk size of every package pulled in through hard references, the package itself excluded
+	int64 DependencySize = -1;
+
+	// Disk size of the whole hard dependency closure, the package itself included
+	int64 GetInclusiveSize() const { return DiskSize + DependencySize; }
+
+	bool IsComputed() const { return DiskSize >= 0; }
+};
+
+/**
+ * FMicroManagerSizeCache
+ * Computes asset sizes on background worker threads from a dependency graph snapshot of the Asset Registry,
+ * and caches them per package so reopening the tab or switching listing condition costs nothing.
+ */
+class FMicroManagerSizeCache : public TSharedFromThis<FMicroManagerSizeCache>
+{
+public:
+	// Queues the size computation for every asset that is not cached yet.
+	// OnSizesUpdated is executed on the game thread once every requested asset is cached, including the ones
+	// an earlier request already queued.
+	void RequestSizes(const TArray<TSharedPtr<FAssetData>>& AssetsData,
+		TSharedRef<const FMicroManagerDependencyGraph> DependencyGraph, FSimpleDelegate OnSizesUpdated);
+
+	// Returns the cached sizes of the package, or nullptr when they were not computed yet. Game thread only.
+	const FMicroManagerAssetSizeInfo* FindSizeInfo(FName PackageName) const;
+
+	// Convenience accessors returning -1 for unknown sizes
+	int64 GetDiskSize(FName PackageName) const;
+	int64 GetResourceSize(FName PackageName) const;
+	int64 GetDependencySize(FName PackageName) const;
+
+	// Drops everything, used when the dependency graph went stale. Batches still running are not cached when they land,
+	// the requests waiting on them are kept for RequeueInvalidatedRequests.
+	void InvalidateAll();
+
+	bool HasInvalidatedRequests() const { return InvalidatedRequests.Num() > 0; }
+
+	// Queues the requests dropped by InvalidateAll again, against the graph built since
+	void RequeueInvalidatedRequests(TSharedRef<const FMicroManagerDependencyGraph> DependencyGraph);
+
+private:
+	void RequestPackageSizes(TArray<FName>&& PackageNames, TSharedRef<const FMicroManagerDependencyGraph> DependencyGraph,
+		FSimpleDelegate OnSizesUpdated);
+
+	// Worker side of RequestSizes, runs off the game thread
+	static void ComputeSizes(const FMicroManagerDependencyGraph& DependencyGraph, const TArray<FName>& PackageNames,
+		TArray<FMicroManagerAssetSizeInfo>& OutSizes);
+
+	// Called back on the game thread to merge a finished batch
+	void OnSizesComputed(uint32 BatchGeneration, const TArray<FName>& PackageNames, TArray<FMicroManagerAssetSizeInfo>& ComputedSizes);
+
+	TMap<FName, FMicroManagerAssetSizeInfo> CachedSizes;
+
+	// Packages already queued on a worker, so the same package is never computed twice at once
+	TSet<FName> PendingPackages;
+
+	// Requests still waiting on packages queued by themselves or by an earlier request
+	FMicroManagerSizeWaiters Waiters;
+
+	// Requests in flight when the cache was last invalidated, waiting for a new graph
+	TArray<FMicroManagerSizeWaiters::FWaiter> InvalidatedRequests;
+};
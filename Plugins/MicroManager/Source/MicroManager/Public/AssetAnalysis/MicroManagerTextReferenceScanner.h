@@ -0,0 +1,71 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * FMicroManagerPathMatcher
+ * Aho-Corasick automaton over a set of package paths, finds every one of them in a text in a single pass.
+ * Matching is ASCII case-insensitive and only whole paths count: "/Game/A" is not found in "/Game/AB",
+ * "/Game/A/B" nor "/Plugin/Game/A", but is found in "/Game/A.A" or "'/Game/A'".
+ *
+ * The trie is stored as flat child offset/label/target arrays, built in one pass over the sorted patterns.
+ */
+class FMicroManagerPathMatcher
+{
+public:
+	void Build(const TArray<FString>& Patterns);
+
+	int32 NumPatterns() const { return PatternLengths.Num(); }
+
+	// Calls OnMatch with the index of every pattern found in the UTF-8 text, once per occurrence. Thread safe.
+	void FindMatches(TConstArrayView<uint8> Utf8Text, TFunctionRef<void(int32 PatternIndex)> OnMatch) const;
+
+private:
+	static constexpr int32 RootNode = 0;
+
+	// Children of node N are ChildLabels/ChildNodes[ChildOffsets[N] .. ChildOffsets[N + 1]], sorted by label
+	TArray<int32> ChildOffsets;
+	TArray<uint8> ChildLabels;
+	TArray<int32> ChildNodes;
+
+	TArray<int32> FailureLinks;
+
+	// Nearest node down the failure chain ending a pattern, INDEX_NONE if there is none
+	TArray<int32> OutputLinks;
+
+	// Pattern ending at each node, INDEX_NONE if none does
+	TArray<int32> NodePatterns;
+
+	// In bytes, per pattern index
+	TArray<int32> PatternLengths;
+
+	int32 FindChild(int32 Node, uint8 Label) const;
+};
+
+/**
+ * FMicroManagerTextReferenceScanner
+ * Finds packages mentioned by path in the project's Config, Source and Plugins text files:
+ * ini settings, data files and ConstructorHelpers paths the Asset Registry knows nothing about.
+ */
+class FMicroManagerTextReferenceScanner
+{
+public:
+	/**
+	 * Searches every text file for the candidate packages, files are read and matched in parallel.
+	 *
+	 * @param CandidatePackages Long package names to look for.
+	 * @param OutReferencedPackages Candidates mentioned at least once.
+	 */
+	static void FindReferencedPackages(const TArray<FName>& CandidatePackages, TSet<FName>& OutReferencedPackages);
+
+	// Text files under the project's Config, Source and Plugins folders, build outputs and content skipped
+	static void GatherTextFiles(TArray<FString>& OutFilePaths);
+
+	// The project's Config, Source and Plugins folders, as absolute paths
+	static void GetTextDirectories(TArray<FString>& OutDirectories);
+
+	// Whether GatherTextFiles lists the file, by extension and folder
+	static bool IsScannedFile(const FString& FilePath);
+};
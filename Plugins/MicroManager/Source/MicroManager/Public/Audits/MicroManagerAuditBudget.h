@@ -0,0 +1,38 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Class.h"
+
+/**
+ * FMicroManagerAuditBudget
+ * Reads the limits of the audits from the MicroManager section of the editor per project ini, each audit prefixing
+ * its keys with its own name. A key that is missing or can't be parsed keeps the default the budget was built with.
+ */
+class FMicroManagerAuditBudget
+{
+public:
+	static void Read(const TCHAR* Key, int32& InOutValue);
+	static void Read(const TCHAR* Key, float& InOutValue);
+
+	// The value is the enumerator's name, Medium for ESoundwaveSampleRateSettings::Medium
+	template <typename EnumType>
+	static void ReadEnum(const TCHAR* Key, EnumType& InOutValue)
+	{
+		FString ValueName;
+		if (!ReadString(Key, ValueName)) return;
+
+		const int64 Value = StaticEnum<EnumType>()->GetValueByNameString(ValueName);
+		if (Value != INDEX_NONE)
+		{
+			InOutValue = static_cast<EnumType>(Value);
+		}
+	}
+
+	// Closes a report summary listing the budgets it applied
+	static const TCHAR* GetWhereToSetText();
+
+private:
+	static bool ReadString(const TCHAR* Key, FString& OutValue);
+};
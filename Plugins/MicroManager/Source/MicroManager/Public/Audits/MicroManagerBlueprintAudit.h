@@ -0,0 +1,74 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetRegistry/AssetData.h"
+
+class FMicroManagerDependencyGraph;
+class UBlueprint;
+
+// A package referenced by a Blueprint, with the size loading it costs
+struct FMicroManagerBlueprintReference
+{
+	FName PackageName;
+
+	// Disk size of the referenced package and its whole hard dependency closure
+	int64 InclusiveSize = 0;
+};
+
+struct FMicroManagerBlueprintAuditEntry
+{
+	FName BlueprintPackage;
+
+	// Everything loading the Blueprint pulls in, the Blueprint itself included
+	int64 HardLoadSize = 0;
+
+	// What the soft references would pull in once resolved, not paid when the Blueprint loads
+	int64 SoftReferenceSize = 0;
+
+	// Direct references, biggest first
+	TArray<FMicroManagerBlueprintReference> HardReferences;
+	TArray<FMicroManagerBlueprintReference> SoftReferences;
+};
+
+/**
+ * FMicroManagerBlueprintAudit
+ * Ranks Blueprints by the size their hard references drag in when they load, and tracks a hard reference
+ * back to the class default or component property holding it so it can be made soft.
+ */
+class FMicroManagerBlueprintAudit
+{
+public:
+	// Audits the Blueprints among the given assets and opens the report once the background pass is done
+	static void RunAndShowReport(const TArray<TSharedPtr<FAssetData>>& AssetsData);
+
+	/**
+	 * Computes the audit entries from a dependency graph snapshot. Safe to run on a worker thread.
+	 *
+	 * @param DependencyGraph Snapshot of the registry dependencies.
+	 * @param BlueprintPackages Packages of the Blueprints to audit.
+	 * @param OutEntries One entry per Blueprint found in the snapshot, heaviest first.
+	 */
+	static void ComputeEntries(const FMicroManagerDependencyGraph& DependencyGraph, const TArray<FName>& BlueprintPackages,
+		TArray<FMicroManagerBlueprintAuditEntry>& OutEntries);
+
+	/**
+	 * Finds the class default or component template property holding a hard reference to a package, looking inside
+	 * structs, arrays, sets and maps, and in the overridden templates of inherited components. Game thread only.
+	 *
+	 * @param Blueprint The Blueprint to inspect, its generated class must be up to date.
+	 * @param ReferencedPackage Package the property points into.
+	 * @param OutPropertyPath Property name followed by the member or element holding the reference, prefixed by the
+	 *                        component name for component templates.
+	 * @param OutVariableName Set when the property is a variable declared by the Blueprint itself.
+	 * @return True if a property was found.
+	 */
+	static bool FindReferencingProperty(UBlueprint* Blueprint, FName ReferencedPackage, FString& OutPropertyPath, FName& OutVariableName);
+
+	// Opens the Blueprint editor on the property holding the reference, or explains where the reference comes from
+	static void NavigateToReferencingProperty(FName BlueprintPackage, FName ReferencedPackage);
+
+private:
+	static bool FindReferencingPropertyInObject(const UObject* Object, FName ReferencedPackage, FString& OutPropertyPath, FName& OutRootPropertyName);
+};
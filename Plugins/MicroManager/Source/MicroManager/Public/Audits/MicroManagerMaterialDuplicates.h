@@ -0,0 +1,105 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetRegistry/AssetData.h"
+#include "Hash/Blake3.h"
+
+class UMaterial;
+class UMaterialInstanceConstant;
+class UMaterialInterface;
+
+enum class EMicroManagerMaterialDuplicateKind : uint8
+{
+	// Same expression graph and settings, parameter defaults may differ
+	Material,
+	// Same parent, same overrides
+	MaterialInstance
+};
+
+// Equivalent materials or instances, every duplicate can be replaced by the canonical one
+struct FMicroManagerMaterialDuplicateGroup
+{
+	EMicroManagerMaterialDuplicateKind Kind = EMicroManagerMaterialDuplicateKind::Material;
+
+	// Kept, the most referenced of the group
+	FAssetData Canonical;
+
+	TArray<FAssetData> Duplicates;
+
+	// Referencer count per duplicate, same order as Duplicates
+	TArray<int32> DuplicateReferencerCounts;
+
+	int32 CanonicalReferencerCount = 0;
+};
+
+/**
+ * FMicroManagerMaterialDuplicates
+ * Finds structurally equivalent materials and material instances and consolidates them.
+ *
+ * A material hashes its settings and the expressions reachable from its outputs, each expression hashing its class,
+ * its properties and the expressions feeding it, so node positions, comments, dangling nodes and the order
+ * expressions were added in don't matter. Connections nested in properties, like function call and custom node
+ * inputs, hash the same way. Scalar, vector and texture parameter defaults are left out: materials
+ * differing only there become instances of one parent overriding them, and share its shaders.
+ * An instance hashes its parent, its sorted parameter and base property overrides and its subsurface and lightmass
+ * settings. Game thread only.
+ */
+class FMicroManagerMaterialDuplicates
+{
+public:
+	// Hashes the materials and instances among the given assets and opens the report, every group and duplicate
+	// row of it consolidating on its own
+	static void RunAndShowReport(const TArray<TSharedPtr<FAssetData>>& AssetsData);
+
+	static FBlake3Hash HashMaterial(UMaterial* Material);
+
+	// False when the instance overrides a parameter type the hash can't compare, it is then never grouped
+	static bool HashMaterialInstance(const UMaterialInstanceConstant* MaterialInstance, FBlake3Hash& OutHash);
+
+	/**
+	 * Groups the equivalent materials and instances, loading them behind a cancelable progress dialog.
+	 *
+	 * @param AssetsData Assets to look through, anything else than materials and material instance constants is ignored.
+	 * @param OutGroups Groups of two or more equivalent assets, most duplicates first.
+	 * @return False if the user canceled.
+	 */
+	static bool FindDuplicateGroups(const TArray<TSharedPtr<FAssetData>>& AssetsData, TArray<FMicroManagerMaterialDuplicateGroup>& OutGroups);
+
+	// Groups the instances still loaded at their path again, used once consolidated materials changed their parents
+	static void FindDuplicateInstanceGroups(const TArray<FAssetData>& InstanceCandidates, TArray<FMicroManagerMaterialDuplicateGroup>& OutGroups);
+
+	/**
+	 * Replaces every duplicate of a group by its canonical asset. Duplicate materials whose parameter defaults match the
+	 * canonical one are consolidated into it, the others into a new instance of it overriding the differing defaults.
+	 * The redirectors, new instances and loaded referencers are then saved in one batch.
+	 *
+	 * @return Number of duplicates consolidated.
+	 */
+	static int32 ConsolidateGroup(const FMicroManagerMaterialDuplicateGroup& Group);
+
+	static const TCHAR* LexToString(EMicroManagerMaterialDuplicateKind Kind);
+
+private:
+	// Shared by the reports opened from one run
+	struct FReportContext
+	{
+		TArray<FAssetData> InstanceCandidates;
+
+		// Groups already shown, so regrouping only reports new ones
+		TSet<FString> ReportedGroupKeys;
+	};
+
+	static void ShowGroupsReport(const FString& Title, const TArray<FMicroManagerMaterialDuplicateGroup>& Groups, TSharedRef<FReportContext> Context);
+
+	// Confirms and consolidates from a report row, regrouping the instances after a material group.
+	// True once every duplicate of the group was consolidated.
+	static bool ConsolidateFromReport(const FMicroManagerMaterialDuplicateGroup& Group, TSharedRef<FReportContext> Context);
+
+	// Instance of the canonical material next to the duplicate, overriding the defaults the duplicate changes
+	static UMaterialInstanceConstant* CreateReplacementInstance(UMaterial* CanonicalMaterial, UMaterial* DuplicateMaterial);
+
+	// Consolidates with no confirmation dialog and leaves redirectors behind for the unloaded referencers
+	static bool ConsolidateInto(UMaterialInterface* Canonical, UMaterialInterface* Duplicate);
+};
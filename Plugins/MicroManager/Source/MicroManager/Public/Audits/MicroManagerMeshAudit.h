@@ -0,0 +1,75 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetRegistry/AssetData.h"
+#include "Engine/EngineTypes.h"
+
+class UStaticMesh;
+
+struct FMicroManagerMeshAuditEntry
+{
+	FAssetData AssetData;
+
+	// All from the registry tags, the mesh is only loaded when one of them is missing
+	int32 Triangles = 0;
+	int32 Vertices = 0;
+	int32 NumLODs = 0;
+	bool bNaniteEnabled = false;
+	TEnumAsByte<ECollisionTraceFlag> CollisionComplexity = CTF_UseDefault;
+	int32 LightMapResolution = 0;
+};
+
+// Limits above which a mesh is flagged
+struct FMicroManagerMeshBudget
+{
+	// Meshes without Nanite above this are switched to Nanite
+	int32 MaxTriangles = 50000;
+
+	// Meshes without Nanite above this need LODs
+	int32 MinTrianglesForLODs = 2000;
+
+	// Complex collision used as simple costs a query per triangle above this
+	int32 MaxComplexCollisionTriangles = 5000;
+
+	int32 MaxLightMapResolution = 256;
+
+	// LODs generated per mesh, each one halving the triangles of the previous
+	int32 GeneratedLODCount = 4;
+
+	static FMicroManagerMeshBudget Load();
+};
+
+/**
+ * FMicroManagerMeshAudit
+ * Reports the triangle, vertex and LOD counts, Nanite, collision complexity and lightmap resolution of the static
+ * meshes under the selected folders from their registry tags, then offers to enable Nanite, generate LODs and
+ * simplify collision on the meshes over budget. Meshes are rebuilt in parallel and saved in one batch. Game thread only.
+ */
+class FMicroManagerMeshAudit
+{
+public:
+	static void RunAndShowReport(const TArray<TSharedPtr<FAssetData>>& AssetsData);
+
+	/**
+	 * Reads the registry tags of every mesh, loading only the ones saved before a tag existed.
+	 *
+	 * @return False if the user canceled.
+	 */
+	static bool CollectEntries(const TArray<TSharedPtr<FAssetData>>& AssetsData, TArray<FMicroManagerMeshAuditEntry>& OutEntries);
+
+	// Why the mesh is over budget, empty when it is not
+	static TArray<FString> FindIssues(const FMicroManagerMeshAuditEntry& Entry, const FMicroManagerMeshBudget& Budget);
+
+	static bool NeedsNanite(const FMicroManagerMeshAuditEntry& Entry, const FMicroManagerMeshBudget& Budget);
+	static bool NeedsLODs(const FMicroManagerMeshAuditEntry& Entry, const FMicroManagerMeshBudget& Budget);
+	static bool NeedsSimpleCollision(const FMicroManagerMeshAuditEntry& Entry, const FMicroManagerMeshBudget& Budget);
+
+	// Only change the build settings, the meshes still have to go through UStaticMesh::BatchBuild
+	static void EnableNanite(UStaticMesh* StaticMesh);
+	static void SetupGeneratedLODs(UStaticMesh* StaticMesh, int32 LODCount);
+
+	// Stops using the render triangles for simple queries, adding a bounding box if the mesh has no simple shape
+	static void SimplifyCollision(UStaticMesh* StaticMesh);
+};
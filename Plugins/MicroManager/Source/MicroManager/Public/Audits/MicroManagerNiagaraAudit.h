@@ -0,0 +1,81 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetRegistry/AssetData.h"
+
+class UNiagaraSystem;
+
+struct FMicroManagerNiagaraEmitterEntry
+{
+	FName Name;
+	bool bIsGPU = false;
+	bool bHasFixedBounds = false;
+
+	// Estimated from the particle counts seen at runtime, or the preallocation when never run
+	int32 MaxParticles = 0;
+};
+
+struct FMicroManagerNiagaraAuditEntry
+{
+	FAssetData AssetData;
+
+	// Enabled emitters only
+	TArray<FMicroManagerNiagaraEmitterEntry> Emitters;
+
+	// Set on the system, overrides the bounds of every emitter
+	bool bHasFixedBounds = false;
+
+	FString EffectType;
+
+	// Culling for the current platform, from the effect type or the system overrides
+	bool bCullByDistance = false;
+	float CullDistance = 0.f;
+	bool bCullMaxInstanceCount = false;
+	int32 MaxInstances = 0;
+	bool bCullByMaxTimeWithoutRender = false;
+	float MaxTimeWithoutRender = 0.f;
+
+	float WarmupTime = 0.f;
+
+	int32 GetNumGPUEmitters() const;
+	int32 GetTotalMaxParticles() const;
+
+	// Whether every enabled emitter gets fixed bounds, from the system or its own
+	bool HasFixedBoundsEverywhere() const;
+
+	bool HasAnyCulling() const { return bCullByDistance || bCullMaxInstanceCount || bCullByMaxTimeWithoutRender; }
+};
+
+// Limits above which a system is flagged
+struct FMicroManagerNiagaraBudget
+{
+	int32 MaxEmitters = 8;
+	int32 MaxParticles = 10000;
+
+	// CPU emitters simulate every particle on the game thread's workers, they get a lower limit
+	int32 MaxCPUEmitterParticles = 2000;
+
+	float MaxWarmupTime = 1.f;
+
+	static FMicroManagerNiagaraBudget Load();
+};
+
+/**
+ * FMicroManagerNiagaraAudit
+ * Reports the bounds, emitters, sim targets, particle counts, scalability culling and warmup of the Niagara systems
+ * under the selected folders, with one nested row per emitter, and flags the systems over budget. Game thread only.
+ */
+class FMicroManagerNiagaraAudit
+{
+public:
+	static void RunAndShowReport(const TArray<TSharedPtr<FAssetData>>& AssetsData);
+
+	static FMicroManagerNiagaraAuditEntry MeasureSystem(UNiagaraSystem* System);
+
+	// Why the system is over budget, empty when it is not
+	static TArray<FString> FindIssues(const FMicroManagerNiagaraAuditEntry& Entry, const FMicroManagerNiagaraBudget& Budget);
+
+	static FString DescribeCulling(const FMicroManagerNiagaraAuditEntry& Entry);
+};
@@ -0,0 +1,78 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetRegistry/AssetData.h"
+
+class UMaterial;
+
+// What a material costs once compiled for the editor's feature level
+struct FMicroManagerShaderCost
+{
+	// MakeStateId of the material the cost was measured for, any edit to it or what it compiles in changes it
+	FGuid StateId;
+
+	int32 PixelInstructions = 0;
+	int32 VertexInstructions = 0;
+	int32 Samplers = 0;
+	int32 TextureSamples = 0;
+	int32 VirtualTextureSamples = 0;
+
+	// Shaders in the compiled shader map, every usage flag and static switch multiplies them
+	int32 ShaderCount = 0;
+
+	// One bit per EMaterialUsage set on the material
+	uint64 UsageFlags = 0;
+
+	// Distinct textures feeding ambient occlusion, roughness and metallic, 2 or 3 could be one ORM texture
+	int32 SeparateOrmTextures = 0;
+
+	friend FArchive& operator<<(FArchive& Ar, FMicroManagerShaderCost& Cost);
+};
+
+// Limits above which a material is flagged
+struct FMicroManagerShaderBudget
+{
+	int32 MaxPixelInstructions = 400;
+	int32 MaxSamplers = 8;
+	int32 MaxShaderCount = 400;
+	int32 MaxUsageFlags = 4;
+
+	static FMicroManagerShaderBudget Load();
+};
+
+/**
+ * FMicroManagerShaderCostReport
+ * Compiles the materials under the selected folders, collects their instruction, sampler and shader counts and
+ * usage flags, and flags the ones over budget. Costs are cached on disk per package and only measured again once
+ * the state id of the material or of a function or parameter collection it uses changed, so a batch over an
+ * unchanged folder doesn't compile anything. Game thread only.
+ */
+class FMicroManagerShaderCostReport
+{
+public:
+	static void RunAndShowReport(const TArray<TSharedPtr<FAssetData>>& AssetsData);
+
+	// Hash of the state ids of the material, its material functions and its parameter collections
+	static FGuid MakeStateId(const UMaterial* Material);
+
+	// Compiles the material if needed, blocking until its shader map is ready
+	static FMicroManagerShaderCost MeasureMaterial(UMaterial* Material);
+
+	// Why the material is over budget, empty when it is not
+	static TArray<FString> FindIssues(const FMicroManagerShaderCost& Cost, const FMicroManagerShaderBudget& Budget);
+
+	static FString DescribeUsageFlags(uint64 UsageFlags);
+
+	// Saved/MicroManager/ShaderCostCache.bin
+	static FString GetCacheFilePath();
+
+private:
+	static constexpr uint32 CacheFileVersion = 2;
+
+	// Costs per material package, empty when the file was written for another feature level or engine version
+	static TMap<FName, FMicroManagerShaderCost> LoadCache(const FString& CacheKey);
+
+	static void SaveCache(const FString& CacheKey, const TMap<FName, FMicroManagerShaderCost>& Cache);
+};
@@ -0,0 +1,65 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetRegistry/AssetData.h"
+#include "Sound/SoundWave.h"
+
+struct FMicroManagerSoundAuditEntry
+{
+	FAssetData AssetData;
+
+	// From the registry tags, the wave is only loaded when one is missing
+	float Duration = 0.f;
+	int32 NumChannels = 0;
+	int32 SampleRate = 0;
+
+	int32 CompressionQuality = 0;
+	ESoundWaveLoadingBehavior LoadingBehavior = ESoundWaveLoadingBehavior::Inherited;
+	ESoundwaveSampleRateSettings SampleRateQuality = ESoundwaveSampleRateSettings::Max;
+	bool bIsStreaming = false;
+
+	// 16 bit PCM size of the whole wave, what decompressing it on load would cost
+	int64 PcmSize = 0;
+
+	// Compressed size kept in memory once loaded, only the first chunk when the wave streams. -1 when the wave is not in memory.
+	int64 ResidentSize = -1;
+};
+
+// Limits of the batch actions
+struct FMicroManagerSoundBudget
+{
+	// Waves longer than this are switched to streaming
+	float StreamingDurationThreshold = 10.f;
+
+	// Applied to the waves still at the maximum sample rate
+	ESoundwaveSampleRateSettings SampleRateOverride = ESoundwaveSampleRateSettings::Medium;
+
+	static FMicroManagerSoundBudget Load();
+};
+
+/**
+ * FMicroManagerSoundAudit
+ * Reports the duration, format, compression, loading behavior and memory of the sound waves under the selected
+ * folders, then offers to stream the long ones and to lower the sample rate of the others. Every change is saved
+ * in one batch. Game thread only.
+ */
+class FMicroManagerSoundAudit
+{
+public:
+	static void RunAndShowReport(const TArray<TSharedPtr<FAssetData>>& AssetsData);
+
+	/**
+	 * Reads the registry tags of every wave, then loads the ones saved without them behind a cancelable progress dialog.
+	 *
+	 * @return False if the user canceled.
+	 */
+	static bool CollectEntries(const TArray<TSharedPtr<FAssetData>>& AssetsData, TArray<FMicroManagerSoundAuditEntry>& OutEntries);
+
+	// Switches the waves longer than the threshold that are not streamed yet to load on demand, returns their packages
+	static TArray<UPackage*> ForceStreaming(const TArray<FMicroManagerSoundAuditEntry>& Entries, float DurationThreshold);
+
+	// Sets the sample rate override of the waves still at the maximum, returns their packages
+	static TArray<UPackage*> ApplySampleRateOverride(const TArray<FMicroManagerSoundAuditEntry>& Entries, ESoundwaveSampleRateSettings SampleRateOverride);
+};
@@ -31,12 +31,34 @@ private:
 
 	void OnDeleteUnusedAssetsButtonClicked();
 
-	void FixUpRedirectors();
-
 	void OnDeleteUnusedFoldersButtonClicked();
 
 	void OnMicroManagerClicked();
 
+	void OnToggleTextReferenceScanClicked();
+
+	bool IsTextReferenceScanEnabled() const;
+
+	void AddCBAuditsSubMenu(FMenuBuilder& MenuBuilder);
+
+	void OnAuditBlueprintHardReferencesClicked();
+
+	void OnProfileAssetLoadsClicked();
+
+	void OnFindDuplicateMaterialsClicked();
+
+	void OnReportShaderCostClicked();
+
+	void OnAuditSoundsClicked();
+
+	void OnAuditStaticMeshesClicked();
+
+	void OnAuditNiagaraSystemsClicked();
+
+	void OnTakeProjectSnapshotClicked();
+
+	void OnDiffProjectSnapshotsClicked();
+
 #pragma endregion
 
 #pragma region CustomEditorTab
@@ -59,12 +81,18 @@ public:
 
 	bool DeleteSingleAssetForAssetList(const FAssetData& AssetDataToDelete);
 	bool DeleteMultipleAssetsForAssetList(TArray<FAssetData> AssetsToDelete);
-	void ListUnusedAssetsForAssetList(const TArray< TSharedPtr <FAssetData> >& AssetsDataToFilter,TArray< TSharedPtr <FAssetData> >& OutUnusedAssetsData);
 	void ListSameNameAssetsForAssetList(const TArray< TSharedPtr <FAssetData> >& AssetsDataToFilter,TArray< TSharedPtr <FAssetData> >& OutSameNameAssetsData);
+	void ListLargestAssetsForAssetList(const TArray< TSharedPtr <FAssetData> >& AssetsDataToFilter, int32 NumOfAssetsToList, TArray< TSharedPtr <FAssetData> >& OutLargestAssetsData);
+	void ListLoadBloatAssetsForAssetList(const TArray< TSharedPtr <FAssetData> >& AssetsDataToFilter, TArray< TSharedPtr <FAssetData> >& OutLoadBloatAssetsData);
 	void SyncCBToClickedAssetForAssetList(const FString& AssetPathsToSync);
 
+	// Assets pulling in at least this many megabytes through hard references are flagged as load bloat,
+	// unless LoadBloatThresholdMB is set through FMicroManagerAuditBudget
+	int32 LoadBloatThresholdMB = 64;
+
 	
 
 
 #pragma endregion	
+
 };
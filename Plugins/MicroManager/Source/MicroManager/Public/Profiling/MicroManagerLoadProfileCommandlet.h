@@ -0,0 +1,25 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "MicroManagerLoadProfileCommandlet.generated.h"
+
+/**
+ * UMicroManagerLoadProfileCommandlet
+ * Profiles the load of every asset under the given folders. No editor holds assets open here, so unlike the tab action
+ * no sample is skipped as already loaded, and what each sample loads is unloaded before the next one.
+ *
+ * Usage: UnrealEditor-Cmd.exe <Project> -run=MicroManagerLoadProfile -Paths=/Game/A+/Game/B [-Output=<File.csv>]
+ */
+UCLASS()
+class MICROMANAGER_API UMicroManagerLoadProfileCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UMicroManagerLoadProfileCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
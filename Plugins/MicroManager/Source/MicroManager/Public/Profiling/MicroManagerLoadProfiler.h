@@ -0,0 +1,76 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetRegistry/AssetData.h"
+
+class UPackage;
+
+enum class EMicroManagerLoadSampleStatus : uint8
+{
+	Loaded,
+	// Already in memory before the sample, e.g. open in an editor, so nothing could be measured
+	AlreadyLoaded,
+	Failed
+};
+
+struct FMicroManagerLoadSample
+{
+	FName PackageName;
+	FString AssetClass;
+	EMicroManagerLoadSampleStatus Status = EMicroManagerLoadSampleStatus::Failed;
+
+	double LoadSeconds = 0.0;
+
+	// Packages brought into memory by the load, the asset's own package included
+	int32 PackagesLoaded = 0;
+
+	// Used physical memory after the load minus before it
+	int64 MemoryDelta = 0;
+};
+
+/**
+ * FMicroManagerLoadProfiler
+ * Loads assets one at a time and records what each load costs. The packages a sample brought into memory are
+ * unloaded right after it, so the next sample loads its dependencies again instead of finding them in memory.
+ * Packages that were loaded before a sample are never unloaded. Every sample is appended to the CSV file and flushed as soon as it is taken, so a run cut short by a
+ * pathological asset still leaves the samples before it on disk. Game thread only.
+ */
+class FMicroManagerLoadProfiler
+{
+public:
+	explicit FMicroManagerLoadProfiler(const FString& InCsvFilePath);
+	~FMicroManagerLoadProfiler();
+
+	// False when the CSV file could not be created
+	bool IsValid() const { return CsvWriter.IsValid(); }
+
+	const FString& GetCsvFilePath() const { return CsvFilePath; }
+
+	// Loads the asset's package, writes its sample to the CSV, then unloads every package the load brought in
+	FMicroManagerLoadSample ProfileAsset(const FAssetData& AssetData);
+
+	// Closes the CSV file
+	void Finish();
+
+	// Saved/MicroManager/LoadProfiles/LoadProfile_<timestamp>.csv
+	static FString MakeDefaultCsvFilePath();
+
+	static const TCHAR* LexToString(EMicroManagerLoadSampleStatus Status);
+
+	// Profiles the assets behind a cancelable progress dialog and opens the report once done
+	static void RunAndShowReport(const TArray<TSharedPtr<FAssetData>>& AssetsData);
+
+private:
+	FString CsvFilePath;
+
+	TUniquePtr<FArchive> CsvWriter;
+
+	void WriteCsvLine(const FString& Line);
+
+	static void GetLoadedPackages(TSet<UPackage*>& OutPackages);
+
+	// Quoted when the field holds a comma, a quote or a line break, with its quotes doubled
+	static FString EscapeCsvField(const FString& Field);
+};
@@ -0,0 +1,52 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "Widgets/SCompoundWidget.h"
+#include "Widgets/Views/STreeView.h"
+
+class FMicroManagerDependencyGraph;
+
+// One hop of the reference chain, its only child is the package referencing it
+struct FMicroManagerReferencePathItem
+{
+	FName PackageName;
+	FString RootReason;
+	TArray<TSharedPtr<FMicroManagerReferencePathItem>> Referencers;
+};
+
+/**
+ * SMicroManagerReferencePathView
+ * Shows why an asset is used: the shortest reference chain from the asset up to a root,
+ * as a tree where every level is the package referencing the level above.
+ */
+class SMicroManagerReferencePathView : public SCompoundWidget
+{
+	SLATE_BEGIN_ARGS(SMicroManagerReferencePathView) {}
+	SLATE_ARGUMENT(TSharedPtr<const FMicroManagerDependencyGraph>, DependencyGraph)
+		// Node indices from the asset to the root, as returned by FindShortestPathToRoot
+		SLATE_ARGUMENT(TArray<int32>, ReferencePath)
+		SLATE_ARGUMENT(FName, AssetPackageName)
+		SLATE_ARGUMENT(double, QueryMilliseconds)
+SLATE_END_ARGS()
+
+public:
+	void Construct(const FArguments& InArgs);
+
+	// Opens the view in its own window
+	static void OpenInWindow(TSharedRef<const FMicroManagerDependencyGraph> DependencyGraph, FName AssetPackageName);
+
+private:
+	TArray<TSharedPtr<FMicroManagerReferencePathItem>> RootItems;
+
+	TSharedPtr<STreeView<TSharedPtr<FMicroManagerReferencePathItem>>> ConstructedTreeView;
+
+	TSharedRef<ITableRow> OnGenerateRowForTree(TSharedPtr<FMicroManagerReferencePathItem> Item, const TSharedRef<STableViewBase>& OwnerTable);
+
+	void OnGetChildrenForTree(TSharedPtr<FMicroManagerReferencePathItem> Item, TArray<TSharedPtr<FMicroManagerReferencePathItem>>& OutChildren);
+
+	// Double click syncs the Content Browser to the package
+	void OnTreeItemDoubleClicked(TSharedPtr<FMicroManagerReferencePathItem> Item);
+
+	void ExpandAllItems(const TSharedPtr<FMicroManagerReferencePathItem>& Item);
+};
@@ -0,0 +1,106 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "Widgets/SCompoundWidget.h"
+#include "Widgets/Views/SHeaderRow.h"
+#include "Widgets/Views/STreeView.h"
+
+// One column of a report. Numeric columns sort by the row values instead of the texts.
+struct FMicroManagerReportColumn
+{
+	FName Id;
+	FString Label;
+	float FillWidth = 0.1f;
+	bool bIsNumeric = false;
+};
+
+// Returns true once the row is handled, its button is then disabled
+DECLARE_DELEGATE_RetVal(bool, FOnMicroManagerReportRowAction);
+
+// One line of a report, children are shown nested under it
+struct FMicroManagerReportRow
+{
+	// Displayed text per column id
+	TMap<FName, FString> Texts;
+
+	// Sort key per numeric column id
+	TMap<FName, double> Values;
+
+	// Synced in the Content Browser on double click when OnNavigate is not bound
+	FSoftObjectPath AssetPath;
+
+	FSimpleDelegate OnNavigate;
+
+	// Fix applying to this row only, shown as a button in an extra Action column when bound
+	FString ActionLabel;
+	FOnMicroManagerReportRowAction OnAction;
+	bool bIsActionDone = false;
+
+	TArray<TSharedPtr<FMicroManagerReportRow>> Children;
+
+	void SetText(FName ColumnId, const FString& Text) { Texts.Add(ColumnId, Text); }
+	void SetValue(FName ColumnId, double Value, const FString& Text) { Values.Add(ColumnId, Value); Texts.Add(ColumnId, Text); }
+	void SetSize(FName ColumnId, int64 Size) { SetValue(ColumnId, static_cast<double>(Size), FText::AsMemory(FMath::Max<int64>(Size, 0)).ToString()); }
+};
+
+/**
+ * SMicroManagerReportView
+ * Sortable, filterable tree of report rows shared by the MicroManager audits.
+ * Double clicking a row navigates to it, rows with an action get a button running it.
+ */
+class SMicroManagerReportView : public SCompoundWidget
+{
+	SLATE_BEGIN_ARGS(SMicroManagerReportView) {}
+		SLATE_ARGUMENT(TArray<FMicroManagerReportColumn>, Columns)
+		SLATE_ARGUMENT(TArray<TSharedPtr<FMicroManagerReportRow>>, Rows)
+		// Shown above the list
+		SLATE_ARGUMENT(FString, Summary)
+		// Column sorted by at first, descending
+		SLATE_ARGUMENT(FName, InitialSortColumn)
+	SLATE_END_ARGS()
+
+public:
+	void Construct(const FArguments& InArgs);
+
+	// Opens the report in its own window
+	static void OpenInWindow(const FString& Title, const FString& Summary, const TArray<FMicroManagerReportColumn>& Columns,
+		const TArray<TSharedPtr<FMicroManagerReportRow>>& Rows, FName InitialSortColumn = NAME_None);
+
+private:
+	TArray<FMicroManagerReportColumn> Columns;
+
+	TArray<TSharedPtr<FMicroManagerReportRow>> AllRows;
+
+	static bool HasAnyAction(const TArray<TSharedPtr<FMicroManagerReportRow>>& Rows);
+
+	// Top level rows passing the filter, in display order
+	TArray<TSharedPtr<FMicroManagerReportRow>> FilteredRows;
+
+	TSharedPtr<STreeView<TSharedPtr<FMicroManagerReportRow>>> ConstructedTreeView;
+
+	FString FilterText;
+
+	FName SortByColumn;
+
+	EColumnSortMode::Type SortMode = EColumnSortMode::None;
+
+	TSharedRef<SHeaderRow> ConstructHeaderRow();
+
+	TSharedRef<ITableRow> OnGenerateRowForTree(TSharedPtr<FMicroManagerReportRow> Item, const TSharedRef<STableViewBase>& OwnerTable);
+
+	void OnGetChildrenForTree(TSharedPtr<FMicroManagerReportRow> Item, TArray<TSharedPtr<FMicroManagerReportRow>>& OutChildren);
+
+	void OnTreeItemDoubleClicked(TSharedPtr<FMicroManagerReportRow> Item);
+
+	void OnFilterTextChanged(const FText& NewFilterText);
+
+	EColumnSortMode::Type GetSortModeForColumn(const FName ColumnId) const;
+
+	void OnColumnSortModeChanged(const EColumnSortPriority::Type SortPriority, const FName& ColumnId, const EColumnSortMode::Type NewSortMode);
+
+	// Rebuilds FilteredRows from AllRows with the current filter and sort
+	void RefreshRows();
+
+	void SortRows(TArray<TSharedPtr<FMicroManagerReportRow>>& RowsToSort) const;
+};
@@ -3,6 +3,11 @@
 #pragma once
 
 #include "Widgets/SCompoundWidget.h"
+#include "Widgets/Views/SHeaderRow.h"
+#include "AssetAnalysis/MicroManagerAssetQuery.h"
+#include "Subsystems/MicroManagerSubsystem.h"
+
+class FMicroManagerNameIndex;
 
 /**
  * SMicroManagerTab
@@ -13,6 +18,8 @@ class SMicroManagerTab : public SCompoundWidget
 	SLATE_BEGIN_ARGS(SMicroManagerTab) {}
 	// Defines a single argument to initialize the asset list
 	SLATE_ARGUMENT(TArray<TSharedPtr<FAssetData>>, AssetsDataArray)
+		// Folders gathered in the background and streamed into the list after the tab opened
+		SLATE_ARGUMENT(TArray<FString>, FolderPathsToScan)
 		SLATE_ARGUMENT(FString,CurrentSelectedFolder)
 SLATE_END_ARGS()
 
@@ -30,6 +37,9 @@ private:
 	// Create an Array to hold assets to be deleted
 	TArray<TSharedPtr<FAssetData>> AssetDataToDeleteArray;
 
+	// Checked assets by object path, so the checks survive the list being filtered or sorted again
+	TSet<FSoftObjectPath> CheckedAssetPaths;
+
 	
 
 	TSharedRef<SListView<TSharedPtr<FAssetData>>> ConstructAssetListView();
@@ -39,6 +49,130 @@ private:
 	// Refresh the list view
 	void RefreshAssetListView();
 
+#pragma region ProgressivePopulation
+
+	void OnAssetScanComplete(TSharedRef<const FMicroManagerAssetScan> CompletedScan);
+
+	// Called once the background gather is done, the data is then streamed into the list page by page
+	void OnAssetsDataGathered(const TArray<TSharedPtr<FAssetData>>& GatheredAssetsData);
+
+	// Active timer moving pending pages into the list until the frame budget is spent
+	EActiveTimerReturnType StreamPendingAssetsData(double InCurrentTime, float InDeltaTime);
+
+	// Adds a freshly streamed page to the displayed data when the listing condition can be applied page by page
+	void AppendPageToDisplayedAssets(const TArray<TSharedPtr<FAssetData>>& PageAssetsData);
+
+	bool IsPopulatingAssets() const;
+
+	TOptional<float> GetPopulationPercent() const;
+
+	FText GetPopulationText() const;
+
+	TSharedPtr<const FMicroManagerAssetScan> AssetScan;
+
+	// Gathered but not yet listed, NextPendingAssetIndex is the first one still to stream
+	TArray<TSharedPtr<FAssetData>> PendingAssetsData;
+	int32 NextPendingAssetIndex = 0;
+
+	bool bIsGatheringAssets = false;
+
+	TSharedPtr<FActiveTimerHandle> StreamingTimerHandle;
+
+	static constexpr int32 AssetsPerPage = 256;
+
+	// Time the list may spend per frame taking in new pages
+	static constexpr double StreamingBudgetSeconds = 0.004;
+
+#pragma endregion
+
+#pragma region SearchBox
+
+	// Builds the name index of the gathered assets on a worker thread
+	void BuildNameIndex(const TArray<TSharedPtr<FAssetData>>& AssetsDataToIndex);
+
+	void OnNameIndexBuilt(TSharedRef<const FMicroManagerNameIndex> BuiltIndex, TMap<TSharedPtr<FAssetData>, int32>&& BuiltIndexIds);
+
+	void OnSearchTextChanged(const FText& NewSearchText);
+
+	// Drops the displayed assets not matching the search text
+	void ApplySearchFilter(TArray<TSharedPtr<FAssetData>>& AssetsDataToFilter) const;
+
+	bool PassesSearchFilter(const TSharedPtr<FAssetData>& AssetData) const;
+
+	TSharedPtr<const FMicroManagerNameIndex> NameIndex;
+
+	// Item id of every indexed asset
+	TMap<TSharedPtr<FAssetData>, int32> NameIndexIds;
+
+	// Lowercased current search, empty when not searching
+	FString SearchText;
+
+	// Item ids matching SearchText, and the same set as bits for the per row test
+	TArray<int32> SearchMatchIds;
+	TBitArray<> SearchMatches;
+
+#pragma endregion
+
+#pragma region FilterQuery
+
+	TSharedRef<SWidget> ConstructQueryBar();
+
+	void OnQueryTextCommitted(const FText& NewQueryText, ETextCommit::Type CommitType);
+
+	// Compiles the query and re-applies the listing, keeps the previous query if the text is invalid
+	bool SetActiveQuery(const FString& QueryText);
+
+	// Drops the assets not matching the active query
+	void ApplyQueryFilter(TArray<TSharedPtr<FAssetData>>& AssetsDataToFilter);
+
+	// Resolves the unused flag of the rows the query still needs, through the registry
+	void ResolveUnusedFlagsForRows(const TArray<int32>& Rows, FMicroManagerAssetColumns& Columns);
+
+	void OnQueryPresetSelected(TSharedPtr<FString> SelectedPreset, ESelectInfo::Type InSelectInfo);
+
+	FReply OnSaveQueryPresetButtonClicked();
+
+	// Presets are stored per project in the editor config
+	void LoadQueryPresets();
+	void SaveQueryPresets() const;
+
+	// Metadata of every listed asset, the query runs over these columns
+	FMicroManagerAssetColumns AssetColumns;
+
+	FMicroManagerAssetQuery ActiveQuery;
+
+	FString ActiveQueryText;
+
+	TArray<TSharedPtr<FString>> QueryPresets;
+
+	TSharedPtr<SEditableTextBox> QueryTextBox;
+
+	TSharedPtr<SComboBox<TSharedPtr<FString>>> QueryPresetComboBox;
+
+#pragma endregion
+
+#pragma region SortableColumns
+
+	TSharedRef<SHeaderRow> ConstructHeaderRow();
+
+	EColumnSortMode::Type GetSortModeForColumn(const FName ColumnId) const;
+
+	void OnColumnSortModeChanged(const EColumnSortPriority::Type SortPriority, const FName& ColumnId, const EColumnSortMode::Type NewSortMode);
+
+	// Sorts DisplayedAssetsData in place. Rows are keyed by item, so the list only reorders them.
+	void SortDisplayedAssetsData();
+
+	// Called by the size cache once a background batch finished
+	void OnAssetSizesUpdated();
+
+	FText GetSizeTextForAsset(TSharedPtr<FAssetData> AssetData, const FName ColumnId) const;
+
+	FName SortByColumn;
+
+	EColumnSortMode::Type SortMode = EColumnSortMode::None;
+
+#pragma endregion
+
 
 #pragma region ComboBoxForListingCondition
 
@@ -54,6 +188,20 @@ private:
 
 	TSharedRef<STextBlock> ConstructComboHelpTexts(const FString& TextContent, ETextJustify::Type TextJustify);
 
+	// Filters StoredAssetsData into DisplayedAssetsData according to the given condition
+	void ApplyListingCondition(const FString& ListingCondition);
+
+	// Filters, searches and sorts StoredAssetsData into DisplayedAssetsData, leaving the list view and the checks alone
+	void ListAssetsForCondition(const FString& ListingCondition);
+
+	// Applies the unused listing again once the text reference scan it waited for is done
+	void OnTextReferenceScanComplete();
+
+	FString ActiveListingCondition;
+
+	// How many assets the "top N by size" condition lists
+	int32 NumOfLargestAssetsToList = 50;
+
 #pragma endregion
 
 #pragma region RowWidgetForAssetListView
@@ -64,6 +212,9 @@ private:
 		const TSharedRef<STableViewBase>& OwnerTable
 	);
 
+	// Called by the row to build the cell of one header column
+	TSharedRef<SWidget> OnGenerateCellForColumn(TSharedPtr<FAssetData> AssetDataToDisplay, const FName& ColumnId);
+
 	void OnRowWidgetMouseButtonClicked(TSharedPtr<FAssetData> ClickedData);
 
 	// Builds a checkbox widget per row
@@ -72,6 +223,8 @@ private:
 	// Callback for checkbox state change
 	void OnCheckBoxStateChanged(ECheckBoxState NewState, TSharedPtr<FAssetData> AssetData);
 
+	ECheckBoxState GetCheckBoxState(TSharedPtr<FAssetData> AssetData) const;
+
 	// Helper function to construct a styled text block for asset class
 	TSharedRef<STextBlock> ConstructTextForRowWidget(const FString& TextContent, const FSlateFontInfo FontToUse) const;
 
@@ -80,6 +233,10 @@ private:
 
 	// Click Handler for the delete button
 	FReply OnDeleteButtonClicked(TSharedPtr<FAssetData> ClickedAssetData);
+
+	// Shows the shortest reference chain from the asset to a map, primary asset or config reference
+	TSharedRef<SButton> ConstructWhyUsedButtonForRowWidget(const TSharedPtr<FAssetData>& AssetDataToDisplay);
+	FReply OnWhyUsedButtonClicked(TSharedPtr<FAssetData> ClickedAssetData);
 #pragma endregion
 
 
@@ -89,11 +246,19 @@ private:
 	TSharedRef<SButton> ConstructDeleteAllButton();
 	TSharedRef<SButton> ConstructSelectAllButton();
 	TSharedRef<SButton> ConstructDeselectAllButton();
+	TSharedRef<SButton> ConstructProfileLoadsButton();
+	TSharedRef<SButton> ConstructExportButton();
 
 	FReply OnDeleteAllButtonClicked();
 	FReply OnSelectAllButtonClicked();
 	FReply OnDeselectAllButtonClicked();
 
+	// Profiles the checked assets, or every displayed one when none is checked
+	FReply OnProfileLoadsButtonClicked();
+
+	// Writes every displayed asset with its sizes to a CSV or JSON file picked by the user
+	FReply OnExportButtonClicked();
+
 	TSharedRef<STextBlock> ConstructTextForTabButtons(const FString& TextContent);
 
 #pragma endregion
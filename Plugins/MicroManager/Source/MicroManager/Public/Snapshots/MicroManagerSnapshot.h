@@ -0,0 +1,125 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetRegistry/AssetData.h"
+
+class FMicroManagerDependencyGraph;
+
+// One package of a snapshot
+struct FMicroManagerSnapshotRecord
+{
+	FString PackageName;
+	FString ClassName;
+	int64 DiskSize = 0;
+
+	// Disk size of the package and its whole hard dependency closure
+	int64 InclusiveSize = 0;
+
+	int32 ReferencerCount = 0;
+	bool bIsRoot = false;
+
+	// Name hashes of the hard dependencies that are records of the same snapshot, ascending. Hashes rather than
+	// record indices so the dependencies of one package compare across snapshots.
+	TArray<uint64> HardDependencyHashes;
+
+	bool IsUnused() const { return ReferencerCount == 0 && !bIsRoot; }
+};
+
+/**
+ * FMicroManagerSnapshotReader
+ * Streams the records of a snapshot file one at a time, in package name order.
+ * Only the header and the class name table are held in memory.
+ */
+class FMicroManagerSnapshotReader
+{
+public:
+	// Opens the file and reads its header, check IsValid before reading records
+	explicit FMicroManagerSnapshotReader(const FString& FilePath);
+
+	bool IsValid() const { return FileReader.IsValid() && Error.IsEmpty(); }
+	const FString& GetError() const { return Error; }
+
+	FDateTime GetTimestamp() const { return Timestamp; }
+	int32 Num() const { return NumRecords; }
+
+	// Reads the next record, returns false once every record was read or the file is corrupt
+	bool Next(FMicroManagerSnapshotRecord& OutRecord);
+
+private:
+	TUniquePtr<FArchive> FileReader;
+	FString Error;
+	FDateTime Timestamp;
+	int32 NumRecords = 0;
+	int32 NumRecordsRead = 0;
+	TArray<FString> ClassNames;
+};
+
+enum class EMicroManagerSnapshotChange : uint8
+{
+	Added,
+	Removed,
+	Grew,
+	BecameUnused,
+	GainedHeavyDependencies
+};
+
+struct FMicroManagerSnapshotDiffEntry
+{
+	FString PackageName;
+	FString ClassName;
+	EMicroManagerSnapshotChange Change = EMicroManagerSnapshotChange::Added;
+	int64 OldDiskSize = 0;
+	int64 NewDiskSize = 0;
+	int64 InclusiveSizeDelta = 0;
+
+	// Hard dependencies the new snapshot has and the old one did not, set for GainedHeavyDependencies
+	int32 NewDependencyCount = 0;
+};
+
+/**
+ * FMicroManagerSnapshot
+ * Versioned, compact snapshots of the project's packages written to Saved/MicroManager/Snapshots,
+ * and the diff between two of them.
+ *
+ * Records are sorted by package name and each name only stores what differs from the previous one,
+ * so a diff is a single merge pass over both files that never holds more than one record of each.
+ */
+class FMicroManagerSnapshot
+{
+public:
+	// Bump when the record layout changes, older files are refused instead of misread
+	static constexpr uint32 FileVersion = 2;
+
+	// Files grow past this much to be reported
+	static constexpr int64 GrowthThreshold = 64 * 1024;
+
+	// Hard closures grow past this much, with new direct dependencies, to be reported as heavy dependencies
+	static constexpr int64 HeavyDependencyThreshold = 1024 * 1024;
+
+	static FString GetSnapshotsDir();
+
+	/**
+	 * Writes a snapshot of the packages behind the given assets. Safe to run on a worker thread.
+	 *
+	 * @param DependencyGraph Graph snapshot the sizes and references come from.
+	 * @param AssetsData Assets to snapshot, usually everything under /Game.
+	 * @param FilePath Destination, written to a temporary file first so a failed write never leaves a truncated snapshot.
+	 * @param OutError Set on failure.
+	 * @return True on success.
+	 */
+	static bool Write(const FMicroManagerDependencyGraph& DependencyGraph, const TArray<TSharedPtr<FAssetData>>& AssetsData,
+		const FString& FilePath, FString& OutError);
+
+	// Merges two snapshots into the list of what changed from the old to the new one
+	static bool Diff(const FString& OldFilePath, const FString& NewFilePath, TArray<FMicroManagerSnapshotDiffEntry>& OutEntries, FString& OutError);
+
+	static const TCHAR* LexToString(EMicroManagerSnapshotChange Change);
+
+	// Snapshots everything under /Game in the background
+	static void TakeProjectSnapshot();
+
+	// Asks for two snapshot files and opens the diff report, oldest first
+	static void PickAndShowDiff();
+};
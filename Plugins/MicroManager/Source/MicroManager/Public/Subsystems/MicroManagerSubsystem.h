@@ -0,0 +1,161 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "EditorSubsystem.h"
+#include "AssetRegistry/AssetData.h"
+#include "AssetAnalysis/MicroManagerDependencyGraph.h"
+#include "MicroManagerSubsystem.generated.h"
+
+class FMicroManagerSizeCache;
+class IAssetRegistry;
+struct FFileChangeData;
+
+// Assets found under a set of folders. Shared by every client that scanned the same folders, freed once none holds it.
+typedef TArray<TSharedPtr<FAssetData>> FMicroManagerAssetScan;
+
+DECLARE_DELEGATE_OneParam(FOnMicroManagerAssetScanComplete, TSharedRef<const FMicroManagerAssetScan>);
+
+/**
+ * UMicroManagerSubsystem
+ * Owns the registry work shared by every MicroManager client: the Content Browser menu, the asset actions and the tabs.
+ * Folder scans, the dependency graph and asset sizes are computed once, cached until the Asset Registry changes,
+ * and requests for work already running are queued on the running job instead of starting another.
+ */
+UCLASS()
+class MICROMANAGER_API UMicroManagerSubsystem : public UEditorSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	// Returns nullptr outside of the editor
+	static UMicroManagerSubsystem* Get();
+
+#pragma region AssetScans
+
+	// Scans the folders on worker threads, OnScanComplete runs on the game thread. Reuses a live scan of the same folders.
+	void RequestAssetScan(const TArray<FString>& FolderPaths, FOnMicroManagerAssetScanComplete OnScanComplete);
+
+	// Blocking flavor of RequestAssetScan for the menu and asset actions
+	TSharedRef<const FMicroManagerAssetScan> ScanFolders(const TArray<FString>& FolderPaths);
+
+	// Gathers the asset data under every folder on task graph workers, merged and de-duplicated. Safe to run on a worker thread.
+	static void GatherAssetDataUnderFolders(const IAssetRegistry& AssetRegistry, const TArray<FString>& FolderPaths,
+		TArray<TSharedPtr<FAssetData>>& OutAssetsData);
+
+	// Folders MicroManager must never list nor delete from
+	static bool IsPathExcludedFromMicroManager(const FString& Path);
+
+#pragma endregion
+
+#pragma region SharedAssetOperations
+
+	// Lists the assets nothing references, the registry lookups are spread across workers.
+	// With the text reference scan enabled, assets mentioned by path in the project's text files count as referenced.
+	void ListUnusedAssets(const TArray<TSharedPtr<FAssetData>>& AssetsDataToFilter, TArray<TSharedPtr<FAssetData>>& OutUnusedAssetsData);
+
+	// Whether Config, Source and Plugins text files are searched for asset paths before an asset is called unused. Saved per project.
+	bool IsTextReferenceScanEnabled() const { return bTextReferenceScanEnabled; }
+	void SetTextReferenceScanEnabled(bool bEnabled);
+
+	// Runs the text reference scan on a worker thread if it is outdated, OnScanComplete runs on the game thread
+	void RequestTextReferenceScan(FSimpleDelegate OnScanComplete);
+
+	// False while ListUnusedAssets would have to scan the text files itself first
+	bool IsTextReferenceScanReady() const { return !bTextReferenceScanEnabled || !bTextReferencedPackagesOutdated; }
+
+	// Fixes up the referencers of every redirector under the given paths
+	void FixUpRedirectors(const TArray<FString>& PackagePaths = { TEXT("/Game") });
+
+#pragma endregion
+
+#pragma region SizesAndDependencies
+
+	// Shared cache of asset sizes, filled in the background
+	TSharedRef<FMicroManagerSizeCache> GetSizeCache();
+
+	// Computes the sizes of the given assets on worker threads, OnSizesUpdated runs on the game thread
+	void RequestAssetSizes(const TArray<TSharedPtr<FAssetData>>& AssetsData, FSimpleDelegate OnSizesUpdated);
+
+	// Hands back the cached dependency graph snapshot, building it on a worker thread first if needed
+	void RequestDependencyGraph(FOnMicroManagerDependencyGraphReady OnGraphReady);
+
+#pragma endregion
+
+private:
+	static FString MakeScanKey(const TArray<FString>& FolderPaths);
+
+	void OnAssetScanComplete(const FString& ScanKey, uint32 ScanGeneration, TSharedRef<const FMicroManagerAssetScan> CompletedScan);
+
+	void OnDependencyGraphBuilt(TSharedRef<const FMicroManagerDependencyGraph> BuiltGraph);
+
+	// Blocking flavor of RequestTextReferenceScan for the menu and asset actions
+	const TSet<FName>& GetTextReferencedPackages();
+
+	// Every project package mentioned in the text files. Safe to run on a worker thread.
+	static void ScanTextReferencedPackages(const IAssetRegistry& AssetRegistry, TSet<FName>& OutReferencedPackages);
+
+	void OnTextReferenceScanComplete(uint32 ScanGeneration, TSet<FName>&& ReferencedPackages);
+
+	// Text files were edited, or packages the last scan did not look for were added
+	void MarkTextReferencesOutdated();
+
+	void WatchTextDirectories();
+	void UnwatchTextDirectories();
+	void OnTextDirectoryChanged(const TArray<FFileChangeData>& FileChanges);
+
+	// Any registry change makes the cached scans and graph stale, the next request redoes them
+	void OnAssetRegistryChanged(const FAssetData& ChangedAssetData);
+	void OnAssetRegistryAdded(const FAssetData& AddedAssetData);
+	void OnAssetRegistryRenamed(const FAssetData& RenamedAssetData, const FString& OldObjectPath);
+	void OnAssetRegistryFilesLoaded();
+
+	// Cheap enough for every registry event, the caches themselves are only dropped by the next request
+	void MarkRegistryChanged();
+
+	// Drops the cached scans, graph and sizes if the registry changed since they were built
+	void FlushRegistryChanges();
+
+	// Weak so a scan lives exactly as long as a client holds it
+	TMap<FString, TWeakPtr<const FMicroManagerAssetScan>> CachedScans;
+
+	// Scans running on a worker, keyed like CachedScans, with every client waiting for them
+	TMap<FString, TArray<FOnMicroManagerAssetScanComplete>> PendingScanRequests;
+
+	// Bumped on every registry change, scans started before it are handed out but not cached
+	uint32 RegistryGeneration = 0;
+
+	// Set by MarkRegistryChanged until FlushRegistryChanges drops the caches
+	bool bRegistryChangePending = false;
+
+	TSharedPtr<FMicroManagerSizeCache> SizeCache;
+
+	TSharedPtr<const FMicroManagerDependencyGraph> DependencyGraph;
+
+	TArray<FOnMicroManagerDependencyGraphReady> PendingDependencyGraphRequests;
+
+	bool bIsBuildingDependencyGraph = false;
+
+	// Set when the registry changed while a build was running, its result is handed out but not cached
+	bool bDependencyGraphOutdated = false;
+
+	bool bTextReferenceScanEnabled = false;
+
+	TSet<FName> TextReferencedPackages;
+
+	bool bTextReferencedPackagesOutdated = true;
+
+	bool bIsScanningTextReferences = false;
+
+	// Bumped whenever the scan goes outdated, a scan started before it is handed out but not cached
+	uint32 TextReferenceGeneration = 0;
+
+	TArray<FSimpleDelegate> PendingTextReferenceScanRequests;
+
+	// Config, Source and Plugins watchers, edits to the text files found there outdate the scan
+	TArray<TPair<FString, FDelegateHandle>> TextDirectoryWatchHandles;
+};
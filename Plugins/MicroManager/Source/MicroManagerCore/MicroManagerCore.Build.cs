@@ -0,0 +1,18 @@
+using UnrealBuildTool;
+
+// Engine independent MicroManager algorithms working on plain data: package ids, edge lists and path strings.
+// Depends on Core only so it can be tested and benchmarked without loading any content.
+public class MicroManagerCore : ModuleRules
+{
+	public MicroManagerCore(ReadOnlyTargetRules Target) : base(Target)
+	{
+		PCHUsage = PCHUsageMode.UseExplicitOrSharedPCHs;
+
+		PublicDependencyModuleNames.AddRange(
+			new string[]
+			{
+				"Core"
+			}
+		);
+	}
+}
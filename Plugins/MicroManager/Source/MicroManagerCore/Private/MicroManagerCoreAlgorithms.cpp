@@ -0,0 +1,180 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "MicroManagerCoreAlgorithms.h"
+#include "Algo/BinarySearch.h"
+#include "String/Find.h"
+
+namespace
+{
+	struct FPlacementCell
+	{
+		int32 GroupKey = 0;
+		int64 X = 0;
+		int64 Y = 0;
+		int64 Z = 0;
+
+		bool operator==(const FPlacementCell& Other) const
+		{
+			return GroupKey == Other.GroupKey && X == Other.X && Y == Other.Y && Z == Other.Z;
+		}
+
+		friend uint32 GetTypeHash(const FPlacementCell& Cell)
+		{
+			uint32 Hash = ::GetTypeHash(Cell.GroupKey);
+			Hash = HashCombineFast(Hash, ::GetTypeHash(Cell.X));
+			Hash = HashCombineFast(Hash, ::GetTypeHash(Cell.Y));
+			return HashCombineFast(Hash, ::GetTypeHash(Cell.Z));
+		}
+	};
+}
+
+bool MicroManagerCore::IsPathExcluded(FStringView Path)
+{
+	static const TCHAR* ExcludedTokens[] = {
+		TEXT("Developers"), TEXT("Collections"), TEXT("_ExternalActors_"), TEXT("_ExternalObjects_"), TEXT("Maps")
+	};
+
+	for (const TCHAR* ExcludedToken : ExcludedTokens)
+	{
+		if (UE::String::FindFirst(Path, ExcludedToken) != INDEX_NONE) return true;
+	}
+	return false;
+}
+
+void MicroManagerCore::FindUnreferencedPackages(int32 NumPackages, TConstArrayView<FMicroManagerPackageEdge> Edges, TBitArray<>& OutIsUnreferenced)
+{
+	OutIsUnreferenced.Init(true, FMath::Max(NumPackages, 0));
+
+	for (const FMicroManagerPackageEdge& Edge : Edges)
+	{
+		if (Edge.Referencer == Edge.Dependency) continue;
+		if (Edge.Dependency < 0 || Edge.Dependency >= NumPackages) continue;
+
+		OutIsUnreferenced[Edge.Dependency] = false;
+	}
+}
+
+void MicroManagerCore::GroupSameNames(TConstArrayView<FString> Names, TArray<int32>& OutDuplicateIndices)
+{
+	OutDuplicateIndices.Reset();
+
+	// FString keys hash and compare without case
+	TMap<FString, int32> GroupIndices;
+	GroupIndices.Reserve(Names.Num());
+	TArray<TArray<int32, TInlineAllocator<2>>> Groups;
+
+	for (int32 Index = 0; Index < Names.Num(); ++Index)
+	{
+		int32& GroupIndex = GroupIndices.FindOrAdd(Names[Index], INDEX_NONE);
+		if (GroupIndex == INDEX_NONE)
+		{
+			GroupIndex = Groups.AddDefaulted();
+		}
+		Groups[GroupIndex].Add(Index);
+	}
+
+	for (const TArray<int32, TInlineAllocator<2>>& Group : Groups)
+	{
+		if (Group.Num() > 1)
+		{
+			OutDuplicateIndices.Append(Group);
+		}
+	}
+}
+
+void MicroManagerCore::FindEmptyFolders(TConstArrayView<FString> FolderPaths, TConstArrayView<FString> AssetFolderPaths, TArray<int32>& OutEmptyFolderIndices)
+{
+	OutEmptyFolderIndices.Reset();
+
+	// Sorted, every folder holding assets below a candidate sits right at or after the candidate itself
+	TArray<FString> SortedAssetFolderPaths(AssetFolderPaths.GetData(), AssetFolderPaths.Num());
+	SortedAssetFolderPaths.Sort([](const FString& A, const FString& B) { return A.Compare(B, ESearchCase::IgnoreCase) < 0; });
+
+	for (int32 FolderIndex = 0; FolderIndex < FolderPaths.Num(); ++FolderIndex)
+	{
+		const FString& FolderPath = FolderPaths[FolderIndex];
+
+		const int32 First = Algo::LowerBound(SortedAssetFolderPaths, FolderPath,
+			[](const FString& A, const FString& B) { return A.Compare(B, ESearchCase::IgnoreCase) < 0; });
+
+		// "/Game/A" holds "/Game/A" and "/Game/A/B" but not "/Game/AB", which can sort in between
+		bool bHasAssets = false;
+		for (int32 Index = First; Index < SortedAssetFolderPaths.Num(); ++Index)
+		{
+			const FString& AssetFolderPath = SortedAssetFolderPaths[Index];
+			if (!AssetFolderPath.StartsWith(FolderPath, ESearchCase::IgnoreCase)) break;
+
+			if (AssetFolderPath.Len() == FolderPath.Len() || AssetFolderPath[FolderPath.Len()] == TEXT('/'))
+			{
+				bHasAssets = true;
+				break;
+			}
+		}
+
+		if (!bHasAssets)
+		{
+			OutEmptyFolderIndices.Add(FolderIndex);
+		}
+	}
+}
+
+void MicroManagerCore::FindOverlappingDuplicates(TConstArrayView<FMicroManagerPlacement> Placements, const FMicroManagerTransformTolerance& Tolerance, TArray<int32>& OutDuplicateIndices)
+{
+	OutDuplicateIndices.Reset();
+
+	// Below a millimeter the cell coordinates of a large world would overflow
+	const double CellSize = FMath::Max(Tolerance.Location, 0.1);
+	const double LocationToleranceSquared = FMath::Square(FMath::Max(Tolerance.Location, 0.0));
+	// Two unit quaternions an angle apart have |dot| = cos(angle / 2), whichever of q and -q each one is
+	const double MinRotationDot = FMath::Cos(FMath::DegreesToRadians(FMath::Clamp(Tolerance.RotationDegrees, 0.0, 180.0)) * 0.5);
+
+	// Kept placements chained per cell, FirstInCell points at the last one added and Next walks back from it
+	TMap<FPlacementCell, int32> FirstInCell;
+	FirstInCell.Reserve(Placements.Num());
+	TArray<int32> Next;
+	Next.Init(INDEX_NONE, Placements.Num());
+
+	for (int32 Index = 0; Index < Placements.Num(); ++Index)
+	{
+		const FMicroManagerPlacement& Placement = Placements[Index];
+		const FVector Location = Placement.Transform.GetLocation();
+		const FPlacementCell Cell = {
+			Placement.GroupKey,
+			FMath::FloorToInt64(Location.X / CellSize),
+			FMath::FloorToInt64(Location.Y / CellSize),
+			FMath::FloorToInt64(Location.Z / CellSize)
+		};
+
+		bool bIsDuplicate = false;
+		for (int32 NeighborIndex = 0; NeighborIndex < 27 && !bIsDuplicate; ++NeighborIndex)
+		{
+			const FPlacementCell NeighborCell = {
+				Cell.GroupKey,
+				Cell.X + NeighborIndex % 3 - 1,
+				Cell.Y + NeighborIndex / 3 % 3 - 1,
+				Cell.Z + NeighborIndex / 9 - 1
+			};
+
+			const int32* First = FirstInCell.Find(NeighborCell);
+			for (int32 Kept = First ? *First : INDEX_NONE; Kept != INDEX_NONE && !bIsDuplicate; Kept = Next[Kept])
+			{
+				const FTransform& KeptTransform = Placements[Kept].Transform;
+				bIsDuplicate = FVector::DistSquared(Location, KeptTransform.GetLocation()) <= LocationToleranceSquared
+					&& FMath::Abs(Placement.Transform.GetRotation() | KeptTransform.GetRotation()) >= MinRotationDot
+					&& (Placement.Transform.GetScale3D() - KeptTransform.GetScale3D()).GetAbsMax() <= Tolerance.Scale;
+			}
+		}
+
+		if (bIsDuplicate)
+		{
+			OutDuplicateIndices.Add(Index);
+		}
+		else
+		{
+			int32& First = FirstInCell.FindOrAdd(Cell, INDEX_NONE);
+			Next[Index] = First;
+			First = Index;
+		}
+	}
+}
@@ -0,0 +1,44 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "MicroManagerSizeWaiters.h"
+
+void FMicroManagerSizeWaiters::Add(TArray<FName>&& RequestedPackages, TSet<FName>&& MissingPackages, FSimpleDelegate OnComplete)
+{
+	Waiters.Add({ MoveTemp(RequestedPackages), MoveTemp(MissingPackages), MoveTemp(OnComplete) });
+}
+
+TArray<FSimpleDelegate> FMicroManagerSizeWaiters::OnBatchLanded(uint32 BatchGeneration, TConstArrayView<FName> PackageNames)
+{
+	TArray<FSimpleDelegate> CompletedCallbacks;
+
+	// Its waiters were handed back by Invalidate, the sizes it computed are stale anyway
+	if (BatchGeneration != Generation) return CompletedCallbacks;
+
+	for (int32 WaiterIndex = 0; WaiterIndex < Waiters.Num();)
+	{
+		FWaiter& Waiter = Waiters[WaiterIndex];
+		for (const FName PackageName : PackageNames)
+		{
+			Waiter.MissingPackages.Remove(PackageName);
+		}
+
+		if (Waiter.MissingPackages.Num() == 0)
+		{
+			CompletedCallbacks.Add(MoveTemp(Waiter.OnComplete));
+			Waiters.RemoveAt(WaiterIndex);
+		}
+		else
+		{
+			++WaiterIndex;
+		}
+	}
+
+	return CompletedCallbacks;
+}
+
+TArray<FMicroManagerSizeWaiters::FWaiter> FMicroManagerSizeWaiters::Invalidate()
+{
+	++Generation;
+	return MoveTemp(Waiters);
+}
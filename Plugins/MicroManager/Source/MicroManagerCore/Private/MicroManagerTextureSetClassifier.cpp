@@ -0,0 +1,228 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "MicroManagerTextureSetClassifier.h"
+
+namespace
+{
+	bool IsAlphanumeric(TCHAR Char)
+	{
+		return FChar::IsAlnum(Char);
+	}
+
+	// A token starts after a separator, at the start of the name, or at a lower to upper case change
+	bool IsTokenStart(FStringView Name, int32 Position)
+	{
+		if (Position == 0 || !IsAlphanumeric(Name[Position]) || !IsAlphanumeric(Name[Position - 1])) return true;
+		return FChar::IsLower(Name[Position - 1]) && FChar::IsUpper(Name[Position]);
+	}
+
+	// Digits after a suffix are variants ("_Normal2"), letters would make it another word
+	bool IsTokenEnd(FStringView Name, int32 End)
+	{
+		if (End == Name.Len() || !FChar::IsAlpha(Name[End])) return true;
+		return FChar::IsLower(Name[End - 1]) && FChar::IsUpper(Name[End]);
+	}
+
+	bool HasLetter(FStringView Name, int32 Start, int32 End)
+	{
+		for (int32 Position = Start; Position < End; ++Position)
+		{
+			if (FChar::IsAlpha(Name[Position])) return true;
+		}
+		return false;
+	}
+
+	// True when only digits and separators follow, e.g. "_01" or "_2"
+	bool IsVariantTail(FStringView Name, int32 End)
+	{
+		return !HasLetter(Name, End, Name.Len());
+	}
+
+	struct FSuffixMatch
+	{
+		int32 Start;
+		int32 End;
+		EMicroManagerTextureChannel Channel;
+	};
+}
+
+void FMicroManagerTextureSetClassifier::AddSuffixes(EMicroManagerTextureChannel Channel, const TArray<FString>& InSuffixes)
+{
+	for (const FString& Suffix : InSuffixes)
+	{
+		if (!Suffix.IsEmpty())
+		{
+			Suffixes.Add({ Suffix, Channel });
+		}
+	}
+}
+
+void FMicroManagerTextureSetClassifier::Reset()
+{
+	Suffixes.Reset();
+	TrieChildOffsets.Reset();
+	TrieLabels.Reset();
+	TrieTargets.Reset();
+	TrieSuffixes.Reset();
+}
+
+void FMicroManagerTextureSetClassifier::Compile()
+{
+	// Suffix lists are short, build with per node child lists then flatten them for lookups
+	TArray<TArray<TPair<TCHAR, int32>>> NodeChildren;
+	NodeChildren.AddDefaulted();
+	TrieSuffixes = { INDEX_NONE };
+
+	for (int32 SuffixIndex = 0; SuffixIndex < Suffixes.Num(); ++SuffixIndex)
+	{
+		int32 Node = 0;
+		for (const TCHAR Char : Suffixes[SuffixIndex].Text)
+		{
+			const TCHAR Label = FChar::ToLower(Char);
+			const TPair<TCHAR, int32>* Child = NodeChildren[Node].FindByPredicate([Label](const TPair<TCHAR, int32>& Edge)
+			{
+				return Edge.Key == Label;
+			});
+
+			if (Child)
+			{
+				Node = Child->Value;
+			}
+			else
+			{
+				const int32 NewNode = NodeChildren.AddDefaulted();
+				TrieSuffixes.Add(INDEX_NONE);
+				NodeChildren[Node].Add({ Label, NewNode });
+				Node = NewNode;
+			}
+		}
+
+		// The same suffix listed for two channels keeps the first one
+		if (TrieSuffixes[Node] == INDEX_NONE)
+		{
+			TrieSuffixes[Node] = SuffixIndex;
+		}
+	}
+
+	TrieChildOffsets.Reset(NodeChildren.Num() + 1);
+	TrieLabels.Reset();
+	TrieTargets.Reset();
+	for (TArray<TPair<TCHAR, int32>>& Children : NodeChildren)
+	{
+		Children.Sort([](const TPair<TCHAR, int32>& A, const TPair<TCHAR, int32>& B) { return A.Key < B.Key; });
+
+		TrieChildOffsets.Add(TrieLabels.Num());
+		for (const TPair<TCHAR, int32>& Child : Children)
+		{
+			TrieLabels.Add(Child.Key);
+			TrieTargets.Add(Child.Value);
+		}
+	}
+	TrieChildOffsets.Add(TrieLabels.Num());
+}
+
+FMicroManagerTextureClassification FMicroManagerTextureSetClassifier::Classify(FStringView TextureName) const
+{
+	FMicroManagerTextureClassification Classification;
+	if (!IsCompiled()) return Classification;
+
+	int32 BestSuffix = INDEX_NONE;
+	int32 BestStart = INDEX_NONE;
+	int32 BestLength = 0;
+	TArray<FSuffixMatch, TInlineAllocator<8>> Matches;
+
+	for (int32 Start = 0; Start < TextureName.Len(); ++Start)
+	{
+		if (!IsTokenStart(TextureName, Start)) continue;
+
+		int32 Node = 0;
+		for (int32 Position = Start; Position < TextureName.Len(); ++Position)
+		{
+			Node = FindChild(Node, FChar::ToLower(TextureName[Position]));
+			if (Node == INDEX_NONE) break;
+
+			const int32 SuffixIndex = TrieSuffixes[Node];
+			if (SuffixIndex == INDEX_NONE || !IsTokenEnd(TextureName, Position + 1)) continue;
+
+			const int32 Length = Position + 1 - Start;
+			const int32 End = Position + 1;
+			Matches.Add({ Start, End, Suffixes[SuffixIndex].Channel });
+
+			// The match ending last wins since texture set suffixes come last, then the longest one
+			const int32 BestEnd = BestStart + BestLength;
+			if (BestSuffix == INDEX_NONE || End > BestEnd || (End == BestEnd && Length > BestLength))
+			{
+				BestSuffix = SuffixIndex;
+				BestStart = Start;
+				BestLength = Length;
+			}
+		}
+	}
+
+	if (BestSuffix == INDEX_NONE) return Classification;
+
+	const int32 BestEnd = BestStart + BestLength;
+	Classification.Channel = Suffixes[BestSuffix].Channel;
+	Classification.MatchedSuffix = Suffixes[BestSuffix].Text;
+	Classification.Confidence = BestEnd == TextureName.Len() ? 1.f : (IsVariantTail(TextureName, BestEnd) ? 0.9f : 0.7f);
+
+	// Another channel only makes the match doubtful when its token comes right before the winning one, possibly
+	// through other suffix tokens ("T_Rock_Metal_diff"). Earlier tokens belong to the asset name ("T_Metal_Plate_diff").
+	int32 ChainStart = BestStart;
+	for (bool bExtended = true; bExtended;)
+	{
+		bExtended = false;
+		for (const FSuffixMatch& Match : Matches)
+		{
+			if (Match.Start >= ChainStart || Match.End > ChainStart || HasLetter(TextureName, Match.End, ChainStart)) continue;
+
+			if (Match.Channel != Classification.Channel)
+			{
+				Classification.Confidence *= 0.5f;
+				return Classification;
+			}
+			ChainStart = Match.Start;
+			bExtended = true;
+		}
+	}
+
+	return Classification;
+}
+
+FMicroManagerTextureSetClassifier FMicroManagerTextureSetClassifier::MakeDefault()
+{
+	FMicroManagerTextureSetClassifier Classifier;
+	Classifier.AddSuffixes(EMicroManagerTextureChannel::BaseColor, { TEXT("_BaseColor"), TEXT("_Albedo"), TEXT("_Diffuse"), TEXT("_diff") });
+	Classifier.AddSuffixes(EMicroManagerTextureChannel::Metallic, { TEXT("_Metallic"), TEXT("_metal") });
+	Classifier.AddSuffixes(EMicroManagerTextureChannel::Roughness, { TEXT("_Roughness"), TEXT("_RoughnessMap"), TEXT("_rough") });
+	Classifier.AddSuffixes(EMicroManagerTextureChannel::Normal, { TEXT("_Normal"), TEXT("_NormalMap"), TEXT("_nor") });
+	Classifier.AddSuffixes(EMicroManagerTextureChannel::AmbientOcclusion, { TEXT("_AmbientOcclusion"), TEXT("_AmbientOcclusionMap"), TEXT("_AO") });
+	Classifier.AddSuffixes(EMicroManagerTextureChannel::ORM, { TEXT("_arm"), TEXT("_OcclusionRoughnessMetallic"), TEXT("_ORM") });
+	Classifier.Compile();
+	return Classifier;
+}
+
+const TCHAR* FMicroManagerTextureSetClassifier::LexToString(EMicroManagerTextureChannel Channel)
+{
+	switch (Channel)
+	{
+	case EMicroManagerTextureChannel::BaseColor: return TEXT("BaseColor");
+	case EMicroManagerTextureChannel::Metallic: return TEXT("Metallic");
+	case EMicroManagerTextureChannel::Roughness: return TEXT("Roughness");
+	case EMicroManagerTextureChannel::Normal: return TEXT("Normal");
+	case EMicroManagerTextureChannel::AmbientOcclusion: return TEXT("AO");
+	case EMicroManagerTextureChannel::ORM: return TEXT("ORM");
+	default: return TEXT("None");
+	}
+}
+
+int32 FMicroManagerTextureSetClassifier::FindChild(int32 Node, TCHAR Label) const
+{
+	for (int32 EdgeIndex = TrieChildOffsets[Node]; EdgeIndex < TrieChildOffsets[Node + 1]; ++EdgeIndex)
+	{
+		if (TrieLabels[EdgeIndex] == Label) return TrieTargets[EdgeIndex];
+		if (TrieLabels[EdgeIndex] > Label) break;
+	}
+	return INDEX_NONE;
+}
@@ -0,0 +1,239 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+/**
+ * Microbenchmarks for the MicroManagerCore decisions on a synthetic project of NumPackages packages.
+ * The data comes from a fixed seed so runs compare, the timings are reported as test info:
+ * UnrealEditor-Cmd <Project>.uproject -ExecCmds="Automation RunTests MicroManager.Core.Benchmark; Quit" -unattended -nullrhi
+ */
+
+#include "MicroManagerCoreAlgorithms.h"
+#include "MicroManagerTextureSetClassifier.h"
+#include "Math/RandomStream.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace MicroManagerCoreBenchmarks
+{
+	constexpr int32 NumPackages = 200000;
+	constexpr int32 NumFolders = 5000;
+	constexpr int32 RandomSeed = 0x4D4D;
+
+	// Folders nest up to three levels under /Game, every package sits in one of them
+	TArray<FString> MakeFolderPaths(FRandomStream& Random)
+	{
+		TArray<FString> FolderPaths;
+		FolderPaths.Reserve(NumFolders);
+		for (int32 FolderIndex = 0; FolderIndex < NumFolders; ++FolderIndex)
+		{
+			const int32 Depth = Random.RandRange(1, 3);
+			FString FolderPath = TEXT("/Game");
+			for (int32 Level = 0; Level < Depth; ++Level)
+			{
+				FolderPath += FString::Printf(TEXT("/Folder%d"), Random.RandRange(0, 40));
+			}
+			FolderPaths.Add(MoveTemp(FolderPath));
+		}
+		return FolderPaths;
+	}
+
+	void ReportTiming(FAutomationTestBase& Test, const TCHAR* What, double StartSeconds, int32 NumItems)
+	{
+		const double Milliseconds = (FPlatformTime::Seconds() - StartSeconds) * 1000.0;
+		Test.AddInfo(FString::Printf(TEXT("%s: %.2f ms for %d items (%.1f ns/item)"),
+			What, Milliseconds, NumItems, NumItems > 0 ? Milliseconds * 1000000.0 / NumItems : 0.0));
+	}
+}
+
+#pragma region PathExclusion
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMicroManagerCorePathExclusionBenchmark, "MicroManager.Core.Benchmark.PathExclusion",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FMicroManagerCorePathExclusionBenchmark::RunTest(const FString& Parameters)
+{
+	using namespace MicroManagerCoreBenchmarks;
+
+	FRandomStream Random(RandomSeed);
+	const TArray<FString> FolderPaths = MakeFolderPaths(Random);
+
+	int32 NumExcluded = 0;
+	const double StartSeconds = FPlatformTime::Seconds();
+	for (int32 PackageIndex = 0; PackageIndex < NumPackages; ++PackageIndex)
+	{
+		NumExcluded += MicroManagerCore::IsPathExcluded(FolderPaths[PackageIndex % FolderPaths.Num()]) ? 1 : 0;
+	}
+	ReportTiming(*this, TEXT("IsPathExcluded"), StartSeconds, NumPackages);
+
+	TestEqual(TEXT("Synthetic folders are never excluded"), NumExcluded, 0);
+	return true;
+}
+
+#pragma endregion
+
+#pragma region UnreferencedPackages
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMicroManagerCoreUnreferencedPackagesBenchmark, "MicroManager.Core.Benchmark.UnreferencedPackages",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FMicroManagerCoreUnreferencedPackagesBenchmark::RunTest(const FString& Parameters)
+{
+	using namespace MicroManagerCoreBenchmarks;
+
+	// About four references per package, to random packages
+	FRandomStream Random(RandomSeed);
+	TArray<FMicroManagerPackageEdge> Edges;
+	Edges.Reserve(NumPackages * 4);
+	for (int32 EdgeIndex = 0; EdgeIndex < NumPackages * 4; ++EdgeIndex)
+	{
+		Edges.Add({ Random.RandRange(0, NumPackages - 1), Random.RandRange(0, NumPackages - 1) });
+	}
+
+	TBitArray<> IsUnreferenced;
+	const double StartSeconds = FPlatformTime::Seconds();
+	MicroManagerCore::FindUnreferencedPackages(NumPackages, Edges, IsUnreferenced);
+	ReportTiming(*this, TEXT("FindUnreferencedPackages"), StartSeconds, Edges.Num());
+
+	TestEqual(TEXT("One flag per package"), IsUnreferenced.Num(), NumPackages);
+	return true;
+}
+
+#pragma endregion
+
+#pragma region SameNames
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMicroManagerCoreSameNamesBenchmark, "MicroManager.Core.Benchmark.SameNames",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FMicroManagerCoreSameNamesBenchmark::RunTest(const FString& Parameters)
+{
+	using namespace MicroManagerCoreBenchmarks;
+
+	// Names drawn from a pool smaller than the package count, so a good share of them collide
+	FRandomStream Random(RandomSeed);
+	TArray<FString> Names;
+	Names.Reserve(NumPackages);
+	for (int32 PackageIndex = 0; PackageIndex < NumPackages; ++PackageIndex)
+	{
+		Names.Add(FString::Printf(TEXT("SM_Asset_%d"), Random.RandRange(0, NumPackages * 2)));
+	}
+
+	TArray<int32> DuplicateIndices;
+	const double StartSeconds = FPlatformTime::Seconds();
+	MicroManagerCore::GroupSameNames(Names, DuplicateIndices);
+	ReportTiming(*this, TEXT("GroupSameNames"), StartSeconds, Names.Num());
+
+	AddInfo(FString::Printf(TEXT("%d of %d names are shared"), DuplicateIndices.Num(), Names.Num()));
+	return true;
+}
+
+#pragma endregion
+
+#pragma region EmptyFolders
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMicroManagerCoreEmptyFoldersBenchmark, "MicroManager.Core.Benchmark.EmptyFolders",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FMicroManagerCoreEmptyFoldersBenchmark::RunTest(const FString& Parameters)
+{
+	using namespace MicroManagerCoreBenchmarks;
+
+	FRandomStream Random(RandomSeed);
+	const TArray<FString> FolderPaths = MakeFolderPaths(Random);
+
+	// Packages only land in the first half of the folders
+	TArray<FString> AssetFolderPaths;
+	AssetFolderPaths.Reserve(NumPackages);
+	for (int32 PackageIndex = 0; PackageIndex < NumPackages; ++PackageIndex)
+	{
+		AssetFolderPaths.Add(FolderPaths[Random.RandRange(0, FolderPaths.Num() / 2)]);
+	}
+
+	TArray<int32> EmptyFolderIndices;
+	const double StartSeconds = FPlatformTime::Seconds();
+	MicroManagerCore::FindEmptyFolders(FolderPaths, AssetFolderPaths, EmptyFolderIndices);
+	ReportTiming(*this, TEXT("FindEmptyFolders"), StartSeconds, AssetFolderPaths.Num());
+
+	AddInfo(FString::Printf(TEXT("%d of %d folders are empty"), EmptyFolderIndices.Num(), FolderPaths.Num()));
+	return true;
+}
+
+#pragma endregion
+
+#pragma region OverlappingDuplicates
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMicroManagerCoreOverlappingDuplicatesBenchmark, "MicroManager.Core.Benchmark.OverlappingDuplicates",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FMicroManagerCoreOverlappingDuplicatesBenchmark::RunTest(const FString& Parameters)
+{
+	using namespace MicroManagerCoreBenchmarks;
+
+	// A 100k actor level of 200 meshes spread over 2 km, one actor in ten pasted a second time in place
+	constexpr int32 NumActors = 100000;
+	FRandomStream Random(RandomSeed);
+	TArray<FMicroManagerPlacement> Placements;
+	Placements.Reserve(NumActors);
+	while (Placements.Num() < NumActors)
+	{
+		FMicroManagerPlacement Placement;
+		Placement.GroupKey = Random.RandRange(0, 199);
+		Placement.Transform = FTransform(FRotator(0.0, Random.FRandRange(0.0, 360.0), 0.0),
+			FVector(Random.FRandRange(-100000.0, 100000.0), Random.FRandRange(-100000.0, 100000.0), Random.FRandRange(0.0, 5000.0)));
+		Placements.Add(Placement);
+
+		if (Random.RandRange(0, 9) == 0 && Placements.Num() < NumActors)
+		{
+			Placements.Add(Placement);
+		}
+	}
+
+	TArray<int32> DuplicateIndices;
+	const double StartSeconds = FPlatformTime::Seconds();
+	MicroManagerCore::FindOverlappingDuplicates(Placements, FMicroManagerTransformTolerance(), DuplicateIndices);
+	ReportTiming(*this, TEXT("FindOverlappingDuplicates"), StartSeconds, Placements.Num());
+
+	AddInfo(FString::Printf(TEXT("%d of %d placements are stacked duplicates"), DuplicateIndices.Num(), Placements.Num()));
+	return true;
+}
+
+#pragma endregion
+
+#pragma region TextureSetClassifier
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMicroManagerCoreTextureSetClassifierBenchmark, "MicroManager.Core.Benchmark.TextureSetClassifier",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FMicroManagerCoreTextureSetClassifierBenchmark::RunTest(const FString& Parameters)
+{
+	using namespace MicroManagerCoreBenchmarks;
+
+	static const TCHAR* Suffixes[] = {
+		TEXT("_BaseColor"), TEXT("_diff"), TEXT("_Normal"), TEXT("_nor"), TEXT("_Roughness"), TEXT("_AO"), TEXT("_ORM"), TEXT("_Mask"), TEXT("")
+	};
+
+	FRandomStream Random(RandomSeed);
+	TArray<FString> TextureNames;
+	TextureNames.Reserve(NumPackages);
+	for (int32 PackageIndex = 0; PackageIndex < NumPackages; ++PackageIndex)
+	{
+		TextureNames.Add(FString::Printf(TEXT("T_Prop_%d%s"), PackageIndex, Suffixes[Random.RandRange(0, UE_ARRAY_COUNT(Suffixes) - 1)]));
+	}
+
+	const FMicroManagerTextureSetClassifier Classifier = FMicroManagerTextureSetClassifier::MakeDefault();
+
+	int32 NumClassified = 0;
+	const double StartSeconds = FPlatformTime::Seconds();
+	for (const FString& TextureName : TextureNames)
+	{
+		NumClassified += Classifier.Classify(TextureName).Channel != EMicroManagerTextureChannel::None ? 1 : 0;
+	}
+	ReportTiming(*this, TEXT("Classify"), StartSeconds, TextureNames.Num());
+
+	AddInfo(FString::Printf(TEXT("%d of %d names classified"), NumClassified, TextureNames.Num()));
+	return true;
+}
+
+#pragma endregion
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,276 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+/**
+ * Unit tests for the MicroManagerCore decisions. They only feed plain data, so they run headless:
+ * UnrealEditor-Cmd <Project>.uproject -ExecCmds="Automation RunTests MicroManager.Core; Quit" -unattended -nullrhi
+ */
+
+#include "MicroManagerCoreAlgorithms.h"
+#include "MicroManagerSizeWaiters.h"
+#include "MicroManagerTextureSetClassifier.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#pragma region PathExclusion
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMicroManagerCorePathExclusionTest, "MicroManager.Core.PathExclusion",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::SmokeFilter)
+
+bool FMicroManagerCorePathExclusionTest::RunTest(const FString& Parameters)
+{
+	TestTrue(TEXT("Developers folder"), MicroManagerCore::IsPathExcluded(TEXT("/Game/Developers/Someone")));
+	TestTrue(TEXT("Collections folder"), MicroManagerCore::IsPathExcluded(TEXT("/Game/Collections")));
+	TestTrue(TEXT("External actors"), MicroManagerCore::IsPathExcluded(TEXT("/Game/__ExternalActors__/Level/A")));
+	TestTrue(TEXT("External objects"), MicroManagerCore::IsPathExcluded(TEXT("/Game/__ExternalObjects__/Level/A")));
+	TestTrue(TEXT("Maps folder"), MicroManagerCore::IsPathExcluded(TEXT("/Game/Maps/Arena")));
+	TestFalse(TEXT("Regular folder"), MicroManagerCore::IsPathExcluded(TEXT("/Game/Props/Crates")));
+	TestFalse(TEXT("Empty path"), MicroManagerCore::IsPathExcluded(TEXT("")));
+
+	return true;
+}
+
+#pragma endregion
+
+#pragma region UnreferencedPackages
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMicroManagerCoreUnreferencedPackagesTest, "MicroManager.Core.UnreferencedPackages",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::SmokeFilter)
+
+bool FMicroManagerCoreUnreferencedPackagesTest::RunTest(const FString& Parameters)
+{
+	// 0 -> 1 -> 2, 3 only references itself, 4 is referenced from an id out of the candidate range
+	const TArray<FMicroManagerPackageEdge> Edges = {
+		{ 0, 1 }, { 1, 2 }, { 1, 2 }, { 3, 3 }, { 7, 4 }, { 2, 9 }
+	};
+
+	TBitArray<> IsUnreferenced;
+	MicroManagerCore::FindUnreferencedPackages(5, Edges, IsUnreferenced);
+
+	if (!TestEqual(TEXT("One flag per package"), IsUnreferenced.Num(), 5)) return false;
+
+	TestTrue(TEXT("Root package"), IsUnreferenced[0]);
+	TestFalse(TEXT("Referenced package"), IsUnreferenced[1]);
+	TestFalse(TEXT("Referenced twice"), IsUnreferenced[2]);
+	TestTrue(TEXT("Self reference only"), IsUnreferenced[3]);
+	TestFalse(TEXT("Referenced from outside the candidates"), IsUnreferenced[4]);
+
+	MicroManagerCore::FindUnreferencedPackages(0, Edges, IsUnreferenced);
+	TestEqual(TEXT("No packages"), IsUnreferenced.Num(), 0);
+
+	return true;
+}
+
+#pragma endregion
+
+#pragma region SameNames
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMicroManagerCoreSameNamesTest, "MicroManager.Core.SameNames",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::SmokeFilter)
+
+bool FMicroManagerCoreSameNamesTest::RunTest(const FString& Parameters)
+{
+	const TArray<FString> Names = {
+		TEXT("SM_Rock"), TEXT("T_Rock_D"), TEXT("sm_rock"), TEXT("M_Unique"), TEXT("T_Rock_D"), TEXT("SM_Rock")
+	};
+
+	TArray<int32> DuplicateIndices;
+	MicroManagerCore::GroupSameNames(Names, DuplicateIndices);
+
+	// Groups in first-seen order, members in input order, unique names left out
+	const TArray<int32> Expected = { 0, 2, 5, 1, 4 };
+	TestTrue(TEXT("Duplicate indices"), DuplicateIndices == Expected);
+
+	MicroManagerCore::GroupSameNames(TArray<FString>{ TEXT("A"), TEXT("B") }, DuplicateIndices);
+	TestEqual(TEXT("No duplicates"), DuplicateIndices.Num(), 0);
+
+	return true;
+}
+
+#pragma endregion
+
+#pragma region EmptyFolders
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMicroManagerCoreEmptyFoldersTest, "MicroManager.Core.EmptyFolders",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::SmokeFilter)
+
+bool FMicroManagerCoreEmptyFoldersTest::RunTest(const FString& Parameters)
+{
+	const TArray<FString> Folders = {
+		TEXT("/Game/A"),		// holds /Game/A/B/C
+		TEXT("/Game/A/B"),		// holds /Game/A/B/C
+		TEXT("/Game/A/Empty"),
+		TEXT("/Game/AB"),		// holds itself
+		TEXT("/Game/A-Side"),	// sorts between /Game/A and /Game/A/..., holds nothing
+		TEXT("/Game/Props")
+	};
+	const TArray<FString> AssetFolders = {
+		TEXT("/Game/A/B/C"), TEXT("/game/ab"), TEXT("/Game/A/B/C"), TEXT("/Game/Propsy")
+	};
+
+	TArray<int32> EmptyIndices;
+	MicroManagerCore::FindEmptyFolders(Folders, AssetFolders, EmptyIndices);
+
+	const TArray<int32> Expected = { 2, 4, 5 };
+	TestTrue(TEXT("Empty folder indices"), EmptyIndices == Expected);
+
+	MicroManagerCore::FindEmptyFolders(Folders, TArray<FString>(), EmptyIndices);
+	TestEqual(TEXT("Every folder is empty without assets"), EmptyIndices.Num(), Folders.Num());
+
+	return true;
+}
+
+#pragma endregion
+
+#pragma region OverlappingDuplicates
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMicroManagerCoreOverlappingDuplicatesTest, "MicroManager.Core.OverlappingDuplicates",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::SmokeFilter)
+
+bool FMicroManagerCoreOverlappingDuplicatesTest::RunTest(const FString& Parameters)
+{
+	const FQuat Turned(FVector::UpVector, FMath::DegreesToRadians(90.0));
+	const TArray<FMicroManagerPlacement> Placements = {
+		{ 0, FTransform(FVector(100.0, 0.0, 0.0)) },
+		{ 0, FTransform(FVector(100.5, 0.0, 0.0)) },					// within the location tolerance of 0
+		{ 1, FTransform(FVector(100.0, 0.0, 0.0)) },					// same spot, other group
+		{ 0, FTransform(Turned, FVector(100.0, 0.0, 0.0)) },			// rotated
+		{ 0, FTransform(FQuat::Identity, FVector(100.0, 0.0, 0.0), FVector(2.0)) },	// scaled
+		{ 0, FTransform(FVector(99.2, 0.0, 0.0)) },						// across a cell border from 0
+		{ 0, FTransform(FVector(105.0, 0.0, 0.0)) },
+		{ 0, FTransform(Turned, FVector(100.0, 0.0, 0.2)) }				// stacks on 3, not on 0
+	};
+
+	TArray<int32> DuplicateIndices;
+	MicroManagerCore::FindOverlappingDuplicates(Placements, FMicroManagerTransformTolerance(), DuplicateIndices);
+
+	const TArray<int32> Expected = { 1, 5, 7 };
+	TestTrue(TEXT("Duplicate indices"), DuplicateIndices == Expected);
+
+	FMicroManagerTransformTolerance LooseTolerance;
+	LooseTolerance.Location = 10.0;
+	LooseTolerance.RotationDegrees = 180.0;
+	MicroManagerCore::FindOverlappingDuplicates(Placements, LooseTolerance, DuplicateIndices);
+
+	// Only the scaled one and the other group stay apart
+	const TArray<int32> ExpectedLoose = { 1, 3, 5, 6, 7 };
+	TestTrue(TEXT("Duplicate indices with loose tolerance"), DuplicateIndices == ExpectedLoose);
+
+	return true;
+}
+
+#pragma endregion
+
+#pragma region SizeWaiters
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMicroManagerCoreSizeWaitersTest, "MicroManager.Core.SizeWaiters",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::SmokeFilter)
+
+bool FMicroManagerCoreSizeWaitersTest::RunTest(const FString& Parameters)
+{
+	const FName Rock(TEXT("/Game/Rock"));
+	const FName Tree(TEXT("/Game/Tree"));
+
+	int32 NumRockAndTreeCompleted = 0;
+	int32 NumTreeCompleted = 0;
+	const FSimpleDelegate OnRockAndTree = FSimpleDelegate::CreateLambda([&NumRockAndTreeCompleted]() { ++NumRockAndTreeCompleted; });
+	const FSimpleDelegate OnTree = FSimpleDelegate::CreateLambda([&NumTreeCompleted]() { ++NumTreeCompleted; });
+
+	auto RunAll = [](const TArray<FSimpleDelegate>& Callbacks)
+	{
+		for (const FSimpleDelegate& Callback : Callbacks)
+		{
+			Callback.ExecuteIfBound();
+		}
+	};
+
+	// The second request waits on the package the first one queued
+	FMicroManagerSizeWaiters Waiters;
+	Waiters.Add({ Rock, Tree }, { Rock, Tree }, OnRockAndTree);
+	Waiters.Add({ Tree }, { Tree }, OnTree);
+	const uint32 FirstGeneration = Waiters.GetGeneration();
+
+	RunAll(Waiters.OnBatchLanded(FirstGeneration, { Rock }));
+	TestEqual(TEXT("Completed with a package missing"), NumRockAndTreeCompleted, 0);
+
+	// Invalidated while the batch computing Tree is in flight
+	TArray<FMicroManagerSizeWaiters::FWaiter> InFlight = Waiters.Invalidate();
+	TestEqual(TEXT("Requests handed back"), InFlight.Num(), 2);
+	TestEqual(TEXT("Requests left waiting"), Waiters.Num(), 0);
+	if (InFlight.Num() == 2)
+	{
+		TestEqual(TEXT("Whole request handed back"), InFlight[0].RequestedPackages.Num(), 2);
+	}
+
+	RunAll(Waiters.OnBatchLanded(FirstGeneration, { Tree }));
+	TestEqual(TEXT("Stale batch completes nothing"), NumRockAndTreeCompleted + NumTreeCompleted, 0);
+
+	// Queued again against the new graph, one batch now computes both packages
+	for (FMicroManagerSizeWaiters::FWaiter& Request : InFlight)
+	{
+		TSet<FName> MissingPackages(Request.RequestedPackages);
+		Waiters.Add(MoveTemp(Request.RequestedPackages), MoveTemp(MissingPackages), Request.OnComplete);
+	}
+	TestNotEqual(TEXT("New generation"), Waiters.GetGeneration(), FirstGeneration);
+
+	RunAll(Waiters.OnBatchLanded(Waiters.GetGeneration(), { Rock, Tree }));
+	TestEqual(TEXT("First request completed once"), NumRockAndTreeCompleted, 1);
+	TestEqual(TEXT("Second request completed once"), NumTreeCompleted, 1);
+	TestEqual(TEXT("Nothing left waiting"), Waiters.Num(), 0);
+
+	return true;
+}
+
+#pragma endregion
+
+#pragma region TextureSetClassifier
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMicroManagerCoreTextureSetClassifierTest, "MicroManager.Core.TextureSetClassifier",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::SmokeFilter)
+
+bool FMicroManagerCoreTextureSetClassifierTest::RunTest(const FString& Parameters)
+{
+	const FMicroManagerTextureSetClassifier Classifier = FMicroManagerTextureSetClassifier::MakeDefault();
+
+	struct FCase
+	{
+		const TCHAR* Name;
+		EMicroManagerTextureChannel Expected;
+	};
+
+	const FCase Cases[] = {
+		{ TEXT("T_Rock_BaseColor"),		EMicroManagerTextureChannel::BaseColor },
+		{ TEXT("T_Metal_Plate_diff"),	EMicroManagerTextureChannel::BaseColor },
+		{ TEXT("T_Rock_Normal"),		EMicroManagerTextureChannel::Normal },
+		{ TEXT("T_Rock_nor"),			EMicroManagerTextureChannel::Normal },
+		{ TEXT("T_Rock_ORM"),			EMicroManagerTextureChannel::ORM },
+		{ TEXT("T_Rock_AO"),			EMicroManagerTextureChannel::AmbientOcclusion },
+		{ TEXT("T_Rock_AOMask"),		EMicroManagerTextureChannel::None },
+		{ TEXT("T_Rock"),				EMicroManagerTextureChannel::None },
+	};
+
+	for (const FCase& Case : Cases)
+	{
+		const FMicroManagerTextureClassification Classification = Classifier.Classify(Case.Name);
+		TestEqual(FString::Printf(TEXT("Channel of %s"), Case.Name),
+			FMicroManagerTextureSetClassifier::LexToString(Classification.Channel), FMicroManagerTextureSetClassifier::LexToString(Case.Expected));
+	}
+
+	// Channel words in the asset name don't make the suffix doubtful, a suffix right before it does
+	TestEqual(TEXT("Channel word in the asset name"), Classifier.Classify(TEXT("T_Metal_Plate_diff")).Confidence, 1.f);
+	TestEqual(TEXT("Channel suffix right before"), Classifier.Classify(TEXT("T_Rock_Metal_diff")).Confidence, 0.5f);
+
+	// "_nor" only counts as a whole token, never as the start of "_Normal"
+	FMicroManagerTextureSetClassifier NorOnly;
+	NorOnly.AddSuffixes(EMicroManagerTextureChannel::Normal, { TEXT("_nor") });
+	NorOnly.Compile();
+	TestTrue(TEXT("Partial token"), NorOnly.Classify(TEXT("T_Rock_Normal")).Channel == EMicroManagerTextureChannel::None);
+	TestTrue(TEXT("Whole token"), NorOnly.Classify(TEXT("T_Rock_nor")).Channel == EMicroManagerTextureChannel::Normal);
+	TestEqual(TEXT("Whole token at the end"), NorOnly.Classify(TEXT("T_Rock_nor")).Confidence, 1.f);
+
+	return true;
+}
+
+#pragma endregion
+
+#endif // WITH_DEV_AUTOMATION_TESTS
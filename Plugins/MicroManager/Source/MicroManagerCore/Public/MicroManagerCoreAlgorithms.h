@@ -0,0 +1,74 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+// A reference from one package id to another
+struct FMicroManagerPackageEdge
+{
+	int32 Referencer = INDEX_NONE;
+	int32 Dependency = INDEX_NONE;
+};
+
+// Where an item sits in a level, items only match others of the same group, e.g. the same mesh and materials
+struct FMicroManagerPlacement
+{
+	int32 GroupKey = 0;
+	FTransform Transform;
+};
+
+// How far two placements may differ and still stack on each other
+struct FMicroManagerTransformTolerance
+{
+	double Location = 1.0;
+	double RotationDegrees = 1.0;
+	double Scale = 0.01;
+};
+
+/**
+ * MicroManagerCore
+ * The decisions behind the MicroManager operations, on plain data only. The editor module gathers the
+ * data from the Asset Registry and applies the results, these functions never touch an engine API.
+ */
+namespace MicroManagerCore
+{
+	// Folders MicroManager must never list nor delete from: developer, collection, external actor and map folders
+	MICROMANAGERCORE_API bool IsPathExcluded(FStringView Path);
+
+	/**
+	 * Flags the packages nothing else references. A package referencing itself still counts as unreferenced.
+	 *
+	 * @param NumPackages Package ids are 0 .. NumPackages - 1, edges to ids out of range are ignored.
+	 * @param Edges References between packages, in any order, duplicates allowed.
+	 * @param OutIsUnreferenced One flag per package id.
+	 */
+	MICROMANAGERCORE_API void FindUnreferencedPackages(int32 NumPackages, TConstArrayView<FMicroManagerPackageEdge> Edges, TBitArray<>& OutIsUnreferenced);
+
+	/**
+	 * Finds the names shared by more than one item, compared without case.
+	 *
+	 * @param Names One name per item.
+	 * @param OutDuplicateIndices Indices of every item whose name is shared, the items of a name are contiguous
+	 *                            and keep their input order, names appear in the order they were first met.
+	 */
+	MICROMANAGERCORE_API void GroupSameNames(TConstArrayView<FString> Names, TArray<int32>& OutDuplicateIndices);
+
+	/**
+	 * Finds the folders holding no asset, neither directly nor in a sub folder.
+	 *
+	 * @param FolderPaths Candidate folders, without trailing slash.
+	 * @param AssetFolderPaths Folder of every asset, duplicates allowed.
+	 * @param OutEmptyFolderIndices Indices into FolderPaths, ascending.
+	 */
+	MICROMANAGERCORE_API void FindEmptyFolders(TConstArrayView<FString> FolderPaths, TConstArrayView<FString> AssetFolderPaths, TArray<int32>& OutEmptyFolderIndices);
+
+	/**
+	 * Finds the placements stacked on an earlier one of the same group, through a spatial hash with cells the size
+	 * of the location tolerance so each placement is only compared with its 27 neighboring cells.
+	 *
+	 * @param Placements Items in priority order, of two stacked items the first one is kept.
+	 * @param OutDuplicateIndices Indices of the items to remove, ascending.
+	 */
+	MICROMANAGERCORE_API void FindOverlappingDuplicates(TConstArrayView<FMicroManagerPlacement> Placements, const FMicroManagerTransformTolerance& Tolerance, TArray<int32>& OutDuplicateIndices);
+}
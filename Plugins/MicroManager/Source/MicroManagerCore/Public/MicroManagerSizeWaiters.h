@@ -0,0 +1,48 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * FMicroManagerSizeWaiters
+ * Tracks the size requests still waiting on packages that background batches compute. A request completes once
+ * every package it asked for landed, whichever batch computed it, so two requests sharing packages never compute
+ * them twice. Invalidate starts a new generation and hands back the requests in flight, batches of an older
+ * generation then complete nothing and the owner queues those requests again against fresh data.
+ *
+ * Plain data only, the editor size cache drives it from the game thread.
+ */
+class MICROMANAGERCORE_API FMicroManagerSizeWaiters
+{
+public:
+	struct FWaiter
+	{
+		// The whole request, so it can be queued again once the cache was dropped
+		TArray<FName> RequestedPackages;
+
+		// Packages of the request not landed yet
+		TSet<FName> MissingPackages;
+
+		FSimpleDelegate OnComplete;
+	};
+
+	uint32 GetGeneration() const { return Generation; }
+
+	int32 Num() const { return Waiters.Num(); }
+
+	// Waits for MissingPackages, every one of them must be part of a batch of the current generation
+	void Add(TArray<FName>&& RequestedPackages, TSet<FName>&& MissingPackages, FSimpleDelegate OnComplete);
+
+	// Marks the packages of a batch as landed. Returns the callbacks of the requests now complete, in request order,
+	// for the caller to run once its own state is updated. A batch of an older generation completes nothing.
+	TArray<FSimpleDelegate> OnBatchLanded(uint32 BatchGeneration, TConstArrayView<FName> PackageNames);
+
+	// Starts a new generation and returns every request still waiting, in request order
+	TArray<FWaiter> Invalidate();
+
+private:
+	TArray<FWaiter> Waiters;
+
+	uint32 Generation = 0;
+};
@@ -0,0 +1,80 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Material input a texture of a texture set feeds
+enum class EMicroManagerTextureChannel : uint8
+{
+	None,
+	BaseColor,
+	Metallic,
+	Roughness,
+	Normal,
+	AmbientOcclusion,
+	// Occlusion, roughness and metallic packed in R, G and B
+	ORM
+};
+
+struct FMicroManagerTextureClassification
+{
+	EMicroManagerTextureChannel Channel = EMicroManagerTextureChannel::None;
+
+	// 1 for an unambiguous match ending the name, lower when the match is followed by more tokens
+	// or when a suffix of another channel comes right before it
+	float Confidence = 0.f;
+
+	// Suffix that decided the channel, as it was registered
+	FString MatchedSuffix;
+};
+
+/**
+ * FMicroManagerTextureSetClassifier
+ * Classifies texture names into material channels from per-channel suffix lists.
+ * Every suffix is compiled into one case-insensitive trie and a name is classified in a single pass
+ * that only starts a match at a token boundary and only accepts it when it ends at one, so "_nor"
+ * never fires inside "_Normal" nor "_AO" inside "_AOMask". The match ending last wins,
+ * then the longest, so "T_Metal_Plate_diff" is a base color and "_RoughnessMap" beats "_Roughness".
+ *
+ * Depends on Core only, so the batch builder, commandlets and tests can use it without the editor.
+ */
+class MICROMANAGERCORE_API FMicroManagerTextureSetClassifier
+{
+public:
+	// Adds suffixes to a channel, takes effect on the next Compile
+	void AddSuffixes(EMicroManagerTextureChannel Channel, const TArray<FString>& Suffixes);
+
+	void Reset();
+
+	// Builds the trie from every suffix added so far
+	void Compile();
+
+	bool IsCompiled() const { return TrieChildOffsets.Num() > 0; }
+
+	FMicroManagerTextureClassification Classify(FStringView TextureName) const;
+
+	// The suffix lists the quick material creation widget starts with
+	static FMicroManagerTextureSetClassifier MakeDefault();
+
+	static const TCHAR* LexToString(EMicroManagerTextureChannel Channel);
+
+private:
+	struct FSuffix
+	{
+		FString Text;
+		EMicroManagerTextureChannel Channel;
+	};
+
+	TArray<FSuffix> Suffixes;
+
+	// Children of node N are TrieLabels/TrieTargets[TrieChildOffsets[N] .. TrieChildOffsets[N + 1]], sorted by label
+	TArray<int32> TrieChildOffsets;
+	TArray<TCHAR> TrieLabels;
+	TArray<int32> TrieTargets;
+
+	// Suffix ending at each node, INDEX_NONE if none does
+	TArray<int32> TrieSuffixes;
+
+	int32 FindChild(int32 Node, TCHAR Label) const;
+};